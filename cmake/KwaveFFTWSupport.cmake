@@ -0,0 +1,40 @@
+#############################################################################
+##    Kwave                - cmake/KwaveFFTWSupport.txt
+##                           -------------------
+##    begin                : Sun Oct 18 2026
+##    copyright            : (C) 2026 by Thomas Eschenbacher
+##    email                : Thomas.Eschenbacher@gmx.de
+#############################################################################
+#
+#############################################################################
+#                                                                           #
+# Redistribution and use in source and binary forms, with or without        #
+# modification, are permitted provided that the following conditions        #
+# are met:                                                                  #
+#                                                                           #
+# 1. Redistributions of source code must retain the above copyright         #
+#    notice, this list of conditions and the following disclaimer.          #
+# 2. Redistributions in binary form must reproduce the above copyright      #
+#    notice, this list of conditions and the following disclaimer in the    #
+#    documentation and/or other materials provided with the distribution.   #
+#                                                                           #
+# For details see the accompanying cmake/COPYING-CMAKE-SCRIPTS file.        #
+#                                                                           #
+#############################################################################
+
+INCLUDE(FindPkgConfig)
+INCLUDE(UsePkgConfig)
+
+#############################################################################
+### check for FFTW v3 headers and library                                 ###
+
+PKG_CHECK_MODULES(FFTW REQUIRED fftw3>=3.0)
+IF (NOT FFTW_FOUND)
+    MESSAGE(FATAL_ERROR "FFTW library not found")
+ENDIF(NOT FFTW_FOUND)
+
+MESSAGE(STATUS "Found FFTW library in ${FFTW_LIBDIR}")
+MESSAGE(STATUS "Found FFTW headers in ${FFTW_INCLUDEDIR}")
+
+#############################################################################
+#############################################################################
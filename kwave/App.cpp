@@ -32,14 +32,18 @@
 #include <KSharedConfig>
 
 #include "libkwave/ClipBoard.h"
+#include "libkwave/Dither.h"
 #include "libkwave/LabelList.h"
 #include "libkwave/Logger.h"
+#include "libkwave/MemoryBudget.h"
 #include "libkwave/Parser.h"
 #include "libkwave/PluginManager.h"
+#include "libkwave/Profiler.h"
 #include "libkwave/Sample.h"
 #include "libkwave/SampleArray.h"
 #include "libkwave/SignalManager.h"
 #include "libkwave/String.h"
+#include "libkwave/TaskPool.h"
 #include "libkwave/Utils.h"
 
 #include "App.h"
@@ -94,6 +98,23 @@ void Kwave::App::processCmdline(QCommandLineParser *cmdline)
     }
     // else: use default
 
+    // read the dither settings for saving and playback
+    bool mode_ok    = false;
+    bool shaping_ok = false;
+    const Kwave::Dither::Mode mode = Kwave::Dither::modeFromName(
+        cfg.readEntry("Dither"), &mode_ok);
+    const Kwave::Dither::Shaping shaping = Kwave::Dither::shapingFromName(
+        cfg.readEntry("Noise Shaping"), &shaping_ok);
+    if (mode_ok)
+        Kwave::Dither::setDefaults(mode, (shaping_ok) ?
+            shaping : Kwave::Dither::defaultShaping());
+
+    // read the limits for worker threads and memory of all files,
+    // zero means automatic
+    Kwave::TaskPool::setMaxThreads(cfg.readEntry("Worker Threads", 0));
+    Kwave::MemoryBudget::instance().setLimit(
+        cfg.readEntry("Memory Limit", 0));
+
     // if user interface type is given as cmdline parameter: use that one
     if (m_cmdline->isSet(_("gui"))) {
         QString arg = m_cmdline->value(_("gui")).toUpper();
@@ -124,6 +145,9 @@ Kwave::App::~App()
 
     // let remaining cleanup handlers run (deferred delete)
     processEvents(QEventLoop::ExcludeUserInputEvents);
+
+    // write the performance trace, if requested
+    Kwave::Profiler::stopTrace();
 }
 
 //***************************************************************************
@@ -147,6 +171,11 @@ int Kwave::App::newInstance(const QStringList &args, const QString &dir)
                 exit(-1);
         }
 
+        if (m_cmdline->isSet(_("trace"))) {
+            if (!Kwave::Profiler::startTrace(m_cmdline->value(_("trace"))))
+                exit(-1);
+        }
+
         Kwave::Splash::showMessage(i18n("Reading configuration..."));
         readConfig();
 
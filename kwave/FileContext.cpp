@@ -22,6 +22,7 @@
 
 #include <QApplication>
 #include <QFile>
+#include <QFileInfo>
 #include <QLocale>
 #include <QPointer>
 #include <QTextStream>
@@ -80,6 +81,7 @@ Kwave::FileContext::FileContext(Kwave::App &app)
      m_last_status_message_text(),
      m_last_status_message_timer(),
      m_last_status_message_ms(0),
+     m_save_progress(-1),
      m_last_undo(QString()),
      m_last_redo(QString()),
      m_instance_nr(-1),
@@ -187,6 +189,10 @@ bool Kwave::FileContext::init(Kwave::TopWidget *top_widget)
             this, SLOT(setUndoRedoInfo(QString,QString)));
     connect(m_signal_manager, SIGNAL(sigModified()),
             this,             SLOT(modifiedChanged()));
+    connect(m_signal_manager, SIGNAL(sigSaveProgress(QString,qreal)),
+            this,             SLOT(saveProgress(QString,qreal)));
+    connect(m_signal_manager, SIGNAL(sigSaveDone(QString,int)),
+            this,             SLOT(saveDone(QString,int)));
 
     // connect the plugin manager
     connect(m_plugin_manager, SIGNAL(sigCommand(QString)),
@@ -451,6 +457,8 @@ int Kwave::FileContext::executeCommand(const QString &line)
         result = revert();
     CASE_COMMAND("save")
         result = saveFile();
+    CASE_COMMAND("cancelsave")
+        if (m_signal_manager) m_signal_manager->cancelSave();
     CASE_COMMAND("saveas")
         result = saveFileAs(parser.nextParam(), false);
     CASE_COMMAND("saveselect")
@@ -612,6 +620,34 @@ void Kwave::FileContext::modifiedChanged()
         m_main_widget->setWindowTitle(windowCaption(true));
 }
 
+//***************************************************************************
+void Kwave::FileContext::saveProgress(const QString &filename, qreal percent)
+{
+    const int progress = qBound(0, Kwave::toInt(percent), 100);
+    if (progress == m_save_progress) return;
+    m_save_progress = progress;
+
+    QFileInfo file(filename);
+    statusBarMessage(i18n("Saving '%1'...", file.fileName()), 0);
+    if (isActive()) emit sigSaveProgress(m_save_progress);
+}
+
+//***************************************************************************
+void Kwave::FileContext::saveDone(const QString &filename, int result)
+{
+    m_save_progress = -1;
+    if (isActive()) emit sigSaveProgress(m_save_progress);
+
+    QFileInfo file(filename);
+    if (!result)
+        statusBarMessage(i18n("Saved '%1'", file.fileName()), 2000);
+    else if (result == -EINTR)
+        statusBarMessage(i18n("Saving '%1' has been canceled",
+                              file.fileName()), 2000);
+    else
+        statusBarMessage(QString(), 0);
+}
+
 //***************************************************************************
 void Kwave::FileContext::contextSwitched(Kwave::FileContext *context)
 {
@@ -660,7 +696,7 @@ void Kwave::FileContext::activated()
 
     // emit latest meta data
     if (m_signal_manager)
-        emit sigMetaDataChanged(m_signal_manager->metaData());
+        emit sigMetaDataChanged(std::as_const(*m_signal_manager).metaData());
 
     // emit latest view range change
     if (m_main_widget && m_signal_manager) {
@@ -673,6 +709,9 @@ void Kwave::FileContext::activated()
     // force update of the "modified" state
     emit sigModified();
 
+    // show or hide the progress of a save in background
+    emit sigSaveProgress(m_save_progress);
+
     // emit last undo/redo info
     emit sigUndoRedoInfo(m_last_undo, m_last_redo);
 
@@ -953,7 +992,7 @@ int Kwave::FileContext::saveFileAs(const QString &filename, bool selection)
         if (!encoder) {
             // no extension selected yet, use mime type from file info
             QString mime_type = Kwave::FileInfo(
-                m_signal_manager->metaData()).get(
+                std::as_const(*m_signal_manager).metaData()).get(
                     Kwave::INF_MIMETYPE).toString();
             encoder = Kwave::CodecManager::encoder(mime_type);
             if (encoder) {
@@ -1032,7 +1071,7 @@ int Kwave::FileContext::saveFileAs(const QString &filename, bool selection)
 
     // maybe we now have a new mime type
     QString previous_mimetype_name =
-        Kwave::FileInfo(m_signal_manager->metaData()).get(
+        Kwave::FileInfo(std::as_const(*m_signal_manager).metaData()).get(
             Kwave::INF_MIMETYPE).toString();
 
     QString new_mimetype_name = Kwave::CodecManager::mimeTypeOf(url);
@@ -1047,7 +1086,7 @@ int Kwave::FileContext::saveFileAs(const QString &filename, bool selection)
             DBG(previous_mimetype_name) );
 
         // set the new mimetype
-        Kwave::FileInfo info(m_signal_manager->metaData());
+        Kwave::FileInfo info(std::as_const(*m_signal_manager).metaData());
         info.set(Kwave::INF_MIMETYPE, new_mimetype_name);
 
         // set the new filename
@@ -1061,7 +1100,7 @@ int Kwave::FileContext::saveFileAs(const QString &filename, bool selection)
                : -1;
 
         // restore the mime type and the filename
-        info = Kwave::FileInfo(m_signal_manager->metaData());
+        info = Kwave::FileInfo(std::as_const(*m_signal_manager).metaData());
         info.set(Kwave::INF_MIMETYPE, previous_mimetype_name);
         info.set(Kwave::INF_FILENAME, url.toDisplayString());
         m_signal_manager->setFileInfo(info, false);
@@ -1097,6 +1136,10 @@ bool Kwave::FileContext::closeFile()
             res = saveFile();
             qDebug("FileContext::closeFile()::saveFile, res=%d",res);
             if (res) return false;
+
+            // the file must be complete before the signal can be closed
+            res = m_signal_manager->waitForSave();
+            if (res) return false;
         }
     }
 
@@ -234,6 +234,12 @@ namespace Kwave
          */
         void sigModified();
 
+        /**
+         * Emits the progress of a save in background
+         * @param percent progress [0...100] or -1 if no save is running
+         */
+        void sigSaveProgress(int percent);
+
         /**
          * emitted when the context is about to be destroyed
          * (in the context of it's destructor)
@@ -304,6 +310,20 @@ namespace Kwave
          */
         void modifiedChanged();
 
+        /**
+         * Called during a save in background
+         * @param filename name of the file that is saved
+         * @param percent the progress [0...100]
+         */
+        void saveProgress(const QString &filename, qreal percent);
+
+        /**
+         * Called when a save in background is done
+         * @param filename name of the file that has been saved
+         * @param result zero if succeeded or negative error code
+         */
+        void saveDone(const QString &filename, int result);
+
         /** process the next delayed command from m_delayed_command_queue */
         void processDelayedCommand();
 
@@ -418,6 +438,9 @@ namespace Kwave
         /** number of milliseconds the status message should be shown */
         unsigned int m_last_status_message_ms;
 
+        /** progress of a save in background [0...100] or -1 */
+        int m_save_progress;
+
         /** name of the last undo action */
         QString m_last_undo;
 
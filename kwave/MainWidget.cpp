@@ -169,7 +169,7 @@ Kwave::MainWidget::MainWidget(QWidget *parent, Kwave::FileContext &context,
             this,       SLOT(setOffset(sample_index_t)));
     connect(m_overview, SIGNAL(sigCommand(QString)),
             this,       SIGNAL(sigCommand(QString)));
-    m_overview->metaDataChanged(signal_manager->metaData());
+    m_overview->metaDataChanged(std::as_const(*signal_manager).metaData());
     m_overview->hide();
 
     // -- horizontal scrollbar --
@@ -442,7 +442,7 @@ int Kwave::MainWidget::executeCommand(const QString &command)
                   (m_offset - visible_samples) : 0);
     CASE_COMMAND("view:scroll_next_label")
         sample_index_t ofs =
-            Kwave::LabelList(signal_manager->metaData()).nextLabelRight(
+            signal_manager->labels().nextLabelRight(
                 m_offset + (visible_samples / 2));
         if (ofs > signal_length)
             ofs = signal_length - 1;
@@ -450,7 +450,7 @@ int Kwave::MainWidget::executeCommand(const QString &command)
                   (ofs - (visible_samples / 2)) : 0);
     CASE_COMMAND("view:scroll_prev_label")
         sample_index_t ofs =
-            Kwave::LabelList(signal_manager->metaData()).nextLabelLeft(
+            signal_manager->labels().nextLabelLeft(
                 m_offset + (visible_samples / 2));
         setOffset((ofs > (visible_samples / 2)) ?
                   (ofs - (visible_samples / 2)) : 0);
@@ -493,7 +493,7 @@ int Kwave::MainWidget::executeCommand(const QString &command)
         }
     CASE_COMMAND("label:edit")
         int index = parser.toInt();
-        Kwave::LabelList labels(signal_manager->metaData());
+        const Kwave::LabelIndex &labels = signal_manager->labels();
         if ((index >= labels.count()) || (index < 0))
             return -EINVAL;
         Kwave::Label label = labels.at(index);
@@ -676,7 +676,7 @@ double Kwave::MainWidget::fullZoom() const
     if (!length) {
         // no length: streaming mode -> try to use "estimated length"
         // and add some extra, 10% should be ok
-        Kwave::FileInfo info(signal_manager->metaData());
+        Kwave::FileInfo info(std::as_const(*signal_manager).metaData());
         if (info.contains(Kwave::INF_ESTIMATED_LENGTH)) {
             // estimated length in samples
             length = info.get(Kwave::INF_ESTIMATED_LENGTH).toULongLong();
@@ -1011,8 +1011,9 @@ int Kwave::MainWidget::saveLabels(const QString &filename)
     file.open(QIODevice::WriteOnly);
     QTextStream out(&file);
 
-    Kwave::LabelList labels(signal_manager->metaData());
-    foreach (const Kwave::Label &label, labels) {
+    const Kwave::LabelIndex &labels = signal_manager->labels();
+    for (int index = 0; index < labels.count(); ++index) {
+        const Kwave::Label &label = labels.at(index);
         sample_index_t pos = label.pos();
         const QString name = Kwave::Parser::escape(label.name());
         out << _("label:add(") << pos;
@@ -39,9 +39,11 @@
 #include <QMenuBar>
 #include <QMutableMapIterator>
 #include <QPixmap>
+#include <QProgressBar>
 #include <QSizePolicy>
 #include <QStatusBar>
 #include <QStringList>
+#include <QToolButton>
 #include <QtGlobal>
 
 #include <KComboBox>
@@ -55,8 +57,9 @@
 
 #include "libkwave/ClipBoard.h"
 #include "libkwave/CodecManager.h"
+#include "libkwave/Dither.h"
 #include "libkwave/FileDrag.h"
-#include "libkwave/LabelList.h"
+#include "libkwave/LabelIndex.h"
 #include "libkwave/Logger.h"
 #include "libkwave/MessageBox.h"
 #include "libkwave/MetaDataList.h"
@@ -135,6 +138,26 @@ Kwave::TopWidget::TopWidget(Kwave::App &app)
     m_lbl_status_size->setSizePolicy(policy);
     m_lbl_status_size->setFrameStyle(frame_style);
 
+    // progress and cancel button of a save in background, only
+    // visible while saving
+    m_save_progress = new(std::nothrow) QProgressBar(this);
+    if (m_save_progress) {
+        m_save_progress->setRange(0, 100);
+        m_save_progress->setMaximumWidth(150);
+        m_save_progress->setVisible(false);
+        status_bar->addPermanentWidget(m_save_progress);
+    }
+    m_save_cancel = new(std::nothrow) QToolButton(this);
+    if (m_save_cancel) {
+        m_save_cancel->setIcon(QIcon::fromTheme(_("process-stop")));
+        m_save_cancel->setToolTip(i18n("Cancel saving"));
+        m_save_cancel->setAutoRaise(true);
+        m_save_cancel->setVisible(false);
+        status_bar->addPermanentWidget(m_save_cancel);
+        connect(m_save_cancel, SIGNAL(clicked()),
+                this,          SLOT(statusBarCancelSave()));
+    }
+
     // start up iconified if requested
     const QCommandLineParser *args = m_application.cmdline();
     bool iconic = (args && args->isSet(_("iconic")));
@@ -182,6 +205,8 @@ void Kwave::TopWidget::connectContext(Kwave::FileContext *context)
     // connect the status bar
     connect(context, SIGNAL(sigStatusBarMessage(QString,uint)),
             this,    SLOT(showStatusBarMessage(QString,uint)));
+    connect(context, SIGNAL(sigSaveProgress(int)),
+            this,    SLOT(showSaveProgress(int)));
 }
 
 //***************************************************************************
@@ -721,6 +746,24 @@ int Kwave::TopWidget::executeCommand(const QString &line)
         KHelpMenu *dlg = new(std::nothrow) KHelpMenu(this, _("Kwave"));
         if (dlg) dlg->aboutKDE();
         result = 0;
+    CASE_COMMAND("dither")
+        // dither for saving and playback: mode [,noise shaping]
+        bool mode_ok    = false;
+        bool shaping_ok = true;
+        const Kwave::Dither::Mode mode =
+            Kwave::Dither::modeFromName(parser.firstParam(), &mode_ok);
+        Kwave::Dither::Shaping shaping = Kwave::Dither::Flat;
+        if (parser.count() > 1)
+            shaping = Kwave::Dither::shapingFromName(
+                parser.nextParam(), &shaping_ok);
+        if (!mode_ok || !shaping_ok) return -EINVAL;
+
+        Kwave::Dither::setDefaults(mode, shaping);
+        KConfigGroup cfg = KSharedConfig::openConfig()->group(u"Global"_s);
+        cfg.writeEntry(_("Dither"), Kwave::Dither::modeName(mode));
+        cfg.writeEntry(_("Noise Shaping"), Kwave::Dither::shapingName(shaping));
+        updateMenu();
+        result = 0;
     CASE_COMMAND("menu")
         Q_ASSERT(m_menu_manager);
         if (m_menu_manager) result = m_menu_manager->executeCommand(command);
@@ -1364,6 +1407,26 @@ void Kwave::TopWidget::updateMenu()
         DEFAULT_IMPOSSIBLE;
     }
 
+    // dither for saving and playback, not all combinations are in the menu
+    switch (Kwave::Dither::defaultMode()) {
+        case Kwave::Dither::None:
+            m_menu_manager->selectItem(_("@DITHER"), _("ID_DITHER_NONE"));
+            break;
+        case Kwave::Dither::Rectangular:
+            m_menu_manager->selectItem(_("@DITHER"),
+                                       _("ID_DITHER_RECTANGULAR"));
+            break;
+        case Kwave::Dither::Triangular: {
+            QString id = _("ID_DITHER_TPDF");
+            const Kwave::Dither::Shaping shaping =
+                Kwave::Dither::defaultShaping();
+            if (shaping != Kwave::Dither::Flat)
+                id += _("_") + Kwave::Dither::shapingName(shaping).toUpper();
+            m_menu_manager->selectItem(_("@DITHER"), id);
+            break;
+        }
+    }
+
     if (have_window_menu) {
         // update the "Windows" menu
         m_menu_manager->clearNumberedMenu(_("ID_WINDOW_LIST"));
@@ -1397,7 +1460,7 @@ void Kwave::TopWidget::updateMenu()
     // and update the label menu
     bool have_labels = false;
     if (signal_manager) {
-        Kwave::LabelList labels(signal_manager->metaData());
+        const Kwave::LabelIndex &labels = signal_manager->labels();
         have_labels = !labels.isEmpty();
 
         m_menu_manager->clearNumberedMenu(_("ID_LABEL_DELETE"));
@@ -1410,9 +1473,8 @@ void Kwave::TopWidget::updateMenu()
                       "(All)"), _("-1"));
 
             // iterate over the list of labels
-            unsigned int index = 0;
-            foreach (const Kwave::Label &label, labels) {
-                QString name = label.name();
+            for (int index = 0; index < labels.count(); ++index) {
+                QString name = labels.at(index).name();
                 QString desc = (name.length()) ?
                     i18nc(
                     "list menu entry of a label, %1=index, %2=description/name",
@@ -1422,7 +1484,6 @@ void Kwave::TopWidget::updateMenu()
                             "#%1", index);
                 m_menu_manager->addNumberedMenuEntry(
                     _("ID_LABEL_DELETE"), desc, name.setNum(index));
-                index++;
             }
         }
     }
@@ -1447,7 +1508,7 @@ void Kwave::TopWidget::updateMenu()
     bool enable_revert = false;
     if (signal_manager) {
         bool have_filename = Kwave::FileInfo(
-            signal_manager->metaData()
+            std::as_const(*signal_manager).metaData()
         ).contains(Kwave::INF_FILENAME);
         bool is_modified = signal_manager->isModified();
         enable_revert = have_filename && is_modified;
@@ -1573,6 +1634,17 @@ void Kwave::TopWidget::showStatusBarMessage(const QString &msg,
         status_bar->clearMessage();
 }
 
+//***************************************************************************
+void Kwave::TopWidget::showSaveProgress(int percent)
+{
+    const bool saving = (percent >= 0);
+    if (m_save_progress) {
+        if (saving) m_save_progress->setValue(percent);
+        m_save_progress->setVisible(saving);
+    }
+    if (m_save_cancel) m_save_cancel->setVisible(saving);
+}
+
 //***************************************************************************
 void Kwave::TopWidget::subWindowActivated(QMdiSubWindow *sub)
 {
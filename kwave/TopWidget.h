@@ -41,6 +41,8 @@ class QDragEnterEvent;
 class QDropEvent;
 class QLabel;
 class QMdiSubWindow;
+class QProgressBar;
+class QToolButton;
 
 namespace Kwave
 {
@@ -248,6 +250,15 @@ namespace Kwave
          */
         void showStatusBarMessage(const QString &msg, unsigned int ms);
 
+        /**
+         * Shows the progress of a save in background in the status bar
+         * @param percent progress [0...100] or -1 to hide it
+         */
+        void showSaveProgress(int percent);
+
+        /** status bar: cancel a save in background */
+        void statusBarCancelSave() { forwardCommand(_("cancelsave()")); }
+
         /**
          * called when a MDI sub window or TAB has been activated
          * @param sub the sub window that has been activated
@@ -393,6 +404,12 @@ namespace Kwave
 
         /** status bar label for cursor / playback position */
         QLabel *m_lbl_status_cursor = nullptr;
+
+        /** status bar progress of a save in background */
+        QProgressBar *m_save_progress = nullptr;
+
+        /** status bar button for canceling a save in background */
+        QToolButton *m_save_cancel = nullptr;
     };
 }
 
@@ -174,6 +174,12 @@ int main(int argc, char **argv)
               "Log all commands into a file <file>."),
         i18nc("placeholder of command line parameter", "file")
     ));
+    cmdline.addOption(QCommandLineOption(
+        _("trace"),
+        i18nc("description of command line parameter",
+              "Write a performance trace into a file <file>."),
+        i18nc("placeholder of command line parameter", "file")
+    ));
     cmdline.addOption(QCommandLineOption(
         _("gui"),
         i18nc("description of command line parameter",
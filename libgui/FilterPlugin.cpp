@@ -30,6 +30,7 @@
 #include "libkwave/MultiTrackReader.h"
 #include "libkwave/MultiTrackWriter.h"
 #include "libkwave/PluginManager.h"
+#include "libkwave/Profiler.h"
 #include "libkwave/SampleSink.h"
 #include "libkwave/modules/StreamObject.h"
 #include "libkwave/undo/UndoTransactionGuard.h"
@@ -181,6 +182,11 @@ void Kwave::FilterPlugin::run(QStringList params)
             sleep(1);
     }
 
+    // count the processed samples, the time is measured by the caller
+    if (!m_listen)
+        Kwave::Profiler::count("filtered samples",
+            static_cast<qint64>(last - first + 1) * tracks.count());
+
     // cleanup
     delete filter;
     if (!m_listen) {
@@ -70,7 +70,7 @@ void Kwave::SelectionItem::startDragging()
                                 m_signal_manager.selectedTracks(), first, last);
 
     // create the file info
-    Kwave::MetaDataList meta = m_signal_manager.metaData();
+    Kwave::MetaDataList meta = std::as_const(m_signal_manager).metaData();
     Kwave::FileInfo info(meta);
     info.setLength(last - first + 1);
     info.setRate(rate);
@@ -43,7 +43,7 @@
 #include <KLocalizedString>
 
 #include "libkwave/ClipBoard.h"
-#include "libkwave/LabelList.h"
+#include "libkwave/LabelIndex.h"
 #include "libkwave/Track.h"
 #include "libkwave/Utils.h"
 
@@ -181,7 +181,7 @@ void Kwave::SignalWidget::contextMenuEvent(QContextMenuEvent *e)
     if (!have_signal)return;
     bool have_selection = (m_signal_manager->selection().length() > 1);
     bool have_labels =
-        !(Kwave::LabelList(m_signal_manager->metaData()).isEmpty());
+        !(m_signal_manager->labels().isEmpty());
 
     QMenu *context_menu = new(std::nothrow) QMenu(this);
     Q_ASSERT(context_menu);
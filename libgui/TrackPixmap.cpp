@@ -22,6 +22,7 @@
 #include <QPolygon>
 #include <QTime>
 
+#include "libkwave/Profiler.h"
 #include "libkwave/SampleReader.h"
 #include "libkwave/Track.h"
 
@@ -49,7 +50,7 @@ Kwave::TrackPixmap::TrackPixmap(Kwave::Track &track)
     m_sample_buffer(), m_min_buffer(), m_max_buffer(),
     m_modified(false), m_valid(0), m_lock_buffer(),
     m_interpolation_order(0), m_interpolation_alpha(),
-    m_colors(Kwave::Colors::Normal)
+    m_colors(Kwave::Colors::Normal), m_tiles(track)
 {
     // connect all the notification signals of the track
     connect(&track,
@@ -65,6 +66,8 @@ Kwave::TrackPixmap::TrackPixmap(Kwave::Track &track)
         sample_index_t, sample_index_t)));
     connect(&track, SIGNAL(sigSelectionChanged(bool)),
             this, SLOT(selectionChanged()));
+    connect(&m_tiles, SIGNAL(sigTilesReady()),
+            this, SLOT(tilesReady()));
 }
 
 //***************************************************************************
@@ -377,6 +380,7 @@ bool Kwave::TrackPixmap::validateBuffer()
 //***************************************************************************
 void Kwave::TrackPixmap::repaint()
 {
+    Kwave::ProfileScope profile("repaint");
     QMutexLocker lock(&m_lock_buffer);
 
     int w = width();
@@ -394,13 +398,16 @@ void Kwave::TrackPixmap::repaint()
     p.fillRect(0, 0, w, h, m_colors.background);
 
     if (m_zoom > 0) {
-        // first make the buffer valid
-        validateBuffer();
-
-        // then draw the samples
         if (m_minmax_mode) {
-            drawOverview(p, h >> 1, h, 0, w - 1);
+            // composite the tiles, missing ones are rendered in the
+            // background and trigger another repaint when ready
+            m_tiles.draw(p, m_offset, m_zoom, w, h, m_vertical_zoom,
+                         m_colors);
         } else {
+            // first make the buffer valid
+            validateBuffer();
+
+            // then draw the samples
             if (m_zoom < INTERPOLATION_ZOOM) {
                 drawInterpolatedSignal(p, w, h >> 1, h);
             } else {
@@ -450,37 +457,14 @@ void Kwave::TrackPixmap::selectionChanged()
 }
 
 //***************************************************************************
-void Kwave::TrackPixmap::drawOverview(QPainter &p, int middle, int height,
-                                      int first, int last)
+void Kwave::TrackPixmap::tilesReady()
 {
-    const Kwave::SampleArray &min_buffer = m_min_buffer;
-    const Kwave::SampleArray &max_buffer = m_max_buffer;
-
-    Q_ASSERT(m_minmax_mode);
-    Q_ASSERT(width() <= Kwave::toInt(min_buffer.size()));
-    Q_ASSERT(width() <= Kwave::toInt(max_buffer.size()));
-
-    // scale_y: pixels per unit
-    double scale_y = (m_vertical_zoom * height) / (1 << SAMPLE_BITS);
-
-    p.setPen(m_colors.sample);
-    int last_min = Kwave::toInt(min_buffer[first] * scale_y);
-    int last_max = Kwave::toInt(max_buffer[first] * scale_y);
-    for (int i = first; i <= last; i++) {
-        Q_ASSERT(m_valid[i]);
-        int max = Kwave::toInt(max_buffer[i] * scale_y);
-        int min = Kwave::toInt(min_buffer[i] * scale_y);
-
-        // make sure there is a connection between this
-        // section and the one before, avoid gaps
-        if (min > last_max + 1) min = last_max + 1;
-        if (max + 1 < last_min) max = last_min - 1;
-
-        p.drawLine(i, middle - max, i, middle - min);
-
-        last_min = min;
-        last_max = max;
+    {
+        QMutexLocker lock(&m_lock_buffer);
+        if (!m_minmax_mode) return; // not interested
+        m_modified = true;
     }
+    emit sigModified();
 }
 
 //***************************************************************************
@@ -712,6 +696,9 @@ void Kwave::TrackPixmap::slotSamplesInserted(Kwave::Track *,
     {
         QMutexLocker lock(&m_lock_buffer);
 
+        // the cached tiles are affected even if not visible
+        m_tiles.invalidate(offset, SAMPLE_INDEX_MAX);
+
         convertOverlap(offset, length);
         if (!length) return; // false alarm
 
@@ -738,6 +725,9 @@ void Kwave::TrackPixmap::slotSamplesDeleted(Kwave::Track *,
     {
         QMutexLocker lock(&m_lock_buffer);
 
+        // the cached tiles are affected even if not visible
+        m_tiles.invalidate(offset, SAMPLE_INDEX_MAX);
+
         convertOverlap(offset, length);
         if (!length) return; // false alarm
 
@@ -764,6 +754,9 @@ void Kwave::TrackPixmap::slotSamplesModified(Kwave::Track *,
     {
         QMutexLocker lock(&m_lock_buffer);
 
+        // the cached tiles are affected even if not visible
+        m_tiles.invalidate(offset, length);
+
         convertOverlap(offset, length);
         if (!length) return; // false alarm
 
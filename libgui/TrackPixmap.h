@@ -36,6 +36,7 @@
 #include "libkwave/Utils.h"
 
 #include "libgui/Colors.h"
+#include "libgui/WaveformTileCache.h"
 
 /**
  * The TrackPixmap is a graphical representation of a track's sample
@@ -124,6 +125,9 @@ namespace Kwave
         /** Sets the internal "modified" flag */
         virtual void setModified() { m_modified = true; }
 
+        /** Returns the cache of the overview tiles */
+        inline Kwave::WaveformTileCache &tileCache() { return m_tiles; }
+
     signals:
 
         /** Emitted if the content of the pixmap was modified. */
@@ -187,6 +191,12 @@ namespace Kwave
          */
         void selectionChanged();
 
+        /**
+         * Sets the state of the pixmap to "modified" when tiles of the
+         * overview have been rendered in the background
+         */
+        void tilesReady();
+
     private:
 
         /**
@@ -210,18 +220,6 @@ namespace Kwave
          */
         bool validateBuffer();
 
-        /**
-         * Draws the signal as an overview with multiple samples per
-         * pixel.
-         * @param p reference to a QPainter
-         * @param middle the y position of the zero line [pixels]
-         * @param height the height of the pixmap [pixels]
-         * @param first the offset of the first pixel
-         * @param last the offset of the last pixel
-         */
-        void drawOverview(QPainter &p, int middle, int height,
-            int first, int last);
-
         /**
          * Calculates the parameters for interpolation of the graphical
          * display when zoomed in. Allocates (new) buffer for the
@@ -367,6 +365,9 @@ namespace Kwave
         /** set of colors for drawing */
         Kwave::Colors::ColorSet m_colors;
 
+        /** tiles of the overview, used in min/max mode */
+        Kwave::WaveformTileCache m_tiles;
+
     };
 }
 
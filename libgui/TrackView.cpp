@@ -18,16 +18,18 @@
 
 #include <new>
 
+#include <QElapsedTimer>
 #include <QIcon>
 #include <QMenu>
 #include <QPainter>
 #include <QPalette>
 #include <QResizeEvent>
-#include <QTime>
 #include <QVBoxLayout>
 
 #include "libkwave/Label.h"
-#include "libkwave/LabelList.h"
+#include "libkwave/LabelIndex.h"
+#include "libkwave/MemoryBudget.h"
+#include "libkwave/Profiler.h"
 #include "libkwave/SignalManager.h"
 #include "libkwave/String.h"
 #include "libkwave/Track.h"
@@ -39,10 +41,14 @@
 #include "libgui/SelectionItem.h"
 #include "libgui/TrackView.h"
 #include "libgui/ViewItem.h"
+#include "libgui/WaveformTileCache.h"
 
 /** minimum height of the view in pixel */
 #define MINIMUM_HEIGHT 100
 
+/** paints that take longer than this miss a frame at 60Hz [ns] */
+#define FRAME_TIME_NS 16667000
+
 //***************************************************************************
 Kwave::TrackView::TrackView(QWidget *parent, QWidget *controls,
                             Kwave::SignalManager *signal_manager,
@@ -68,6 +74,10 @@ Kwave::TrackView::TrackView(QWidget *parent, QWidget *controls,
     connect(&m_pixmap, SIGNAL(sigModified()),
             this,      SLOT(refreshSignalLayer()));
 
+    // account the overview tiles to the file we belong to
+    Kwave::MemoryBudget::instance().registerConsumer(
+        &(m_pixmap.tileCache()), signal_manager);
+
     if (controls) {
         // add the channel controls, for "enabled" / "disabled"
 
@@ -194,17 +204,22 @@ QSharedPointer<Kwave::ViewItem> Kwave::TrackView::findItem(const QPoint &pos)
     unsigned int nearest_label_index = 0;
     double       d_label             = tolerance;
     {
-        unsigned int index = 0;
-        foreach (const Kwave::Label &label,
-            Kwave::LabelList(m_signal_manager->metaData()))
+        // only the labels within the tolerance are of interest
+        const Kwave::LabelIndex &labels = m_signal_manager->labels();
+        const sample_index_t from = (fine_pos > tolerance) ?
+            static_cast<sample_index_t>(fine_pos - tolerance) : 0;
+        for (int index = labels.lowerBound(from); index < labels.count();
+             ++index)
         {
-            double d = qAbs(static_cast<double>(label.pos()) - fine_pos);
+            const Kwave::Label &label = labels.at(index);
+            const double lp = static_cast<double>(label.pos());
+            if (lp > fine_pos + tolerance) break; // outside right, done
+            double d = qAbs(lp - fine_pos);
             if (d < qMin(d_label, tolerance)) {
                 d_label             = d;
                 nearest_label       = label;
-                nearest_label_index = index;
+                nearest_label_index = Kwave::toUint(index);
             }
-            index++;
         }
     }
 
@@ -342,10 +357,9 @@ void Kwave::TrackView::paintEvent(QPaintEvent *)
 
 //     qDebug("TrackView::paintEvent()");
 // #define DEBUG_REPAINT_TIMES
-#ifdef DEBUG_REPAINT_TIMES
-    QTime time;
+    QElapsedTimer time;
     time.start();
-#endif /* DEBUG_REPAINT_TIMES */
+    Kwave::ProfileScope profile("paint track");
 
     QPainter p;
     const int width  = QWidget::width();
@@ -407,12 +421,10 @@ void Kwave::TrackView::paintEvent(QPaintEvent *)
 
         int last_marker = -1;
         const sample_index_t last_visible = lastVisible();
-        foreach (const Kwave::Label &label,
-                 Kwave::LabelList(m_signal_manager->metaData()))
-        {
-            sample_index_t pos = label.pos();
-            if (pos < m_offset)     continue; // outside left
-            if (pos > last_visible) break;    // far outside right, done
+        const Kwave::LabelIndex &labels = m_signal_manager->labels();
+        const int end = labels.upperBound(last_visible);
+        for (int index = labels.lowerBound(m_offset); index < end; ++index) {
+            sample_index_t pos = labels.at(index).pos();
             int x = samples2pixels(pos - m_offset);
             if (x >= width) break; // outside right, done
 
@@ -512,8 +524,12 @@ void Kwave::TrackView::paintEvent(QPaintEvent *)
     p.drawImage(0, 0, m_image);
     p.end();
 
+    // frame time metrics, the paint time itself is in the profile scope
+    if (time.nsecsElapsed() > FRAME_TIME_NS)
+        Kwave::Profiler::count("slow track paints", 1);
+
 #ifdef DEBUG_REPAINT_TIMES
-   qDebug("TrackView::paintEvent() -- done, t=%d ms --", time.elapsed());
+   qDebug("TrackView::paintEvent() -- done, t=%lld ms --", time.elapsed());
 #endif /* DEBUG_REPAINT_TIMES */
 }
 
@@ -0,0 +1,274 @@
+/***************************************************************************
+  WaveformTileCache.cpp  -  cache for background rendered waveform tiles
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <math.h>
+
+#include <QPainter>
+
+#include "libkwave/Profiler.h"
+#include "libkwave/SampleReader.h"
+#include "libkwave/TaskPool.h"
+#include "libkwave/Track.h"
+#include "libkwave/Utils.h"
+
+#include "libgui/WaveformTileCache.h"
+
+/** width of one tile [pixels] */
+#define TILE_WIDTH 256
+
+/** scale of the fixed point representation of the zoom factor */
+#define ZOOM_ID_SCALE 1.0E6
+
+/** minimum size of the cache [kilobytes] */
+#define CACHE_MIN_COST 8192
+
+//***************************************************************************
+Kwave::WaveformTileCache::WaveformTileCache(Kwave::Track &track)
+    :QObject(), Kwave::TileCache<TileKey, Tile>(CACHE_MIN_COST),
+     m_track(track), m_style(), m_style_generation(0), m_zoom(0.0)
+{
+    m_style.height        = 0;
+    m_style.vertical_zoom = 1.0;
+}
+
+//***************************************************************************
+Kwave::WaveformTileCache::~WaveformTileCache()
+{
+}
+
+//***************************************************************************
+sample_index_t Kwave::WaveformTileCache::firstSample(const TileKey &key) const
+{
+    return static_cast<sample_index_t>(floor(
+        static_cast<double>(key.index * TILE_WIDTH) * key.zoom));
+}
+
+//***************************************************************************
+sample_index_t Kwave::WaveformTileCache::lastSample(const TileKey &key) const
+{
+    const sample_index_t end = static_cast<sample_index_t>(floor(
+        static_cast<double>((key.index + 1) * TILE_WIDTH) * key.zoom));
+    return (end) ? (end - 1) : 0;
+}
+
+//***************************************************************************
+void Kwave::WaveformTileCache::setStyle(const Style &style)
+{
+    if ((style.height == m_style.height) &&
+        qFuzzyCompare(style.vertical_zoom, m_style.vertical_zoom) &&
+        (style.background == m_style.background) &&
+        (style.sample == m_style.sample)) return; // no change
+
+    m_style = style;
+    m_style_generation++;
+}
+
+//***************************************************************************
+bool Kwave::WaveformTileCache::draw(QPainter &p, sample_index_t offset,
+                                    double zoom, int width, int height,
+                                    double vertical_zoom,
+                                    const Kwave::Colors::ColorSet &colors)
+{
+    Q_ASSERT(zoom > 1.0);
+    if ((zoom <= 1.0) || (width <= 0) || (height <= 0)) return false;
+
+    Style style;
+    style.height        = height;
+    style.vertical_zoom = vertical_zoom;
+    style.background    = colors.background;
+    style.sample        = colors.sample;
+    setStyle(style);
+    m_zoom = zoom;
+
+    TileKey key;
+    key.zoom_id = qRound64(zoom * ZOOM_ID_SCALE);
+    key.zoom    = zoom;
+    key.index   = 0;
+
+    // position of the view relative to the start of the signal [pixels]
+    const double view_x = static_cast<double>(offset) / zoom;
+    const sample_index_t first_tile = static_cast<sample_index_t>(
+        view_x / TILE_WIDTH);
+    const sample_index_t last_tile  = static_cast<sample_index_t>(
+        (view_x + width - 1) / TILE_WIDTH);
+    const sample_index_t length     = m_track.length();
+
+    // keep the visible tiles and some more for scrolling back and forth,
+    // one tile needs TILE_WIDTH * 4 bytes = 1 kilobyte per line
+    const int visible = Kwave::toInt(last_tile - first_tile + 1);
+    setVisibleCost(static_cast<qint64>(visible) * height);
+
+    bool complete = true;
+    for (sample_index_t index = first_tile; index <= last_tile; ++index) {
+        key.index = index;
+        if (firstSample(key) >= length) break; // behind the end
+
+        const Tile *tile = cachedTile(key);
+        if (tile && (tile->style == m_style_generation)) {
+            const int x = Kwave::toInt(rint(
+                static_cast<double>(index * TILE_WIDTH) - view_x));
+            p.drawImage(x, 0, tile->image);
+            Kwave::Profiler::count("waveform tile hits", 1);
+        } else {
+            request(key, tile);
+            Kwave::Profiler::count("waveform tile misses", 1);
+            complete = false;
+        }
+    }
+
+    // prefetch the neighbours, for smooth scrolling
+    if (complete) {
+        key.index = last_tile + 1;
+        if ((firstSample(key) < length) && !contains(key))
+            request(key, nullptr);
+        key.index = first_tile - 1;
+        if (first_tile && !contains(key))
+            request(key, nullptr);
+    }
+
+    return complete;
+}
+
+//***************************************************************************
+void Kwave::WaveformTileCache::request(const TileKey &key, const Tile *cached)
+{
+    if (isPending(key)) return; // already on the way
+
+    Tile job;
+    job.key    = key;
+    job.style  = m_style_generation;
+    job.reader = nullptr;
+
+    if (cached && !cached->min.isEmpty()) {
+        // only the style has changed, re-use the min/max data
+        job.min = cached->min;
+        job.max = cached->max;
+    } else {
+        job.reader = m_track.openReader(Kwave::SinglePassForward,
+                                        firstSample(key), lastSample(key));
+        Q_ASSERT(job.reader);
+        if (!job.reader) return;
+    }
+
+    QFutureWatcher<Tile> *watcher =
+        addJob(key, this, SLOT(tileFinished()));
+    if (!watcher) {
+        delete job.reader;
+        return;
+    }
+
+    watcher->setFuture(Kwave::TaskPool::run(Kwave::TaskPool::Interactive,
+        &Kwave::WaveformTileCache::render, job, m_style));
+}
+
+//***************************************************************************
+Kwave::WaveformTileCache::Tile Kwave::WaveformTileCache::render(Tile tile,
+                                                                Style style)
+{
+    // compute min/max of each column
+    if (tile.reader) {
+        tile.min.resize(TILE_WIDTH);
+        tile.max.resize(TILE_WIDTH);
+        const double zoom = tile.key.zoom;
+        const sample_index_t column0 = tile.key.index * TILE_WIDTH;
+        for (unsigned int i = 0; i < TILE_WIDTH; ++i) {
+            const sample_index_t s1 = static_cast<sample_index_t>(
+                floor(static_cast<double>(column0 + i) * zoom));
+            sample_index_t s2 = static_cast<sample_index_t>(
+                floor(static_cast<double>(column0 + i + 1) * zoom));
+            s2 = (s2 > s1) ? (s2 - 1) : s1;
+
+            sample_t min;
+            sample_t max;
+            tile.reader->minMax(s1, s2, min, max);
+            tile.min[i] = min;
+            tile.max[i] = max;
+        }
+        delete tile.reader;
+        tile.reader = nullptr;
+    }
+    if ((tile.min.size() < TILE_WIDTH) || (tile.max.size() < TILE_WIDTH)) {
+        tile.min.fill(0, TILE_WIDTH);
+        tile.max.fill(0, TILE_WIDTH);
+    }
+
+    // render the image, one vertical line per column
+    const int height = qMax(1, style.height);
+    const int middle = height >> 1;
+    QImage image(TILE_WIDTH, height, QImage::Format_ARGB32_Premultiplied);
+    image.fill(style.background);
+
+    // scale_y: pixels per unit
+    const double scale_y = (style.vertical_zoom * height) / (1 << SAMPLE_BITS);
+
+    QPainter p(&image);
+    p.setPen(style.sample);
+    int last_min = Kwave::toInt(tile.min[0] * scale_y);
+    int last_max = Kwave::toInt(tile.max[0] * scale_y);
+    for (int i = 0; i < TILE_WIDTH; ++i) {
+        int max = Kwave::toInt(tile.max[i] * scale_y);
+        int min = Kwave::toInt(tile.min[i] * scale_y);
+
+        // make sure there is a connection between this
+        // section and the one before, avoid gaps
+        if (min > last_max + 1) min = last_max + 1;
+        if (max + 1 < last_min) max = last_min - 1;
+
+        p.drawLine(i, middle - max, i, middle - min);
+
+        last_min = min;
+        last_max = max;
+    }
+    p.end();
+
+    tile.image = image;
+    return tile;
+}
+
+//***************************************************************************
+void Kwave::WaveformTileCache::tileFinished()
+{
+    QFutureWatcher<Tile> *watcher =
+        static_cast<QFutureWatcher<Tile> *>(sender());
+    Q_ASSERT(watcher);
+    if (!watcher) return;
+
+    const Tile result = watcher->result();
+    takeResult(result, qMax(1, m_style.height));
+    Kwave::Profiler::count("waveform tiles rendered", 1);
+
+    if (result.key.zoom_id == qRound64(m_zoom * ZOOM_ID_SCALE))
+        emit sigTilesReady();
+}
+
+//***************************************************************************
+void Kwave::WaveformTileCache::invalidate(sample_index_t offset,
+                                          sample_index_t length)
+{
+    if (!length) return;
+
+    const sample_index_t last = (length > SAMPLE_INDEX_MAX - offset) ?
+        SAMPLE_INDEX_MAX : (offset + length - 1);
+    discard(offset, last);
+}
+
+//***************************************************************************
+//***************************************************************************
+
+#include "moc_WaveformTileCache.cpp"
@@ -0,0 +1,191 @@
+/***************************************************************************
+    WaveformTileCache.h  -  cache for background rendered waveform tiles
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef WAVEFORM_TILE_CACHE_H
+#define WAVEFORM_TILE_CACHE_H
+
+#include "config.h"
+#include "libkwavegui_export.h"
+
+#include <QtGlobal>
+#include <QColor>
+#include <QImage>
+#include <QObject>
+#include <QVector>
+
+#include "libkwave/Sample.h"
+#include "libkwave/TileCache.h"
+
+#include "libgui/Colors.h"
+
+class QPainter;
+
+namespace Kwave
+{
+    class SampleReader;
+    class Track;
+
+    /** identifies a waveform tile: zoom factor and index of the tile */
+    typedef struct WaveformTileKey {
+        qint64         zoom_id; /**< zoom factor, fixed point     */
+        double         zoom;    /**< samples per pixel            */
+        sample_index_t index;   /**< index of the tile            */
+
+        /** compare operator, needed for QHash and QCache */
+        bool operator == (const WaveformTileKey &other) const {
+            return ((zoom_id == other.zoom_id) && (index == other.index));
+        }
+
+        /** hash function, needed for QHash and QCache */
+        friend size_t qHash(const WaveformTileKey &key, size_t seed = 0) {
+            return ::qHash(key.zoom_id, seed) ^ ::qHash(key.index, seed);
+        }
+    } WaveformTileKey;
+
+    /** one waveform tile, or one render job */
+    typedef struct {
+        WaveformTileKey key;        /**< zoom and index            */
+        unsigned int style;         /**< style of the image        */
+        QVector<sample_t> min;      /**< minimum per column        */
+        QVector<sample_t> max;      /**< maximum per column        */
+        QImage image;               /**< rendered image            */
+        Kwave::SampleReader *reader;/**< reader, only for jobs     */
+    } WaveformTile;
+
+    /**
+     * Cache for the overview display of a track, used when more than one
+     * sample is shown per pixel. The overview is split into tiles with a
+     * fixed width in pixels, for each zoom factor. Missing tiles are
+     * computed and rendered in the global thread pool, the GUI thread
+     * only composites the finished images.
+     */
+    class LIBKWAVEGUI_EXPORT WaveformTileCache: public QObject,
+        public Kwave::TileCache<Kwave::WaveformTileKey, Kwave::WaveformTile>
+    {
+        Q_OBJECT
+    public:
+
+        /**
+         * Constructor
+         * @param track the track with the sample data
+         */
+        explicit WaveformTileCache(Kwave::Track &track);
+
+        /** Destructor */
+        ~WaveformTileCache() override;
+
+        /**
+         * Draws the overview of the visible area. Tiles that are not
+         * available are requested in the background and left empty,
+         * sigTilesReady() is emitted when they are done.
+         *
+         * @param p painter of the destination
+         * @param offset index of the first visible sample
+         * @param zoom number of samples per pixel, must be > 1.0
+         * @param width width of the visible area [pixels]
+         * @param height height of the visible area [pixels]
+         * @param vertical_zoom vertical zoom factor
+         * @param colors the color set to use
+         * @return true if all visible tiles were available
+         */
+        bool draw(QPainter &p, sample_index_t offset, double zoom,
+                  int width, int height, double vertical_zoom,
+                  const Kwave::Colors::ColorSet &colors);
+
+        /**
+         * Discards all tiles that contain samples of a given range
+         * @param offset index of the first sample
+         * @param length number of samples, SAMPLE_INDEX_MAX means
+         *               everything up to the end
+         */
+        void invalidate(sample_index_t offset, sample_index_t length);
+
+    signals:
+
+        /** emitted when tiles for the current zoom have become ready */
+        void sigTilesReady();
+
+    private slots:
+
+        /** takes over the result of a finished render job */
+        void tileFinished();
+
+    private:
+
+        /** identifies a tile */
+        typedef Kwave::WaveformTileKey TileKey;
+
+        /** one tile, or one render job */
+        typedef Kwave::WaveformTile Tile;
+
+        /** parameters for rendering the images of the tiles */
+        typedef struct {
+            int    height;        /**< height of the image [pixels] */
+            double vertical_zoom; /**< vertical zoom factor         */
+            QColor background;    /**< background color            */
+            QColor sample;        /**< color of the samples         */
+        } Style;
+
+        /** returns the first sample of a tile */
+        sample_index_t firstSample(const TileKey &key) const override;
+
+        /** returns the last sample of a tile */
+        sample_index_t lastSample(const TileKey &key) const override;
+
+        /**
+         * Computes the min/max data of a tile if needed and renders
+         * the image, runs in a worker thread
+         * @param tile the job, min/max data is re-used if not empty
+         * @param style the style of the image
+         * @return the finished tile
+         */
+        static Tile render(Tile tile, Style style);
+
+        /**
+         * Starts a render job for a tile if not already pending
+         * @param key zoom and index of the tile
+         * @param cached the cached tile with min/max data, or null
+         */
+        void request(const TileKey &key, const Tile *cached);
+
+        /**
+         * Sets a new style and invalidates all images if it has changed
+         * @param style the new style
+         */
+        void setStyle(const Style &style);
+
+    private:
+
+        /** the track with the sample data */
+        Kwave::Track &m_track;
+
+        /** current style */
+        Style m_style;
+
+        /** generation of the style, images of other styles are stale */
+        unsigned int m_style_generation;
+
+        /** zoom factor of the last draw() */
+        double m_zoom;
+
+    };
+}
+
+#endif /* WAVEFORM_TILE_CACHE_H */
+
+//***************************************************************************
+//***************************************************************************
@@ -0,0 +1,127 @@
+/***************************************************************************
+       AudioChecksum.cpp  -  checksums of the audio data of a signal
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <new>
+
+#include <QCryptographicHash>
+
+#include "libkwave/AudioChecksum.h"
+#include "libkwave/String.h"
+#include "libkwave/Utils.h"
+
+//***************************************************************************
+Kwave::AudioChecksum::AudioChecksum(unsigned int tracks, unsigned int bits)
+    :m_bits(qBound(1U, bits, 32U)), m_bytes((m_bits + 7) >> 3),
+     m_tracks(tracks), m_all()
+{
+    for (Hashes &h : m_tracks)
+        h.md5 = new(std::nothrow)
+            QCryptographicHash(QCryptographicHash::Md5);
+    m_all.md5 = new(std::nothrow) QCryptographicHash(QCryptographicHash::Md5);
+}
+
+//***************************************************************************
+Kwave::AudioChecksum::~AudioChecksum()
+{
+    for (Hashes &h : m_tracks) {
+        delete h.md5;
+        h.md5 = nullptr;
+    }
+    delete m_all.md5;
+    m_all.md5 = nullptr;
+}
+
+//***************************************************************************
+void Kwave::AudioChecksum::process(unsigned int track,
+                                   const sample_t *samples,
+                                   unsigned int count)
+{
+    Q_ASSERT(track < tracks());
+    Q_ASSERT(samples);
+    if ((track >= tracks()) || !samples || !count) return;
+    Hashes &h = m_tracks[track];
+
+    // encode as little endian integers with the resolution of the file
+    const qsizetype start = h.pending.size();
+    h.pending.resize(start + (count * m_bytes));
+    unsigned char *dst = reinterpret_cast<unsigned char *>(
+        h.pending.data() + start);
+    for (unsigned int i = 0; i < count; ++i) {
+        const quint32 value = static_cast<quint32>((m_bits <= SAMPLE_BITS) ?
+            (samples[i] >> (SAMPLE_BITS - m_bits)) :
+            (samples[i] * (1 << (m_bits - SAMPLE_BITS))));
+        for (unsigned int b = 0; b < m_bytes; ++b)
+            *(dst++) = static_cast<unsigned char>(value >> (8 * b));
+    }
+
+    const char *data = h.pending.constData() + start;
+    const qsizetype length = h.pending.size() - start;
+    if (h.md5) h.md5->addData(QByteArrayView(data, length));
+    h.xxh64.addData(data, length);
+}
+
+//***************************************************************************
+void Kwave::AudioChecksum::combine()
+{
+    if (m_tracks.isEmpty()) return;
+
+    // the number of samples that are available in all tracks
+    qsizetype available = m_tracks.first().pending.size();
+    for (const Hashes &h : std::as_const(m_tracks))
+        available = qMin(available, h.pending.size());
+    const qsizetype samples = available / m_bytes;
+    if (!samples) return;
+
+    // interleave them
+    const unsigned int n = tracks();
+    QByteArray &buffer = m_all.pending;
+    buffer.resize(samples * n * m_bytes);
+    char *dst = buffer.data();
+    for (qsizetype i = 0; i < samples; ++i) {
+        for (unsigned int t = 0; t < n; ++t) {
+            const char *src = m_tracks[t].pending.constData() + (i * m_bytes);
+            for (unsigned int b = 0; b < m_bytes; ++b)
+                *(dst++) = src[b];
+        }
+    }
+    for (Hashes &h : m_tracks)
+        h.pending.remove(0, samples * m_bytes);
+
+    if (m_all.md5) m_all.md5->addData(buffer);
+    m_all.xxh64.addData(buffer);
+    buffer.clear();
+}
+
+//***************************************************************************
+QString Kwave::AudioChecksum::md5(int track) const
+{
+    const Hashes &h = (track < 0) ? m_all : m_tracks[track];
+    if (!h.md5) return QString();
+    return QString::fromLatin1(h.md5->result().toHex());
+}
+
+//***************************************************************************
+QString Kwave::AudioChecksum::xxh64(int track) const
+{
+    const Hashes &h = (track < 0) ? m_all : m_tracks[track];
+    return _("%1").arg(h.xxh64.result(), 16, 16, QLatin1Char('0'));
+}
+
+//***************************************************************************
+//***************************************************************************
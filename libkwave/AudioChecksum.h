@@ -0,0 +1,126 @@
+/***************************************************************************
+         AudioChecksum.h  -  checksums of the audio data of a signal
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef AUDIO_CHECKSUM_H
+#define AUDIO_CHECKSUM_H
+
+#include "config.h"
+#include "libkwave_export.h"
+
+#include <QtGlobal>
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+#include "libkwave/Sample.h"
+#include "libkwave/XXHash64.h"
+
+class QCryptographicHash;
+
+namespace Kwave
+{
+
+    /**
+     * Computes MD5 and XXH64 checksums of the audio data of each track and
+     * of all tracks together. The samples are hashed as signed little
+     * endian integers with the resolution of the file, using the smallest
+     * number of whole bytes. For all tracks together the samples are
+     * interleaved, which gives the same MD5 sum as the one that is stored
+     * in the STREAMINFO block of a FLAC file.
+     *
+     * The tracks are independent of each other, so process() may be called
+     * for different tracks from different threads at the same time.
+     * combine() must be called from a single thread while no track is
+     * processed.
+     */
+    class LIBKWAVE_EXPORT AudioChecksum
+    {
+    public:
+
+        /**
+         * Constructor
+         * @param tracks number of tracks
+         * @param bits resolution of the samples [1...32 bits]
+         */
+        AudioChecksum(unsigned int tracks, unsigned int bits);
+
+        /** Destructor */
+        virtual ~AudioChecksum();
+
+        /** returns the number of tracks */
+        inline unsigned int tracks() const {
+            return static_cast<unsigned int>(m_tracks.size());
+        }
+
+        /** returns the resolution [bits per sample] */
+        inline unsigned int bits() const { return m_bits; }
+
+        /**
+         * Adds a block of samples of one track
+         * @param track index of the track
+         * @param samples pointer to the first sample
+         * @param count number of samples
+         */
+        void process(unsigned int track, const sample_t *samples,
+                     unsigned int count);
+
+        /**
+         * Adds the samples that have been processed in all tracks to the
+         * checksums over all tracks
+         */
+        void combine();
+
+        /**
+         * Returns the MD5 sum as hex string
+         * @param track index of the track or -1 for all tracks
+         */
+        QString md5(int track = -1) const;
+
+        /**
+         * Returns the XXH64 hash as hex string
+         * @param track index of the track or -1 for all tracks
+         */
+        QString xxh64(int track = -1) const;
+
+    private:
+
+        /** checksums and pending data of one track or all tracks */
+        typedef struct {
+            QCryptographicHash *md5;     /**< MD5 sum                  */
+            Kwave::XXHash64     xxh64;   /**< XXH64 hash               */
+            QByteArray          pending; /**< encoded, not yet combined */
+        } Hashes;
+
+        /** resolution [bits per sample] */
+        unsigned int m_bits;
+
+        /** number of bytes per encoded sample */
+        unsigned int m_bytes;
+
+        /** checksums of each track */
+        QVector<Hashes> m_tracks;
+
+        /** checksums of all tracks */
+        Hashes m_all;
+
+    };
+}
+
+#endif /* AUDIO_CHECKSUM_H */
+
+//***************************************************************************
+//***************************************************************************
@@ -83,7 +83,9 @@ void Kwave::ClipBoard::copy(QWidget *widget,
     Kwave::MultiTrackReader src(Kwave::SinglePassForward, signal_manager,
         track_list, offset, offset + length - 1);
 
-    if (!buffer->encode(widget, src, signal_manager.metaData())) {
+    const Kwave::MetaDataList &meta_data =
+        std::as_const(signal_manager).metaData();
+    if (!buffer->encode(widget, src, meta_data)) {
         // encoding failed, reset to empty
         buffer->clear();
         delete buffer;
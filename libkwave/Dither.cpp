@@ -0,0 +1,265 @@
+/***************************************************************************
+             Dither.cpp  -  dither and noise shaping for bit depth reduction
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <math.h>
+
+#include <QAtomicInt>
+
+#include "libkwave/Dither.h"
+#include "libkwave/String.h"
+
+/** number of samples that are processed at once */
+#define CHUNK 256
+
+/**
+ * number of samples in a row that have to fit into the target resolution
+ * before the dither is turned off
+ */
+#define EXACT_RUN_MIN 4096
+
+/** limit of the requantization error that is fed back [LSB] */
+#define MAX_ERROR 4.0
+
+/** first order highpass, 6dB per octave */
+static const float shaping_first_order[] = {
+    1.0f
+};
+
+/** E-weighted filter of Wannamaker, for 44.1kHz */
+static const float shaping_e_weighted[] = {
+    1.623f, -0.982f, 0.109f
+};
+
+/** F-weighted filter of Wannamaker, for 44.1kHz */
+static const float shaping_f_weighted[] = {
+    2.412f, -3.370f, 3.937f, -4.174f, 3.353f,
+    -2.205f, 1.281f, -0.569f, 0.0847f
+};
+
+/** default dither mode, for saving and playback */
+static QAtomicInt g_default_mode(Kwave::Dither::Triangular);
+
+/** default noise shaping, for saving and playback */
+static QAtomicInt g_default_shaping(Kwave::Dither::Flat);
+
+//***************************************************************************
+Kwave::Dither::Dither(unsigned int bits, Mode mode, Shaping shaping,
+                      quint32 seed)
+    :m_shift(0), m_mode(mode), m_noise(seed), m_order(0), m_exact_run(0)
+{
+    if (bits && (bits < SAMPLE_BITS) && (mode != None))
+        m_shift = SAMPLE_BITS - bits;
+
+    m_noise.setShape((mode == Rectangular) ?
+        Kwave::RandomNoise::White : Kwave::RandomNoise::Tpdf);
+
+    const float *coeff = nullptr;
+    switch (shaping) {
+        case FirstOrder:
+            coeff   = shaping_first_order;
+            m_order = sizeof(shaping_first_order) / sizeof(float);
+            break;
+        case EWeighted:
+            coeff   = shaping_e_weighted;
+            m_order = sizeof(shaping_e_weighted) / sizeof(float);
+            break;
+        case FWeighted:
+            coeff   = shaping_f_weighted;
+            m_order = sizeof(shaping_f_weighted) / sizeof(float);
+            break;
+        default:
+            m_order = 0;
+            break;
+    }
+    Q_ASSERT(m_order <= DITHER_MAX_ORDER);
+
+    for (unsigned int k = 0; k < DITHER_MAX_ORDER; ++k)
+        m_coeff[k] = (k < m_order) ? coeff[k] : 0.0f;
+    reset();
+}
+
+//***************************************************************************
+Kwave::Dither::~Dither()
+{
+}
+
+//***************************************************************************
+void Kwave::Dither::reset()
+{
+    for (unsigned int k = 0; k < DITHER_MAX_ORDER; ++k)
+        m_error[k] = 0.0f;
+    m_exact_run = 0;
+}
+
+//***************************************************************************
+void Kwave::Dither::process(sample_t *samples, unsigned int count,
+                            unsigned int stride)
+{
+    Q_ASSERT(samples);
+    Q_ASSERT(stride);
+    if (!m_shift || !samples || !count || !stride) return;
+
+    // check if the block already fits into the target resolution
+    const sample_t mask = (1 << m_shift) - 1;
+    sample_t low_bits = 0;
+    for (unsigned int i = 0; i < count; ++i)
+        low_bits |= samples[i * stride];
+    if (!(low_bits & mask)) {
+        if (m_exact_run < EXACT_RUN_MIN) m_exact_run += count;
+        if (m_exact_run >= EXACT_RUN_MIN) {
+            for (unsigned int k = 0; k < DITHER_MAX_ORDER; ++k)
+                m_error[k] = 0.0f;
+            return;
+        }
+    } else {
+        m_exact_run = 0;
+    }
+
+    float noise[CHUNK];
+    while (count) {
+        const unsigned int n = qMin<unsigned int>(count, CHUNK);
+        m_noise.generate(noise, n);
+        if (m_order)
+            processShaped(samples, noise, n, stride);
+        else
+            processFlat(samples, noise, n, stride);
+        samples += n * stride;
+        count   -= n;
+    }
+}
+
+//***************************************************************************
+void Kwave::Dither::processFlat(sample_t *samples, const float *noise,
+                                unsigned int count, unsigned int stride)
+{
+    const sample_t q    = 1 << m_shift;
+    const sample_t mask = ~(q - 1);
+    const sample_t half = q >> 1;
+    const sample_t lo   = -(1 << (SAMPLE_BITS - 1)) + q;
+    const sample_t hi   =  (1 << (SAMPLE_BITS - 1)) - q;
+    const float scale   = static_cast<float>(q) *
+        ((m_mode == Rectangular) ? 0.5f : 1.0f);
+
+    // add the noise and round to the next step, clearing the lower bits
+    // rounds towards minus infinity in two's complement
+    for (unsigned int i = 0; i < count; ++i) {
+        sample_t s = samples[i * stride];
+        s += static_cast<sample_t>(noise[i] * scale) + half;
+        s &= mask;
+        samples[i * stride] = qBound(lo, s, hi);
+    }
+}
+
+//***************************************************************************
+void Kwave::Dither::processShaped(sample_t *samples, const float *noise,
+                                  unsigned int count, unsigned int stride)
+{
+    const sample_t q     = 1 << m_shift;
+    const double   inv_q = 1.0 / static_cast<double>(q);
+    const double   lo    = static_cast<double>(-(1 << (SAMPLE_BITS - 1)) + q)
+                           * inv_q;
+    const double   hi    = static_cast<double>( (1 << (SAMPLE_BITS - 1)) - q)
+                           * inv_q;
+    const double   scale = (m_mode == Rectangular) ? 0.5 : 1.0;
+    const unsigned int order = m_order;
+
+    // the error feedback depends on the previous output, this cannot be
+    // vectorized over time, only the filter itself is short enough
+    for (unsigned int i = 0; i < count; ++i) {
+        double w = static_cast<double>(samples[i * stride]) * inv_q;
+        for (unsigned int k = 0; k < order; ++k)
+            w -= m_coeff[k] * m_error[k];
+
+        double y = floor(w + (noise[i] * scale) + 0.5);
+        y = qBound(lo, y, hi);
+
+        for (unsigned int k = order - 1; k > 0; --k)
+            m_error[k] = m_error[k - 1];
+        m_error[0] = static_cast<float>(qBound(-MAX_ERROR, y - w, MAX_ERROR));
+
+        samples[i * stride] = static_cast<sample_t>(y) * q;
+    }
+}
+
+//***************************************************************************
+Kwave::Dither::Mode Kwave::Dither::defaultMode()
+{
+    return static_cast<Mode>(g_default_mode.loadRelaxed());
+}
+
+//***************************************************************************
+Kwave::Dither::Shaping Kwave::Dither::defaultShaping()
+{
+    return static_cast<Shaping>(g_default_shaping.loadRelaxed());
+}
+
+//***************************************************************************
+void Kwave::Dither::setDefaults(Mode mode, Shaping shaping)
+{
+    g_default_mode.storeRelaxed(mode);
+    g_default_shaping.storeRelaxed(shaping);
+}
+
+//***************************************************************************
+QString Kwave::Dither::modeName(Mode mode)
+{
+    switch (mode) {
+        case Rectangular: return _("rectangular");
+        case Triangular:  return _("tpdf");
+        default:          return _("none");
+    }
+}
+
+//***************************************************************************
+Kwave::Dither::Mode Kwave::Dither::modeFromName(const QString &name, bool *ok)
+{
+    if (ok) *ok = true;
+    if (name == _("none"))        return None;
+    if (name == _("rectangular")) return Rectangular;
+    if (name == _("tpdf"))        return Triangular;
+    if (ok) *ok = false;
+    return None;
+}
+
+//***************************************************************************
+QString Kwave::Dither::shapingName(Shaping shaping)
+{
+    switch (shaping) {
+        case FirstOrder: return _("first_order");
+        case EWeighted:  return _("e_weighted");
+        case FWeighted:  return _("f_weighted");
+        default:         return _("flat");
+    }
+}
+
+//***************************************************************************
+Kwave::Dither::Shaping Kwave::Dither::shapingFromName(const QString &name,
+                                                      bool *ok)
+{
+    if (ok) *ok = true;
+    if (name == _("flat"))        return Flat;
+    if (name == _("first_order")) return FirstOrder;
+    if (name == _("e_weighted"))  return EWeighted;
+    if (name == _("f_weighted"))  return FWeighted;
+    if (ok) *ok = false;
+    return Flat;
+}
+
+//***************************************************************************
+//***************************************************************************
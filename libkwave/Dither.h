@@ -0,0 +1,190 @@
+/***************************************************************************
+               Dither.h  -  dither and noise shaping for bit depth reduction
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef DITHER_H
+#define DITHER_H
+
+#include "config.h"
+#include "libkwave_export.h"
+
+#include <QtGlobal>
+#include <QString>
+
+#include "libkwave/Sample.h"
+#include "libkwave/modules/RandomNoise.h"
+
+/** maximum order of the noise shaping filters */
+#define DITHER_MAX_ORDER 9
+
+namespace Kwave
+{
+
+    /**
+     * Reduces the resolution of one channel to a lower number of bits,
+     * with dither and optional noise shaping. The samples stay in Kwave's
+     * internal format, only the lower bits are cleared, so that encoders
+     * which simply drop these bits afterwards produce the dithered result.
+     *
+     * After a longer run of samples that already fit into the target
+     * resolution (digital silence or material that has been loaded from
+     * a file with the same resolution) no more dither is added until the
+     * next sample that does not fit, so that saving such a signal again
+     * does not accumulate noise.
+     */
+    class LIBKWAVE_EXPORT Dither
+    {
+    public:
+
+        /** probability density function of the dither noise */
+        typedef enum {
+            None        = 0, /**< off, the encoder truncates         */
+            Rectangular = 1, /**< uniform, +/- 0.5 LSB                */
+            Triangular  = 2  /**< triangular (TPDF), +/- 1 LSB        */
+        } Mode;
+
+        /** filter for shaping the spectrum of the requantization noise */
+        typedef enum {
+            Flat       = 0, /**< no noise shaping                     */
+            FirstOrder = 1, /**< simple first order highpass          */
+            EWeighted  = 2, /**< 3rd order, E-weighted (44.1kHz)      */
+            FWeighted  = 3  /**< 9th order, F-weighted (44.1kHz)      */
+        } Shaping;
+
+        /**
+         * Constructor
+         * @param bits resolution of the output, no change if equal
+         *             or higher than SAMPLE_BITS
+         * @param mode type of the dither noise
+         * @param shaping noise shaping filter
+         * @param seed initial value of the noise generator, should be
+         *             different for each channel
+         */
+        Dither(unsigned int bits, Mode mode, Shaping shaping,
+               quint32 seed = 0);
+
+        /** Destructor */
+        virtual ~Dither();
+
+        /** returns false if the samples are passed unmodified */
+        inline bool isActive() const { return (m_shift > 0); }
+
+        /** resets the filter state, e.g. after a seek */
+        void reset();
+
+        /**
+         * Requantizes a block of samples in place
+         * @param samples pointer to the first sample
+         * @param count number of samples
+         * @param stride distance between two samples of the channel,
+         *               for processing interleaved data
+         */
+        void process(sample_t *samples, unsigned int count,
+                     unsigned int stride = 1);
+
+        /** returns the default dither mode, for saving and playback */
+        static Mode defaultMode();
+
+        /** returns the default noise shaping, for saving and playback */
+        static Shaping defaultShaping();
+
+        /**
+         * Sets the defaults for saving and playback, thread safe
+         * @param mode type of the dither noise
+         * @param shaping noise shaping filter
+         */
+        static void setDefaults(Mode mode, Shaping shaping);
+
+        /**
+         * Converts a mode into a name, for use in commands and config files
+         * @param mode type of the dither noise
+         * @return the name, e.g. "tpdf"
+         */
+        static QString modeName(Mode mode);
+
+        /**
+         * Converts a name into a mode, inverse of modeName()
+         * @param name the name of the mode
+         * @param ok receives false if the name is not known
+         * @return the mode, None if not known
+         */
+        static Mode modeFromName(const QString &name, bool *ok = nullptr);
+
+        /**
+         * Converts a noise shaping filter into a name
+         * @param shaping the noise shaping filter
+         * @return the name, e.g. "e_weighted"
+         */
+        static QString shapingName(Shaping shaping);
+
+        /**
+         * Converts a name into a noise shaping filter
+         * @param name the name of the filter
+         * @param ok receives false if the name is not known
+         * @return the noise shaping filter, Flat if not known
+         */
+        static Shaping shapingFromName(const QString &name,
+                                       bool *ok = nullptr);
+
+    private:
+
+        /**
+         * Processes a part of a block, without any noise shaping
+         * @param samples pointer to the first sample
+         * @param noise dither noise [LSB]
+         * @param count number of samples
+         * @param stride distance between two samples of the channel
+         */
+        void processFlat(sample_t *samples, const float *noise,
+                         unsigned int count, unsigned int stride);
+
+        /**
+         * Processes a part of a block, with error feedback
+         * @see processFlat
+         */
+        void processShaped(sample_t *samples, const float *noise,
+                           unsigned int count, unsigned int stride);
+
+    private:
+
+        /** number of bits to clear, zero if inactive */
+        unsigned int m_shift;
+
+        /** type of the dither noise */
+        Mode m_mode;
+
+        /** generator for the dither noise */
+        Kwave::RandomNoise m_noise;
+
+        /** order of the noise shaping filter, zero for flat */
+        unsigned int m_order;
+
+        /** coefficients of the noise shaping filter */
+        float m_coeff[DITHER_MAX_ORDER];
+
+        /** last requantization errors [LSB], most recent first */
+        float m_error[DITHER_MAX_ORDER];
+
+        /** number of samples in a row that needed no requantization */
+        unsigned int m_exact_run;
+
+    };
+}
+
+#endif /* DITHER_H */
+
+//***************************************************************************
+//***************************************************************************
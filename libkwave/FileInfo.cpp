@@ -183,6 +183,10 @@ void Kwave::FileInfo::PropertyTypesMap::fill()
             "terms of the Open Audio License.\n"
             "See http://www.eff.org/IP/Open_licenses/eff_oal.html\n"
             "for details'), etc."));
+    append(Kwave::INF_MD5,
+        FP_READONLY | FP_INTERNAL | FP_NO_LOAD_SAVE,
+        _(kli18n("MD5 Checksum").untranslatedText()),
+        kli18n("MD5 sum of the audio data, as stored in the file"));
     append(Kwave::INF_MEDIUM,
         FP_NONE,
         _(kli18n("Medium").untranslatedText()),
@@ -76,6 +76,7 @@ namespace Kwave
         INF_LABELS,              /**< labels/markers */
         INF_LENGTH,              /**< length of the file in samples */
         INF_LICENSE,             /**< license information */
+        INF_MD5,                 /**< MD5 sum of the audio data in the file */
         INF_MEDIUM,              /**< medium */
         INF_MIMETYPE,            /**< mime type of the file format */
         INF_MPEG_EMPHASIS,       /**< MPEG emphasis mode */
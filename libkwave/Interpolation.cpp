@@ -49,7 +49,8 @@ Kwave::Interpolation::InterpolationMap
 
 //***************************************************************************
 Kwave::Interpolation::Interpolation(interpolation_t type)
-    :m_curve(), m_x(), m_y(), m_der(), m_type(type)
+    :m_curve(), m_x(), m_y(), m_der(), m_type(type),
+     m_segment(1), m_poly_x(), m_poly_y()
 {
 }
 
@@ -172,6 +173,171 @@ double Kwave::Interpolation::singleInterpolation(double input)
     return 0;
 }
 
+//***************************************************************************
+bool Kwave::Interpolation::seekSegment(double x)
+{
+    const unsigned int count = this->count();
+    unsigned int i = m_segment;
+
+    // restart from the beginning if we went backwards
+    if ((i < 1) || (i > count) || ((i > 1) && !(m_x[i - 1] < x)))
+        i = 1;
+
+    while ((i < count) && (m_x[i] < x))
+        i++;
+
+    const bool moved = (i != m_segment);
+    m_segment = i;
+    return moved;
+}
+
+//***************************************************************************
+unsigned int Kwave::Interpolation::segmentRun(sample_index_t first,
+                                              sample_index_t length,
+                                              unsigned int max) const
+{
+    // the last segment extends up to the end
+    if (m_segment >= count()) return max;
+
+    // estimate the index of the last position within the segment,
+    // then correct rounding errors
+    const double x_end  = m_x[m_segment];
+    const double len    = static_cast<double>(length);
+    const double last_f = x_end * len;
+    sample_index_t last = (last_f > 0.0) ?
+        static_cast<sample_index_t>(last_f) : 0;
+    while ((last > first) && (static_cast<double>(last) / len > x_end))
+        last--;
+    while (static_cast<double>(last + 1) / len <= x_end)
+        last++;
+
+    if (last < first) return 1; // should not happen, at least one
+    const sample_index_t n = last - first + 1;
+    return (n < max) ? static_cast<unsigned int>(n) : max;
+}
+
+//***************************************************************************
+void Kwave::Interpolation::interpolateRange(sample_index_t first,
+                                            sample_index_t length,
+                                            double *y, unsigned int count)
+{
+    Q_ASSERT(y);
+    if (!y || !count) return;
+
+    const unsigned int points = this->count();
+    if (!points || !length) {
+        for (unsigned int k = 0; k < count; ++k) y[k] = 0.0;
+        return;
+    }
+
+    const double len = static_cast<double>(length);
+    unsigned int degree = 0;
+    switch (m_type) {
+        case INTPOL_POLYNOMIAL3: degree = 3; break;
+        case INTPOL_POLYNOMIAL5: degree = 5; break;
+        case INTPOL_POLYNOMIAL7: degree = 7; break;
+        default: break;
+    }
+
+    if (m_type == INTPOL_NPOLYNOMIAL) {
+        // one single polynom, no segments
+        for (unsigned int k = 0; k < count; ++k) {
+            const double x = qMin(1.0, static_cast<double>(first + k) / len);
+            double ny = m_y[0];
+            for (unsigned int j = 1; j < points; j++)
+                ny = ny * (x - m_x[j]) + m_y[j];
+            y[k] = ny;
+        }
+        return;
+    }
+
+    unsigned int k = 0;
+    bool new_polynom = true;
+    while (k < count) {
+        const sample_index_t pos = first + k;
+        const double x0 = qMin(1.0, static_cast<double>(pos) / len);
+        if (seekSegment(x0)) new_polynom = true;
+
+        const unsigned int i = m_segment;
+        const unsigned int n = (pos < length) ?
+            segmentRun(pos, length, count - k) : (count - k);
+        double *out = y + k;
+
+        switch (m_type) {
+            case INTPOL_LINEAR: {
+                const double xa    = m_x[i - 1];
+                const double ya    = m_y[i - 1];
+                const double slope = (m_y[i] - ya) / (m_x[i] - xa);
+                for (unsigned int j = 0; j < n; ++j) {
+                    const double x = qMin(1.0,
+                        static_cast<double>(pos + j) / len);
+                    out[j] = ya + slope * (x - xa);
+                }
+                break;
+            }
+            case INTPOL_SPLINE: {
+                const double xa   = m_x[i - 1];
+                const double xb   = m_x[i];
+                const double ya   = m_y[i - 1];
+                const double yb   = m_y[i];
+                const double da   = m_der[i - 1];
+                const double db   = m_der[i];
+                const double diff = xb - xa;
+                const double h6   = (diff * diff) / 6;
+                for (unsigned int j = 0; j < n; ++j) {
+                    const double x = qMin(1.0,
+                        static_cast<double>(pos + j) / len);
+                    const double a = (xb - x) / diff;
+                    const double b = (x - xa) / diff;
+                    out[j] = a * ya + b * yb +
+                        ((a * a * a - a) * da + (b * b * b - b) * db) * h6;
+                }
+                break;
+            }
+            case INTPOL_SAH: {
+                const double ya = m_y[i - 1];
+                for (unsigned int j = 0; j < n; ++j)
+                    out[j] = ya;
+                break;
+            }
+            case INTPOL_POLYNOMIAL3:
+            case INTPOL_POLYNOMIAL5:
+            case INTPOL_POLYNOMIAL7: {
+                Q_ASSERT(m_curve);
+                if (!m_curve) {
+                    for (unsigned int j = 0; j < n; ++j) out[j] = 0.0;
+                    break;
+                }
+
+                // the polynom only changes with the segment
+                if (new_polynom) {
+                    m_poly_x.resize(7);
+                    m_poly_y.resize(7);
+                    createPolynom(*m_curve, m_poly_x, m_poly_y,
+                                  i - 1 - degree / 2, degree);
+                    new_polynom = false;
+                }
+                const double *px = m_poly_x.constData();
+                const double *py = m_poly_y.constData();
+                for (unsigned int j = 0; j < n; ++j) {
+                    const double x = qMin(1.0,
+                        static_cast<double>(pos + j) / len);
+                    double ny = py[0];
+                    for (unsigned int d = 1; d < degree; d++)
+                        ny = ny * (x - px[d]) + py[d];
+                    out[j] = ny;
+                }
+                break;
+            }
+            default:
+                for (unsigned int j = 0; j < n; ++j) out[j] = 0.0;
+                break;
+        }
+
+        k += n;
+    }
+}
+
 //***************************************************************************
 bool Kwave::Interpolation::prepareInterpolation(const Kwave::Curve &points)
 {
@@ -191,6 +357,7 @@ bool Kwave::Interpolation::prepareInterpolation(const Kwave::Curve &points)
         c++;
     }
     m_x[c] = m_y[c] = 0.0;
+    m_segment = 1;
 
     switch (m_type) {
         case INTPOL_NPOLYNOMIAL:
@@ -25,6 +25,7 @@
 #include <QStringList>
 #include <QVector>
 
+#include "libkwave/Sample.h"
 #include "libkwave/TypesMap.h"
 
 namespace Kwave
@@ -67,6 +68,24 @@ namespace Kwave
          */
         double singleInterpolation(double pos);
 
+        /**
+         * Fills a block with interpolated values at equidistant positions,
+         * value number k is the same as singleInterpolation() at the
+         * position (first + k) / length.
+         *
+         * The current segment of the curve is remembered between calls,
+         * so that consecutive blocks with ascending positions only need
+         * to walk through the curve once. Within each segment the values
+         * are computed in a tight loop.
+         *
+         * @param first index of the first position, [0...length]
+         * @param length number of positions that map to [0...1]
+         * @param y receives the interpolated values
+         * @param count number of values to compute
+         */
+        void interpolateRange(sample_index_t first, sample_index_t length,
+                              double *y, unsigned int count);
+
         /**
          * Same as getSingleInterpolation, but return value
          * will be limited to be [0...1]
@@ -177,6 +196,26 @@ namespace Kwave
                             QVector<double> &y,
                             int pos, unsigned int degree);
 
+        /**
+         * Moves the segment cursor to the segment that contains a position,
+         * the same segment as the linear search in singleInterpolation()
+         * would find
+         * @param x position [0...1]
+         * @return true if the cursor has been moved
+         */
+        bool seekSegment(double x);
+
+        /**
+         * Returns the number of equidistant positions, starting at a given
+         * index, that are within the current segment
+         * @param first index of the first position
+         * @param length number of positions that map to [0...1]
+         * @param max maximum number of positions
+         * @return number of positions [1...max]
+         */
+        unsigned int segmentRun(sample_index_t first, sample_index_t length,
+                                unsigned int max) const;
+
     private:
 
         /**  List of points to be interpolated. */
@@ -197,6 +236,18 @@ namespace Kwave
         /** Type of the interpolation. */
         Kwave::interpolation_t m_type;
 
+        /**
+         * index of the end point of the current segment, used by
+         * interpolateRange() [1...count()]
+         */
+        unsigned int m_segment;
+
+        /** x coordinates of the polynom of the current segment */
+        QVector<double> m_poly_x;
+
+        /** coefficients of the polynom of the current segment */
+        QVector<double> m_poly_y;
+
     };
 
     //***********************************************************************
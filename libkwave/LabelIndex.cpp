@@ -0,0 +1,187 @@
+/***************************************************************************
+         LabelIndex.cpp  -  index of labels, ordered by position
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <algorithm>
+
+#include "libkwave/LabelIndex.h"
+#include "libkwave/MetaDataList.h"
+
+//***************************************************************************
+static bool label_before_pos(const Kwave::Label &label, sample_index_t pos)
+{
+    return (label.pos() < pos);
+}
+
+//***************************************************************************
+static bool pos_before_label(sample_index_t pos, const Kwave::Label &label)
+{
+    return (pos < label.pos());
+}
+
+//***************************************************************************
+Kwave::LabelIndex::LabelIndex()
+    :m_labels(), m_valid(false)
+{
+}
+
+//***************************************************************************
+Kwave::LabelIndex::~LabelIndex()
+{
+}
+
+//***************************************************************************
+void Kwave::LabelIndex::rebuild(const Kwave::MetaDataList &meta_data_list)
+{
+    const Kwave::LabelList labels(meta_data_list);
+    m_labels = QVector<Kwave::Label>(labels.constBegin(), labels.constEnd());
+    m_valid  = true;
+}
+
+//***************************************************************************
+void Kwave::LabelIndex::invalidate()
+{
+    m_labels.clear();
+    m_valid = false;
+}
+
+//***************************************************************************
+void Kwave::LabelIndex::clear()
+{
+    m_labels.clear();
+    m_valid = true;
+}
+
+//***************************************************************************
+int Kwave::LabelIndex::insert(const Kwave::Label &label)
+{
+    if (!m_valid) return -1; // will be rebuilt anyway
+    const int index = upperBound(label.pos());
+    m_labels.insert(index, label);
+    return index;
+}
+
+//***************************************************************************
+void Kwave::LabelIndex::insert(const Kwave::LabelList &labels)
+{
+    if (!m_valid || labels.isEmpty()) return; // will be rebuilt anyway
+
+    // append all, sort the new ones and merge them with the old ones,
+    // a stable merge keeps new labels behind old ones at the same position
+    const int old_count = count();
+    m_labels.reserve(old_count + Kwave::toInt(labels.count()));
+    for (const Kwave::Label &label : labels)
+        m_labels.append(label);
+    std::stable_sort(m_labels.begin() + old_count, m_labels.end());
+    std::inplace_merge(m_labels.begin(), m_labels.begin() + old_count,
+                       m_labels.end());
+}
+
+//***************************************************************************
+void Kwave::LabelIndex::removeAt(int index)
+{
+    if ((index < 0) || (index >= count())) return;
+    m_labels.removeAt(index);
+}
+
+//***************************************************************************
+bool Kwave::LabelIndex::remove(const Kwave::Label &label)
+{
+    const QString id = label.id();
+    const int end = upperBound(label.pos());
+    for (int index = lowerBound(label.pos()); index < end; ++index) {
+        if (m_labels.at(index).id() == id) {
+            m_labels.removeAt(index);
+            return true;
+        }
+    }
+    return false;
+}
+
+//***************************************************************************
+int Kwave::LabelIndex::find(sample_index_t pos) const
+{
+    const int index = lowerBound(pos);
+    if ((index < count()) && (m_labels.at(index).pos() == pos))
+        return index;
+    return -1; // nothing found
+}
+
+//***************************************************************************
+int Kwave::LabelIndex::indexOf(const Kwave::Label &label) const
+{
+    const int end = upperBound(label.pos());
+    for (int index = lowerBound(label.pos()); index < end; ++index) {
+        if (m_labels.at(index) == label) return index;
+    }
+    return -1; // nothing found
+}
+
+//***************************************************************************
+int Kwave::LabelIndex::lowerBound(sample_index_t pos) const
+{
+    return Kwave::toInt(std::lower_bound(m_labels.constBegin(),
+        m_labels.constEnd(), pos, label_before_pos) - m_labels.constBegin());
+}
+
+//***************************************************************************
+int Kwave::LabelIndex::upperBound(sample_index_t pos) const
+{
+    return Kwave::toInt(std::upper_bound(m_labels.constBegin(),
+        m_labels.constEnd(), pos, pos_before_label) - m_labels.constBegin());
+}
+
+//***************************************************************************
+sample_index_t Kwave::LabelIndex::nextLabelLeft(sample_index_t from) const
+{
+    const int index = lowerBound(from);
+    return (index > 0) ? m_labels.at(index - 1).pos() : 0;
+}
+
+//***************************************************************************
+sample_index_t Kwave::LabelIndex::nextLabelRight(sample_index_t from) const
+{
+    const int index = upperBound(from);
+    return (index < count()) ? m_labels.at(index).pos() : SAMPLE_INDEX_MAX;
+}
+
+//***************************************************************************
+Kwave::LabelList Kwave::LabelIndex::range(sample_index_t first,
+                                          sample_index_t last) const
+{
+    Kwave::LabelList list;
+    if (first > last) return list;
+
+    const int end = upperBound(last);
+    for (int index = lowerBound(first); index < end; ++index)
+        list.append(m_labels.at(index));
+    return list;
+}
+
+//***************************************************************************
+Kwave::LabelList Kwave::LabelIndex::toList() const
+{
+    Kwave::LabelList list;
+    list.reserve(m_labels.count());
+    for (const Kwave::Label &label : m_labels)
+        list.append(label);
+    return list;
+}
+
+//***************************************************************************
+//***************************************************************************
@@ -0,0 +1,181 @@
+/***************************************************************************
+           LabelIndex.h  -  index of labels, ordered by position
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+#ifndef LABEL_INDEX_H
+#define LABEL_INDEX_H
+
+#include "config.h"
+#include "libkwave_export.h"
+
+#include <QtGlobal>
+#include <QVector>
+
+#include "libkwave/Label.h"
+#include "libkwave/LabelList.h"
+#include "libkwave/Sample.h"
+#include "libkwave/Utils.h"
+
+namespace Kwave
+{
+    class MetaDataList;
+
+    /**
+     * Index of all labels of a signal, kept sorted by position. Unlike
+     * a Kwave::LabelList it is meant to be maintained incrementally,
+     * lookups by position are done with a binary search.
+     *
+     * The index does not observe the meta data it has been built from,
+     * the owner has to call insert()/remove() or invalidate() whenever
+     * the labels in the meta data change.
+     */
+    class LIBKWAVE_EXPORT LabelIndex
+    {
+    public:
+
+        /** Constructor, creates an empty and invalid index */
+        LabelIndex();
+
+        /** Destructor */
+        virtual ~LabelIndex();
+
+        /**
+         * Rebuilds the index from a list of meta data and marks it valid
+         * @param meta_data_list list of meta data
+         */
+        void rebuild(const Kwave::MetaDataList &meta_data_list);
+
+        /** marks the index as out of date, it needs a rebuild() */
+        void invalidate();
+
+        /** returns true if the index is up to date */
+        inline bool isValid() const { return m_valid; }
+
+        /** removes all labels, the index stays valid */
+        void clear();
+
+        /** returns the number of labels */
+        inline int count() const { return Kwave::toInt(m_labels.count()); }
+
+        /** returns true if there are no labels */
+        inline bool isEmpty() const { return m_labels.isEmpty(); }
+
+        /**
+         * returns the label at a given index
+         * @param index the index of the label [0...count()-1]
+         */
+        inline const Kwave::Label &at(int index) const {
+            return m_labels.at(index);
+        }
+
+        /**
+         * Inserts a label behind all labels with the same or a lower
+         * position
+         * @param label the label to insert
+         * @return index of the inserted label or -1 if the index is
+         *         not valid (and will be rebuilt anyway)
+         */
+        int insert(const Kwave::Label &label);
+
+        /**
+         * Inserts a list of labels at once. The new labels are sorted
+         * and merged with the existing ones in one pass, which is much
+         * faster than inserting them one by one.
+         * @param labels list of labels, in any order
+         */
+        void insert(const Kwave::LabelList &labels);
+
+        /**
+         * Removes the label at a given index
+         * @param index the index of the label [0...count()-1]
+         */
+        void removeAt(int index);
+
+        /**
+         * Removes a label, identified by its meta data id
+         * @param label the label to remove
+         * @return true if found and removed
+         */
+        bool remove(const Kwave::Label &label);
+
+        /**
+         * Finds the first label at an exact position
+         * @param pos position [samples]
+         * @return index of the label or -1 if not found
+         */
+        int find(sample_index_t pos) const;
+
+        /**
+         * Returns the index of a label with equal position and name
+         * @param label reference to a label
+         * @return index [0...count()-1] or -1 if not found
+         */
+        int indexOf(const Kwave::Label &label) const;
+
+        /**
+         * Returns the index of the first label at or after a position
+         * @param pos position [samples]
+         * @return index [0...count()], count() if there is none
+         */
+        int lowerBound(sample_index_t pos) const;
+
+        /**
+         * Returns the index of the first label after a position
+         * @param pos position [samples]
+         * @return index [0...count()], count() if there is none
+         */
+        int upperBound(sample_index_t pos) const;
+
+        /**
+         * returns the position of the next label left from a given position
+         * or zero (begin of signal) if there is none
+         * @see Kwave::LabelList::nextLabelLeft
+         */
+        sample_index_t nextLabelLeft(sample_index_t from) const;
+
+        /**
+         * returns the position of the next label right from a given position
+         * or SAMPLE_INDEX_MAX if there is none
+         * @see Kwave::LabelList::nextLabelRight
+         */
+        sample_index_t nextLabelRight(sample_index_t from) const;
+
+        /**
+         * Returns all labels within a range of positions
+         * @param first first position [samples]
+         * @param last last position [samples], inclusive
+         * @return list of labels, sorted by position
+         */
+        Kwave::LabelList range(sample_index_t first,
+                               sample_index_t last) const;
+
+        /** returns a copy of all labels as a label list */
+        Kwave::LabelList toList() const;
+
+    private:
+
+        /** all labels, sorted by ascending position */
+        QVector<Kwave::Label> m_labels;
+
+        /** true if the index is up to date */
+        bool m_valid;
+    };
+
+}
+
+#endif /* LABEL_INDEX_H */
+
+//***************************************************************************
+//***************************************************************************
@@ -0,0 +1,255 @@
+/***************************************************************************
+       MemoryBudget.cpp  -  accounting of memory used by all open files
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <algorithm>
+#include <unistd.h>
+
+#include <QCoreApplication>
+#include <QList>
+#include <QMutexLocker>
+#include <QPair>
+#include <QThread>
+
+#include "libkwave/MemoryBudget.h"
+#include "libkwave/SamplePool.h"
+
+/** limit if the size of the physical memory is not known [MB] */
+#define DEFAULT_LIMIT_MB 2048
+
+/** the limit is enforced down to this fraction, to avoid thrashing [%] */
+#define LOW_WATER_PERCENT 90
+
+/** define this to get the usage per file in the debug output */
+#undef DEBUG_MEMORY_BUDGET
+
+//***************************************************************************
+Kwave::MemoryConsumer::~MemoryConsumer()
+{
+}
+
+//***************************************************************************
+qint64 Kwave::MemoryConsumer::releaseMemory(Kind kind, qint64 bytes)
+{
+    Q_UNUSED(kind)
+    Q_UNUSED(bytes)
+    return 0;
+}
+
+//***************************************************************************
+Kwave::MemoryBudget &Kwave::MemoryBudget::instance()
+{
+    static Kwave::MemoryBudget budget;
+    return budget;
+}
+
+//***************************************************************************
+Kwave::MemoryBudget::MemoryBudget()
+    :QObject(), m_lock(), m_consumers(), m_limit(0), m_check_pending(0)
+{
+    // enforce() has to run in the main thread
+    QCoreApplication *app = QCoreApplication::instance();
+    if (app && (thread() != app->thread())) moveToThread(app->thread());
+
+    setLimit(0);
+}
+
+//***************************************************************************
+Kwave::MemoryBudget::~MemoryBudget()
+{
+    QMutexLocker lock(&m_lock);
+    m_consumers.clear();
+}
+
+//***************************************************************************
+void Kwave::MemoryBudget::registerConsumer(Kwave::MemoryConsumer *consumer,
+                                           const void *document)
+{
+    Q_ASSERT(consumer);
+    if (!consumer) return;
+
+    QMutexLocker lock(&m_lock);
+    m_consumers[consumer] = document;
+}
+
+//***************************************************************************
+void Kwave::MemoryBudget::unregisterConsumer(Kwave::MemoryConsumer *consumer)
+{
+    QMutexLocker lock(&m_lock);
+    m_consumers.remove(consumer);
+}
+
+//***************************************************************************
+void Kwave::MemoryBudget::setLimit(qint64 megabytes)
+{
+    if (megabytes <= 0) {
+        // use half of the physical memory
+        const long pages     = sysconf(_SC_PHYS_PAGES);
+        const long page_size = sysconf(_SC_PAGESIZE);
+        if ((pages > 0) && (page_size > 0))
+            megabytes = ((static_cast<qint64>(pages) * page_size) >> 20) / 2;
+        else
+            megabytes = DEFAULT_LIMIT_MB;
+    }
+
+    {
+        QMutexLocker lock(&m_lock);
+        m_limit = megabytes << 20;
+    }
+    check();
+}
+
+//***************************************************************************
+qint64 Kwave::MemoryBudget::limit() const
+{
+    QMutexLocker lock(&m_lock);
+    return m_limit;
+}
+
+//***************************************************************************
+qint64 Kwave::MemoryBudget::usage(const void *document,
+                                  Kwave::MemoryConsumer::Kind kind) const
+{
+    QMutexLocker lock(&m_lock);
+
+    qint64 bytes = 0;
+    for (auto it = m_consumers.constBegin();
+         it != m_consumers.constEnd(); ++it)
+    {
+        if (document && (it.value() != document)) continue;
+        bytes += it.key()->memoryUsage(kind);
+    }
+
+    // the sample pool is shared by all files
+    if (!document && (kind == Kwave::MemoryConsumer::Cache))
+        bytes += Kwave::SamplePool::statistics().cached_bytes;
+
+    return bytes;
+}
+
+//***************************************************************************
+void Kwave::MemoryBudget::check()
+{
+    if (!m_check_pending.testAndSetOrdered(0, 1)) return; // already queued
+    QMetaObject::invokeMethod(this, "enforce", Qt::QueuedConnection);
+}
+
+//***************************************************************************
+qint64 Kwave::MemoryBudget::release(Kwave::MemoryConsumer::Kind kind,
+                                    qint64 bytes)
+{
+    // the consumers are called without holding the lock, they may
+    // need to take locks of their own that are held while registering
+    QList<Kwave::MemoryConsumer *> list;
+    {
+        QMutexLocker lock(&m_lock);
+        list = m_consumers.keys();
+    }
+
+    // sort the consumers by their usage, largest first
+    QList< QPair<qint64, Kwave::MemoryConsumer *> > consumers;
+    for (Kwave::MemoryConsumer *consumer : std::as_const(list)) {
+        qint64 used = consumer->memoryUsage(kind);
+        if (used > 0) consumers.append(qMakePair(used, consumer));
+    }
+    std::sort(consumers.begin(), consumers.end(),
+        [](const QPair<qint64, Kwave::MemoryConsumer *> &a,
+           const QPair<qint64, Kwave::MemoryConsumer *> &b) {
+            return a.first > b.first;
+        }
+    );
+
+    qint64 released = 0;
+    for (const auto &entry : std::as_const(consumers)) {
+        if (released >= bytes) break;
+        released += entry.second->releaseMemory(kind, bytes - released);
+    }
+    return released;
+}
+
+//***************************************************************************
+void Kwave::MemoryBudget::enforce()
+{
+    Q_ASSERT(QThread::currentThread() == thread());
+    m_check_pending.storeRelease(0);
+
+    const qint64 max     = limit();
+    const qint64 samples = usage(nullptr, Kwave::MemoryConsumer::Samples);
+    const qint64 pooled  = Kwave::SamplePool::statistics().cached_bytes;
+    const qint64 undo    = usage(nullptr, Kwave::MemoryConsumer::Undo);
+    const qint64 cached  = usage(nullptr, Kwave::MemoryConsumer::Cache);
+    if (samples + undo + cached <= max) return; // cached includes the pool
+
+#ifdef DEBUG_MEMORY_BUDGET
+    dump();
+#endif
+
+    // the sample pool holds nothing anybody needs
+    Kwave::SamplePool::trim();
+
+    // sample data can not be released, if it alone exceeds the limit
+    // discarding undo data or caches would not help at all
+    if (samples >= max) return;
+
+    // the rest must fit into what the sample data leaves free, with some
+    // hysteresis if possible
+    const qint64 low_water = (max * LOW_WATER_PERCENT) / 100;
+    const qint64 room      = (samples < low_water) ?
+        (low_water - samples) : (max - samples);
+    qint64 excess = (undo + cached - pooled) - room;
+
+    // first evict the caches, then discard old undo data
+    if (excess > 0) excess -= release(Kwave::MemoryConsumer::Cache, excess);
+    if (excess > 0) excess -= release(Kwave::MemoryConsumer::Undo,  excess);
+
+    if (excess > 0)
+        qWarning("MemoryBudget: still %lld MB over the limit",
+                 excess >> 20);
+}
+
+#ifdef DEBUG_MEMORY_BUDGET
+//***************************************************************************
+void Kwave::MemoryBudget::dump() const
+{
+    QList<const void *> documents;
+    {
+        QMutexLocker lock(&m_lock);
+        foreach (const void *document, m_consumers)
+            if (document && !documents.contains(document))
+                documents.append(document);
+    }
+
+    qDebug("MemoryBudget: limit=%lld MB", limit() >> 20);
+    foreach (const void *document, documents) {
+        qDebug("    %p: samples=%lld MB, undo=%lld MB, cache=%lld MB",
+            document,
+            usage(document, Kwave::MemoryConsumer::Samples) >> 20,
+            usage(document, Kwave::MemoryConsumer::Undo)    >> 20,
+            usage(document, Kwave::MemoryConsumer::Cache)   >> 20);
+    }
+    qDebug("    total: samples=%lld MB, undo=%lld MB, cache=%lld MB",
+        usage(nullptr, Kwave::MemoryConsumer::Samples) >> 20,
+        usage(nullptr, Kwave::MemoryConsumer::Undo)    >> 20,
+        usage(nullptr, Kwave::MemoryConsumer::Cache)   >> 20);
+}
+#endif /* DEBUG_MEMORY_BUDGET */
+
+//***************************************************************************
+//***************************************************************************
+
+#include "moc_MemoryBudget.cpp"
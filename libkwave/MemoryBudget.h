@@ -0,0 +1,173 @@
+/***************************************************************************
+         MemoryBudget.h  -  accounting of memory used by all open files
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef MEMORY_BUDGET_H
+#define MEMORY_BUDGET_H
+
+#include "config.h"
+#include "libkwave_export.h"
+
+#include <QtGlobal>
+#include <QAtomicInt>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+
+namespace Kwave
+{
+
+    /**
+     * Interface of everything that holds a noticeable amount of memory
+     * and wants to be accounted in the MemoryBudget.
+     */
+    class LIBKWAVE_EXPORT MemoryConsumer
+    {
+    public:
+
+        /** kind of memory */
+        typedef enum {
+            Samples = 0, /**< sample data of a signal, never released   */
+            Undo    = 1, /**< undo and redo data                        */
+            Cache   = 2  /**< data that can be re-created when needed   */
+        } Kind;
+
+        /** Destructor */
+        virtual ~MemoryConsumer();
+
+        /**
+         * Returns the amount of memory in use, called from the
+         * main thread only
+         * @param kind the kind of memory
+         * @return number of bytes
+         */
+        virtual qint64 memoryUsage(Kind kind) = 0;
+
+        /**
+         * Tries to release memory, called from the main thread only
+         * @param kind the kind of memory, never Samples
+         * @param bytes number of bytes that should be released
+         * @return number of bytes that have been released
+         */
+        virtual qint64 releaseMemory(Kind kind, qint64 bytes);
+
+    };
+
+    /**
+     * Keeps track of the memory used by all open files and enforces a
+     * global limit. When the limit is exceeded, caches are evicted first,
+     * starting with the largest one, then the oldest undo data of the
+     * files with the most undo data is discarded. Sample data itself is
+     * never touched, if it alone exceeds the limit nothing is released.
+     */
+    class LIBKWAVE_EXPORT MemoryBudget: public QObject
+    {
+        Q_OBJECT
+    public:
+
+        /** returns the one and only instance */
+        static Kwave::MemoryBudget &instance();
+
+        /**
+         * Registers a consumer, or changes the document it belongs to.
+         * @param consumer the memory consumer
+         * @param document identifies the file, e.g. its SignalManager,
+         *                 or null for memory that is shared by all files
+         */
+        void registerConsumer(Kwave::MemoryConsumer *consumer,
+                              const void *document);
+
+        /**
+         * Removes a consumer, must be called before it is destroyed
+         * @param consumer the memory consumer
+         */
+        void unregisterConsumer(Kwave::MemoryConsumer *consumer);
+
+        /**
+         * Sets the global limit
+         * @param megabytes the limit in whole megabytes, zero or less for
+         *                  using half of the physical memory
+         */
+        void setLimit(qint64 megabytes);
+
+        /** returns the global limit [bytes] */
+        qint64 limit() const;
+
+        /**
+         * Returns the memory used by a file or all files, must be called
+         * from the main thread
+         * @param document the file or null for all files
+         * @param kind the kind of memory
+         * @return number of bytes
+         */
+        qint64 usage(const void *document,
+                     Kwave::MemoryConsumer::Kind kind) const;
+
+        /**
+         * Should be called after allocating larger amounts of memory. Can
+         * be called from any thread, the check is done later in the main
+         * thread and repeated calls are merged into one.
+         */
+        void check();
+
+    public slots:
+
+        /** enforces the limit, must be called from the main thread */
+        void enforce();
+
+    private:
+
+        /** Constructor */
+        MemoryBudget();
+
+        /** Destructor */
+        ~MemoryBudget() override;
+
+        /**
+         * Releases memory of one kind, largest consumer first
+         * @param kind the kind of memory
+         * @param bytes the number of bytes to release
+         * @return number of bytes that have been released
+         */
+        qint64 release(Kwave::MemoryConsumer::Kind kind, qint64 bytes);
+
+        /**
+         * writes the usage per document to the debug output, only
+         * available with DEBUG_MEMORY_BUDGET
+         */
+        void dump() const;
+
+    private:
+
+        /** lock for m_consumers */
+        mutable QMutex m_lock;
+
+        /** all consumers, with the document they belong to */
+        QHash<Kwave::MemoryConsumer *, const void *> m_consumers;
+
+        /** the global limit [bytes] */
+        qint64 m_limit;
+
+        /** non-zero if enforce() is already scheduled */
+        QAtomicInt m_check_pending;
+
+    };
+}
+
+#endif /* MEMORY_BUDGET_H */
+
+//***************************************************************************
+//***************************************************************************
@@ -134,6 +134,14 @@ int Kwave::MessageBox::error(QWidget *parent,
         parent, message, caption);
 }
 
+//***************************************************************************
+int Kwave::MessageBox::information(QWidget *parent,
+    QString message, QString caption)
+{
+    return Kwave::MessageBox::exec(KMessageBox::Information,
+        parent, message, caption);
+}
+
 //***************************************************************************
 int Kwave::MessageBox::exec(KMessageBox::DialogType mode, QWidget *parent,
     QString message, QString caption,
@@ -82,6 +82,10 @@ namespace Kwave
         static int error(QWidget *widget,
             QString message, QString caption = QString());
 
+        /** @see KMessageBox::information */
+        static int information(QWidget *widget,
+            QString message, QString caption = QString());
+
     private:
 
         /** Default constructor (not implemented) */
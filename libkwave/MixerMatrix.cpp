@@ -18,11 +18,20 @@
 
 #include "config.h"
 
+#include <algorithm>
+#include <string.h>
+
 #include "libkwave/MixerMatrix.h"
+#include "libkwave/Utils.h"
+#include "libkwave/memcpy.h"
+
+/** number of samples that are mixed per block, in mix() */
+#define MIX_BLOCK_SIZE 256
 
 //***************************************************************************
 Kwave::MixerMatrix::MixerMatrix(unsigned int inputs, unsigned int outputs)
-    :Kwave::Matrix<double>(inputs, outputs)
+    :Kwave::Matrix<double>(inputs, outputs),
+     m_inputs(inputs), m_outputs(outputs), m_type(Dense), m_terms()
 {
     for (unsigned int y = 0; y < outputs; y++) {
         unsigned int m1, m2;
@@ -43,6 +52,8 @@ Kwave::MixerMatrix::MixerMatrix(unsigned int inputs, unsigned int outputs)
                 static_cast<double>(inputs) : 0.0;
         }
     }
+
+    update();
 }
 
 //***************************************************************************
@@ -50,5 +61,90 @@ Kwave::MixerMatrix::~MixerMatrix()
 {
 }
 
+//***************************************************************************
+void Kwave::MixerMatrix::update()
+{
+    bool identity    = (m_inputs == m_outputs);
+    bool permutation = true;
+    unsigned int non_zero = 0;
+
+    m_terms.resize(Kwave::toInt(m_outputs));
+    for (unsigned int y = 0; y < m_outputs; y++) {
+        QVector<Term> &terms = m_terms[y];
+        terms.clear();
+        for (unsigned int x = 0; x < m_inputs; x++) {
+            const double f = (*this)[x][y];
+            if (qFuzzyIsNull(f)) continue;
+            Term term;
+            term.input  = x;
+            term.factor = static_cast<float>(f);
+            terms.append(term);
+        }
+        non_zero += Kwave::toUint(terms.count());
+
+        const bool copy = (terms.count() == 1) &&
+            qFuzzyCompare(terms.first().factor, 1.0f);
+        if (!copy || (terms.first().input != y)) identity = false;
+        if (!copy && !terms.isEmpty()) permutation = false;
+    }
+
+    if (identity)
+        m_type = Identity;
+    else if (permutation)
+        m_type = Permutation;
+    else if (2 * non_zero <= m_inputs * m_outputs)
+        m_type = Sparse;
+    else
+        m_type = Dense;
+}
+
+//***************************************************************************
+void Kwave::MixerMatrix::mix(const sample_t * const *input,
+                             sample_t * const *output,
+                             unsigned int count) const
+{
+    if (m_type == Identity) {
+        for (unsigned int y = 0; y < m_outputs; y++)
+            MEMCPY(output[y], input[y], count * sizeof(sample_t));
+        return;
+    }
+
+    if (m_type == Permutation) {
+        for (unsigned int y = 0; y < m_outputs; y++) {
+            const QVector<Term> &terms = m_terms[y];
+            if (terms.isEmpty())
+                memset(output[y], 0x00, count * sizeof(sample_t));
+            else
+                MEMCPY(output[y], input[terms.first().input],
+                       count * sizeof(sample_t));
+        }
+        return;
+    }
+
+    // sum up the non-zero terms, block by block, in single precision
+    const float s_min = static_cast<float>(SAMPLE_MIN);
+    const float s_max = static_cast<float>(SAMPLE_MAX);
+    float sum[MIX_BLOCK_SIZE];
+    for (unsigned int y = 0; y < m_outputs; y++) {
+        const QVector<Term> &terms = m_terms[y];
+        sample_t *out = output[y];
+        for (unsigned int pos = 0; pos < count; pos += MIX_BLOCK_SIZE) {
+            const unsigned int len = qMin<unsigned int>(MIX_BLOCK_SIZE,
+                                                        count - pos);
+            std::fill(sum, sum + len, 0.0f);
+            for (const Term &term : terms) {
+                const sample_t *in = input[term.input] + pos;
+                const float f = term.factor;
+                for (unsigned int i = 0; i < len; i++)
+                    sum[i] += f * static_cast<float>(in[i]);
+            }
+            for (unsigned int i = 0; i < len; i++) {
+                const float v = qBound(s_min, sum[i], s_max);
+                out[pos + i] = static_cast<sample_t>(v);
+            }
+        }
+    }
+}
+
 //***************************************************************************
 //***************************************************************************
@@ -23,15 +23,39 @@
 #include "libkwave_export.h"
 
 #include <QtGlobal>
+#include <QVector>
 
 #include "libkwave/Matrix.h"
+#include "libkwave/Sample.h"
 
 namespace Kwave
 {
 
+    /**
+     * Matrix with the factors for mixing a number of input channels into
+     * a number of output channels, <c>(*matrix)[x][y]</c> is the factor
+     * of input x in output y. The default factors mix up or down to the
+     * number of outputs, they can be changed afterwards, followed by a
+     * call to update().
+     *
+     * Most matrices have only a few non-zero factors, e.g. when channels
+     * are swapped or copied, so the matrix is classified and mix() uses
+     * the cheapest way: copying for identity and permutation matrices,
+     * otherwise only the non-zero factors are applied to blocks of
+     * samples, in single precision so that the loops can be vectorized.
+     */
     class LIBKWAVE_EXPORT MixerMatrix: public Kwave::Matrix<double>
     {
     public:
+
+        /** classification of the factors */
+        typedef enum {
+            Identity,    /**< each output is the input with the same index */
+            Permutation, /**< each output is a copy of one input or silent */
+            Sparse,      /**< at most half of the factors are non-zero    */
+            Dense        /**< most of the factors are non-zero            */
+        } Type;
+
         /**
          * Constructor
          * @param inputs number of inputs
@@ -41,6 +65,54 @@ namespace Kwave
 
         /** Destructor */
         virtual ~MixerMatrix() override;
+
+        /** returns the number of inputs */
+        inline unsigned int inputs() const { return m_inputs; }
+
+        /** returns the number of outputs */
+        inline unsigned int outputs() const { return m_outputs; }
+
+        /**
+         * Classifies the matrix and prepares the factors for mix(),
+         * must be called after changing one of the factors
+         */
+        void update();
+
+        /** returns the classification, as of the last update() */
+        inline Type type() const { return m_type; }
+
+        /**
+         * Mixes a block of samples of all inputs into all outputs,
+         * the result is clipped to the range of sample_t.
+         * @param input array with one pointer per input
+         * @param output array with one pointer per output, the output
+         *               buffers must not overlap with the inputs
+         * @param count number of samples per input and output
+         */
+        void mix(const sample_t * const *input,
+                 sample_t * const *output,
+                 unsigned int count) const;
+
+    private:
+
+        /** one non-zero factor of an output */
+        typedef struct {
+            unsigned int input; /**< index of the input */
+            float factor;       /**< factor of the input */
+        } Term;
+
+        /** number of inputs */
+        unsigned int m_inputs;
+
+        /** number of outputs */
+        unsigned int m_outputs;
+
+        /** classification of the matrix */
+        Type m_type;
+
+        /** list of non-zero factors, per output */
+        QVector< QVector<Term> > m_terms;
+
     };
 
 }
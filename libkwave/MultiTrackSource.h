@@ -26,9 +26,9 @@
 #include <QFutureSynchronizer>
 #include <QList>
 #include <QObject>
-#include <QtConcurrentRun>
 
 #include "libkwave/SampleSource.h"
+#include "libkwave/TaskPool.h"
 
 namespace Kwave
 {
@@ -77,7 +77,7 @@ namespace Kwave
             QFutureSynchronizer<void> synchronizer;
             foreach (SOURCE *src, static_cast< QList<SOURCE *> >(*this)) {
                 if (!src) continue;
-                synchronizer.addFuture(QtConcurrent::run(
+                synchronizer.addFuture(Kwave::TaskPool::run(
                     &Kwave::MultiTrackSource<SOURCE, INITIALIZE>::runSource,
                     this,
                     src)
@@ -21,6 +21,7 @@
 #include <new>
 
 #include <QMutexLocker>
+#include <QVarLengthArray>
 
 #include "libkwave/MessageBox.h"
 #include "libkwave/MixerMatrix.h"
@@ -39,6 +40,12 @@
 /** Sets the number of screen refreshes per second when in playback mode */
 #define SCREEN_REFRESHES_PER_SECOND 25
 
+/**
+ * number of sample frames that are mixed at once, small enough for
+ * reacting on seek requests without a noticeable delay
+ */
+#define PLAYBACK_BLOCK_FRAMES 256
+
 //***************************************************************************
 Kwave::PlaybackController::PlaybackController(
     Kwave::SignalManager &signal_manager
@@ -429,7 +436,19 @@ void Kwave::PlaybackController::run_wrapper(const QVariant &params)
 
     // loop until process is stopped
     // or run once if not in loop mode
-    Kwave::SampleArray in_samples(tracks);
+    QVector<Kwave::SampleArray> in_blocks(Kwave::toInt(tracks));
+    QVector<Kwave::SampleArray> out_blocks(Kwave::toInt(out_channels));
+    bool allocated = true;
+    for (Kwave::SampleArray &block : in_blocks)
+        if (!block.resize(PLAYBACK_BLOCK_FRAMES)) allocated = false;
+    for (Kwave::SampleArray &block : out_blocks)
+        if (!block.resize(PLAYBACK_BLOCK_FRAMES)) allocated = false;
+    if (!allocated) {
+        emit sigDevicePlaybackDone();
+        return;
+    }
+    QVarLengthArray<const sample_t *> in(Kwave::toInt(tracks));
+    QVarLengthArray<sample_t *> out(Kwave::toInt(out_channels));
     Kwave::SampleArray out_samples(out_channels);
     sample_index_t pos = m_playback_position;
     updatePlaybackPos(pos);
@@ -442,7 +461,7 @@ void Kwave::PlaybackController::run_wrapper(const QVariant &params)
         // samples (this happens when resuming after a pause)
         if (pos > first) input.skip(pos - first);
 
-        while ((pos++ <= last) && !m_thread.isInterruptionRequested()) {
+        while ((pos <= last) && !m_thread.isInterruptionRequested()) {
             unsigned int x;
             unsigned int y;
             bool seek_again = false;
@@ -483,50 +502,58 @@ void Kwave::PlaybackController::run_wrapper(const QVariant &params)
             if (seek_again) input.seek(pos);
             if (seek_done)  seekDone(pos);
 
-            // fill input buffer with samples
+            // fill the input buffers with a block of samples of each
+            // audible track, behind the end with zeroes
+            const unsigned int frames = Kwave::toUint(qMin<sample_index_t>(
+                PLAYBACK_BLOCK_FRAMES, last - pos + 1));
             for (x = 0; x < audible_count; ++x) {
-                in_samples[x] = 0;
+                Kwave::SampleArray &block = in_blocks[x];
                 Kwave::SampleReader *stream = input[audible_tracks[x]];
                 Q_ASSERT(stream);
-                if (!stream) continue;
-
-                if (!stream->eof()) (*stream) >> in_samples[x];
+                unsigned int len = 0;
+                if (stream && !stream->eof())
+                    len = stream->read(block, 0, frames);
+                sample_t *samples = block.data();
+                while (len < frames) samples[len++] = 0;
+                in[x] = block.constData();
             }
 
-            // multiply matrix with input to get output
-            const Kwave::SampleArray &in = in_samples;
-            for (y = 0; y < out_channels; ++y) {
-                double sum = 0;
-                for (x = 0; x < audible_count; ++x) {
-                    sum += static_cast<double>(in[x]) * (*mixer)[x][y];
+            // multiply matrix with the whole block of input
+            for (y = 0; y < out_channels; ++y)
+                out[y] = out_blocks[y].data();
+            mixer->mix(in.constData(), out.constData(), frames);
+
+            for (unsigned int i = 0; i < frames; ++i) {
+                for (y = 0; y < out_channels; ++y)
+                    out_samples[y] = out[y][i];
+
+                // write samples to the playback device
+                int result = -1;
+                {
+                    unsigned int retry = 10;
+                    while (retry-- && !m_thread.isInterruptionRequested()) {
+                        QMutexLocker lock(&m_lock_device);
+                        if (m_device)
+                            result = m_device->write(out_samples);
+                        if (result == 0)
+                            break;
+                    }
                 }
-                out_samples[y] = static_cast<sample_t>(sum);
-            }
-
-            // write samples to the playback device
-            int result = -1;
-            {
-                unsigned int retry = 10;
-                while (retry-- && !m_thread.isInterruptionRequested()) {
-                    QMutexLocker lock(&m_lock_device);
-                    if (m_device)
-                        result = m_device->write(out_samples);
-                    if (result == 0)
-                        break;
+                if (result) {
+                    m_thread.requestInterruption();
+                    break;
+                }
+                ++pos;
+
+                // update the playback position if timer elapsed
+                if (!pos_countdown) {
+                    pos_countdown = Kwave::toUint(ceil(
+                        m_playback_params.rate /
+                        SCREEN_REFRESHES_PER_SECOND));
+                    updatePlaybackPos(pos);
+                } else {
+                    --pos_countdown;
                 }
-            }
-            if (result) {
-                m_thread.requestInterruption();
-                pos = last;
-            }
-
-            // update the playback position if timer elapsed
-            if (!pos_countdown) {
-                pos_countdown = Kwave::toUint(ceil(
-                    m_playback_params.rate / SCREEN_REFRESHES_PER_SECOND));
-                updatePlaybackPos(pos);
-            } else {
-                --pos_countdown;
             }
         }
 
@@ -35,6 +35,7 @@
 #include "libkwave/ConfirmCancelProxy.h"
 #include "libkwave/Plugin.h"
 #include "libkwave/PluginManager.h"
+#include "libkwave/Profiler.h"
 #include "libkwave/Sample.h"
 #include "libkwave/SignalManager.h"
 #include "libkwave/String.h"
@@ -396,7 +397,10 @@ void Kwave::Plugin::run_wrapper(const QVariant &params)
     t.start();
 
     // call the plugin's run function in this worker thread context
-    run(params.toStringList());
+    {
+        Kwave::ProfileScope profile("plugin", name());
+        run(params.toStringList());
+    }
 
     // evaluate the elapsed time
     double seconds = static_cast<double>(t.elapsed()) * 1E-3;
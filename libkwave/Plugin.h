@@ -120,6 +120,8 @@ namespace Kwave
          * Called after the plugin has been loaded into memory. This is
          * useful for plugins that don't use start() and execute(),
          * maybe for some persistent plugins like playback and record.
+         * Only called at startup, and only for plugins that have set
+         * <c>"X-Kwave-Load": true</c> in their meta data (json file).
          * The default implementation does nothing.
          */
         virtual void load(QStringList &params);
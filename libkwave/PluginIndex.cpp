@@ -0,0 +1,153 @@
+/***************************************************************************
+        PluginIndex.cpp  -  cached index of the installed plugins
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QLibrary>
+#include <QLocale>
+#include <QSet>
+#include <QStandardPaths>
+
+#include <KConfig>
+#include <KConfigGroup>
+#include <KPluginMetaData>
+
+#include "libkwave/PluginIndex.h"
+#include "libkwave/String.h"
+
+/** name of the group with the properties of the whole index */
+#define INDEX_GROUP "Index"
+
+//***************************************************************************
+Kwave::PluginIndex::PluginIndex(const QString &cache_file)
+    :m_cache_file(cache_file), m_misses(0)
+{
+}
+
+//***************************************************************************
+Kwave::PluginIndex::~PluginIndex()
+{
+}
+
+//***************************************************************************
+QString Kwave::PluginIndex::defaultCacheFile()
+{
+    const QString dir =
+        QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (dir.isEmpty() || !QDir().mkpath(dir)) return QString();
+    return dir + _("/plugin-index");
+}
+
+//***************************************************************************
+QStringList Kwave::PluginIndex::directories()
+{
+    // the same search path as KPluginMetaData::findPlugins(_("kwave"))
+    QStringList list;
+    foreach (const QString &path, QCoreApplication::libraryPaths())
+        list.append(path + _("/kwave"));
+    return list;
+}
+
+//***************************************************************************
+QList<Kwave::PluginIndex::Entry> Kwave::PluginIndex::scan(
+    const QStringList &directories)
+{
+    QList<Kwave::PluginIndex::Entry> list;
+    QSet<QString> ids;
+    QSet<QString> files;
+    m_misses = 0;
+
+    // an empty file name gives a cache in memory only
+    KConfig cache(m_cache_file, KConfig::SimpleConfig);
+
+    // the names are translated, start over if the language has changed
+    KConfigGroup index = cache.group(_(INDEX_GROUP));
+    const QString locale = QLocale().name();
+    if ((index.readEntry("locale") != locale) ||
+        (index.readEntry("version") != _(KWAVE_VERSION)))
+    {
+        foreach (const QString &group, cache.groupList())
+            cache.deleteGroup(group);
+    }
+
+    foreach (const QString &directory, directories) {
+        const QFileInfoList entries = QDir(directory).entryInfoList(
+            QDir::Files | QDir::Readable, QDir::Name);
+        foreach (const QFileInfo &info, entries) {
+            const QString file = info.absoluteFilePath();
+            if (!QLibrary::isLibrary(file)) continue;
+            files.insert(file);
+
+            // read the meta data only if the library has changed
+            KConfigGroup cfg = cache.group(file);
+            const qint64 mtime = info.lastModified().toMSecsSinceEpoch();
+            const qint64 size  = info.size();
+            if ((cfg.readEntry("mtime", qint64(-1)) != mtime) ||
+                (cfg.readEntry("size",  qint64(-1)) != size))
+            {
+                m_misses++;
+                const KPluginMetaData meta(file);
+                const bool valid = meta.isValid() &&
+                    !meta.pluginId().isEmpty();
+                cfg.writeEntry("mtime",   mtime);
+                cfg.writeEntry("size",    size);
+                cfg.writeEntry("valid",   valid);
+                cfg.writeEntry("id",      meta.pluginId());
+                cfg.writeEntry("name",    meta.name());
+                cfg.writeEntry("version", meta.version());
+                cfg.writeEntry("author",  meta.authors().isEmpty() ?
+                    QString() : meta.authors().first().name());
+                cfg.writeEntry("load",
+                    meta.value(_("X-Kwave-Load"), false));
+            }
+
+            // not a plugin or already found in a previous directory
+            if (!cfg.readEntry("valid", false)) continue;
+            const QString id = cfg.readEntry("id");
+            if (ids.contains(id)) continue;
+            ids.insert(id);
+
+            Entry entry;
+            entry.file    = file;
+            entry.id      = id;
+            entry.name    = cfg.readEntry("name");
+            entry.version = cfg.readEntry("version");
+            entry.author  = cfg.readEntry("author");
+            entry.load    = cfg.readEntry("load", false);
+            list.append(entry);
+        }
+    }
+
+    // forget about libraries that have been removed
+    foreach (const QString &group, cache.groupList()) {
+        if ((group != _(INDEX_GROUP)) && !files.contains(group))
+            cache.deleteGroup(group);
+    }
+
+    index.writeEntry("locale",  locale);
+    index.writeEntry("version", _(KWAVE_VERSION));
+    cache.sync();
+
+    return list;
+}
+
+//***************************************************************************
+//***************************************************************************
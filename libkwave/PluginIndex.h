@@ -0,0 +1,96 @@
+/***************************************************************************
+          PluginIndex.h  -  cached index of the installed plugins
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef PLUGIN_INDEX_H
+#define PLUGIN_INDEX_H
+
+#include "config.h"
+#include "libkwave_export.h"
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+namespace Kwave
+{
+
+    /**
+     * Index of the installed plugin libraries, with the meta data that
+     * is needed before a plugin is loaded. Reading the meta data means
+     * opening every library, which is slow on network file systems, so
+     * the index is kept in a cache file. The meta data of a library is
+     * only read again if its modification time or size has changed.
+     */
+    class LIBKWAVE_EXPORT PluginIndex
+    {
+    public:
+
+        /** meta data of one plugin */
+        typedef struct {
+            QString file;    /**< full path of the library            */
+            QString id;      /**< internal name, like "zero"          */
+            QString name;    /**< translated name, for the user       */
+            QString version; /**< binary and settings version, "a:b"  */
+            QString author;  /**< name of the (first) author          */
+            bool    load;    /**< if true, load at startup            */
+        } Entry;
+
+        /**
+         * Constructor
+         * @param cache_file path of the cache file, an empty string
+         *                   disables the cache
+         */
+        explicit PluginIndex(const QString &cache_file);
+
+        /** Destructor */
+        virtual ~PluginIndex();
+
+        /** returns the default path of the cache file */
+        static QString defaultCacheFile();
+
+        /** returns the directories that contain Kwave plugins */
+        static QStringList directories();
+
+        /**
+         * Scans a list of directories for plugin libraries. If a plugin
+         * is found more than once, the first one is used.
+         * @param directories list of directories
+         * @return list of entries, one per plugin
+         */
+        QList<Kwave::PluginIndex::Entry> scan(const QStringList &directories);
+
+        /**
+         * Returns the number of libraries that were not found in the
+         * cache during the last scan and had to be opened
+         */
+        inline unsigned int misses() const { return m_misses; }
+
+    private:
+
+        /** path of the cache file */
+        QString m_cache_file;
+
+        /** number of libraries that had to be opened */
+        unsigned int m_misses;
+
+    };
+}
+
+#endif /* PLUGIN_INDEX_H */
+
+//***************************************************************************
+//***************************************************************************
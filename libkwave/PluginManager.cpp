@@ -44,7 +44,9 @@
 #include "libkwave/PlayBackDevice.h"
 #include "libkwave/PlaybackDeviceFactory.h"
 #include "libkwave/Plugin.h"
+#include "libkwave/PluginIndex.h"
 #include "libkwave/PluginManager.h"
+#include "libkwave/Profiler.h"
 #include "libkwave/SignalManager.h"
 #include "libkwave/Utils.h"
 #include "libkwave/Writer.h"
@@ -130,12 +132,15 @@ bool Kwave::PluginManager::loadAllPlugins()
     // Try to load all plugins. This has to be called only once per
     // instance of the main window!
     // NOTE: this also gives each plugin the chance to stay in memory
-    //       if necessary (e.g. for codecs)
-    for (QMap<QString, PluginModule>::iterator it(m_plugin_modules.begin());
-         it != m_plugin_modules.end(); ++it)
-    {
-        const QString      &name   = it.key();
-        KwavePluginPointer  plugin = createPluginInstance(name);
+    //       if necessary (e.g. for codecs). Plugins that are not needed
+    //       at startup are skipped, they are loaded on their first use.
+    foreach (const QString &name, m_plugin_modules.keys()) {
+        if (!m_plugin_modules[name].m_load) continue;
+
+        emit sigProgress(i18n("Loading plugin %1...", name));
+        QApplication::processEvents();
+
+        KwavePluginPointer plugin = createPluginInstance(name);
         if (plugin) {
 //          qDebug("PluginManager::loadAllPlugins(): plugin '%s'",
 //                 DBG(plugin->name()));
@@ -197,6 +202,22 @@ Kwave::Plugin *Kwave::PluginManager::createPluginInstance(const QString &name)
 //     qDebug("loadPlugin(%s) [module use count=%d]",
 //         DBG(name), info.m_use_count);
 
+    // load the library on the first use
+    if (!info.m_factory) {
+        Kwave::ProfileScope profile("plugin load", name);
+        KPluginFactory::Result<KPluginFactory> result =
+            KPluginFactory::loadFactory(KPluginMetaData(info.m_library));
+        if (!result) {
+            qWarning("plugin '%s': loading failed: '%s'", DBG(name),
+                     DBG(result.errorString));
+            Kwave::MessageBox::error(m_parent_widget,
+                i18n("The plugin '%1' could not be loaded.", name),
+                i18n("Error On Loading Plugin"));
+            return nullptr;
+        }
+        info.m_factory = result.plugin;
+    }
+
     KPluginFactory *factory = info.m_factory;
     Q_ASSERT(factory);
 
@@ -627,16 +648,18 @@ void Kwave::PluginManager::searchPluginModules()
         return;
     }
 
-    QVector<KPluginMetaData> plugins_meta_data =
-        KPluginMetaData::findPlugins(_("kwave"));
-    foreach (const KPluginMetaData &i, plugins_meta_data) {
-        QString library     = i.fileName();
-        QString description = i.name();
-        QString name        = i.pluginId();
-        QString version_raw = i.version();
+    Kwave::ProfileScope profile("plugin scan");
+    Kwave::PluginIndex index(Kwave::PluginIndex::defaultCacheFile());
+    const QList<Kwave::PluginIndex::Entry> entries =
+        index.scan(Kwave::PluginIndex::directories());
+    foreach (const Kwave::PluginIndex::Entry &i, entries) {
+        QString library     = i.file;
+        QString description = i.name;
+        QString name        = i.id;
+        QString version_raw = i.version;
         QString version;
         QString settings;
-        QString author      = i.authors().first().name();
+        QString author      = i.author;
 
         if (version_raw.contains(_(":"))) {
             version  = version_raw.split(_(":")).at(0);
@@ -661,24 +684,14 @@ void Kwave::PluginManager::searchPluginModules()
             continue;
         }
 
-        KPluginFactory::Result<KPluginFactory> result =
-            KPluginFactory::loadFactory(i);
-
-        if (!result) {
-            qWarning("plugin '%s': loading failed: '%s'", DBG(name),
-                     DBG(result.errorString));
-            continue;
-        }
-
-        emit sigProgress(i18n("Loading plugin %1...", name));
-        QApplication::processEvents();
-
         PluginModule info;
         info.m_name        = name;
         info.m_author      = author;
         info.m_description = description;
         info.m_version     = settings;
-        info.m_factory     = result.plugin;
+        info.m_library     = library;
+        info.m_load        = i.load;
+        info.m_factory     = nullptr;
         info.m_use_count   = 1;
 
         m_plugin_modules.insert(info.m_name, info);
@@ -686,7 +699,8 @@ void Kwave::PluginManager::searchPluginModules()
         qDebug("%16s %5s written by %s", DBG(name), DBG(settings), DBG(author));
     }
 
-    qDebug("--- \n found %lld plugins\n", m_plugin_modules.count());
+    qDebug("--- \n found %lld plugins, %u not in the index cache\n",
+           m_plugin_modules.count(), index.misses());
 }
 
 //***************************************************************************
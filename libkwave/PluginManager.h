@@ -71,10 +71,13 @@ namespace Kwave
         ~PluginManager() override;
 
         /**
-         * Tries to load all plugins. If a pesistent plugin is found,
-         * it will stay loaded in memory, all other (non-persistent)
-         * plugins will be unloaded afterwards. This also filters out
-         * all plugins that do not correctly load.
+         * Loads all plugins that have to register something at startup,
+         * like codecs or menu entries (marked with "X-Kwave-Load" in
+         * their meta data). If a pesistent plugin is found, it will stay
+         * loaded in memory, all other (non-persistent) plugins will be
+         * unloaded afterwards. This also filters out all of these
+         * plugins that do not correctly load. All other plugins are
+         * loaded when they are used for the first time.
          * @internal used once by each toplevel window at startup
          * @return true if at least one plugin was loaded, false if none
          */
@@ -222,10 +225,12 @@ namespace Kwave
         void enqueueCommand(const QString &command);
 
         /**
-         * Searches the standard KDE data directories for plugins (through
-         * the KDE's standard search algorithm) and creates a map of
-         * plugin names and file names. First it collects a list of
+         * Searches the plugin directories for plugins and creates a map
+         * of plugin names and file names. First it collects a list of
          * filenames and then filters it to sort out invalid entries.
+         * The meta data of the plugins is taken from the plugin index
+         * cache if possible, the libraries are not loaded yet.
+         * @see Kwave::PluginIndex
          */
         void searchPluginModules();
 
@@ -235,7 +240,10 @@ namespace Kwave
             QString            m_author;      /**< name of the author   */
             QString            m_description; /**< short description    */
             QString            m_version;     /**< settings version     */
-            KPluginFactory    *m_factory;     /**< plugin factory       */
+            QString            m_library;     /**< path of the library  */
+            bool               m_load;        /**< load at startup      */
+            KPluginFactory    *m_factory;     /**< plugin factory, or
+                                                   null if not loaded */
             int                m_use_count;   /**< usage counter        */
         } PluginModule;
 
@@ -0,0 +1,274 @@
+/***************************************************************************
+           Profiler.cpp  -  lightweight timing and counting of operations
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QVector>
+
+#include "libkwave/Profiler.h"
+#include "libkwave/SamplePool.h"
+#include "libkwave/String.h"
+#include "libkwave/Utils.h"
+
+/** maximum number of events in a trace, to limit the memory usage */
+#define MAX_TRACE_EVENTS (1024 * 1024)
+
+// static initializers
+QAtomicInt Kwave::Profiler::m_enabled(0);
+
+namespace
+{
+    /** one recorded event of a trace */
+    typedef struct {
+        const char *name;   /**< name of the operation or counter   */
+        QString     detail; /**< additional information             */
+        int         thread; /**< index of the thread                */
+        qint64      start;  /**< start time [us]                    */
+        qint64      value;  /**< duration [us] or counter value  */
+        bool        counter;/**< true for a counter                 */
+    } TraceEvent;
+
+    /** internal state of the profiler */
+    class ProfilerState
+    {
+    public:
+        ProfilerState()
+            :m_lock(), m_clock(), m_timings(), m_counters(), m_threads(),
+             m_trace_file(), m_trace()
+        {
+            m_clock.start();
+        }
+
+        /** returns a small index for the current thread, needs m_lock */
+        int threadIndex()
+        {
+            const quintptr id = reinterpret_cast<quintptr>(
+                QThread::currentThreadId());
+            auto it = m_threads.constFind(id);
+            if (it != m_threads.constEnd()) return it.value();
+            const int index = Kwave::toInt(m_threads.count()) + 1;
+            m_threads.insert(id, index);
+            return index;
+        }
+
+        /** lock for all members except m_clock */
+        QMutex m_lock;
+
+        /** time base of all events */
+        QElapsedTimer m_clock;
+
+        /** accumulated timings, per name and detail */
+        QHash<QString, Kwave::Profiler::Timing> m_timings;
+
+        /** counters, per name */
+        QHash<QString, qint64> m_counters;
+
+        /** map of thread ids to thread indices */
+        QHash<quintptr, int> m_threads;
+
+        /** name of the trace file, empty if no trace is running */
+        QString m_trace_file;
+
+        /** recorded events of the trace */
+        QVector<TraceEvent> m_trace;
+    };
+}
+
+/** returns the internal state, created on first use */
+static ProfilerState &state()
+{
+    static ProfilerState s;
+    return s;
+}
+
+//***************************************************************************
+void Kwave::Profiler::setEnabled(bool enable)
+{
+    state(); // start the clock
+    m_enabled.storeRelaxed(enable ? 1 : 0);
+}
+
+//***************************************************************************
+void Kwave::Profiler::reset()
+{
+    ProfilerState &s = state();
+    QMutexLocker lock(&s.m_lock);
+    s.m_timings.clear();
+    s.m_counters.clear();
+}
+
+//***************************************************************************
+bool Kwave::Profiler::startTrace(const QString &filename)
+{
+    // check that the file can be written, it is written at the end
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning("Profiler: cannot write trace file '%s'", DBG(filename));
+        return false;
+    }
+    file.close();
+
+    ProfilerState &s = state();
+    {
+        QMutexLocker lock(&s.m_lock);
+        s.m_trace_file = filename;
+        s.m_trace.clear();
+    }
+    qDebug("Profiler: tracing into '%s'", DBG(filename));
+    setEnabled(true);
+    return true;
+}
+
+//***************************************************************************
+void Kwave::Profiler::stopTrace()
+{
+    ProfilerState &s = state();
+    QString filename;
+    QVector<TraceEvent> trace;
+    {
+        QMutexLocker lock(&s.m_lock);
+        if (s.m_trace_file.isEmpty()) return;
+        filename = s.m_trace_file;
+        trace    = s.m_trace;
+        s.m_trace_file.clear();
+        s.m_trace.clear();
+    }
+
+    // convert into the Chrome trace event format
+    QJsonArray events;
+    for (const TraceEvent &ev : std::as_const(trace)) {
+        QJsonObject event;
+        QJsonObject args;
+        event[_("name")] = _(ev.name);
+        event[_("pid")]  = 1;
+        event[_("tid")]  = ev.thread;
+        event[_("ts")]   = static_cast<double>(ev.start);
+        if (ev.counter) {
+            event[_("ph")]   = _("C");
+            args[_("value")] = static_cast<double>(ev.value);
+        } else {
+            event[_("ph")]   = _("X");
+            event[_("cat")]  = _("kwave");
+            event[_("dur")]  = static_cast<double>(ev.value);
+            if (!ev.detail.isEmpty()) args[_("detail")] = ev.detail;
+        }
+        if (!args.isEmpty()) event[_("args")] = args;
+        events.append(event);
+    }
+    QJsonObject root;
+    root[_("traceEvents")]     = events;
+    root[_("displayTimeUnit")] = _("ms");
+
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+        (file.write(QJsonDocument(root).toJson(QJsonDocument::Compact)) < 0))
+    {
+        qWarning("Profiler: writing trace file '%s' failed", DBG(filename));
+        return;
+    }
+    qDebug("Profiler: wrote %lld events into '%s'",
+           static_cast<long long>(trace.count()), DBG(filename));
+}
+
+//***************************************************************************
+qint64 Kwave::Profiler::now()
+{
+    return state().m_clock.nsecsElapsed() / 1000;
+}
+
+//***************************************************************************
+void Kwave::Profiler::addTime(const char *name, const QString &detail,
+                              qint64 start, qint64 duration)
+{
+    ProfilerState &s = state();
+    const QString key = (detail.isEmpty()) ?
+        _(name) : (_(name) + _(": ") + detail);
+
+    QMutexLocker lock(&s.m_lock);
+    Timing &timing = s.m_timings[key];
+    timing.calls++;
+    timing.total_us += duration;
+    if (duration > timing.max_us) timing.max_us = duration;
+
+    if (!s.m_trace_file.isEmpty() && (s.m_trace.count() < MAX_TRACE_EVENTS))
+        s.m_trace.append({name, detail, s.threadIndex(), start, duration,
+                          false});
+}
+
+//***************************************************************************
+void Kwave::Profiler::addCount(const char *name, qint64 value)
+{
+    ProfilerState &s = state();
+    const qint64 t = now();
+
+    QMutexLocker lock(&s.m_lock);
+    qint64 &counter = s.m_counters[_(name)];
+    counter += value;
+
+    if (!s.m_trace_file.isEmpty() && (s.m_trace.count() < MAX_TRACE_EVENTS))
+        s.m_trace.append({name, QString(), s.threadIndex(), t, counter,
+                          true});
+}
+
+//***************************************************************************
+QMap<QString, Kwave::Profiler::Timing> Kwave::Profiler::timings()
+{
+    ProfilerState &s = state();
+    QMutexLocker lock(&s.m_lock);
+
+    QMap<QString, Timing> result;
+    for (auto it = s.m_timings.constBegin();
+         it != s.m_timings.constEnd(); ++it)
+        result.insert(it.key(), it.value());
+    return result;
+}
+
+//***************************************************************************
+QMap<QString, qint64> Kwave::Profiler::counters()
+{
+    QMap<QString, qint64> result;
+    {
+        ProfilerState &s = state();
+        QMutexLocker lock(&s.m_lock);
+        for (auto it = s.m_counters.constBegin();
+             it != s.m_counters.constEnd(); ++it)
+            result.insert(it.key(), it.value());
+    }
+
+    // the sample pool always counts its allocations
+    const Kwave::SamplePool::Statistics pool =
+        Kwave::SamplePool::statistics();
+    result.insert(_("sample pool: heap allocations"),
+                  static_cast<qint64>(pool.allocations));
+    result.insert(_("sample pool: recycled blocks"),
+                  static_cast<qint64>(pool.recycled));
+    result.insert(_("sample pool: cached bytes"),
+                  static_cast<qint64>(pool.cached_bytes));
+    return result;
+}
+
+//***************************************************************************
+//***************************************************************************
@@ -0,0 +1,169 @@
+/***************************************************************************
+             Profiler.h  -  lightweight timing and counting of operations
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "config.h"
+#include "libkwave_export.h"
+
+#include <QtGlobal>
+#include <QAtomicInt>
+#include <QMap>
+#include <QString>
+
+namespace Kwave
+{
+
+    /**
+     * Collects the time spent in marked parts of the code and counters for
+     * processed bytes, samples and allocations. Everything is compiled in
+     * but costs only one atomic load per measuring point while disabled.
+     *
+     * The results can be inspected at runtime or written as a trace file
+     * in the Chrome trace event format, which can be loaded into
+     * chrome://tracing or Perfetto.
+     *
+     * @see Kwave::ProfileScope
+     */
+    class LIBKWAVE_EXPORT Profiler
+    {
+    public:
+
+        /** accumulated timing of one kind of operation */
+        typedef struct {
+            quint64 calls;    /**< number of calls                  */
+            qint64  total_us; /**< sum of all durations [us]        */
+            qint64  max_us;   /**< longest duration [us]            */
+        } Timing;
+
+        /** returns true if profiling is enabled */
+        static inline bool isEnabled() {
+            return (m_enabled.loadRelaxed() != 0);
+        }
+
+        /**
+         * Enables or disables profiling, the collected data is kept
+         * @param enable if true, start collecting data
+         */
+        static void setEnabled(bool enable);
+
+        /** discards all timings and counters */
+        static void reset();
+
+        /**
+         * Enables profiling and records all events for a trace file,
+         * which is written by stopTrace() or on shutdown
+         * @param filename name of the trace file
+         * @return true if the file could be created
+         */
+        static bool startTrace(const QString &filename);
+
+        /** writes the trace file and stops recording events */
+        static void stopTrace();
+
+        /** returns the time since the start of the application [us] */
+        static qint64 now();
+
+        /**
+         * Adds the duration of an operation, used by ProfileScope
+         * @param name name of the operation, must be a static string
+         * @param detail additional information, e.g. a plugin name
+         * @param start start time, as returned by now() [us]
+         * @param duration duration [us]
+         */
+        static void addTime(const char *name, const QString &detail,
+                            qint64 start, qint64 duration);
+
+        /**
+         * Adds a value to a counter, e.g. processed bytes or samples
+         * @param name name of the counter, must be a static string
+         * @param value the value to add
+         */
+        static inline void count(const char *name, qint64 value) {
+            if (isEnabled()) addCount(name, value);
+        }
+
+        /** returns the timings, with the name and detail as key */
+        static QMap<QString, Timing> timings();
+
+        /**
+         * Returns all counters, including the allocation statistics
+         * of the sample pool
+         */
+        static QMap<QString, qint64> counters();
+
+    private:
+
+        /** @see count(), only called if enabled */
+        static void addCount(const char *name, qint64 value);
+
+        /** non-zero if profiling is enabled */
+        static QAtomicInt m_enabled;
+
+    };
+
+    /**
+     * Measures the time from its construction until it goes out of scope,
+     * if profiling is enabled.
+     */
+    class LIBKWAVE_EXPORT ProfileScope
+    {
+    public:
+
+        /**
+         * Constructor, starts the measurement
+         * @param name name of the operation, must be a static string
+         * @param detail additional information, e.g. a plugin name
+         */
+        explicit ProfileScope(const char *name,
+                              const QString &detail = QString())
+            :m_name(name), m_detail(), m_start(-1)
+        {
+            if (!Kwave::Profiler::isEnabled()) return;
+            m_detail = detail;
+            m_start  = Kwave::Profiler::now();
+        }
+
+        /** Destructor, ends the measurement */
+        ~ProfileScope()
+        {
+            if (m_start < 0) return;
+            Kwave::Profiler::addTime(m_name, m_detail, m_start,
+                                     Kwave::Profiler::now() - m_start);
+        }
+
+    private:
+
+        Q_DISABLE_COPY(ProfileScope)
+
+        /** name of the operation */
+        const char *m_name;
+
+        /** additional information */
+        QString m_detail;
+
+        /** start time [us] or -1 if disabled */
+        qint64 m_start;
+
+    };
+}
+
+#endif /* PROFILER_H */
+
+//***************************************************************************
+//***************************************************************************
@@ -0,0 +1,158 @@
+/***************************************************************************
+          ReadAhead.cpp  -  reads blocks of all tracks ahead of an encoder
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <QMutexLocker>
+
+#include "libkwave/MultiTrackReader.h"
+#include "libkwave/ReadAhead.h"
+#include "libkwave/SampleReader.h"
+#include "libkwave/TaskPool.h"
+#include "libkwave/Utils.h"
+
+//***************************************************************************
+Kwave::ReadAhead::ReadAhead(Kwave::MultiTrackReader &src,
+                            sample_index_t length,
+                            unsigned int block_size,
+                            unsigned int depth)
+    :m_src(src), m_rest(length), m_block_size(qMax(block_size, 1U)),
+     m_depth(qMax(depth, 1U)), m_queue(), m_lock(), m_cond(),
+     m_reading(false), m_scheduled(false), m_stop(!src.tracks()),
+     m_task()
+{
+    QMutexLocker lock(&m_lock);
+    schedule();
+}
+
+//***************************************************************************
+Kwave::ReadAhead::~ReadAhead()
+{
+    {
+        QMutexLocker lock(&m_lock);
+        m_stop = true;
+    }
+    m_task.waitForFinished();
+}
+
+//***************************************************************************
+unsigned int Kwave::ReadAhead::readBlock(Kwave::ReadAhead::Block &block)
+{
+    const unsigned int tracks = m_src.tracks();
+    const unsigned int len = (m_rest < m_block_size) ?
+        Kwave::toUint(m_rest) : m_block_size;
+
+    block.resize(Kwave::toInt(tracks));
+    for (unsigned int track = 0; track < tracks; track++) {
+        Kwave::SampleArray &buffer = block[Kwave::toInt(track)];
+        if (!buffer.resize(len)) return 0;
+
+        Kwave::SampleReader *reader = m_src[track];
+        unsigned int pos = 0;
+        if (reader && !reader->eof())
+            pos = reader->read(buffer, 0, len);
+        while (pos < len) buffer[pos++] = 0;
+    }
+
+    return len;
+}
+
+//***************************************************************************
+void Kwave::ReadAhead::produce()
+{
+    QMutexLocker lock(&m_lock);
+    while (!m_stop && m_rest && !m_reading && !m_src.isCanceled() &&
+           (Kwave::toUint(m_queue.count()) < m_depth))
+    {
+        m_reading = true;
+        lock.unlock();
+
+        Kwave::ReadAhead::Block block;
+        const unsigned int len = readBlock(block);
+
+        lock.relock();
+        m_reading = false;
+        if (len) {
+            m_queue.enqueue(block);
+            m_rest -= len;
+        } else {
+            m_stop = true; // out of memory
+        }
+        m_cond.wakeAll();
+    }
+    m_scheduled = false;
+}
+
+//***************************************************************************
+void Kwave::ReadAhead::schedule()
+{
+    if (m_scheduled || m_stop || !m_rest) return;
+    if (Kwave::toUint(m_queue.count()) >= m_depth) return;
+
+    m_scheduled = true;
+    m_task = Kwave::TaskPool::run(Kwave::TaskPool::Background,
+                                  &Kwave::ReadAhead::produce, this);
+}
+
+//***************************************************************************
+unsigned int Kwave::ReadAhead::read(Kwave::ReadAhead::Block &block)
+{
+    QMutexLocker lock(&m_lock);
+
+    // blocks that have been read ahead are useless after a cancel
+    if (m_src.isCanceled()) {
+        block.clear();
+        return 0;
+    }
+
+    while (m_queue.isEmpty()) {
+        if (m_stop || !m_rest || m_src.isCanceled()) {
+            block.clear();
+            return 0;
+        }
+
+        // wait for the block that is currently being read
+        if (m_reading) {
+            m_cond.wait(&m_lock);
+            continue;
+        }
+
+        // nothing prepared, read it here instead of waiting until
+        // a worker thread becomes available
+        m_reading = true;
+        lock.unlock();
+        const unsigned int len = readBlock(block);
+        lock.relock();
+        m_reading = false;
+        m_cond.wakeAll();
+        if (!len) {
+            m_stop = true; // out of memory
+            block.clear();
+            return 0;
+        }
+        m_rest -= len;
+        schedule();
+        return len;
+    }
+
+    block = m_queue.dequeue();
+    schedule();
+    return Kwave::toUint(block.first().size());
+}
+
+//***************************************************************************
+//***************************************************************************
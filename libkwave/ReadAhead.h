@@ -0,0 +1,137 @@
+/***************************************************************************
+            ReadAhead.h  -  reads blocks of all tracks ahead of an encoder
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef READ_AHEAD_H
+#define READ_AHEAD_H
+
+#include "config.h"
+#include "libkwave_export.h"
+
+#include <QtGlobal>
+#include <QFuture>
+#include <QMutex>
+#include <QQueue>
+#include <QVector>
+#include <QWaitCondition>
+
+#include "libkwave/Sample.h"
+#include "libkwave/SampleArray.h"
+
+namespace Kwave
+{
+
+    class MultiTrackReader;
+
+    /**
+     * Reads blocks of samples of all tracks of a MultiTrackReader in
+     * the task pool, while the caller (usually an encoder) is busy with
+     * the previous blocks. Up to a given number of blocks are kept
+     * ready in a queue, so that reading the stripes overlaps with the
+     * compression and the output to the file.
+     *
+     * If no block is ready and nobody is reading, the caller reads the
+     * next block by itself instead of waiting for a free worker thread.
+     * The MultiTrackReader must not be used otherwise while this object
+     * exists.
+     */
+    class LIBKWAVE_EXPORT ReadAhead
+    {
+    public:
+
+        /** one block of samples, one array per track */
+        typedef QVector<Kwave::SampleArray> Block;
+
+        /**
+         * Constructor
+         * @param src the source of the samples
+         * @param length number of samples per track, the tracks are
+         *               padded with zeroes if they are shorter
+         * @param block_size number of samples per track and block
+         * @param depth maximum number of blocks that are read ahead
+         */
+        ReadAhead(Kwave::MultiTrackReader &src, sample_index_t length,
+                  unsigned int block_size, unsigned int depth = 4);
+
+        /** Destructor, waits until the current block has been read */
+        virtual ~ReadAhead();
+
+        /**
+         * Takes the next block, waits if it is currently being read
+         * @param block receives the block, all arrays have the same size
+         * @return number of samples per track, zero at the end, if
+         *         the source has been canceled or out of memory
+         */
+        unsigned int read(Kwave::ReadAhead::Block &block);
+
+    private:
+
+        /**
+         * Reads the next block from the source, must only be called by
+         * the one who has set m_reading
+         * @param block receives the samples
+         * @return number of samples per track, zero if out of memory
+         */
+        unsigned int readBlock(Kwave::ReadAhead::Block &block);
+
+        /** fills the queue, runs in a worker thread */
+        void produce();
+
+        /** starts produce() if necessary, m_lock must be held */
+        void schedule();
+
+    private:
+
+        /** the source of the samples */
+        Kwave::MultiTrackReader &m_src;
+
+        /** number of samples per track that have not been read yet */
+        sample_index_t m_rest;
+
+        /** number of samples per track and block */
+        unsigned int m_block_size;
+
+        /** maximum number of blocks in the queue */
+        unsigned int m_depth;
+
+        /** blocks that have been read ahead */
+        QQueue<Kwave::ReadAhead::Block> m_queue;
+
+        /** protects all members except m_src */
+        QMutex m_lock;
+
+        /** signaled when a block has been read */
+        QWaitCondition m_cond;
+
+        /** true while a block is being read from the source */
+        bool m_reading;
+
+        /** true while produce() is running or queued */
+        bool m_scheduled;
+
+        /** true if reading has been stopped */
+        bool m_stop;
+
+        /** the last started call of produce() */
+        QFuture<void> m_task;
+
+    };
+}
+
+#endif /* READ_AHEAD_H */
+
+//***************************************************************************
+//***************************************************************************
@@ -0,0 +1,195 @@
+/***************************************************************************
+               STFT.cpp  -  short time fourier transform
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <string.h>
+
+#include <fftw3.h>
+
+#include "libkwave/GlobalLock.h"
+#include "libkwave/STFT.h"
+#include "libkwave/Utils.h"
+
+//***************************************************************************
+Kwave::STFT::STFT(unsigned int fft_points, Kwave::window_function_t window,
+                  unsigned int hop, unsigned int batch)
+    :m_points(fft_points),
+     m_hop((hop) ? hop : qMax(1U, fft_points / 2)),
+     m_batch(qMax(1U, batch)),
+     m_window(),
+     m_time(nullptr), m_freq(nullptr),
+     m_plan_forward(nullptr), m_plan_inverse(nullptr)
+{
+    Q_ASSERT(fft_points >= 2);
+    if (fft_points < 2) return;
+
+    Kwave::WindowFunction func(window);
+    m_window = func.points(m_points);
+    Q_ASSERT(m_window.count() == Kwave::toInt(m_points));
+    if (m_window.count() != Kwave::toInt(m_points))
+        m_window.fill(1.0, Kwave::toInt(m_points));
+
+    m_time = fftw_alloc_real(size_t(m_points) * m_batch);
+    m_freq = reinterpret_cast<Complex *>(
+        fftw_alloc_complex(size_t(bins()) * m_batch));
+    Q_ASSERT(m_time && m_freq);
+    if (!m_time || !m_freq) return;
+
+    // one plan for each direction, each for a whole batch of frames
+    const int n    = Kwave::toInt(m_points);
+    const int dist = Kwave::toInt(bins());
+    fftw_complex *freq = reinterpret_cast<fftw_complex *>(m_freq);
+    {
+        Kwave::GlobalLock _lock; // libfftw is not threadsafe!
+        m_plan_forward = fftw_plan_many_dft_r2c(1, &n, Kwave::toInt(m_batch),
+            m_time, nullptr, 1, n,
+            freq,   nullptr, 1, dist,
+            FFTW_ESTIMATE);
+        m_plan_inverse = fftw_plan_many_dft_c2r(1, &n, Kwave::toInt(m_batch),
+            freq,   nullptr, 1, dist,
+            m_time, nullptr, 1, n,
+            FFTW_ESTIMATE);
+    }
+    Q_ASSERT(m_plan_forward);
+    Q_ASSERT(m_plan_inverse);
+}
+
+//***************************************************************************
+Kwave::STFT::~STFT()
+{
+    if (m_plan_forward || m_plan_inverse) {
+        Kwave::GlobalLock _lock; // libfftw is not threadsafe!
+        if (m_plan_forward) fftw_destroy_plan(m_plan_forward);
+        if (m_plan_inverse) fftw_destroy_plan(m_plan_inverse);
+    }
+    m_plan_forward = nullptr;
+    m_plan_inverse = nullptr;
+
+    if (m_time) fftw_free(m_time);
+    if (m_freq) fftw_free(m_freq);
+    m_time = nullptr;
+    m_freq = nullptr;
+}
+
+//***************************************************************************
+bool Kwave::STFT::isValid() const
+{
+    return (m_plan_forward && m_plan_inverse);
+}
+
+//***************************************************************************
+quint64 Kwave::STFT::frames(quint64 length) const
+{
+    if (!length) return 0;
+    if (length <= m_points) return 1;
+    return 1 + ((length - m_points + m_hop - 1) / m_hop);
+}
+
+//***************************************************************************
+quint64 Kwave::STFT::samples(quint64 frames) const
+{
+    return (frames) ? (((frames - 1) * m_hop) + m_points) : 0;
+}
+
+//***************************************************************************
+bool Kwave::STFT::forward(const double *input, unsigned int frames,
+                          Complex *output)
+{
+    Q_ASSERT(input);
+    Q_ASSERT(output);
+    if (!isValid() || !input || !output) return false;
+
+    const unsigned int points = m_points;
+    const unsigned int bins   = this->bins();
+    const double *w = m_window.constData();
+
+    for (unsigned int done = 0; done < frames; ) {
+        const unsigned int count = qMin(m_batch, frames - done);
+
+        // apply the window function, unused frames of the batch are zero
+        for (unsigned int f = 0; f < count; ++f) {
+            const double *src = input + (quint64(done + f) * m_hop);
+            double *dst = m_time + (size_t(f) * points);
+            for (unsigned int i = 0; i < points; ++i)
+                dst[i] = src[i] * w[i];
+        }
+        if (count < m_batch)
+            memset(m_time + (size_t(count) * points), 0x00,
+                   sizeof(double) * points * (m_batch - count));
+
+        fftw_execute(m_plan_forward);
+
+        memcpy(output + (size_t(done) * bins), m_freq,
+               sizeof(Complex) * bins * count);
+        done += count;
+    }
+    return true;
+}
+
+//***************************************************************************
+bool Kwave::STFT::inverse(const Complex *input, unsigned int frames,
+                          double *output)
+{
+    Q_ASSERT(input);
+    Q_ASSERT(output);
+    if (!isValid() || !input || !output) return false;
+
+    const unsigned int points = m_points;
+    const unsigned int bins   = this->bins();
+    const double *w = m_window.constData();
+
+    // the inverse FFT is not normalized and each sample is covered
+    // by points / hop frames, weighted with the square of the window
+    const double power = windowPower();
+    if (power <= 0.0) return false;
+    const double scale = static_cast<double>(m_hop) /
+                         (static_cast<double>(points) * power);
+
+    for (unsigned int done = 0; done < frames; ) {
+        const unsigned int count = qMin(m_batch, frames - done);
+
+        memcpy(m_freq, input + (size_t(done) * bins),
+               sizeof(Complex) * bins * count);
+        if (count < m_batch)
+            memset(static_cast<void *>(m_freq + (size_t(count) * bins)),
+                   0x00, sizeof(Complex) * bins * (m_batch - count));
+
+        fftw_execute(m_plan_inverse);
+
+        // overlap and add, with the window function
+        for (unsigned int f = 0; f < count; ++f) {
+            const double *src = m_time + (size_t(f) * points);
+            double *dst = output + (quint64(done + f) * m_hop);
+            for (unsigned int i = 0; i < points; ++i)
+                dst[i] += src[i] * w[i] * scale;
+        }
+        done += count;
+    }
+    return true;
+}
+
+//***************************************************************************
+double Kwave::STFT::windowPower() const
+{
+    double sum = 0.0;
+    for (const double w : m_window) sum += w * w;
+    return sum;
+}
+
+//***************************************************************************
+//***************************************************************************
@@ -0,0 +1,165 @@
+/***************************************************************************
+                 STFT.h  -  short time fourier transform
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef STFT_H
+#define STFT_H
+
+#include "config.h"
+#include "libkwave_export.h"
+
+#include <complex>
+
+#include <QtGlobal>
+#include <QVector>
+
+#include "libkwave/WindowFunction.h"
+
+/** opaque plan of libfftw, see fftw3.h */
+struct fftw_plan_s;
+
+namespace Kwave
+{
+
+    /**
+     * Short time fourier transform and its inverse, with a window
+     * function and overlapping frames. Frame number i starts at sample
+     * i * hop of the input and has fft_points samples, its spectrum
+     * has fft_points / 2 + 1 bins. The frames are transformed in
+     * batches, with one FFTW plan for a whole batch.
+     *
+     * An instance is not threadsafe, for working in several threads
+     * each thread uses its own instance and with it its own plans.
+     * Creating and destroying the plans is serialized through the
+     * global lock, as libfftw requires.
+     */
+    class LIBKWAVE_EXPORT STFT
+    {
+    public:
+
+        /** complex value of one bin of a spectrum */
+        typedef std::complex<double> Complex;
+
+        /**
+         * Constructor
+         * @param fft_points number of points of the FFT [2...]
+         * @param window the window function
+         * @param hop distance between the start of two frames,
+         *            zero means fft_points / 2
+         * @param batch maximum number of frames per FFT call
+         */
+        STFT(unsigned int fft_points, Kwave::window_function_t window,
+             unsigned int hop = 0, unsigned int batch = 32);
+
+        /** Destructor */
+        virtual ~STFT();
+
+        /** returns true if the plans and buffers have been created */
+        bool isValid() const;
+
+        /** returns the number of FFT points */
+        inline unsigned int fftPoints() const { return m_points; }
+
+        /** returns the number of bins of a spectrum, fft_points / 2 + 1 */
+        inline unsigned int bins() const { return (m_points / 2) + 1; }
+
+        /** returns the distance between two frames [samples] */
+        inline unsigned int hop() const { return m_hop; }
+
+        /** returns the coefficients of the window function */
+        inline const QVector<double> &window() const { return m_window; }
+
+        /**
+         * Returns the number of frames that are needed to cover a number
+         * of samples, the last frame may be incomplete
+         * @param length number of samples
+         */
+        quint64 frames(quint64 length) const;
+
+        /**
+         * Returns the number of samples that are needed for a number of
+         * frames, (frames - 1) * hop + fft_points
+         * @param frames number of frames
+         */
+        quint64 samples(quint64 frames) const;
+
+        /**
+         * Computes the spectra of a number of frames
+         * @param input samples, at least samples(frames)
+         * @param frames number of frames
+         * @param output receives frames * bins() values
+         * @return true if successful
+         */
+        bool forward(const double *input, unsigned int frames,
+                     Complex *output);
+
+        /**
+         * Transforms a number of spectra back into the time domain and
+         * adds them to the output, with the window function and overlap.
+         * The result is scaled so that forward() followed by inverse()
+         * reproduces the input where the squares of the window add up to
+         * a constant, e.g. without window and with hop = fft_points.
+         * @param input frames * bins() values
+         * @param frames number of frames
+         * @param output samples(frames) samples, the result is added
+         * @return true if successful
+         */
+        bool inverse(const Complex *input, unsigned int frames,
+                     double *output);
+
+        /** returns the sum of the squares of the window coefficients */
+        double windowPower() const;
+
+        /** returns the power of a bin, the squared magnitude */
+        static inline double power(const Complex &c) {
+            return (c.real() * c.real()) + (c.imag() * c.imag());
+        }
+
+    private:
+
+        Q_DISABLE_COPY(STFT)
+
+        /** number of FFT points */
+        unsigned int m_points;
+
+        /** distance between two frames */
+        unsigned int m_hop;
+
+        /** number of frames per batch */
+        unsigned int m_batch;
+
+        /** coefficients of the window function */
+        QVector<double> m_window;
+
+        /** time domain buffer of a batch, from fftw_malloc */
+        double *m_time;
+
+        /** frequency domain buffer of a batch, from fftw_malloc */
+        Complex *m_freq;
+
+        /** plan for the forward transform of a batch */
+        fftw_plan_s *m_plan_forward;
+
+        /** plan for the inverse transform of a batch */
+        fftw_plan_s *m_plan_inverse;
+
+    };
+}
+
+#endif /* STFT_H */
+
+//***************************************************************************
+//***************************************************************************
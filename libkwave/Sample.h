@@ -84,6 +84,45 @@ static inline sample_t double2sample(const double f) {
         f * static_cast<double>(1 << (SAMPLE_BITS - 1)));
 }
 
+/**
+ * Converts a block of samples to floats, in the range [-1.0 ... +1.0].
+ * Works on plain arrays, so that the compiler can vectorize the loop.
+ * @param src pointer to the first sample
+ * @param dst pointer to the first float
+ * @param count number of samples to convert
+ */
+static inline void samples2floats(const sample_t *src,
+                                  float *dst,
+                                  unsigned int count)
+{
+    const float scale = 1.0f / static_cast<float>(1 << (SAMPLE_BITS - 1));
+    for (unsigned int i = 0; i < count; ++i)
+        dst[i] = static_cast<float>(src[i]) * scale;
+}
+
+/**
+ * Converts a block of floats back to samples, with clipping to the
+ * range [SAMPLE_MIN ... SAMPLE_MAX]. Intermediate results of floating
+ * point processing may exceed the range of sample_t, they are only
+ * limited here, at the end of the processing chain.
+ * @param src pointer to the first float
+ * @param dst pointer to the first sample
+ * @param count number of samples to convert
+ */
+static inline void floats2samples(const float *src,
+                                  sample_t *dst,
+                                  unsigned int count)
+{
+    const float scale = static_cast<float>(1 << (SAMPLE_BITS - 1));
+    const float s_min = static_cast<float>(SAMPLE_MIN);
+    const float s_max = static_cast<float>(SAMPLE_MAX);
+    for (unsigned int i = 0; i < count; ++i) {
+        float f = src[i] * scale;
+        f = (f < s_min) ? s_min : ((f > s_max) ? s_max : f);
+        dst[i] = static_cast<sample_t>(f);
+    }
+}
+
 #endif /* SAMPLE_H */
 
 //***************************************************************************
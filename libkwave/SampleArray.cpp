@@ -20,7 +20,9 @@
 #include <new>
 #include <stdlib.h>
 
+#include "libkwave/Profiler.h"
 #include "libkwave/SampleArray.h"
+#include "libkwave/SamplePool.h"
 #include "libkwave/memcpy.h"
 
 //***************************************************************************
@@ -84,7 +86,7 @@ const sample_t & Kwave::SampleArray::operator [] (unsigned int index) const
 bool Kwave::SampleArray::resize(unsigned int size)
 {
     if (!m_storage) return false;
-    if (size == m_storage->m_size) return true;
+    if (size == this->size()) return true; // without detaching
 
     m_storage->resize(size);
     if (size && (m_storage->m_size > size)) {
@@ -95,31 +97,66 @@ bool Kwave::SampleArray::resize(unsigned int size)
     return (m_storage->m_size == size);
 }
 
+//***************************************************************************
+bool Kwave::SampleArray::reuse(unsigned int size)
+{
+    if (!m_storage) return false;
+
+    // if someone else still holds our storage, do not detach (which would
+    // copy the old content) but start over with a fresh storage
+    if (m_storage.constData()->ref.loadRelaxed() > 1) {
+        SampleStorage *storage = new(std::nothrow) SampleStorage;
+        if (!storage) return false;
+        m_storage = storage;
+    }
+
+    // blocks of the streaming modules are recycled through the pool,
+    // a size of zero releases the memory, like resize(0)
+    if (size == this->size()) return true; // without detaching
+    m_storage->resize(size, true);
+    return (m_storage->m_size == size);
+}
+
 //***************************************************************************
 unsigned int Kwave::SampleArray::size() const
 {
     return (m_storage) ? m_storage->m_size : 0;
 }
 
+//***************************************************************************
+bool Kwave::SampleArray::isShared() const
+{
+    return (m_storage && (m_storage.constData()->ref.loadRelaxed() > 1));
+}
+
 //***************************************************************************
 Kwave::SampleArray::SampleStorage::SampleStorage()
     :QSharedData()
 {
-    m_size     = 0;
-    m_data     = nullptr;
+    m_size          = 0;
+    m_pool_capacity = 0;
+    m_data          = nullptr;
 }
 
 //***************************************************************************
 Kwave::SampleArray::SampleStorage::SampleStorage(const SampleStorage &other)
     :QSharedData(other)
 {
-    m_size     = 0;
-    m_data     = nullptr;
+    m_size          = 0;
+    m_pool_capacity = 0;
+    m_data          = nullptr;
 
     if (other.m_size) {
-        m_data = static_cast<sample_t *>(
-            ::malloc(other.m_size * sizeof(sample_t))
-        );
+        Kwave::Profiler::count("sample array copies", 1);
+        if (other.m_pool_capacity) {
+            m_data = Kwave::SamplePool::allocate(other.m_size,
+                                                 m_pool_capacity);
+        } else {
+            Kwave::Profiler::count("sample heap allocations", 1);
+            m_data = static_cast<sample_t *>(
+                ::malloc(other.m_size * sizeof(sample_t))
+            );
+        }
         if (m_data) {
             m_size = other.m_size;
             MEMCPY(m_data, other.m_data, m_size * sizeof(sample_t));
@@ -130,38 +167,86 @@ Kwave::SampleArray::SampleStorage::SampleStorage(const SampleStorage &other)
 //***************************************************************************
 Kwave::SampleArray::SampleStorage::~SampleStorage()
 {
-    if (m_data) ::free(m_data);
+    release();
 }
 
 //***************************************************************************
-void Kwave::SampleArray::SampleStorage::resize(unsigned int size)
+void Kwave::SampleArray::SampleStorage::release()
 {
-    if (size) {
+    sample_t *t = m_data;
+    m_data = nullptr;
+    m_size = 0;
+    if (m_pool_capacity)
+        Kwave::SamplePool::release(t, m_pool_capacity);
+    else if (t)
+        ::free(t);
+    m_pool_capacity = 0;
+}
+
+//***************************************************************************
+void Kwave::SampleArray::SampleStorage::resize(unsigned int size,
+                                               bool pooled)
+{
+    if (!size) {
+        // resize to zero == delete/free memory
+        release();
+        return;
+    }
+
+    const unsigned int old_size = m_size;
+    if (m_pool_capacity) pooled = true;
+    if (m_pool_capacity && (size <= m_pool_capacity)) {
+        // fits into the current block of the pool
+        m_size = size;
+    } else if (pooled && (size <= Kwave::SamplePool::maxPooledSize())) {
+        // move to a (larger) block from the pool, keep existing data
+        unsigned int capacity = 0;
+        sample_t *new_data = Kwave::SamplePool::allocate(size, capacity);
+        if (!new_data) {
+            qWarning("Kwave::SampleArray::SampleStorage::resize(%u): OOM! "
+                     "- keeping old size %u", size, m_size);
+            return;
+        }
+        if (m_data)
+            MEMCPY(new_data, m_data, qMin(size, m_size) * sizeof(sample_t));
+        release();
+        m_data          = new_data;
+        m_pool_capacity = capacity;
+        m_size          = size;
+    } else if (m_pool_capacity) {
+        // too large for the pool: move from the pool to the heap
+        Kwave::Profiler::count("sample heap allocations", 1);
+        sample_t *new_data = static_cast<sample_t *>(
+            ::malloc(size * sizeof(sample_t)));
+        if (!new_data) {
+            qWarning("Kwave::SampleArray::SampleStorage::resize(%u): OOM! "
+                     "- keeping old size %u", size, m_size);
+            return;
+        }
+        MEMCPY(new_data, m_data, qMin(size, m_size) * sizeof(sample_t));
+        release();
+        m_data = new_data;
+        m_size = size;
+    } else {
         // resize using realloc, keep existing data
+        Kwave::Profiler::count("sample heap allocations", 1);
         sample_t *new_data = static_cast<sample_t *>(
             ::realloc(m_data, size * sizeof(sample_t)));
-        if (new_data) {
-            // successful
-            m_data = new_data;
-            if (size > m_size) {
-                // initialize the new data
-                unsigned int count = size - m_size;
-                sample_t *p = m_data + m_size;
-                while (count--)
-                    *(p++) = 0;
-            }
-            m_size = size;
-        } else {
+        if (!new_data) {
             qWarning("Kwave::SampleArray::SampleStorage::resize(%u): OOM! "
                      "- keeping old size %u", size, m_size);
+            return;
         }
-    } else {
-        // resize to zero == delete/free memory
-        Q_ASSERT(m_data);
-        sample_t *t = m_data;
-        m_data = nullptr;
-        m_size = 0;
-        ::free(t);
+        m_data = new_data;
+        m_size = size;
+    }
+
+    if (size > old_size) {
+        // initialize the new data
+        unsigned int count = size - old_size;
+        sample_t *p = m_data + old_size;
+        while (count--)
+            *(p++) = 0;
     }
 }
 
@@ -89,6 +89,23 @@ namespace Kwave
          */
         bool resize(unsigned int size);
 
+        /**
+         * Prepares the array for being completely overwritten with new
+         * data. If the storage is shared with another array, e.g. because
+         * a receiver of an emitted block still holds it, the storage is
+         * not copied but replaced with a fresh (recycled) one. Otherwise
+         * it is kept and only resized. The content is undefined afterwards.
+         * A size of zero releases the storage, like resize(0).
+         *
+         * Only storage that is prepared this way is taken from the
+         * Kwave::SamplePool, other arrays like the pages of a stripe use
+         * exactly the memory they need.
+         *
+         * @param size new number of samples
+         * @return true if succeeded, false if failed
+         */
+        bool reuse(unsigned int size);
+
         /**
          * Returns the number of samples.
          * @return samples [0...N]
@@ -102,6 +119,13 @@ namespace Kwave
          */
         inline bool isEmpty() const { return (size() == 0); }
 
+        /**
+         * Returns whether the storage is also used by another array,
+         * in that case the next write access makes a private copy.
+         * @return true if shared, false if not
+         */
+        bool isShared() const;
+
     private:
 
         class SampleStorage: public QSharedData {
@@ -119,13 +143,25 @@ namespace Kwave
             /**
              * Resizes the array
              * @param size new number of samples
+             * @param pooled if true, take the memory from the pool if
+             *               the size allows it, implied if the memory
+             *               already comes from the pool
              */
-            void resize(unsigned int size);
+            void resize(unsigned int size, bool pooled = false);
+
+            /** releases the sample data */
+            void release();
 
         public:
             /** size in samples */
             unsigned int m_size;
 
+            /**
+             * size of the allocated memory in samples if the memory is
+             * managed by Kwave::SamplePool, zero otherwise
+             */
+            unsigned int m_pool_capacity;
+
             /** pointer to the area with the samples (allocated) */
             sample_t *m_data;
         };
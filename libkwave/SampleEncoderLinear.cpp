@@ -17,12 +17,15 @@
 
 #include "config.h"
 
+#include <new>
+
 #include <QtGlobal>
 
 #include "libkwave/Sample.h"
 #include "libkwave/SampleEncoderLinear.h"
 #include "libkwave/SampleFormat.h"
 #include "libkwave/Utils.h"
+#include "libkwave/memcpy.h"
 
 //***************************************************************************
 static void encode_NULL(const sample_t *src, quint8 *dst, unsigned int count)
@@ -108,8 +111,12 @@ Kwave::SampleEncoderLinear::SampleEncoderLinear(
     Kwave::byte_order_t endianness
 )
     :SampleEncoder(),
+     m_bits_per_sample(bits_per_sample),
      m_bytes_per_sample((bits_per_sample + 7) >> 3),
-     m_encoder(encode_NULL)
+     m_encoder(encode_NULL),
+     m_dither(),
+     m_dither_channel(0),
+     m_dither_buffer()
 {
     // sanity checks: we support only signed/unsigned and big/little endian
     Q_ASSERT((sample_format == Kwave::SampleFormat::Signed) ||
@@ -164,6 +171,32 @@ Kwave::SampleEncoderLinear::SampleEncoderLinear(
 //***************************************************************************
 Kwave::SampleEncoderLinear::~SampleEncoderLinear()
 {
+    qDeleteAll(m_dither);
+    m_dither.clear();
+}
+
+//***************************************************************************
+void Kwave::SampleEncoderLinear::setDither(unsigned int channels,
+                                          Kwave::Dither::Mode mode,
+                                          Kwave::Dither::Shaping shaping)
+{
+    qDeleteAll(m_dither);
+    m_dither.clear();
+    m_dither_channel = 0;
+
+    for (unsigned int channel = 0; channel < channels; ++channel) {
+        Kwave::Dither *dither = new(std::nothrow)
+            Kwave::Dither(m_bits_per_sample, mode, shaping, channel);
+        Q_ASSERT(dither);
+        if (!dither || !dither->isActive()) {
+            // not needed or out of memory: plain truncation as before
+            delete dither;
+            qDeleteAll(m_dither);
+            m_dither.clear();
+            return;
+        }
+        m_dither.append(dither);
+    }
 }
 
 //***************************************************************************
@@ -180,6 +213,26 @@ void Kwave::SampleEncoderLinear::encode(const Kwave::SampleArray &samples,
     const sample_t *src = samples.constData();
     quint8 *dst = reinterpret_cast<quint8 *>(raw_data.data());
 
+    if (!m_dither.isEmpty() && count) {
+        // dither a copy, the samples belong to the caller
+        if ((m_dither_buffer.size() < count) && !m_dither_buffer.resize(count))
+            return;
+        sample_t *buf = m_dither_buffer.data();
+        MEMCPY(buf, src, count * sizeof(sample_t));
+
+        const unsigned int channels = Kwave::toUint(m_dither.count());
+        for (unsigned int channel = 0; channel < channels; ++channel) {
+            // position of the first sample of this channel in the buffer
+            const unsigned int first =
+                (channel + channels - m_dither_channel) % channels;
+            if (first >= count) continue;
+            m_dither[channel]->process(buf + first,
+                (count - first + channels - 1) / channels, channels);
+        }
+        m_dither_channel = (m_dither_channel + count) % channels;
+        src = buf;
+    }
+
     m_encoder(src, dst, count);
 }
 
@@ -22,8 +22,11 @@
 #include "libkwave_export.h"
 
 #include <QtGlobal>
+#include <QList>
 
 #include "libkwave/ByteOrder.h"
+#include "libkwave/Dither.h"
+#include "libkwave/SampleArray.h"
 #include "libkwave/SampleEncoder.h"
 #include "libkwave/SampleFormat.h"
 
@@ -59,14 +62,38 @@ namespace Kwave
         /** Returns the number of bytes per sample in raw (encoded) form */
         unsigned int rawBytesPerSample() override;
 
+        /**
+         * Enables dither for reducing the resolution to the number of
+         * bits of the raw data, with one independent dither per channel.
+         * The samples passed to encode() have to be interleaved, a frame
+         * may be split over several calls.
+         * @param channels number of interleaved channels
+         * @param mode type of the dither noise, None turns dither off
+         * @param shaping noise shaping filter
+         */
+        void setDither(unsigned int channels, Kwave::Dither::Mode mode,
+                       Kwave::Dither::Shaping shaping);
+
     private:
 
+        /** number of bits per raw sample */
+        unsigned int m_bits_per_sample;
+
         /** number of bytes per raw sample */
         unsigned int m_bytes_per_sample;
 
         /** optimized function used for encoding the given format */
         void (*m_encoder)(const sample_t *, quint8 *, unsigned int);
 
+        /** one dither per channel, empty if dither is off */
+        QList<Kwave::Dither *> m_dither;
+
+        /** channel of the next sample passed to encode() */
+        unsigned int m_dither_channel;
+
+        /** copy of the samples, for dithering */
+        Kwave::SampleArray m_dither_buffer;
+
     };
 }
 
@@ -0,0 +1,203 @@
+/*************************************************************************
+         SamplePool.cpp  -  pool for recycling sample buffers
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <new>
+#include <stdlib.h>
+
+#include <QAtomicInteger>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include "libkwave/SamplePool.h"
+
+/** log2 of the smallest block size in samples */
+#define POOL_MIN_SHIFT 8
+
+/** log2 of the largest block size in samples (512k, max stream block) */
+#define POOL_MAX_SHIFT 19
+
+/** number of size classes */
+#define POOL_CLASSES (POOL_MAX_SHIFT - POOL_MIN_SHIFT + 1)
+
+/** maximum number of free blocks per size class */
+#define POOL_MAX_FREE_BLOCKS 64
+
+/** upper limit of the memory held in the pool [bytes] */
+#define POOL_MAX_CACHED_BYTES (64ULL * 1024ULL * 1024ULL)
+
+namespace
+{
+    /** free list of one size class */
+    class SizeClass
+    {
+    public:
+        SizeClass() :m_lock(), m_count(0) { }
+
+        /** lock for m_free and m_count */
+        QMutex m_lock;
+
+        /** number of entries in m_free */
+        unsigned int m_count;
+
+        /** free blocks */
+        sample_t *m_free[POOL_MAX_FREE_BLOCKS];
+    };
+
+    /** internal state of the pool, allocated once and never destroyed */
+    class PoolState
+    {
+    public:
+        PoolState()
+            :m_classes(), m_allocations(0), m_recycled(0),
+             m_released(0), m_freed(0), m_cached_bytes(0)
+        {
+        }
+
+        /** one free list per size class */
+        SizeClass m_classes[POOL_CLASSES];
+
+        /** statistics: number of heap allocations */
+        QAtomicInteger<quint64> m_allocations;
+
+        /** statistics: number of recycled blocks */
+        QAtomicInteger<quint64> m_recycled;
+
+        /** statistics: number of released blocks */
+        QAtomicInteger<quint64> m_released;
+
+        /** statistics: number of blocks given back to the heap */
+        QAtomicInteger<quint64> m_freed;
+
+        /** number of bytes currently held in the free lists */
+        QAtomicInteger<quint64> m_cached_bytes;
+    };
+}
+
+//***************************************************************************
+static PoolState &pool()
+{
+    // intentionally leaked: sample arrays may be released during static
+    // destruction, after a static pool object would already be gone
+    static PoolState *state = new PoolState();
+    return *state;
+}
+
+//***************************************************************************
+static unsigned int sizeClass(unsigned int size)
+{
+    unsigned int shift = POOL_MIN_SHIFT;
+    while ((1U << shift) < size) shift++;
+    return shift - POOL_MIN_SHIFT;
+}
+
+//***************************************************************************
+unsigned int Kwave::SamplePool::maxPooledSize()
+{
+    return (1U << POOL_MAX_SHIFT);
+}
+
+//***************************************************************************
+sample_t *Kwave::SamplePool::allocate(unsigned int size,
+                                      unsigned int &capacity)
+{
+    Q_ASSERT(size <= maxPooledSize());
+    capacity = 0;
+    if (!size || (size > maxPooledSize())) return nullptr;
+
+    PoolState &state = pool();
+    const unsigned int cls = sizeClass(size);
+    const unsigned int block_size = (1U << (cls + POOL_MIN_SHIFT));
+
+    {
+        SizeClass &c = state.m_classes[cls];
+        QMutexLocker _lock(&c.m_lock);
+        if (c.m_count) {
+            sample_t *block = c.m_free[--c.m_count];
+            state.m_cached_bytes -= block_size * sizeof(sample_t);
+            state.m_recycled++;
+            capacity = block_size;
+            return block;
+        }
+    }
+
+    sample_t *block = static_cast<sample_t *>(
+        ::malloc(block_size * sizeof(sample_t)));
+    if (!block) return nullptr;
+    state.m_allocations++;
+    capacity = block_size;
+    return block;
+}
+
+//***************************************************************************
+void Kwave::SamplePool::release(sample_t *data, unsigned int capacity)
+{
+    if (!data) return;
+    PoolState &state = pool();
+    const unsigned int cls = sizeClass(capacity);
+    Q_ASSERT(capacity == (1U << (cls + POOL_MIN_SHIFT)));
+    state.m_released++;
+
+    const quint64 bytes = capacity * sizeof(sample_t);
+    if (state.m_cached_bytes.loadRelaxed() + bytes <= POOL_MAX_CACHED_BYTES) {
+        SizeClass &c = state.m_classes[cls];
+        QMutexLocker _lock(&c.m_lock);
+        if (c.m_count < POOL_MAX_FREE_BLOCKS) {
+            c.m_free[c.m_count++] = data;
+            state.m_cached_bytes += bytes;
+            return;
+        }
+    }
+
+    // pool is full -> give the block back to the heap
+    state.m_freed++;
+    ::free(data);
+}
+
+//***************************************************************************
+Kwave::SamplePool::Statistics Kwave::SamplePool::statistics()
+{
+    PoolState &state = pool();
+    Statistics stat;
+    stat.allocations  = state.m_allocations.loadRelaxed();
+    stat.recycled     = state.m_recycled.loadRelaxed();
+    stat.released     = state.m_released.loadRelaxed();
+    stat.freed        = state.m_freed.loadRelaxed();
+    stat.cached_bytes = state.m_cached_bytes.loadRelaxed();
+    return stat;
+}
+
+//***************************************************************************
+void Kwave::SamplePool::trim()
+{
+    PoolState &state = pool();
+    for (unsigned int cls = 0; cls < POOL_CLASSES; ++cls) {
+        SizeClass &c = state.m_classes[cls];
+        const quint64 bytes =
+            (1ULL << (cls + POOL_MIN_SHIFT)) * sizeof(sample_t);
+        QMutexLocker _lock(&c.m_lock);
+        while (c.m_count) {
+            ::free(c.m_free[--c.m_count]);
+            state.m_cached_bytes -= bytes;
+            state.m_freed++;
+        }
+    }
+}
+
+//***************************************************************************
+//***************************************************************************
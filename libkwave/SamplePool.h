@@ -0,0 +1,92 @@
+/*************************************************************************
+           SamplePool.h  -  pool for recycling sample buffers
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef SAMPLE_POOL_H
+#define SAMPLE_POOL_H
+
+#include "config.h"
+#include "libkwave_export.h"
+
+#include <QtGlobal>
+
+#include "libkwave/Sample.h"
+
+namespace Kwave
+{
+
+    /**
+     * Global pool for recycling the memory of small and medium sized
+     * blocks of samples, as they are used by the streaming modules.
+     * Blocks are managed in size classes with a power of two, each class
+     * keeps a limited number of free blocks. Memory can be allocated in
+     * one thread and released in any other thread.
+     *
+     * Blocks that are larger than maxPooledSize() are not handled by the
+     * pool, they have to be managed with malloc/realloc/free.
+     */
+    class LIBKWAVE_EXPORT SamplePool
+    {
+    public:
+
+        /** statistics about the usage of the pool */
+        typedef struct {
+            quint64 allocations; /**< number of real heap allocations     */
+            quint64 recycled;    /**< number of blocks taken from the pool */
+            quint64 released;    /**< number of blocks given back          */
+            quint64 freed;       /**< number of blocks returned to the heap */
+            quint64 cached_bytes;/**< bytes currently held in the pool     */
+        } Statistics;
+
+        /**
+         * Returns the maximum number of samples of a block that can be
+         * managed by the pool
+         */
+        static unsigned int maxPooledSize();
+
+        /**
+         * Allocates a block of samples, either by recycling a block from
+         * the pool or from the heap.
+         *
+         * @param size number of samples, must not exceed maxPooledSize()
+         * @param capacity receives the real size of the block in samples
+         * @return pointer to the samples or null if out of memory
+         */
+        static sample_t *allocate(unsigned int size, unsigned int &capacity);
+
+        /**
+         * Gives a block back into the pool. If the pool is full the
+         * block is returned to the heap.
+         *
+         * @param data pointer to the block, as returned by allocate()
+         * @param capacity size of the block in samples, as returned
+         *                 by allocate()
+         */
+        static void release(sample_t *data, unsigned int capacity);
+
+        /** Returns the current statistics of the pool */
+        static Statistics statistics();
+
+        /** Returns all cached blocks to the heap */
+        static void trim();
+
+    };
+}
+
+#endif /* SAMPLE_POOL_H */
+
+//***************************************************************************
+//***************************************************************************
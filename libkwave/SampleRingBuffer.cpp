@@ -0,0 +1,124 @@
+/*************************************************************************
+   SampleRingBuffer.cpp  -  fixed size ring buffer for sample_t
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <algorithm>
+
+#include "libkwave/SampleRingBuffer.h"
+#include "libkwave/Writer.h"
+#include "libkwave/memcpy.h"
+
+//***************************************************************************
+Kwave::SampleRingBuffer::SampleRingBuffer()
+    :m_buffer(), m_capacity(0), m_length(0), m_write_pos(0)
+{
+}
+
+//***************************************************************************
+Kwave::SampleRingBuffer::SampleRingBuffer(unsigned int capacity)
+    :m_buffer(), m_capacity(0), m_length(0), m_write_pos(0)
+{
+    setCapacity(capacity);
+}
+
+//***************************************************************************
+Kwave::SampleRingBuffer::~SampleRingBuffer()
+{
+}
+
+//***************************************************************************
+bool Kwave::SampleRingBuffer::setCapacity(unsigned int capacity)
+{
+    flush();
+    if (capacity == m_capacity) return true;
+
+    m_capacity = 0;
+    if (!m_buffer.resize(capacity)) {
+        qWarning("SampleRingBuffer::setCapacity(%u): out of memory",
+                 capacity);
+        m_buffer.resize(0);
+        return false;
+    }
+    m_capacity = capacity;
+    return true;
+}
+
+//***************************************************************************
+void Kwave::SampleRingBuffer::flush()
+{
+    m_length    = 0;
+    m_write_pos = 0;
+}
+
+//***************************************************************************
+void Kwave::SampleRingBuffer::put(const Kwave::SampleArray &samples)
+{
+    put(samples.constData(), samples.size());
+}
+
+//***************************************************************************
+void Kwave::SampleRingBuffer::put(const sample_t *samples, unsigned int count)
+{
+    if (!m_capacity || !count || !samples) return;
+    sample_t *dst = m_buffer.data();
+    Q_ASSERT(dst);
+    if (!dst) return;
+
+    if (count >= m_capacity) {
+        // the new data replaces the whole content
+        MEMCPY(dst, samples + (count - m_capacity),
+               m_capacity * sizeof(sample_t));
+        m_write_pos = 0;
+        m_length    = m_capacity;
+        return;
+    }
+
+    // copy up to the end of the storage, then wrap around
+    const unsigned int first = qMin(count, m_capacity - m_write_pos);
+    MEMCPY(dst + m_write_pos, samples, first * sizeof(sample_t));
+    if (first < count)
+        MEMCPY(dst, samples + first, (count - first) * sizeof(sample_t));
+
+    m_write_pos = (m_write_pos + count) % m_capacity;
+    m_length    = qMin(m_length + count, m_capacity);
+}
+
+//***************************************************************************
+bool Kwave::SampleRingBuffer::drainInto(Kwave::Writer &writer)
+{
+    if (!m_length) return true;
+
+    // flush pending single-sample writes, to keep the order
+    if (!writer.flush()) return false;
+
+    // as long as the buffer is not full, it never wrapped around and the
+    // oldest sample is at index zero. Otherwise rotate the content so that
+    // the oldest sample moves to the start of the storage.
+    if ((m_length == m_capacity) && m_write_pos) {
+        sample_t *p = m_buffer.data();
+        std::rotate(p, p + m_write_pos, p + m_capacity);
+    }
+
+    unsigned int count = m_length;
+    const bool ok = writer.write(m_buffer, count);
+    flush();
+    return ok;
+}
+
+//***************************************************************************
+//***************************************************************************
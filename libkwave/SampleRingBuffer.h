@@ -0,0 +1,128 @@
+/*************************************************************************
+     SampleRingBuffer.h  -  fixed size ring buffer for sample_t
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef SAMPLE_RING_BUFFER_H
+#define SAMPLE_RING_BUFFER_H
+
+#include "config.h"
+#include "libkwave_export.h"
+
+#include <QtGlobal>
+
+#include "libkwave/Sample.h"
+#include "libkwave/SampleArray.h"
+
+namespace Kwave
+{
+
+    class Writer;
+
+    /**
+     * Ring buffer with a fixed capacity for samples of one track. The
+     * storage is allocated once when setting the capacity, appending and
+     * dropping old samples never allocates memory. When more samples are
+     * appended than fit into the buffer, the oldest ones get overwritten.
+     *
+     * @note this class does no locking, it is intended to be used from
+     *       one thread only (e.g. for prerecording)
+     */
+    class LIBKWAVE_EXPORT SampleRingBuffer
+    {
+    public:
+        /** Constructor, creates an empty buffer without capacity */
+        SampleRingBuffer();
+
+        /**
+         * Constructor, creates an empty buffer with a given capacity
+         * @param capacity maximum number of samples
+         */
+        explicit SampleRingBuffer(unsigned int capacity);
+
+        /** Destructor */
+        ~SampleRingBuffer();
+
+        /**
+         * Sets a new capacity and allocates the storage. Discards the
+         * current content.
+         * @param capacity maximum number of samples
+         * @return true if succeeded, false if out of memory
+         */
+        bool setCapacity(unsigned int capacity);
+
+        /** Returns the maximum number of samples the buffer can hold */
+        inline unsigned int capacity() const { return m_capacity; }
+
+        /**
+         * Returns the number of samples currently in the buffer, which
+         * is the actual pre-roll depth in samples.
+         */
+        inline unsigned int length() const { return m_length; }
+
+        /** Returns true if the buffer contains no samples */
+        inline bool isEmpty() const { return (m_length == 0); }
+
+        /** Discards the content, keeps the storage */
+        void flush();
+
+        /**
+         * Appends samples to the buffer, overwriting the oldest ones
+         * if the capacity is exceeded.
+         *
+         * @param samples reference to an array of samples
+         */
+        void put(const Kwave::SampleArray &samples);
+
+        /**
+         * Appends samples to the buffer, overwriting the oldest ones
+         * if the capacity is exceeded.
+         *
+         * @param samples pointer to the first sample
+         * @param count number of samples
+         */
+        void put(const sample_t *samples, unsigned int count);
+
+        /**
+         * Transfers the whole content to a writer, starting with the
+         * oldest sample, and empties the buffer afterwards. The data is
+         * rearranged in place and passed to the writer as one single block.
+         *
+         * @param writer the writer that receives the samples
+         * @return true if succeeded, false if the writer failed
+         */
+        bool drainInto(Kwave::Writer &writer);
+
+    private:
+
+        /** storage for the samples, allocated with full capacity */
+        Kwave::SampleArray m_buffer;
+
+        /** maximum number of samples */
+        unsigned int m_capacity;
+
+        /** number of samples in the buffer */
+        unsigned int m_length;
+
+        /** index of the position for the next write */
+        unsigned int m_write_pos;
+
+    };
+}
+
+#endif /* SAMPLE_RING_BUFFER_H */
+
+//***************************************************************************
+//***************************************************************************
@@ -0,0 +1,201 @@
+/***************************************************************************
+            SaveJob.cpp  -  saves a snapshot of a signal in background
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <errno.h>
+#include <stdio.h>
+
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryFile>
+#include <QThread>
+
+#include "libkwave/Encoder.h"
+#include "libkwave/MultiTrackReader.h"
+#include "libkwave/Profiler.h"
+#include "libkwave/SaveJob.h"
+#include "libkwave/String.h"
+
+//***************************************************************************
+Kwave::SaveJob::SaveJob(Kwave::Encoder *encoder,
+                        Kwave::MultiTrackReader *src,
+                        const Kwave::MetaDataList &meta_data,
+                        const QString &filename, QWidget *widget)
+    :QObject(),
+     m_encoder(encoder),
+     m_src(src),
+     m_meta_data(meta_data),
+     m_filename(filename),
+     m_tmp_filename(),
+     m_widget(widget),
+     m_owner_thread(QThread::currentThread()),
+     m_thread(this, QVariant()),
+     m_result(-EINVAL),
+     m_done(true)
+{
+    if (m_src) {
+        connect(m_src, SIGNAL(progress(qreal)),
+                this,  SIGNAL(sigProgress(qreal)),
+                Qt::QueuedConnection);
+        connect(&m_thread, SIGNAL(sigCancel()),
+                m_src,     SLOT(cancel()),
+                Qt::DirectConnection);
+    }
+    connect(&m_thread, SIGNAL(finished()),
+            this,      SLOT(finished()),
+            Qt::QueuedConnection);
+}
+
+//***************************************************************************
+Kwave::SaveJob::~SaveJob()
+{
+    if (!m_done) {
+        cancel();
+        wait();
+    }
+
+    delete m_src;
+    m_src = nullptr;
+    delete m_encoder;
+    m_encoder = nullptr;
+}
+
+//***************************************************************************
+bool Kwave::SaveJob::start()
+{
+    Q_ASSERT(m_done);
+    Q_ASSERT(m_encoder);
+    Q_ASSERT(m_src);
+    if (!m_done || !m_encoder || !m_src) return false;
+
+    // reserve a unique name for the temporary file, in the same
+    // directory so that the final rename does not cross file systems
+    QTemporaryFile tmp(m_filename + _(".XXXXXX"));
+    tmp.setAutoRemove(false);
+    if (!tmp.open()) {
+        qWarning("SaveJob: creating a temporary file for '%s' failed",
+                 DBG(m_filename));
+        m_result = -EIO;
+        return false;
+    }
+    m_tmp_filename = tmp.fileName();
+
+    // keep the permissions of an existing file, otherwise use the
+    // defaults of a newly created file instead of the restrictive
+    // ones of a temporary file
+    if (QFile::exists(m_filename)) {
+        tmp.setPermissions(QFile::permissions(m_filename));
+    } else {
+        tmp.setPermissions(QFile::ReadOwner | QFile::WriteOwner |
+                           QFile::ReadGroup | QFile::ReadOther);
+    }
+    tmp.close();
+
+    // the encoder (and maybe a QProcess within) has to live in the
+    // worker thread while encoding, it moves back when done
+    m_encoder->moveToThread(&m_thread);
+
+    m_result = 0;
+    m_done   = false;
+    m_thread.start();
+    return true;
+}
+
+//***************************************************************************
+void Kwave::SaveJob::run_wrapper(const QVariant &params)
+{
+    Q_UNUSED(params)
+
+    QFile dst(m_tmp_filename);
+    bool encoded;
+    {
+        Kwave::ProfileScope profile("encode",
+            QFileInfo(m_filename).suffix().toLower());
+        encoded = m_encoder->encode(m_widget, *m_src, dst, m_meta_data);
+    }
+    if (dst.isOpen()) {
+        Kwave::Profiler::count("encoded bytes", dst.size());
+        dst.close();
+    }
+    if (encoded)
+        Kwave::Profiler::count("encoded samples",
+            static_cast<qint64>(m_src->last() - m_src->first() + 1) *
+            m_src->tracks());
+
+    if (m_src->isCanceled())
+        m_result = -EINTR;
+    else if (!encoded)
+        m_result = -EIO;
+    else
+        m_result = 0;
+
+    m_encoder->moveToThread(m_owner_thread);
+}
+
+//***************************************************************************
+void Kwave::SaveJob::cancel()
+{
+    if (!m_done) m_thread.cancel();
+}
+
+//***************************************************************************
+int Kwave::SaveJob::wait()
+{
+    if (m_done) return m_result;
+
+    // the encoder might show a message box, which is executed in our
+    // thread, so do not simply block but keep the events flowing
+    if (m_thread.isRunning()) {
+        QEventLoop loop;
+        connect(&m_thread, SIGNAL(finished()), &loop, SLOT(quit()));
+        if (m_thread.isRunning()) loop.exec();
+    }
+    m_thread.wait();
+
+    finished();
+    return m_result;
+}
+
+//***************************************************************************
+void Kwave::SaveJob::finished()
+{
+    if (m_done) return; // already finished through wait()
+    m_done = true;
+
+    if (!m_result) {
+        // atomically replace the destination file
+        if (::rename(QFile::encodeName(m_tmp_filename).constData(),
+                     QFile::encodeName(m_filename).constData()) != 0)
+        {
+            const int err = errno;
+            qWarning("SaveJob: renaming '%s' to '%s' failed",
+                     DBG(m_tmp_filename), DBG(m_filename));
+            m_result = (err) ? -err : -EIO;
+        }
+    }
+    if (m_result) QFile::remove(m_tmp_filename);
+
+    qDebug("SaveJob: '%s' done, result=%d", DBG(m_filename), m_result);
+    emit sigDone(m_result);
+}
+
+//***************************************************************************
+//***************************************************************************
+
+#include "moc_SaveJob.cpp"
@@ -0,0 +1,161 @@
+/***************************************************************************
+              SaveJob.h  -  saves a snapshot of a signal in background
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef SAVE_JOB_H
+#define SAVE_JOB_H
+
+#include "config.h"
+#include "libkwave_export.h"
+
+#include <QtGlobal>
+#include <QObject>
+#include <QString>
+#include <QVariant>
+
+#include "libkwave/MetaDataList.h"
+#include "libkwave/Runnable.h"
+#include "libkwave/WorkerThread.h"
+
+class QThread;
+class QWidget;
+
+namespace Kwave
+{
+
+    class Encoder;
+    class MultiTrackReader;
+
+    /**
+     * Encodes a signal into a file, in a worker thread. The source has to
+     * be opened before the job is started, it holds copies of the stripes
+     * of the signal and therefore is a snapshot that is not affected by
+     * later modifications. The encoder writes into a temporary file in the
+     * same directory, which replaces the destination file only if encoding
+     * has completed successfully.
+     */
+    class LIBKWAVE_EXPORT SaveJob: public QObject, public Kwave::Runnable
+    {
+        Q_OBJECT
+    public:
+
+        /**
+         * Constructor
+         * @param encoder the encoder to use, will be owned by the job
+         * @param src source of the samples, will be owned by the job
+         * @param meta_data meta data of the file to save
+         * @param filename name of the destination file
+         * @param widget a widget, used as parent for message boxes
+         */
+        SaveJob(Kwave::Encoder *encoder, Kwave::MultiTrackReader *src,
+                const Kwave::MetaDataList &meta_data,
+                const QString &filename, QWidget *widget);
+
+        /** Destructor, cancels and waits if still running */
+        ~SaveJob() override;
+
+        /**
+         * Creates the temporary file and starts the worker thread
+         * @return true if started, false if failed
+         */
+        bool start();
+
+        /**
+         * Waits until the job is done, without blocking message boxes
+         * shown by the encoder, and finishes it if not already done
+         * @return result of the job
+         */
+        int wait();
+
+        /** returns true until the job is done */
+        inline bool isRunning() const { return !m_done; }
+
+        /** returns the name of the destination file */
+        inline const QString &fileName() const { return m_filename; }
+
+        /**
+         * Returns the result of the job, only valid when done: zero if
+         * succeeded, -EINTR if canceled or another negative error code
+         */
+        inline int result() const { return m_result; }
+
+        /** runs the encoder, in the worker thread */
+        void run_wrapper(const QVariant &params) override;
+
+    signals:
+
+        /**
+         * emits the progress of the encoder
+         * @param percent the progress [0...100]
+         */
+        void sigProgress(qreal percent);
+
+        /**
+         * emitted when the job is done, after the destination file has
+         * been replaced or the temporary file has been removed
+         * @param result zero if succeeded or negative error code
+         */
+        void sigDone(int result);
+
+    public slots:
+
+        /** cancels the job, the destination file is not touched */
+        void cancel();
+
+    private slots:
+
+        /** called when the worker thread has finished */
+        void finished();
+
+    private:
+
+        /** the encoder */
+        Kwave::Encoder *m_encoder;
+
+        /** snapshot of the signal */
+        Kwave::MultiTrackReader *m_src;
+
+        /** meta data of the file to save */
+        Kwave::MetaDataList m_meta_data;
+
+        /** name of the destination file */
+        QString m_filename;
+
+        /** name of the temporary file */
+        QString m_tmp_filename;
+
+        /** parent widget for message boxes */
+        QWidget *m_widget;
+
+        /** the thread that created the job */
+        QThread *m_owner_thread;
+
+        /** worker thread for encoding */
+        Kwave::WorkerThread m_thread;
+
+        /** result of the encoder, set in the worker thread */
+        int m_result;
+
+        /** true when the job is done */
+        bool m_done;
+
+    };
+}
+
+#endif /* SAVE_JOB_H */
+
+//***************************************************************************
+//***************************************************************************
@@ -264,6 +264,16 @@ sample_index_t Kwave::Signal::length()
     return max;
 }
 
+//***************************************************************************
+void Kwave::Signal::memoryUsage(quint64 &shared, quint64 &exclusive)
+{
+    QReadLocker lock(&m_lock_tracks);
+
+    for (Kwave::Track *track : m_tracks) {
+        if (track) track->memoryUsage(shared, exclusive);
+    }
+}
+
 //***************************************************************************
 bool Kwave::Signal::trackSelected(unsigned int track)
 {
@@ -181,6 +181,16 @@ namespace Kwave
          */
         sample_index_t length();
 
+        /**
+         * Determines how much memory is used by the samples of all tracks
+         * @param shared receives the number of bytes that are shared with
+         *        other users, like the undo buffer (added to the value)
+         * @param exclusive receives the number of bytes that are used
+         *        only by the signal (added to the value)
+         * @see Kwave::Track::memoryUsage
+         */
+        void memoryUsage(quint64 &shared, quint64 &exclusive);
+
         /**
          * Queries if a track is selected. If the index of the track is
          * out of range, the return value will be false.
@@ -30,6 +30,7 @@
 #include <QFileInfo>
 #include <QMutableListIterator>
 #include <QMutexLocker>
+#include <QSet>
 #include <QUrl>
 #include <QVector>
 
@@ -44,11 +45,14 @@
 #include "libkwave/FileProgress.h"
 #include "libkwave/InsertMode.h"
 #include "libkwave/LabelList.h"
+#include "libkwave/MemoryBudget.h"
 #include "libkwave/MessageBox.h"
 #include "libkwave/MultiTrackReader.h"
 #include "libkwave/MultiTrackWriter.h"
 #include "libkwave/Parser.h"
+#include "libkwave/Profiler.h"
 #include "libkwave/Sample.h"
+#include "libkwave/SaveJob.h"
 #include "libkwave/Signal.h"
 #include "libkwave/SignalManager.h"
 #include "libkwave/String.h"
@@ -90,7 +94,13 @@ Kwave::SignalManager::SignalManager(QWidget *parent)
     m_undo_transaction(nullptr),
     m_undo_transaction_level(0),
     m_undo_transaction_lock(),
-    m_meta_data()
+    m_meta_data(),
+    m_label_index(),
+    m_modification_count(0),
+    m_save_job(nullptr),
+    m_save_selection(false),
+    m_save_modification_count(0),
+    m_undo_memory(0)
 {
     // connect to the track's signals
     Kwave::Signal *sig = &m_signal;
@@ -112,11 +122,14 @@ Kwave::SignalManager::SignalManager(QWidget *parent)
             sample_index_t)),
             this, SLOT(slotSamplesModified(unsigned int, sample_index_t,
             sample_index_t)));
+
+    Kwave::MemoryBudget::instance().registerConsumer(this, this);
 }
 
 //***************************************************************************
 Kwave::SignalManager::~SignalManager()
 {
+    Kwave::MemoryBudget::instance().unregisterConsumer(this);
     close();
 }
 
@@ -169,6 +182,7 @@ int Kwave::SignalManager::loadFile(const QUrl &url)
 
         // take the preliminary meta data, needed for estimated length
         m_meta_data = meta_data;
+        m_label_index.invalidate();
 
         // detect stream mode. if so, use one sample as display
         bool streaming = (!info.length());
@@ -234,7 +248,12 @@ int Kwave::SignalManager::loadFile(const QUrl &url)
 
         // now decode
         res = 0;
-        if (!decoder->decode(m_parent_widget, writers)) {
+        bool decoded;
+        {
+            Kwave::ProfileScope profile("decode", mimetype);
+            decoded = decoder->decode(m_parent_widget, writers);
+        }
+        if (!decoded) {
             qWarning("decoding failed.");
             res = -EIO;
         } else {
@@ -261,6 +280,11 @@ int Kwave::SignalManager::loadFile(const QUrl &url)
         // enter the filename/mimetype and size into the file info
         info.set(Kwave::INF_FILENAME, fi.absoluteFilePath());
         info.set(Kwave::INF_FILESIZE, src.size());
+        if (!res) {
+            Kwave::Profiler::count("decoded bytes", src.size());
+            Kwave::Profiler::count("decoded samples",
+                static_cast<qint64>(info.length()) * info.tracks());
+        }
         if (!info.contains(Kwave::INF_MIMETYPE))
             info.set(Kwave::INF_MIMETYPE, mimetype);
 
@@ -270,6 +294,7 @@ int Kwave::SignalManager::loadFile(const QUrl &url)
         // take over the decoded and updated file info
         meta_data.replace(Kwave::MetaDataList(info));
         m_meta_data = meta_data;
+        m_label_index.invalidate();
 
         // update the length info in the progress dialog if needed
         if (dialog && use_src_size) {
@@ -316,6 +341,9 @@ int Kwave::SignalManager::loadFile(const QUrl &url)
 //***************************************************************************
 int Kwave::SignalManager::save(const QUrl &url, bool selection)
 {
+    // only one save at a time
+    if (m_save_job) waitForSave();
+
     int res = 0;
     sample_index_t ofs  = 0;
     sample_index_t len  = length();
@@ -347,6 +375,12 @@ int Kwave::SignalManager::save(const QUrl &url, bool selection)
         // maybe we now have a new mime type
         file_info.set(Kwave::INF_MIMETYPE, mimetype_name);
 
+        // the MD5 sum of the audio data only stays valid in a format
+        // that stores it, like FLAC
+        if (!selection &&
+            !encoder->supportedProperties().contains(Kwave::INF_MD5))
+            file_info.set(Kwave::INF_MD5, QVariant());
+
         // check if we lose information and ask the user if this would
         // be acceptable
         QList<Kwave::FileProperty> unsupported = encoder->unsupportedProperties(
@@ -376,13 +410,18 @@ int Kwave::SignalManager::save(const QUrl &url, bool selection)
             }
         }
 
-        // open the destination file
+        // open the source, it holds copies of the stripes and therefore
+        // is a snapshot that is not affected by further modifications
         QString filename = url.path();
-        QFile dst(filename);
-
-        Kwave::MultiTrackReader src(Kwave::SinglePassForward, *this,
-            (selection) ? selectedTracks() : allTracks(),
-            ofs, ofs + len - 1);
+        Kwave::MultiTrackReader *src = new(std::nothrow)
+            Kwave::MultiTrackReader(Kwave::SinglePassForward, *this,
+                (selection) ? selectedTracks() : allTracks(),
+                ofs, ofs + len - 1);
+        Q_ASSERT(src);
+        if (!src) {
+            delete encoder;
+            return -ENOMEM;
+        }
 
         // update the file information
         file_info.setLength(len);
@@ -411,67 +450,57 @@ int Kwave::SignalManager::save(const QUrl &url, bool selection)
             file_info.set(Kwave::INF_CREATION_DATE, date);
         }
 
-        // prepare and show the progress dialog
-        Kwave::FileProgress *dialog = new(std::nothrow)
-            Kwave::FileProgress(m_parent_widget, QUrl(filename),
-                file_info.length() * file_info.tracks() *
-                (file_info.bits() >> 3),
-                file_info.length(), file_info.rate(), file_info.bits(),
-                file_info.tracks()
-            );
-        Q_ASSERT(dialog);
-        if (dialog) {
-            QObject::connect(&src,   SIGNAL(progress(qreal)),
-                             dialog, SLOT(setValue(qreal)),
-                             Qt::QueuedConnection);
-            QObject::connect(dialog, SIGNAL(canceled()),
-                             &src,   SLOT(cancel()));
-        }
-
-        // invoke the encoder...
-        bool encoded = false;
         m_meta_data.replace(Kwave::MetaDataList(file_info));
 
+        Kwave::MetaDataList meta;
         if (selection) {
             // use a copy, don't touch the original !
-            Kwave::MetaDataList meta = m_meta_data;
+            meta = m_meta_data;
 
             // we have to adjust all position aware meta data
             meta.cropByRange(ofs, ofs + len - 1);
 
             // set the filename in the copy of the fileinfo, the original
-            // file which is currently open keeps it's name
+            // file which is currently open keeps it's name. The MD5 sum
+            // is the one of the whole file and does not apply.
             Kwave::FileInfo info(meta);
             info.set(Kwave::INF_FILENAME, filename);
+            info.set(Kwave::INF_MD5, QVariant());
             meta.replace(Kwave::MetaDataList(info));
-
-            encoded = encoder->encode(m_parent_widget, src, dst, meta);
         } else {
             // in case of a "save as" -> modify the current filename
             file_info.set(Kwave::INF_FILENAME, filename);
             m_meta_data.replace(Kwave::MetaDataList(file_info));
-            encoded = encoder->encode(m_parent_widget, src, dst, m_meta_data);
-        }
-        if (!encoded) {
-            Kwave::MessageBox::error(m_parent_widget,
-                i18n("An error occurred while saving the file."));
-            res = -1;
+            meta = m_meta_data;
         }
 
-        delete encoder;
+        // invoke the encoder in background, the job takes
+        // the ownership of the encoder and the source
+        m_save_job = new(std::nothrow) Kwave::SaveJob(
+            encoder, src, meta, filename, m_parent_widget);
+        Q_ASSERT(m_save_job);
+        if (!m_save_job) {
+            delete src;
+            delete encoder;
+            return -ENOMEM;
+        }
         encoder = nullptr;
 
-        if (dialog) {
-            qApp->processEvents();
-            if (dialog->isCanceled()) {
-                // user really pressed cancel !
-                Kwave::MessageBox::error(m_parent_widget,
-                    i18n("The file has been truncated and "
-                          "might be corrupted."));
-                res = -EINTR;
-            }
-            delete dialog;
-            dialog = nullptr;
+        m_save_selection          = selection;
+        m_save_modification_count = m_modification_count;
+        connect(m_save_job, SIGNAL(sigProgress(qreal)),
+                this,       SLOT(saveProgress(qreal)));
+        connect(m_save_job, SIGNAL(sigDone(int)),
+                this,       SLOT(saveDone(int)));
+
+        if (!m_save_job->start()) {
+            Kwave::MessageBox::error(m_parent_widget,
+                i18n("An error occurred while saving the file."));
+            res = m_save_job->result();
+            delete m_save_job;
+            m_save_job = nullptr;
+        } else {
+            emit sigSaveProgress(filename, 0.0);
         }
     } else {
         Kwave::MessageBox::error(m_parent_widget,
@@ -479,16 +508,57 @@ int Kwave::SignalManager::save(const QUrl &url, bool selection)
         res = -EINVAL;
     }
 
-    if (!res && !selection) {
-        // saved without error -> no longer modified
+    emit sigMetaDataChanged(m_meta_data);
+    qDebug("SignalManager::save(): res=%d",res);
+    return res;
+}
+
+//***************************************************************************
+int Kwave::SignalManager::waitForSave()
+{
+    return (m_save_job) ? m_save_job->wait() : 0;
+}
+
+//***************************************************************************
+void Kwave::SignalManager::cancelSave()
+{
+    if (m_save_job) m_save_job->cancel();
+}
+
+//***************************************************************************
+void Kwave::SignalManager::saveProgress(qreal percent)
+{
+    if (m_save_job) emit sigSaveProgress(m_save_job->fileName(), percent);
+}
+
+//***************************************************************************
+void Kwave::SignalManager::saveDone(int result)
+{
+    Kwave::SaveJob *job = m_save_job;
+    Q_ASSERT(job);
+    if (!job) return;
+    m_save_job = nullptr;
+
+    const QString filename = job->fileName();
+    job->deleteLater();
+
+    if (result == -EINTR) {
+        // canceled by the user, the file has not been touched
+        qDebug("SignalManager::saveDone(): canceled");
+    } else if (result) {
+        Kwave::MessageBox::error(m_parent_widget,
+            i18n("An error occurred while saving the file."));
+    } else if (!m_save_selection && !m_closed &&
+               (m_modification_count == m_save_modification_count))
+    {
+        // saved without error and not changed in the meantime
+        // -> no longer modified
         flushUndoBuffers();
         enableModifiedChange(true);
         setModified(false);
     }
 
-    emit sigMetaDataChanged(m_meta_data);
-    qDebug("SignalManager::save(): res=%d",res);
-    return res;
+    emit sigSaveDone(filename, result);
 }
 
 //***************************************************************************
@@ -504,6 +574,7 @@ void Kwave::SignalManager::newSignal(sample_index_t samples, double rate,
     disableUndo();
 
     m_meta_data.clear();
+    m_label_index.invalidate();
     Kwave::FileInfo file_info(m_meta_data);
     file_info.setRate(rate);
     file_info.setBits(bits);
@@ -535,6 +606,9 @@ void Kwave::SignalManager::newSignal(sample_index_t samples, double rate,
 //***************************************************************************
 void Kwave::SignalManager::close()
 {
+    // a save in background has to complete before
+    waitForSave();
+
     // stop the playback
     m_playback_controller.playbackStop();
     m_playback_controller.reset();
@@ -564,6 +638,7 @@ void Kwave::SignalManager::close()
 
     // clear all meta data
     m_meta_data.clear();
+    m_label_index.invalidate();
 
     m_closed = true;
     rememberCurrentSelection();
@@ -735,28 +810,19 @@ int Kwave::SignalManager::executeCommand(const QString &command)
                                          i18n("Expand Selection to Label"));
         sample_index_t selection_left  = m_selection.first();
         sample_index_t selection_right = m_selection.last();
-        Kwave::LabelList labels(m_meta_data);
+        const Kwave::LabelIndex &labels = this->labels();
         if (labels.isEmpty()) return false; // we need labels for this
-        Kwave::Label label_left  = Kwave::Label();
-        Kwave::Label label_right = Kwave::Label();
 
         // the last label <= selection start -> label_left
         // the first label >= selection end  -> label_right
-        foreach (const Kwave::Label &label, labels) {
-            sample_index_t lp = label.pos();
-            if (lp <= selection_left)
-                label_left = label;
-            if ((lp >= selection_right) && (label_right.isNull())) {
-                label_right = label;
-                break; // done
-            }
-        }
+        const int left  = labels.upperBound(selection_left) - 1;
+        const int right = labels.lowerBound(selection_right);
+
         // default left label = start of file
-        selection_left = (label_left.isNull()) ? 0 :
-            label_left.pos();
+        selection_left = (left < 0) ? 0 : labels.at(left).pos();
         // default right label = end of file
-        selection_right = (label_right.isNull()) ?
-            (this->length() - 1) : label_right.pos();
+        selection_right = (right >= labels.count()) ?
+            (this->length() - 1) : labels.at(right).pos();
         sample_index_t len = selection_right - selection_left + 1;
         selectRange(selection_left, len);
 
@@ -766,28 +832,25 @@ int Kwave::SignalManager::executeCommand(const QString &command)
         sample_index_t selection_right = m_selection.last();
         Kwave::Label label_left  = Kwave::Label();
         Kwave::Label label_right = Kwave::Label();
-        Kwave::LabelList labels(m_meta_data);
+        const Kwave::LabelIndex &labels = this->labels();
         if (labels.isEmpty()) return false; // we need labels for this
 
         // special case: nothing selected -> select up to the first label
         if (selection_right == 0) {
-            label_right = labels.first();
+            label_right = labels.at(0);
             selection_left = 0;
         } else {
-            // find the first label starting after the current selection
-            LabelListIterator it(labels);
-            while (it.hasNext()) {
-                Kwave::Label label = it.next();
-                if (label.pos() >= selection_right) {
-                    // take it as selection start
-                    label_left  = label;
-                    // and it's next one as selection end (might be null)
-                    label_right = it.hasNext() ? it.next() : Kwave::Label();
-                    break;
-                }
+            // find the first label starting after the current selection,
+            // take it as selection start and the next one as selection
+            // end (might be null)
+            const int index = labels.lowerBound(selection_right);
+            if (index < labels.count()) {
+                label_left = labels.at(index);
+                if (index + 1 < labels.count())
+                    label_right = labels.at(index + 1);
             }
             // default selection start = last label
-            if (label_left.isNull()) label_left = labels.last();
+            if (label_left.isNull()) label_left = labels.at(labels.count() - 1);
             if (label_left.isNull()) return false; // no labels at all !?
             selection_left = label_left.pos();
         }
@@ -803,21 +866,19 @@ int Kwave::SignalManager::executeCommand(const QString &command)
         sample_index_t selection_left  = selection().first();
         Kwave::Label label_left  = Kwave::Label();
         Kwave::Label label_right = Kwave::Label();
-        Kwave::LabelList labels(m_meta_data);
+        const Kwave::LabelIndex &labels = this->labels();
         if (labels.isEmpty()) return false; // we need labels for this
 
-        // find the last label before the start of the selection
-        foreach (const Kwave::Label &label, labels) {
-            if (label.pos() > selection_left)
-                break; // done
-            label_left  = label_right;
-            label_right = label;
-        }
+        // the last two labels before the start of the selection
+        const int index = labels.upperBound(selection_left);
+        if (index >= 1) label_right = labels.at(index - 1);
+        if (index >= 2) label_left  = labels.at(index - 2);
+
         // default selection start = start of file
         selection_left = (label_left.isNull()) ? 0 :
             label_left.pos();
         // default selection end = first label
-        if (label_right.isNull()) label_right = labels.first();
+        if (label_right.isNull()) label_right = labels.at(0);
         if (label_right.isNull()) return false; // no labels at all !?
         sample_index_t selection_right = label_right.pos();
         sample_index_t len = selection_right - selection_left + 1;
@@ -957,8 +1018,10 @@ void Kwave::SignalManager::slotTrackInserted(unsigned int index,
 {
     setModified(true);
 
+    // the MD5 sum stored in the file no longer matches
     Kwave::FileInfo file_info(m_meta_data);
     file_info.setTracks(tracks());
+    file_info.set(Kwave::INF_MD5, QVariant());
     m_meta_data.replace(Kwave::MetaDataList(file_info));
 
     emit sigTrackInserted(index, track);
@@ -971,8 +1034,10 @@ void Kwave::SignalManager::slotTrackDeleted(unsigned int index,
 {
     setModified(true);
 
+    // the MD5 sum stored in the file no longer matches
     Kwave::FileInfo file_info(m_meta_data);
     file_info.setTracks(tracks());
+    file_info.set(Kwave::INF_MD5, QVariant());
     m_meta_data.replace(Kwave::MetaDataList(file_info));
 
     emit sigTrackDeleted(index, track);
@@ -992,14 +1057,19 @@ void Kwave::SignalManager::slotSamplesInserted(unsigned int track,
     QVector<unsigned int> tracks = selectedTracks();
     if (track == tracks.first()) {
         m_meta_data.shiftRight(offset, length);
+        m_label_index.invalidate();
     }
 
     emit sigSamplesInserted(track, offset, length);
 
+    // the MD5 sum stored in the file no longer matches
     Kwave::FileInfo info(m_meta_data);
     info.setLength(m_last_length);
+    info.set(Kwave::INF_MD5, QVariant());
     m_meta_data.replace(Kwave::MetaDataList(info));
     emit sigMetaDataChanged(m_meta_data);
+
+    Kwave::MemoryBudget::instance().check();
 }
 
 //***************************************************************************
@@ -1015,12 +1085,15 @@ void Kwave::SignalManager::slotSamplesDeleted(unsigned int track,
     QVector<unsigned int> tracks = selectedTracks();
     if (track == tracks.first()) {
         m_meta_data.shiftLeft(offset, length);
+        m_label_index.invalidate();
     }
 
     emit sigSamplesDeleted(track, offset, length);
 
+    // the MD5 sum stored in the file no longer matches
     Kwave::FileInfo info(m_meta_data);
     info.setLength(m_last_length);
+    info.set(Kwave::INF_MD5, QVariant());
     m_meta_data.replace(Kwave::MetaDataList(info));
     emit sigMetaDataChanged(m_meta_data);
 }
@@ -1031,6 +1104,14 @@ void Kwave::SignalManager::slotSamplesModified(unsigned int track,
 {
     setModified(true);
     emit sigSamplesModified(track, offset, length);
+
+    // the MD5 sum stored in the file no longer matches
+    Kwave::FileInfo info(m_meta_data);
+    if (info.contains(Kwave::INF_MD5)) {
+        info.set(Kwave::INF_MD5, QVariant());
+        m_meta_data.replace(Kwave::MetaDataList(info));
+        emit sigMetaDataChanged(m_meta_data);
+    }
 }
 
 //***************************************************************************
@@ -1049,6 +1130,7 @@ bool Kwave::SignalManager::deleteRange(sample_index_t offset,
             return false;
         }
         m_meta_data.deleteRange(offset, length);
+        m_label_index.invalidate();
 
         // store undo data for all audio data (without meta data)
         if (!registerUndoAction(new(std::nothrow) UndoDeleteAction(
@@ -1060,6 +1142,7 @@ bool Kwave::SignalManager::deleteRange(sample_index_t offset,
     } else {
         // delete without undo
         m_meta_data.deleteRange(offset, length);
+        m_label_index.invalidate();
     }
 
     // delete the ranges in all tracks
@@ -1287,6 +1370,7 @@ void Kwave::SignalManager::closeUndoTransaction()
         rememberCurrentSelection();
         m_undo_transaction = nullptr;
         emitUndoRedoInfo();
+        Kwave::MemoryBudget::instance().check();
     }
 }
 
@@ -1427,10 +1511,14 @@ bool Kwave::SignalManager::registerUndoAction(Kwave::UndoAction *action)
 
     // now we might have enough place to append the undo action
     // and store all undo info
-    if (!action->store(*this)) {
-        delete action;
-        return continueWithoutUndo();
+    {
+        Kwave::ProfileScope profile("undo store");
+        if (!action->store(*this)) {
+            delete action;
+            return continueWithoutUndo();
+        }
     }
+    Kwave::Profiler::count("undo bytes", static_cast<qint64>(needed_size));
 
     // everything went ok, register internally
     m_undo_transaction->append(action);
@@ -1469,10 +1557,10 @@ qint64 Kwave::SignalManager::usedUndoRedoMemory()
 }
 
 //***************************************************************************
-void Kwave::SignalManager::freeUndoMemory(qint64 needed)
+void Kwave::SignalManager::freeUndoMemory(qint64 needed, qint64 limit)
 {
     qint64 size = usedUndoRedoMemory() + needed;
-    qint64 undo_limit = Kwave::undoLimit() << 20;
+    qint64 undo_limit = (limit < 0) ? (Kwave::undoLimit() << 20) : limit;
 
     // remove old undo actions if not enough free memory
     while (!m_undo_buffer.isEmpty() && (size > undo_limit)) {
@@ -1497,6 +1585,46 @@ void Kwave::SignalManager::freeUndoMemory(qint64 needed)
     }
 }
 
+//***************************************************************************
+qint64 Kwave::SignalManager::memoryUsage(Kwave::MemoryConsumer::Kind kind)
+{
+    switch (kind) {
+        case Kwave::MemoryConsumer::Samples:
+            return static_cast<qint64>(m_last_length) * tracks() *
+                   static_cast<qint64>(sizeof(sample_t));
+        case Kwave::MemoryConsumer::Undo:
+            // do not block the GUI while an undo action is being stored,
+            // use the value of the last check instead
+            if (m_undo_transaction_lock.tryLock()) {
+                m_undo_memory = usedUndoRedoMemory();
+                m_undo_transaction_lock.unlock();
+            }
+            return m_undo_memory;
+        default:
+            return 0;
+    }
+}
+
+//***************************************************************************
+qint64 Kwave::SignalManager::releaseMemory(Kwave::MemoryConsumer::Kind kind,
+                                           qint64 bytes)
+{
+    if (kind != Kwave::MemoryConsumer::Undo) return 0;
+    if (!m_undo_transaction_lock.tryLock()) return 0;
+
+    qint64 released = 0;
+    if (!m_undo_transaction) {
+        const qint64 used = usedUndoRedoMemory();
+        freeUndoMemory(0, qMax<qint64>(0, used - bytes));
+        m_undo_memory = usedUndoRedoMemory();
+        released = used - m_undo_memory;
+        if (released) emitUndoRedoInfo();
+    }
+
+    m_undo_transaction_lock.unlock();
+    return released;
+}
+
 //***************************************************************************
 void Kwave::SignalManager::emitUndoRedoInfo()
 {
@@ -1785,6 +1913,7 @@ void Kwave::SignalManager::redo()
 //***************************************************************************
 void Kwave::SignalManager::setModified(bool mod)
 {
+    m_modification_count++;
     if (!m_modified_enabled) return;
 
     if (m_modified != mod) {
@@ -1821,26 +1950,25 @@ void Kwave::SignalManager::setFileInfo(const Kwave::FileInfo &new_info,
     emit sigMetaDataChanged(m_meta_data);
 }
 
+//***************************************************************************
+const Kwave::LabelIndex &Kwave::SignalManager::labels() const
+{
+    if (!m_label_index.isValid()) m_label_index.rebuild(m_meta_data);
+    return m_label_index;
+}
+
 //***************************************************************************
 Kwave::Label Kwave::SignalManager::findLabel(sample_index_t pos)
 {
-    Kwave::LabelList labels(m_meta_data);
-    foreach (const Kwave::Label &label, labels) {
-        if (label.pos() == pos) return label; // found it
-    }
-    return Kwave::Label(); // nothing found
+    const Kwave::LabelIndex &index = labels();
+    const int found = index.find(pos);
+    return (found >= 0) ? index.at(found) : Kwave::Label();
 }
 
 //***************************************************************************
 int Kwave::SignalManager::labelIndex(const Kwave::Label &label) const
 {
-    int index = 0;
-    Kwave::LabelList labels(m_meta_data);
-    foreach (const Kwave::Label &l, labels) {
-        if (l == label) return index; // found it
-        index++;
-    }
-    return -1; // nothing found*/
+    return labels().indexOf(label);
 }
 
 //***************************************************************************
@@ -1863,6 +1991,7 @@ Kwave::Label Kwave::SignalManager::addLabel(sample_index_t pos,
 
     // put the label into the list
     m_meta_data.add(label);
+    m_label_index.insert(label);
 
     // register this as a modification
     setModified(true);
@@ -1872,11 +2001,53 @@ Kwave::Label Kwave::SignalManager::addLabel(sample_index_t pos,
     return label;
 }
 
+//***************************************************************************
+int Kwave::SignalManager::addLabels(const Kwave::LabelList &list)
+{
+    if (list.isEmpty()) return 0;
+
+    // collect the new labels first and add them to the index in one
+    // pass, inserting them one by one would be O(n^2)
+    Kwave::LabelList added;
+    {
+        Kwave::UndoTransactionGuard undo(*this, i18n("Add Labels"));
+        const Kwave::LabelIndex &index = labels();
+        QSet<sample_index_t> positions;
+        foreach (const Kwave::Label &l, list) {
+            // skip positions that are already occupied
+            if (l.isNull() || positions.contains(l.pos()) ||
+                (index.find(l.pos()) >= 0))
+                continue;
+
+            Kwave::Label label(l.pos(), l.name());
+            if (m_undo_enabled) {
+                // one undo action per label, the undo of a range would
+                // also remove labels that were not added by us
+                if (!registerUndoAction(new(std::nothrow)
+                    UndoAddMetaDataAction(Kwave::MetaDataList(label))))
+                    break;
+            }
+
+            m_meta_data.add(label);
+            positions.insert(label.pos());
+            added.append(label);
+        }
+        m_label_index.insert(added);
+    }
+    if (added.isEmpty()) return 0;
+
+    // register this as a modification
+    setModified(true);
+
+    emit sigMetaDataChanged(m_meta_data);
+
+    return Kwave::toInt(added.count());
+}
+
 //***************************************************************************
 void Kwave::SignalManager::deleteLabel(int index, bool with_undo)
 {
-    Kwave::LabelList labels(m_meta_data);
-    int count = Kwave::toInt(labels.count());
+    const int count = labels().count();
     if (!count) return;
 
     if (index == -1) {
@@ -1885,19 +2056,20 @@ void Kwave::SignalManager::deleteLabel(int index, bool with_undo)
         if (with_undo) startUndoTransaction(i18n("Delete All Labels"));
 
         for (index = count - 1; index >= 0; --index) {
-            Kwave::MetaData label(labels.at(index));
+            Kwave::MetaData label(m_label_index.at(index));
             if (with_undo) {
                 if (!registerUndoAction(new(std::nothrow)
                     UndoDeleteMetaDataAction(Kwave::MetaDataList(label))))
                     break;
             }
             m_meta_data.remove(label);
+            m_label_index.removeAt(index);
         }
     } else {
         // delete a single label
         if ((index < 0) || (index >= count)) return;
 
-        Kwave::MetaData label(labels.at(index));
+        Kwave::MetaData label(m_label_index.at(index));
 
         // register the undo action
         if (with_undo) {
@@ -1910,6 +2082,7 @@ void Kwave::SignalManager::deleteLabel(int index, bool with_undo)
         }
 
         m_meta_data.remove(label);
+        m_label_index.removeAt(index);
     }
 
     if (with_undo) closeUndoTransaction();
@@ -1925,11 +2098,10 @@ bool Kwave::SignalManager::modifyLabel(int index, sample_index_t pos,
                                        const QString &name,
                                        bool with_undo)
 {
-    Kwave::LabelList labels(m_meta_data);
-    if ((index < 0) || (index >= Kwave::toInt(labels.count())))
+    if ((index < 0) || (index >= labels().count()))
         return false;
 
-    Kwave::Label label = labels.at(index);
+    Kwave::Label label = m_label_index.at(index);
 
     // check: if the label should be moved and there already is a label
     // at the new position -> fail
@@ -1946,9 +2118,11 @@ bool Kwave::SignalManager::modifyLabel(int index, sample_index_t pos,
     }
 
     // now modify the label
+    m_label_index.removeAt(index);
     label.moveTo(pos);
     label.rename(name);
     m_meta_data.add(label);
+    m_label_index.insert(label);
 
     // register this as a modification
     setModified(true);
@@ -1961,6 +2135,7 @@ bool Kwave::SignalManager::modifyLabel(int index, sample_index_t pos,
 void Kwave::SignalManager::mergeMetaData(const Kwave::MetaDataList &meta_data)
 {
     m_meta_data.add(meta_data);
+    m_label_index.invalidate();
     emit sigMetaDataChanged(m_meta_data);
 }
 
@@ -30,6 +30,8 @@
 
 #include "libkwave/FileInfo.h"
 #include "libkwave/Label.h"
+#include "libkwave/LabelIndex.h"
+#include "libkwave/MemoryBudget.h"
 #include "libkwave/MetaData.h"
 #include "libkwave/MetaDataList.h"
 #include "libkwave/PlaybackController.h"
@@ -51,13 +53,15 @@ namespace Kwave
     class UndoTransactionGuard;
     class MultiTrackWriter;
     class SampleReader;
+    class SaveJob;
     class Track;
     class Writer;
 
     /**
      * The SignalManager class manages multi channel signals.
      */
-    class LIBKWAVE_EXPORT SignalManager: public QObject
+    class LIBKWAVE_EXPORT SignalManager: public QObject,
+                                         public Kwave::MemoryConsumer
     {
         Q_OBJECT
 
@@ -138,6 +142,14 @@ namespace Kwave
          */
         inline sample_index_t length() { return m_signal.length(); }
 
+        /**
+         * Determines how much memory is used by the samples of the signal
+         * @see Kwave::Signal::memoryUsage
+         */
+        inline void memoryUsage(quint64 &shared, quint64 &exclusive) {
+            m_signal.memoryUsage(shared, exclusive);
+        }
+
         /** Returns a reference to the current selection */
         inline Kwave::Selection &selection() { return m_selection; }
 
@@ -161,13 +173,27 @@ namespace Kwave
 
         /**
          * Saves the signal to a file with a given resolution. If the file
-         * already exists, it will be overwritten.
+         * already exists, it will be overwritten. The signal is encoded
+         * in background from a snapshot taken at the time of the call,
+         * so that it can still be played and edited in the meantime.
+         * A save that is still running is waited for before.
          * @param url URL with the name of the file to be saved.
          * @param selection if true, only the selected range will be saved
-         * @return zero if succeeded or negative error code
+         * @return zero if succeeded (or started) or negative error code
+         * @see waitForSave()
          */
         int save(const QUrl &url, bool selection);
 
+        /** returns true while a save in background is running */
+        inline bool isSaving() const { return (m_save_job != nullptr); }
+
+        /**
+         * Waits until a running save is done
+         * @return zero if succeeded or nothing to wait for,
+         *         negative error code if failed or canceled
+         */
+        int waitForSave();
+
         /**
          * Deletes a range of samples and creates an undo action.
          * @param offset index of the first sample
@@ -344,6 +370,14 @@ namespace Kwave
          */
         Kwave::Label addLabel(sample_index_t pos, const QString &name);
 
+        /**
+         * add a list of labels, within a single undo transaction.
+         * Labels at positions that are already occupied are skipped.
+         * @param list list of labels to add
+         * @return number of labels that have been added
+         */
+        int addLabels(const Kwave::LabelList &list);
+
         /**
          * delete an existing label
          * @param index the index of the label [0...N-1]
@@ -379,10 +413,22 @@ namespace Kwave
         Kwave::Label findLabel(sample_index_t pos);
 
         /**
-         * Retrieves the list of meta data objects, mutable
+         * Returns the index of all labels, sorted by position
+         * @return reference to an up to date label index
+         */
+        const Kwave::LabelIndex &labels() const;
+
+        /**
+         * Retrieves the list of meta data objects, mutable.
+         * @note invalidates the label index, as the caller might modify
+         *       the labels. Read-only callers should use the const
+         *       version, e.g. through std::as_const()
          * @return list with all MetaData objects
          */
-        Kwave::MetaDataList &metaData() { return m_meta_data; }
+        Kwave::MetaDataList &metaData() {
+            m_label_index.invalidate();
+            return m_meta_data;
+        }
 
         /**
          * Retrieves the list of meta data objects, const
@@ -414,6 +460,17 @@ namespace Kwave
             m_parent_widget = new_parent;
         }
 
+        /** @see Kwave::MemoryConsumer::memoryUsage */
+        qint64 memoryUsage(Kwave::MemoryConsumer::Kind kind) override;
+
+        /**
+         * Discards the oldest undo and redo data, but not while an
+         * undo transaction is open
+         * @see Kwave::MemoryConsumer::releaseMemory
+         */
+        qint64 releaseMemory(Kwave::MemoryConsumer::Kind kind,
+                             qint64 bytes) override;
+
     signals:
 
         /**
@@ -492,8 +549,25 @@ namespace Kwave
          */
         void sigModified();
 
+        /**
+         * Emits the progress of a save in background
+         * @param filename name of the file that is saved
+         * @param percent the progress [0...100]
+         */
+        void sigSaveProgress(const QString &filename, qreal percent);
+
+        /**
+         * Emitted when a save in background is done
+         * @param filename name of the file that has been saved
+         * @param result zero if succeeded or negative error code
+         */
+        void sigSaveDone(const QString &filename, int result);
+
     public slots:
 
+        /** cancels a running save, the destination file stays untouched */
+        void cancelSave();
+
         /**
          * Un-does the last action if possible.
          */
@@ -573,6 +647,19 @@ namespace Kwave
          */
         void emitUndoRedoInfo();
 
+        /**
+         * Forwards the progress of the save in background
+         * @param percent the progress [0...100]
+         */
+        void saveProgress(qreal percent);
+
+        /**
+         * Called when the save in background is done, reports errors
+         * and resets the modified state if nothing has changed since
+         * @param result zero if succeeded or negative error code
+         */
+        void saveDone(int result);
+
     protected:
 
         friend class Kwave::UndoInsertAction;
@@ -677,8 +764,10 @@ namespace Kwave
          * is available. If necessary, it deletes old undo transactions and if
          * still no enough, it also removes old redo transactions.
          * @param needed the amount of memory that should be free afterwards
+         * @param limit the memory that may be used for undo and redo
+         *              [bytes], or -1 for the configured limit
          */
-        void freeUndoMemory(qint64 needed);
+        void freeUndoMemory(qint64 needed, qint64 limit = -1);
 
         /**
          * Enables changes of the modified flag.
@@ -767,6 +856,27 @@ namespace Kwave
          */
         Kwave::MetaDataList m_meta_data;
 
+        /**
+         * index of the labels in m_meta_data, built on demand
+         * @see labels()
+         */
+        mutable Kwave::LabelIndex m_label_index;
+
+        /** number of calls to setModified(), to detect changes */
+        quint64 m_modification_count;
+
+        /** save in background, or null if none is running */
+        Kwave::SaveJob *m_save_job;
+
+        /** true if m_save_job saves only the selection */
+        bool m_save_selection;
+
+        /** m_modification_count at the start of m_save_job */
+        quint64 m_save_modification_count;
+
+        /** memory used for undo and redo, as of the last check [bytes] */
+        qint64 m_undo_memory;
+
     };
 }
 
@@ -23,55 +23,98 @@
 #include "libkwave/Utils.h"
 #include "libkwave/memcpy.h"
 
+/**
+ * number of bits of the index within a page, the samples of a stripe
+ * are stored in pages of 64k samples (256kB), each one is shared
+ * separately between copies of a stripe (copy-on-write)
+ */
+#define STRIPE_PAGE_SHIFT 16
+
+/** number of samples per page */
+#define STRIPE_PAGE_SIZE (1U << STRIPE_PAGE_SHIFT)
+
+/** mask for the index within a page */
+#define STRIPE_PAGE_MASK (STRIPE_PAGE_SIZE - 1)
+
+//***************************************************************************
+/**
+ * Checks whether a buffer contains only silence
+ * @param p pointer to the first sample
+ * @param count number of samples
+ * @return true if all samples are zero
+ */
+static inline bool isZero(const sample_t *p, unsigned int count)
+{
+    while (count--)
+        if (*(p++)) return false;
+    return true;
+}
+
 //***************************************************************************
 //***************************************************************************
 Kwave::Stripe::Stripe()
-    :m_lock(), m_start(0), m_data()
+    :m_lock(), m_start(0), m_pages(), m_head(0), m_length(0)
 {
 }
 
 //***************************************************************************
 Kwave::Stripe::Stripe(const Stripe &other)
-    :m_lock(), m_start(other.m_start), m_data(other.m_data)
+    :m_lock(), m_start(other.m_start), m_pages(other.m_pages),
+     m_head(other.m_head), m_length(other.m_length)
 {
 }
 
 //***************************************************************************
 Kwave::Stripe::Stripe(Stripe &&other)
-    :m_lock(), m_start(other.m_start), m_data(other.m_data)
+    :m_lock(), m_start(other.m_start), m_pages(std::move(other.m_pages)),
+     m_head(other.m_head), m_length(other.m_length)
 {
-    other.m_start = 0;
-    other.m_data.resize(0);
+    other.m_start  = 0;
+    other.m_pages.clear();
+    other.m_head   = 0;
+    other.m_length = 0;
 }
 
 //***************************************************************************
 Kwave::Stripe::Stripe(sample_index_t start)
-    :m_lock(), m_start(start), m_data()
+    :m_lock(), m_start(start), m_pages(), m_head(0), m_length(0)
 {
 }
 
 //***************************************************************************
 Kwave::Stripe::Stripe(sample_index_t start, const Kwave::SampleArray &samples)
-    :m_lock(), m_start(start), m_data(samples)
+    :m_lock(), m_start(start), m_pages(), m_head(0), m_length(0)
 {
+    const unsigned int length = samples.size();
+    if (!length) return;
+
+    if (length <= STRIPE_PAGE_SIZE) {
+        // fits into one page -> share the array
+        m_pages.push_back(samples);
+        m_length = length;
+    } else {
+        if (!unlockedResize(length)) return; // out of memory
+        unlockedWrite(0, samples.constData(), length);
+    }
 }
 
 //***************************************************************************
 Kwave::Stripe::Stripe(sample_index_t start,
                       Kwave::Stripe &stripe,
                       unsigned int offset)
-    :m_lock(), m_start(start), m_data()
+    :m_lock(), m_start(start), m_pages(stripe.m_pages),
+     m_head(stripe.m_head), m_length(stripe.m_length)
 {
     Q_ASSERT(offset < stripe.length());
-    if (offset >= stripe.length()) return;
-
-    unsigned int length = stripe.length() - offset;
-    if (!resize(length)) return; // out of memory
+    if (offset >= stripe.length()) {
+        m_pages.clear();
+        m_head   = 0;
+        m_length = 0;
+        return;
+    }
 
-    const sample_t *src = stripe.m_data.constData();
-    sample_t       *dst = m_data.data();
-    unsigned int    len = length * sizeof(sample_t);
-    MEMCPY(dst, src + offset, len);
+    // share the pages and drop the ones before the offset
+    unlockedDeleteHead(offset);
 }
 
 //***************************************************************************
@@ -84,14 +127,31 @@ Kwave::Stripe::~Stripe()
 Kwave::Stripe & Kwave::Stripe::operator = (Kwave::Stripe &&other) noexcept
 {
     if (this != &other) {
-        m_start = other.m_start;
-        m_data  = other.m_data;
-        other.m_start = 0;
-        other.m_data.resize(0);
+        m_start  = other.m_start;
+        m_pages  = std::move(other.m_pages);
+        m_head   = other.m_head;
+        m_length = other.m_length;
+        other.m_start  = 0;
+        other.m_pages.clear();
+        other.m_head   = 0;
+        other.m_length = 0;
     }
     return *this;
 }
 
+//***************************************************************************
+const Kwave::SampleArray &Kwave::Stripe::silentPage()
+{
+    static const Kwave::SampleArray page(STRIPE_PAGE_SIZE);
+    return page;
+}
+
+//***************************************************************************
+bool Kwave::Stripe::isSilent(const Kwave::SampleArray &page)
+{
+    return (page.constData() == silentPage().constData());
+}
+
 //***************************************************************************
 sample_index_t Kwave::Stripe::start() const
 {
@@ -108,27 +168,168 @@ void Kwave::Stripe::setStart(sample_index_t start)
 //***************************************************************************
 unsigned int Kwave::Stripe::length() const
 {
-    return m_data.size();
+    return m_length;
 }
 
 //***************************************************************************
 sample_index_t Kwave::Stripe::end() const
 {
-    const sample_index_t size = m_data.size();
+    const sample_index_t size = m_length;
     return (size) ? (m_start + size - 1) : 0;
 }
 
+//***************************************************************************
+const sample_t *Kwave::Stripe::constSamples(unsigned int offset,
+                                            unsigned int &available) const
+{
+    const unsigned int pos = m_head + offset;
+    const Kwave::SampleArray &page = m_pages[pos >> STRIPE_PAGE_SHIFT];
+    const unsigned int index = pos & STRIPE_PAGE_MASK;
+    available = page.size() - index;
+    return page.constData() + index;
+}
+
+//***************************************************************************
+sample_t *Kwave::Stripe::samples(unsigned int offset, unsigned int &available)
+{
+    const unsigned int pos = m_head + offset;
+    Kwave::SampleArray &page = m_pages[pos >> STRIPE_PAGE_SHIFT];
+    const unsigned int index = pos & STRIPE_PAGE_MASK;
+    available = page.size() - index;
+
+    // detaches the page if it is shared with another stripe
+    sample_t *p = page.data();
+    return (p) ? (p + index) : nullptr;
+}
+
+//***************************************************************************
+bool Kwave::Stripe::unlockedResize(unsigned int length)
+{
+    if (length == m_length) return true; // nothing to do
+
+    if (!length) {
+        m_pages.clear();
+        m_head   = 0;
+        m_length = 0;
+        return true;
+    }
+
+    const unsigned int end       = m_head + length;
+    const size_t       old_pages = m_pages.size();
+    const size_t       new_pages = (end + STRIPE_PAGE_SIZE - 1) >>
+                                   STRIPE_PAGE_SHIFT;
+    const unsigned int last_size = end -
+        static_cast<unsigned int>((new_pages - 1) << STRIPE_PAGE_SHIFT);
+
+    if (new_pages <= old_pages) {
+        // shrink or resize within the last page
+        m_pages.resize(new_pages);
+        if (!m_pages.back().resize(last_size)) return false;
+    } else {
+        // fill up the last page, then append new ones
+        if (old_pages && !m_pages.back().resize(STRIPE_PAGE_SIZE))
+            return false;
+        for (size_t index = old_pages; index < new_pages; ++index) {
+            const unsigned int size = (index + 1 < new_pages) ?
+                STRIPE_PAGE_SIZE : last_size;
+
+            // full pages of silence share one storage
+            Kwave::SampleArray page = (size == STRIPE_PAGE_SIZE) ?
+                silentPage() : Kwave::SampleArray(size);
+            if (page.size() != size) {
+                // out of memory -> back to the old size
+                m_pages.resize(old_pages);
+                if (old_pages) {
+                    const unsigned int old_end = m_head + m_length;
+                    m_pages.back().resize(old_end - static_cast<unsigned int>(
+                        (old_pages - 1) << STRIPE_PAGE_SHIFT));
+                }
+                return false;
+            }
+            m_pages.push_back(page);
+        }
+    }
+
+    m_length = length;
+    return true;
+}
+
+//***************************************************************************
+void Kwave::Stripe::unlockedDeleteHead(unsigned int length)
+{
+    Q_ASSERT(length <= m_length);
+    if (length >= m_length) {
+        unlockedResize(0);
+        return;
+    }
+
+    const unsigned int head  = m_head + length;
+    const unsigned int pages = head >> STRIPE_PAGE_SHIFT;
+    if (pages) m_pages.erase(m_pages.begin(), m_pages.begin() + pages);
+    m_head    = head & STRIPE_PAGE_MASK;
+    m_length -= length;
+}
+
+//***************************************************************************
+void Kwave::Stripe::unlockedWrite(unsigned int offset, const sample_t *src,
+                                  unsigned int count)
+{
+    Q_ASSERT(offset + count <= m_length);
+    while (count) {
+        const unsigned int pos = m_head + offset;
+        Kwave::SampleArray &page = m_pages[pos >> STRIPE_PAGE_SHIFT];
+        const unsigned int len = qMin(count,
+            page.size() - (pos & STRIPE_PAGE_MASK));
+        const bool silence = isZero(src, len);
+
+        // silence into silence: nothing to do, keep the page shared
+        if (!silence || !isSilent(page)) {
+            unsigned int available = 0;
+            sample_t *dst = samples(offset, available);
+            if (!dst) return; // out of memory
+            MEMCPY(dst, src, len * sizeof(sample_t));
+
+            // a full page that became silent can share the silent page
+            if (silence && (page.size() == STRIPE_PAGE_SIZE) &&
+                isZero(page.constData(), STRIPE_PAGE_SIZE))
+                page = silentPage();
+        }
+
+        src    += len;
+        offset += len;
+        count  -= len;
+    }
+}
+
+//***************************************************************************
+void Kwave::Stripe::unlockedRead(sample_t *dst, unsigned int offset,
+                                 unsigned int count) const
+{
+    Q_ASSERT(offset + count <= m_length);
+    while (count) {
+        unsigned int available = 0;
+        const sample_t *src = constSamples(offset, available);
+        const unsigned int len = qMin(count, available);
+        if (src == silentPage().constData() + (STRIPE_PAGE_SIZE - available))
+            memset(dst, 0x00, len * sizeof(sample_t));
+        else
+            MEMCPY(dst, src, len * sizeof(sample_t));
+        dst    += len;
+        offset += len;
+        count  -= len;
+    }
+}
+
 //***************************************************************************
 unsigned int Kwave::Stripe::resize(unsigned int length)
 {
     QMutexLocker lock(&m_lock);
 
-    unsigned int old_length = m_data.size();
-    if (old_length == length) return old_length; // nothing to do
+    if (m_length == length) return length; // nothing to do
 
-    if (!m_data.resize(length)) {
+    if (!unlockedResize(length)) {
         qWarning("Stripe::resize(%u) failed, out of memory ?", length);
-        return m_data.size();
+        return m_length;
     }
 
     return length;
@@ -145,19 +346,14 @@ unsigned int Kwave::Stripe::append(const Kwave::SampleArray &samples,
 
     QMutexLocker lock(&m_lock);
 
-    unsigned int old_length = m_data.size();
-    unsigned int new_length = old_length + count;
-    if (!m_data.resize(new_length))
+    const unsigned int old_length = m_length;
+    if (!unlockedResize(old_length + count))
         return 0; // out of memory
 
     // append to the end of the area
-    unsigned int cnt = new_length - old_length;
-    MEMCPY(m_data.data() + old_length,
-           samples.constData() + offset,
-           cnt * sizeof(sample_t)
-    );
+    unlockedWrite(old_length, samples.constData() + offset, count);
 
-    return cnt;
+    return count;
 }
 
 //***************************************************************************
@@ -167,7 +363,7 @@ void Kwave::Stripe::deleteRange(unsigned int offset, unsigned int length)
 
     QMutexLocker lock(&m_lock);
 
-    const unsigned int size = m_data.size();
+    const unsigned int size = m_length;
     if (!size) return;
 
     unsigned int first = offset;
@@ -180,17 +376,32 @@ void Kwave::Stripe::deleteRange(unsigned int offset, unsigned int length)
     Q_ASSERT(last >= first);
     if (last < first) return;
 
+    if (!first) {
+        // delete from the start: only drop pages, no need to copy
+        unlockedDeleteHead(last + 1);
+        return;
+    }
+
     // move all samples after the deleted area to the left
     unsigned int src = last + 1;
     unsigned int len = size - src;
-    if (len) {
-        unsigned int dst = first;
-        sample_t    *p   = m_data.data();
-        memmove(p + dst, p + src, len * sizeof(sample_t));
+    unsigned int dst = first;
+    while (len) {
+        // get the destination first, it might detach the source page
+        unsigned int dst_available = 0;
+        unsigned int src_available = 0;
+        sample_t *d = samples(dst, dst_available);
+        if (!d) return; // out of memory
+        const sample_t *s = constSamples(src, src_available);
+        const unsigned int n = qMin(len, qMin(dst_available, src_available));
+        memmove(d, s, n * sizeof(sample_t));
+        src += n;
+        dst += n;
+        len -= n;
     }
 
     // resize the buffer to it's new size
-    m_data.resize(size - length);
+    unlockedResize(size - (last - first + 1));
 }
 
 //***************************************************************************
@@ -198,16 +409,21 @@ bool Kwave::Stripe::combine(unsigned int offset, Kwave::Stripe &other)
 {
     // resize the storage if necessary
     const unsigned int combined_len = offset + other.length();
-    if (!resize(combined_len))
+    if (resize(combined_len) != combined_len)
         return false; // resizing failed, maybe OOM ?
 
     // copy the data from the other stripe
     QMutexLocker lock(&m_lock);
-    const sample_t *src = other.m_data.constData();
-    sample_t       *dst = this->m_data.data();
-    unsigned int    len = other.length() * sizeof(sample_t);
-    if (!src || !dst) return false; // src or dst does not exist
-    MEMCPY(dst + offset, src, len);
+    unsigned int pos   = 0;
+    unsigned int count = other.length();
+    while (count) {
+        unsigned int available = 0;
+        const sample_t *src = other.constSamples(pos, available);
+        const unsigned int len = qMin(count, available);
+        unlockedWrite(offset + pos, src, len);
+        pos   += len;
+        count -= len;
+    }
 
     return true;
 }
@@ -218,11 +434,7 @@ void Kwave::Stripe::overwrite(unsigned int offset,
         unsigned int srcoff, unsigned int srclen)
 {
     QMutexLocker lock(&m_lock);
-
-    const sample_t *src = source.constData();
-    sample_t       *dst = this->m_data.data();
-    unsigned int    len = srclen * sizeof(sample_t);
-    MEMCPY(dst + offset, src + srcoff, len);
+    unlockedWrite(offset, source.constData() + srcoff, srclen);
 }
 
 //***************************************************************************
@@ -232,9 +444,9 @@ unsigned int Kwave::Stripe::read(Kwave::SampleArray &buffer,
                                  unsigned int length)
 {
     QMutexLocker lock(&m_lock);
-    if (!length || m_data.isEmpty()) return 0; // nothing to do !?
+    if (!length || !m_length) return 0; // nothing to do !?
 
-    unsigned int current_len = m_data.size();
+    unsigned int current_len = m_length;
     Q_ASSERT(offset < current_len);
     if (offset >= current_len) return 0;
     if ((offset + length) > current_len)
@@ -242,11 +454,10 @@ unsigned int Kwave::Stripe::read(Kwave::SampleArray &buffer,
     Q_ASSERT(length);
     if (!length) return 0;
 
-    // directly memcpy
-    const sample_t *src = m_data.constData();
-    sample_t       *dst = buffer.data();
-    unsigned int    len = length * sizeof(sample_t);
-    MEMCPY(dst + dstoff, src + offset, len);
+    // copy page by page
+    sample_t *dst = buffer.data();
+    if (!dst) return 0;
+    unlockedRead(dst + dstoff, offset, length);
 
     return length;
 }
@@ -256,40 +467,68 @@ void Kwave::Stripe::minMax(unsigned int first, unsigned int last,
                            sample_t &min, sample_t &max)
 {
     QMutexLocker lock(&m_lock);
-    if (m_data.isEmpty()) return;
-
-    const sample_t *buffer = m_data.constData();
-    if (!buffer) return;
+    if (!m_length) return;
 
     // loop over the storage to get min/max
     sample_t lo = min;
     sample_t hi = max;
-    Q_ASSERT(first < m_data.size());
+    Q_ASSERT(first < m_length);
     Q_ASSERT(first <= last);
-    Q_ASSERT(last < m_data.size());
-    buffer += first;
-    unsigned int remaining = last - first + 1;
-
-    // speedup: process a block of 8 samples at once, to allow loop unrolling
-    const unsigned int block = 8;
-    while (Q_LIKELY(remaining >= block)) {
-        for (unsigned int count = 0; Q_LIKELY(count < block); count++) {
+    Q_ASSERT(last < m_length);
+
+    unsigned int offset = first;
+    unsigned int count  = last - first + 1;
+    while (count) {
+        unsigned int available = 0;
+        const sample_t *buffer = constSamples(offset, available);
+        unsigned int remaining = qMin(count, available);
+        const bool silence = isSilent(
+            m_pages[(m_head + offset) >> STRIPE_PAGE_SHIFT]);
+        offset += remaining;
+        count  -= remaining;
+
+        // silent pages need not be scanned
+        if (silence) {
+            if (lo > 0) lo = 0;
+            if (hi < 0) hi = 0;
+            continue;
+        }
+
+        // speedup: process a block of 8 samples at once,
+        // to allow loop unrolling
+        const unsigned int block = 8;
+        while (Q_LIKELY(remaining >= block)) {
+            for (unsigned int c = 0; Q_LIKELY(c < block); c++) {
+                sample_t s = *(buffer++);
+                if (Q_UNLIKELY(s < lo)) lo = s;
+                if (Q_UNLIKELY(s > hi)) hi = s;
+            }
+            remaining -= block;
+        }
+        while (Q_LIKELY(remaining)) {
             sample_t s = *(buffer++);
             if (Q_UNLIKELY(s < lo)) lo = s;
             if (Q_UNLIKELY(s > hi)) hi = s;
+            remaining--;
         }
-        remaining -= block;
-    }
-    while (Q_LIKELY(remaining)) {
-        sample_t s = *(buffer++);
-        if (Q_UNLIKELY(s < lo)) lo = s;
-        if (Q_UNLIKELY(s > hi)) hi = s;
-        remaining--;
     }
     min = lo;
     max = hi;
 }
 
+//***************************************************************************
+void Kwave::Stripe::memoryUsage(quint64 &shared, quint64 &exclusive) const
+{
+    for (const Kwave::SampleArray &page : m_pages) {
+        if (isSilent(page)) continue; // no memory of its own
+        const quint64 bytes = page.size() * sizeof(sample_t);
+        if (page.isShared())
+            shared += bytes;
+        else
+            exclusive += bytes;
+    }
+}
+
 //***************************************************************************
 Kwave::Stripe &Kwave::Stripe::operator << (const Kwave::SampleArray &samples)
 {
@@ -310,7 +549,11 @@ bool Kwave::Stripe::operator == (const Kwave::Stripe &other) const
 //***************************************************************************
 Kwave::Stripe &Kwave::Stripe::operator = (const Kwave::Stripe &other)
 {
-    m_data = other.m_data;
+    if (this != &other) {
+        m_pages  = other.m_pages;
+        m_head   = other.m_head;
+        m_length = other.m_length;
+    }
     return *this;
 }
 
@@ -28,6 +28,8 @@
 #include <QMutex>
 #include <QSharedData>
 
+#include <vector>
+
 #include "libkwave/Sample.h"
 #include "libkwave/SampleArray.h"
 
@@ -183,6 +185,18 @@ namespace Kwave
          */
         Stripe &operator << (const Kwave::SampleArray &samples);
 
+        /**
+         * Determines how much memory is used by the samples of the stripe.
+         * The samples are stored in pages, a copy of a stripe shares all
+         * pages with the original until one of them gets modified. Pages
+         * that contain only silence do not use any memory.
+         * @param shared receives the number of bytes in pages that are
+         *        also used by other stripes (added to the value)
+         * @param exclusive receives the number of bytes in pages that are
+         *        only used by this stripe (added to the value)
+         */
+        void memoryUsage(quint64 &shared, quint64 &exclusive) const;
+
         /** compare operator */
         bool operator == (const Stripe &other) const;
 
@@ -229,6 +243,77 @@ namespace Kwave
             sample_index_t m_right;
         };
 
+    private:
+
+        /**
+         * Returns a page filled with zeroes. All pages of silence share
+         * the storage of this one, until they get written.
+         */
+        static const Kwave::SampleArray &silentPage();
+
+        /**
+         * Checks whether a page shares the storage of the silent page
+         * @param page a page of a stripe
+         * @return true if the page contains only silence
+         */
+        static bool isSilent(const Kwave::SampleArray &page);
+
+        /**
+         * Resizes the stripe, without locking
+         * @param length new number of samples
+         * @return true if succeeded, false if out of memory
+         */
+        bool unlockedResize(unsigned int length);
+
+        /**
+         * Removes samples from the start of the stripe by dropping
+         * pages, without copying any samples
+         * @param length number of samples to remove, must not exceed
+         *        the length of the stripe
+         */
+        void unlockedDeleteHead(unsigned int length);
+
+        /**
+         * Copies samples from a buffer into the stripe, only the pages
+         * that are touched get detached from other stripes. Writing
+         * silence into a silent page does not detach it and a full page
+         * that becomes silent shares the silent page again.
+         * @param offset index of the first sample within the stripe
+         * @param src pointer to the source samples
+         * @param count number of samples, must fit into the stripe
+         */
+        void unlockedWrite(unsigned int offset, const sample_t *src,
+                           unsigned int count);
+
+        /**
+         * Copies samples from the stripe into a buffer
+         * @param dst pointer to the destination buffer
+         * @param offset index of the first sample within the stripe
+         * @param count number of samples, must fit into the stripe
+         */
+        void unlockedRead(sample_t *dst, unsigned int offset,
+                          unsigned int count) const;
+
+        /**
+         * Returns a read-only pointer to a sample
+         * @param offset index of the sample within the stripe
+         * @param available receives the number of samples that follow
+         *        in the same page, including the one at offset
+         * @return pointer to the sample
+         */
+        const sample_t *constSamples(unsigned int offset,
+                                     unsigned int &available) const;
+
+        /**
+         * Returns a writable pointer to a sample and detaches the page
+         * that contains it if necessary
+         * @param offset index of the sample within the stripe
+         * @param available receives the number of samples that follow
+         *        in the same page, including the one at offset
+         * @return pointer to the sample or null if out of memory
+         */
+        sample_t *samples(unsigned int offset, unsigned int &available);
+
     private:
 
         /** mutex for locking some operations */
@@ -237,8 +322,17 @@ namespace Kwave
         /** start position within the track */
         sample_index_t m_start;
 
-        /** pointer to the shared data */
-        Kwave::SampleArray m_data;
+        /**
+         * pages with the samples, all of them except the last one have
+         * exactly the page size, each one is shared separately
+         */
+        std::vector<Kwave::SampleArray> m_pages;
+
+        /** index of the first sample of the stripe within the first page */
+        unsigned int m_head;
+
+        /** number of samples */
+        unsigned int m_length;
 
     };
 }
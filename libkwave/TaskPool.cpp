@@ -0,0 +1,59 @@
+/***************************************************************************
+           TaskPool.cpp  -  application wide pool for worker tasks
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <QThread>
+#include <QThreadPool>
+
+#include "libkwave/TaskPool.h"
+
+/** time after which an idle worker thread exits [ms] */
+#define THREAD_EXPIRY_TIMEOUT 30000
+
+Q_GLOBAL_STATIC(QThreadPool, g_pool)
+
+//***************************************************************************
+QThreadPool *Kwave::TaskPool::pool()
+{
+    QThreadPool *pool = g_pool();
+    static bool initialized = [pool]() {
+        pool->setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+        pool->setExpiryTimeout(THREAD_EXPIRY_TIMEOUT);
+        pool->setObjectName(QStringLiteral("Kwave::TaskPool"));
+        return true;
+    }();
+    Q_UNUSED(initialized)
+    return pool;
+}
+
+//***************************************************************************
+void Kwave::TaskPool::setMaxThreads(int threads)
+{
+    if (threads <= 0) threads = QThread::idealThreadCount();
+    pool()->setMaxThreadCount(qMax(1, threads));
+    qDebug("TaskPool: using up to %d threads", maxThreads());
+}
+
+//***************************************************************************
+int Kwave::TaskPool::maxThreads()
+{
+    return pool()->maxThreadCount();
+}
+
+//***************************************************************************
+//***************************************************************************
@@ -0,0 +1,114 @@
+/***************************************************************************
+             TaskPool.h  -  application wide pool for worker tasks
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TASK_POOL_H
+#define TASK_POOL_H
+
+#include "config.h"
+#include "libkwave_export.h"
+
+#include <utility>
+
+#include <QtGlobal>
+#include <QFuture>
+#include <QThreadPool>
+#include <QtConcurrentRun>
+#include <QtConcurrentTask>
+
+namespace Kwave
+{
+
+    /**
+     * One bounded pool of worker threads for the whole application, shared
+     * by all open files, plugins and views. All short running parallel jobs
+     * should be started through this class instead of running their own
+     * threads or using QtConcurrent::run() directly, so that the number of
+     * busy threads never exceeds the number of cores, regardless of how
+     * many files are processed at the same time.
+     *
+     * Jobs with a higher priority are taken from the queue first, so that
+     * interactive work like rendering the display is not stuck behind the
+     * queue of a long batch operation.
+     *
+     * A thread that waits for the result of a job that has not been
+     * started yet takes it out of the queue and runs it by itself, so jobs
+     * may wait for the results of other jobs without blocking the pool.
+     */
+    class LIBKWAVE_EXPORT TaskPool
+    {
+    public:
+
+        /** priority of a job */
+        typedef enum {
+            Background  = 0, /**< batch processing, e.g. of a plugin  */
+            Normal      = 1, /**< default                             */
+            Interactive = 2  /**< user is waiting for it, e.g. display */
+        } Priority;
+
+        /** returns the thread pool, for use with QtConcurrent */
+        static QThreadPool *pool();
+
+        /**
+         * Sets the maximum number of worker threads
+         * @param threads number of threads, zero or less for using
+         *                one thread per core
+         */
+        static void setMaxThreads(int threads);
+
+        /** returns the maximum number of worker threads */
+        static int maxThreads();
+
+        /**
+         * Runs a function or a member function in the pool, with
+         * "Normal" priority
+         * @param f the function to call, e.g. &Class::method
+         * @param args the arguments, e.g. an object pointer and
+         *             the parameters
+         * @return a future that provides the result of the function
+         */
+        template <typename Function, typename... Args>
+        static auto run(Function &&f, Args &&...args)
+        {
+            return run(Normal, std::forward<Function>(f),
+                       std::forward<Args>(args)...);
+        }
+
+        /**
+         * Runs a function or a member function in the pool
+         * @param priority priority of the job
+         * @param f the function to call, e.g. &Class::method
+         * @param args the arguments, e.g. an object pointer and
+         *             the parameters
+         * @return a future that provides the result of the function
+         */
+        template <typename Function, typename... Args>
+        static auto run(Priority priority, Function &&f, Args &&...args)
+        {
+            return QtConcurrent::task(std::forward<Function>(f))
+                .withArguments(std::forward<Args>(args)...)
+                .withPriority(static_cast<int>(priority))
+                .onThreadPool(*pool())
+                .spawn();
+        }
+
+    };
+}
+
+#endif /* TASK_POOL_H */
+
+//***************************************************************************
+//***************************************************************************
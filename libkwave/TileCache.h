@@ -0,0 +1,243 @@
+/***************************************************************************
+            TileCache.h  -  base of caches for background computed tiles
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TILE_CACHE_H
+#define TILE_CACHE_H
+
+#include "config.h"
+
+#include <new>
+
+#include <QtGlobal>
+#include <QCache>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+
+#include "libkwave/MemoryBudget.h"
+#include "libkwave/Sample.h"
+
+namespace Kwave
+{
+    /**
+     * Base of the caches for tiles that are computed in the global thread
+     * pool, like the overview of a track or the columns of a sonagram.
+     * It keeps the finished tiles and the running jobs, derived classes
+     * start the jobs and tell which samples a tile depends on.
+     *
+     * The size of the cache follows the visible area. It is accounted in
+     * the MemoryBudget and evicts the least recently used tiles when the
+     * application runs short of memory, but never the visible ones.
+     *
+     * @tparam Key identifies a tile, needs "==" and a qHash() function
+     * @tparam Tile one tile or the result of one job, with its key in
+     *              the member "key"
+     */
+    template <class Key, class Tile> class TileCache:
+        public Kwave::MemoryConsumer
+    {
+    public:
+
+        /**
+         * Constructor
+         * @param min_cost minimum size of the cache [kilobytes]
+         */
+        explicit TileCache(qsizetype min_cost)
+            :Kwave::MemoryConsumer(), m_cache(min_cost), m_pending(),
+             m_stale(), m_min_cost(min_cost), m_visible_cost(0)
+        {
+            Kwave::MemoryBudget::instance().registerConsumer(this, nullptr);
+        }
+
+        /** Destructor, waits for all pending jobs */
+        ~TileCache() override
+        {
+            Kwave::MemoryBudget::instance().unregisterConsumer(this);
+
+            // the jobs own their readers and delete them when done
+            foreach (QFutureWatcher<Tile> *watcher, m_pending) {
+                watcher->disconnect();
+                watcher->waitForFinished();
+                delete watcher;
+            }
+            m_pending.clear();
+            m_stale.clear();
+            m_cache.clear();
+        }
+
+        /** discards all tiles */
+        void clear()
+        {
+            foreach (const Key &key, m_pending.keys())
+                m_stale.insert(key);
+            m_cache.clear();
+        }
+
+        /** @see Kwave::MemoryConsumer::memoryUsage */
+        qint64 memoryUsage(Kwave::MemoryConsumer::Kind kind) override
+        {
+            if (kind != Kwave::MemoryConsumer::Cache) return 0;
+            return static_cast<qint64>(m_cache.totalCost()) << 10;
+        }
+
+        /** @see Kwave::MemoryConsumer::releaseMemory */
+        qint64 releaseMemory(Kwave::MemoryConsumer::Kind kind,
+                             qint64 bytes) override
+        {
+            if (kind != Kwave::MemoryConsumer::Cache) return 0;
+
+            // shrinking the cache drops the least recently used tiles, the
+            // visible ones have been used last and are kept, otherwise they
+            // would be computed again and evicted again on the next check
+            const qint64 before = m_cache.totalCost();
+            const qint64 keep   = qMax<qint64>(m_visible_cost,
+                                               before - ((bytes + 1023) >> 10));
+            if (keep >= before) return 0;
+            const qsizetype max_cost = m_cache.maxCost();
+            m_cache.setMaxCost(static_cast<qsizetype>(keep));
+            m_cache.setMaxCost(max_cost);
+
+            return (before - m_cache.totalCost()) << 10;
+        }
+
+    protected:
+
+        /** returns the first sample a tile depends on */
+        virtual sample_index_t firstSample(const Key &key) const = 0;
+
+        /** returns the last sample a tile depends on */
+        virtual sample_index_t lastSample(const Key &key) const = 0;
+
+        /**
+         * Sets the cost of the visible tiles. The cache keeps four times
+         * as much, for scrolling back and forth, but at least the minimum.
+         * @param cost cost of the visible tiles [kilobytes]
+         */
+        void setVisibleCost(qint64 cost)
+        {
+            m_visible_cost = cost;
+            m_cache.setMaxCost(static_cast<qsizetype>(
+                qMax<qint64>(m_min_cost, 4 * cost)));
+        }
+
+        /**
+         * Looks up a finished tile and marks it as recently used
+         * @param key identifies the tile
+         * @return pointer to the tile or null if not in the cache
+         */
+        const Tile *cachedTile(const Key &key) {
+            return m_cache.object(key);
+        }
+
+        /** returns true if a finished tile is in the cache */
+        bool contains(const Key &key) const { return m_cache.contains(key); }
+
+        /** returns true if a job for a tile is running */
+        bool isPending(const Key &key) const {
+            return m_pending.contains(key);
+        }
+
+        /**
+         * Creates the watcher for a new job. The caller starts the job
+         * by setting the future of the watcher.
+         * @param key identifies the tile
+         * @param receiver parent of the watcher, gets notified when
+         *                 the job is done
+         * @param slot slot of the receiver, which calls takeResult()
+         * @return the watcher or null if out of memory
+         */
+        QFutureWatcher<Tile> *addJob(const Key &key, QObject *receiver,
+                                     const char *slot)
+        {
+            QFutureWatcher<Tile> *watcher =
+                new(std::nothrow) QFutureWatcher<Tile>(receiver);
+            Q_ASSERT(watcher);
+            if (!watcher) return nullptr;
+
+            QObject::connect(watcher, SIGNAL(finished()), receiver, slot);
+            m_pending.insert(key, watcher);
+            return watcher;
+        }
+
+        /**
+         * Takes over the result of a finished job, unless its samples
+         * have been invalidated in the meantime. In that case the tile
+         * is requested again on the next repaint.
+         * @param result the finished tile
+         * @param cost cost of the tile [kilobytes]
+         */
+        void takeResult(const Tile &result, int cost)
+        {
+            QFutureWatcher<Tile> *watcher = m_pending.take(result.key);
+            if (watcher) watcher->deleteLater();
+            if (m_stale.remove(result.key)) return;
+
+            // the cache limits itself to its maximum cost
+            Tile *copy = new(std::nothrow) Tile(result);
+            if (copy) m_cache.insert(result.key, copy, cost);
+        }
+
+        /**
+         * Discards all tiles that depend on samples of a given range
+         * @param first index of the first sample
+         * @param last index of the last sample
+         */
+        void discard(sample_index_t first, sample_index_t last)
+        {
+            foreach (const Key &key, m_cache.keys()) {
+                if ((lastSample(key) < first) || (firstSample(key) > last))
+                    continue;
+                m_cache.remove(key);
+            }
+
+            // tiles of the range that are currently computed are out of
+            // date, all others are still welcome
+            foreach (const Key &key, m_pending.keys()) {
+                if ((lastSample(key) < first) || (firstSample(key) > last))
+                    continue;
+                m_stale.insert(key);
+            }
+        }
+
+    private:
+
+        /** finished tiles, cost is in kilobytes */
+        QCache<Key, Tile> m_cache;
+
+        /** running jobs, to avoid duplicate requests */
+        QHash<Key, QFutureWatcher<Tile> *> m_pending;
+
+        /**
+         * running jobs of tiles with samples that have been invalidated
+         * while computing, their results are dropped
+         */
+        QSet<Key> m_stale;
+
+        /** minimum size of the cache [kilobytes] */
+        qsizetype m_min_cost;
+
+        /** cost of the visible tiles [kilobytes] */
+        qint64 m_visible_cost;
+
+    };
+}
+
+#endif /* TILE_CACHE_H */
+
+//***************************************************************************
+//***************************************************************************
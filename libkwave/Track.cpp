@@ -185,6 +185,14 @@ sample_index_t Kwave::Track::unlockedLength()
     return s.start() + s.length();
 }
 
+//***************************************************************************
+void Kwave::Track::memoryUsage(quint64 &shared, quint64 &exclusive)
+{
+    QMutexLocker lock(&m_lock);
+    for (const Stripe &stripe : m_stripes)
+        stripe.memoryUsage(shared, exclusive);
+}
+
 //***************************************************************************
 Kwave::Writer *Kwave::Track::openWriter(Kwave::InsertMode mode,
                                         sample_index_t left,
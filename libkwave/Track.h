@@ -143,6 +143,17 @@ namespace Kwave
         /** returns the unique ID of this track instance */
         const QUuid &uuid() const { return m_uuid; }
 
+        /**
+         * Determines how much memory is used by the samples of the track
+         * @param shared receives the number of bytes that are shared with
+         *        copies of the stripes, e.g. in the undo buffer or a
+         *        reader (added to the value)
+         * @param exclusive receives the number of bytes that are used
+         *        only by this track (added to the value)
+         * @see Kwave::Stripe::memoryUsage
+         */
+        void memoryUsage(quint64 &shared, quint64 &exclusive);
+
     public slots:
 
         /** toggles the selection of the slot on/off */
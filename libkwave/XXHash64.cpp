@@ -0,0 +1,179 @@
+/***************************************************************************
+           XXHash64.cpp  -  fast non-cryptographic 64 bit hash
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <string.h>
+
+#include <QtEndian>
+
+#include "libkwave/XXHash64.h"
+
+/* the five primes of XXH64 */
+static const quint64 PRIME1 = Q_UINT64_C(0x9E3779B185EBCA87);
+static const quint64 PRIME2 = Q_UINT64_C(0xC2B2AE3D27D4EB4F);
+static const quint64 PRIME3 = Q_UINT64_C(0x165667B19E3779F9);
+static const quint64 PRIME4 = Q_UINT64_C(0x85EBCA77C2B2AE63);
+static const quint64 PRIME5 = Q_UINT64_C(0x27D4EB2F165667C5);
+
+//***************************************************************************
+static inline quint64 rotl(quint64 x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+//***************************************************************************
+static inline quint64 read64(const char *p)
+{
+    return qFromLittleEndian<quint64>(p);
+}
+
+//***************************************************************************
+static inline quint32 read32(const char *p)
+{
+    return qFromLittleEndian<quint32>(p);
+}
+
+//***************************************************************************
+static inline quint64 mix(quint64 acc, quint64 input)
+{
+    acc += input * PRIME2;
+    acc  = rotl(acc, 31);
+    return acc * PRIME1;
+}
+
+//***************************************************************************
+static inline quint64 merge(quint64 acc, quint64 value)
+{
+    acc ^= mix(0, value);
+    return (acc * PRIME1) + PRIME4;
+}
+
+//***************************************************************************
+Kwave::XXHash64::XXHash64(quint64 seed)
+    :m_acc(), m_seed(seed), m_length(0), m_buffer(), m_buffered(0)
+{
+    reset(seed);
+}
+
+//***************************************************************************
+void Kwave::XXHash64::reset(quint64 seed)
+{
+    m_seed     = seed;
+    m_acc[0]   = seed + PRIME1 + PRIME2;
+    m_acc[1]   = seed + PRIME2;
+    m_acc[2]   = seed;
+    m_acc[3]   = seed - PRIME1;
+    m_length   = 0;
+    m_buffered = 0;
+}
+
+//***************************************************************************
+void Kwave::XXHash64::addStripe(const char *data)
+{
+    m_acc[0] = mix(m_acc[0], read64(data));
+    m_acc[1] = mix(m_acc[1], read64(data + 8));
+    m_acc[2] = mix(m_acc[2], read64(data + 16));
+    m_acc[3] = mix(m_acc[3], read64(data + 24));
+}
+
+//***************************************************************************
+void Kwave::XXHash64::addData(const char *data, qsizetype length)
+{
+    if (!data || (length <= 0)) return;
+    m_length += static_cast<quint64>(length);
+
+    // complete a partially filled stripe
+    if (m_buffered) {
+        const qsizetype n = qMin<qsizetype>(length, 32 - m_buffered);
+        memcpy(m_buffer + m_buffered, data, n);
+        m_buffered += static_cast<unsigned int>(n);
+        data       += n;
+        length     -= n;
+        if (m_buffered < 32) return;
+        addStripe(m_buffer);
+        m_buffered = 0;
+    }
+
+    // full stripes, directly out of the source
+    while (length >= 32) {
+        addStripe(data);
+        data   += 32;
+        length -= 32;
+    }
+
+    // keep the rest for later
+    if (length) {
+        memcpy(m_buffer, data, length);
+        m_buffered = static_cast<unsigned int>(length);
+    }
+}
+
+//***************************************************************************
+quint64 Kwave::XXHash64::result() const
+{
+    quint64 h;
+    if (m_length >= 32) {
+        h = rotl(m_acc[0], 1) + rotl(m_acc[1], 7) +
+            rotl(m_acc[2], 12) + rotl(m_acc[3], 18);
+        h = merge(h, m_acc[0]);
+        h = merge(h, m_acc[1]);
+        h = merge(h, m_acc[2]);
+        h = merge(h, m_acc[3]);
+    } else {
+        h = m_seed + PRIME5;
+    }
+    h += m_length;
+
+    // the remaining bytes, in steps of 8, 4 and 1
+    const char *p   = m_buffer;
+    const char *end = m_buffer + m_buffered;
+    while (p + 8 <= end) {
+        h ^= mix(0, read64(p));
+        h  = (rotl(h, 27) * PRIME1) + PRIME4;
+        p += 8;
+    }
+    if (p + 4 <= end) {
+        h ^= static_cast<quint64>(read32(p)) * PRIME1;
+        h  = (rotl(h, 23) * PRIME2) + PRIME3;
+        p += 4;
+    }
+    while (p < end) {
+        h ^= static_cast<quint64>(static_cast<quint8>(*p)) * PRIME5;
+        h  = rotl(h, 11) * PRIME1;
+        p++;
+    }
+
+    // final avalanche
+    h ^= h >> 33;
+    h *= PRIME2;
+    h ^= h >> 29;
+    h *= PRIME3;
+    h ^= h >> 32;
+    return h;
+}
+
+//***************************************************************************
+quint64 Kwave::XXHash64::hash(const QByteArray &data, quint64 seed)
+{
+    Kwave::XXHash64 h(seed);
+    h.addData(data);
+    return h.result();
+}
+
+//***************************************************************************
+//***************************************************************************
@@ -0,0 +1,100 @@
+/***************************************************************************
+             XXHash64.h  -  fast non-cryptographic 64 bit hash
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef XXHASH64_H
+#define XXHASH64_H
+
+#include "config.h"
+#include "libkwave_export.h"
+
+#include <QtGlobal>
+#include <QByteArray>
+
+namespace Kwave
+{
+
+    /**
+     * Streaming implementation of the XXH64 hash of the xxHash family by
+     * Yann Collet. It processes several GB per second and produces the same
+     * values as the reference implementation, so the results can be
+     * compared with the output of "xxhsum -H1".
+     */
+    class LIBKWAVE_EXPORT XXHash64
+    {
+    public:
+
+        /**
+         * Constructor
+         * @param seed start value of the hash
+         */
+        explicit XXHash64(quint64 seed = 0);
+
+        /**
+         * Discards all data and starts again
+         * @param seed start value of the hash
+         */
+        void reset(quint64 seed = 0);
+
+        /**
+         * Adds data to the hash
+         * @param data pointer to the first byte
+         * @param length number of bytes
+         */
+        void addData(const char *data, qsizetype length);
+
+        /** @see addData */
+        inline void addData(const QByteArray &data) {
+            addData(data.constData(), data.size());
+        }
+
+        /** returns the hash of all data added so far */
+        quint64 result() const;
+
+        /**
+         * Returns the hash of a block of data
+         * @param data the bytes to hash
+         * @param seed start value of the hash
+         */
+        static quint64 hash(const QByteArray &data, quint64 seed = 0);
+
+    private:
+
+        /** processes one stripe of 32 bytes */
+        void addStripe(const char *data);
+
+        /** the four accumulators */
+        quint64 m_acc[4];
+
+        /** the seed */
+        quint64 m_seed;
+
+        /** total number of bytes */
+        quint64 m_length;
+
+        /** data that did not fill a complete stripe */
+        char m_buffer[32];
+
+        /** number of bytes in m_buffer */
+        unsigned int m_buffered;
+
+    };
+}
+
+#endif /* XXHASH64_H */
+
+//***************************************************************************
+//***************************************************************************
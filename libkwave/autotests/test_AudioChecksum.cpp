@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: 2026 Thomas Eschenbacher <Thomas.Eschenbacher@gmx.de>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "AudioChecksum.h"
+#include "XXHash64.h"
+#include <QCryptographicHash>
+#include <QTest>
+#include <QVector>
+
+class TestAudioChecksum : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void xxh64();
+    void interleaved();
+};
+
+void TestAudioChecksum::xxh64()
+{
+    // reference values of the xxHash project
+    QCOMPARE(Kwave::XXHash64::hash(QByteArray()),
+             Q_UINT64_C(0xEF46DB3751D8E999));
+    QCOMPARE(Kwave::XXHash64::hash(QByteArray("abc")),
+             Q_UINT64_C(0x44BC2CF5AD770999));
+    const QByteArray text("Nobody inspects the spammish repetition");
+    QCOMPARE(Kwave::XXHash64::hash(text), Q_UINT64_C(0xFBCEA83C8A378BF1));
+
+    // adding the data in pieces gives the same result
+    Kwave::XXHash64 h;
+    for (int pos = 0; pos < text.size(); pos += 5)
+        h.addData(text.mid(pos, 5));
+    QCOMPARE(h.result(), Q_UINT64_C(0xFBCEA83C8A378BF1));
+}
+
+void TestAudioChecksum::interleaved()
+{
+    // two tracks with 16 bit, stored as 24 bit samples
+    const int length = 1000;
+    QVector<sample_t> left(length);
+    QVector<sample_t> right(length);
+    QByteArray raw_left;
+    QByteArray raw_right;
+    QByteArray raw_all;
+    for (int i = 0; i < length; ++i) {
+        const qint16 l = static_cast<qint16>(i * 37 - 20000);
+        const qint16 r = static_cast<qint16>(-i * 11);
+        left[i]  = l * 256;
+        right[i] = r * 256;
+        const char bytes[4] = {
+            static_cast<char>(l & 0xFF), static_cast<char>(l >> 8),
+            static_cast<char>(r & 0xFF), static_cast<char>(r >> 8)
+        };
+        raw_left.append(bytes, 2);
+        raw_right.append(bytes + 2, 2);
+        raw_all.append(bytes, 4);
+    }
+
+    // process the tracks in different blocks
+    Kwave::AudioChecksum checksum(2, 16);
+    checksum.process(0, left.constData(), 300);
+    checksum.process(1, right.constData(), 100);
+    checksum.combine();
+    checksum.process(1, right.constData() + 100, 900);
+    checksum.combine();
+    checksum.process(0, left.constData() + 300, 700);
+    checksum.combine();
+
+    const auto md5 = [](const QByteArray &data) {
+        return QString::fromLatin1(
+            QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex());
+    };
+    QCOMPARE(checksum.md5(0), md5(raw_left));
+    QCOMPARE(checksum.md5(1), md5(raw_right));
+    QCOMPARE(checksum.md5(), md5(raw_all));
+    QCOMPARE(checksum.xxh64(),
+             QString::number(Kwave::XXHash64::hash(raw_all), 16)
+                 .rightJustified(16, QLatin1Char('0')));
+}
+
+QTEST_MAIN(TestAudioChecksum)
+
+#include "test_AudioChecksum.moc"
@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: 2026 Thomas Eschenbacher <Thomas.Eschenbacher@gmx.de>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "modules/Convolver.h"
+#include <QRandomGenerator>
+#include <QTest>
+#include <QVector>
+#include <math.h>
+
+/** returns a vector with random values in [-1 ... +1] */
+static QVector<double> noise(int count, quint32 seed)
+{
+    QRandomGenerator random(seed);
+    QVector<double> values(count);
+    for (int i = 0; i < count; ++i)
+        values[i] = (2.0 * random.generateDouble()) - 1.0;
+    return values;
+}
+
+/** convolution in direct form, for reference */
+static QVector<double> direct(const QVector<double> &input,
+                              const QVector<double> &response)
+{
+    QVector<double> output(input.size(), 0.0);
+    for (int n = 0; n < input.size(); ++n) {
+        double sum = 0.0;
+        const int taps = qMin(response.size(), n + 1);
+        for (int k = 0; k < taps; ++k)
+            sum += response[k] * input[n - k];
+        output[n] = sum;
+    }
+    return output;
+}
+
+class TestConvolver : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void identity();
+    void matchesDirect_data();
+    void matchesDirect();
+    void mix();
+    void benchmarkDirect();
+    void benchmarkFFT();
+};
+
+void TestConvolver::identity()
+{
+    QVector<double> response(1, 1.0);
+    Kwave::Convolver convolver(response);
+    QVERIFY(convolver.isValid());
+    QCOMPARE(convolver.partitions(), 1U);
+
+    const QVector<double> input = noise(5000, 1);
+    QVector<double> output(input.size());
+    convolver.process(input.constData(), output.data(), 3000);
+    convolver.process(input.constData() + 3000, output.data() + 3000, 2000);
+    for (int i = 0; i < input.size(); ++i)
+        QVERIFY(fabs(output[i] - input[i]) < 1e-12);
+}
+
+void TestConvolver::matchesDirect_data()
+{
+    QTest::addColumn<int>("taps");
+    QTest::addColumn<int>("partition");
+    QTest::addColumn<int>("chunk");
+    QTest::newRow("short, one partition")   <<   100 <<   0 <<  777;
+    QTest::newRow("many partitions")        <<  3000 << 256 << 1000;
+    QTest::newRow("tiny chunks")            <<  1000 << 128 <<   33;
+    QTest::newRow("aligned chunks")         <<  2048 << 512 <<  512;
+    QTest::newRow("large chunks")           <<  5000 << 256 << 9000;
+}
+
+void TestConvolver::matchesDirect()
+{
+    QFETCH(int, taps);
+    QFETCH(int, partition);
+    QFETCH(int, chunk);
+
+    const QVector<double> response = noise(taps, 2);
+    const QVector<double> input    = noise(20000, 3);
+    const QVector<double> expected = direct(input, response);
+
+    Kwave::Convolver convolver(response, partition);
+    QVERIFY(convolver.isValid());
+
+    // in place, in chunks that do not fit to the partitions
+    QVector<double> output = input;
+    for (int pos = 0; pos < output.size(); pos += chunk)
+        convolver.process(output.constData() + pos, output.data() + pos,
+                          qMin(chunk, output.size() - pos));
+
+    for (int i = 0; i < output.size(); ++i)
+        QVERIFY(fabs(output[i] - expected[i]) < 1e-9);
+}
+
+void TestConvolver::mix()
+{
+    // a delay of ten samples, half wet and half dry
+    QVector<double> response(11, 0.0);
+    response[10] = 1.0;
+    Kwave::Convolver convolver(response);
+    convolver.setMix(QVariant(0.5));
+
+    const QVector<double> input = noise(2000, 4);
+    QVector<double> output(input.size());
+    convolver.process(input.constData(), output.data(), input.size());
+    for (int i = 10; i < input.size(); ++i)
+        QVERIFY(fabs(output[i] - 0.5 * (input[i] + input[i - 10])) < 1e-12);
+}
+
+void TestConvolver::benchmarkDirect()
+{
+    const QVector<double> response = noise(4096, 5);
+    const QVector<double> input    = noise(32768, 6);
+    QVector<double> output;
+    QBENCHMARK {
+        output = direct(input, response);
+    }
+    QCOMPARE(output.size(), input.size());
+}
+
+void TestConvolver::benchmarkFFT()
+{
+    const QVector<double> response = noise(4096, 5);
+    const QVector<double> input    = noise(32768, 6);
+    QVector<double> output(input.size());
+    Kwave::Convolver convolver(response);
+    QBENCHMARK {
+        convolver.process(input.constData(), output.data(), input.size());
+    }
+}
+
+QTEST_MAIN(TestConvolver)
+
+#include "test_Convolver.moc"
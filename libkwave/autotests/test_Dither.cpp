@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: 2026 Thomas Eschenbacher <Thomas.Eschenbacher@gmx.de>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Dither.h"
+#include <QTest>
+#include <QVector>
+#include <math.h>
+
+/** one step of a 16 bit sample, in Kwave's internal resolution */
+static const sample_t STEP = 1 << (SAMPLE_BITS - 16);
+
+class TestDither : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void lowerBitsCleared_data();
+    void lowerBitsCleared();
+    void noBias();
+    void exactInputUnchanged();
+    void inactive();
+};
+
+void TestDither::lowerBitsCleared_data()
+{
+    QTest::addColumn<int>("shaping");
+    QTest::newRow("flat")        << int(Kwave::Dither::Flat);
+    QTest::newRow("first order") << int(Kwave::Dither::FirstOrder);
+    QTest::newRow("e-weighted")  << int(Kwave::Dither::EWeighted);
+    QTest::newRow("f-weighted")  << int(Kwave::Dither::FWeighted);
+}
+
+void TestDither::lowerBitsCleared()
+{
+    QFETCH(int, shaping);
+    Kwave::Dither dither(16, Kwave::Dither::Triangular,
+                         static_cast<Kwave::Dither::Shaping>(shaping), 1);
+    QVERIFY(dither.isActive());
+
+    // a full scale sine, which also hits the limits
+    QVector<sample_t> samples(100000);
+    for (int i = 0; i < samples.size(); ++i)
+        samples[i] = static_cast<sample_t>(
+            SAMPLE_MAX * sin(2.0 * M_PI * 0.0123 * i));
+    const QVector<sample_t> original = samples;
+
+    // interleaved with stride 2, in blocks of odd sizes
+    for (int i = 0; i < samples.size() / 2; i += 777)
+        dither.process(samples.data() + (2 * i),
+                       qMin(777, (samples.size() / 2) - i), 2);
+
+    for (int i = 0; i < samples.size(); ++i) {
+        if (i & 1) {
+            QCOMPARE(samples[i], original[i]);
+        } else {
+            QCOMPARE(samples[i] & (STEP - 1), 0);
+            QVERIFY(samples[i] >= SAMPLE_MIN);
+            QVERIFY(samples[i] <= SAMPLE_MAX);
+        }
+    }
+}
+
+void TestDither::noBias()
+{
+    // a DC offset of a fraction of one step must be kept on average
+    Kwave::Dither dither(16, Kwave::Dither::Triangular,
+                         Kwave::Dither::Flat, 2);
+    QVector<sample_t> samples(100000, (3 * STEP) / 10);
+    dither.process(samples.data(), samples.size());
+
+    double sum = 0.0;
+    for (int i = 0; i < samples.size(); ++i)
+        sum += samples[i];
+    const double mean = sum / (samples.size() * STEP);
+    QVERIFY(fabs(mean - 0.3) < 0.01);
+}
+
+void TestDither::exactInputUnchanged()
+{
+    // samples that already fit into 16 bits, e.g. from a 16 bit file
+    Kwave::Dither dither(16, Kwave::Dither::Triangular,
+                         Kwave::Dither::EWeighted, 3);
+    QVector<sample_t> samples(20000);
+    for (int i = 0; i < samples.size(); ++i)
+        samples[i] = ((i * 37) % 2001 - 1000) * STEP;
+    const QVector<sample_t> original = samples;
+
+    for (int i = 0; i < samples.size(); i += 1000)
+        dither.process(samples.data() + i, 1000);
+
+    // after some samples the dither has to detect it and turn off
+    for (int i = 5000; i < samples.size(); ++i)
+        QCOMPARE(samples[i], original[i]);
+}
+
+void TestDither::inactive()
+{
+    QVERIFY(!Kwave::Dither(24, Kwave::Dither::Triangular,
+                           Kwave::Dither::Flat).isActive());
+    QVERIFY(!Kwave::Dither(32, Kwave::Dither::Triangular,
+                           Kwave::Dither::Flat).isActive());
+    QVERIFY(!Kwave::Dither(16, Kwave::Dither::None,
+                           Kwave::Dither::FWeighted).isActive());
+}
+
+QTEST_MAIN(TestDither)
+#include "test_Dither.moc"
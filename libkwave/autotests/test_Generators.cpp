@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: 2026 Thomas Eschenbacher <Thomas.Eschenbacher@gmx.de>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "modules/PhasorOscillator.h"
+#include "modules/RandomNoise.h"
+#include "modules/SweepGenerator.h"
+#include <QTest>
+#include <QVector>
+#include <math.h>
+
+class TestGenerators : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void phasorOscillator();
+    void linearSweep();
+    void logarithmicSweep();
+    void noiseRange_data();
+    void noiseRange();
+    void noiseIsReproducible();
+};
+
+/** generates in blocks of odd sizes, to cover the partial lane groups */
+template <class T> static void generate(T &gen, QVector<float> &buffer)
+{
+    static const unsigned int sizes[] = { 7, 1000, 4096, 3, 25000 };
+    unsigned int pos = 0;
+    unsigned int s   = 0;
+    while (pos < static_cast<unsigned int>(buffer.size())) {
+        unsigned int n = qMin<unsigned int>(sizes[s++ % 5],
+            static_cast<unsigned int>(buffer.size()) - pos);
+        gen.generate(buffer.data() + pos, n);
+        pos += n;
+    }
+}
+
+void TestGenerators::phasorOscillator()
+{
+    Kwave::PhasorOscillator osc;
+    osc.setFrequency(0.01234);
+    osc.setPhase(0.3);
+
+    QVector<float> buffer(1000003);
+    generate(osc, buffer);
+
+    double max_error = 0.0;
+    for (int i = 0; i < buffer.size(); ++i) {
+        const double expected = sin(0.3 + (2.0 * M_PI * 0.01234 * i));
+        max_error = qMax(max_error, fabs(buffer[i] - expected));
+    }
+    QVERIFY(max_error < 1.0E-6);
+}
+
+void TestGenerators::linearSweep()
+{
+    const double f0 = 0.001;
+    const double f1 = 0.45;
+    const double length = 100000;
+    Kwave::SweepGenerator sweep;
+    sweep.setSweep(f0, f1, 100000, false);
+
+    QVector<float> buffer(150000);
+    generate(sweep, buffer);
+
+    double max_error = 0.0;
+    for (int i = 0; i < buffer.size(); ++i) {
+        double n    = i;
+        double rest = 0.0;
+        if (n > length) {
+            rest = 2.0 * M_PI * f1 * (n - length);
+            n    = length;
+        }
+        const double phi = rest +
+            (2.0 * M_PI * ((f0 * n) + ((f1 - f0) * n * n / (2.0 * length))));
+        max_error = qMax(max_error, fabs(buffer[i] - sin(phi)));
+    }
+    QVERIFY(max_error < 1.0E-6);
+}
+
+void TestGenerators::logarithmicSweep()
+{
+    const double f0 = 0.001;
+    const double f1 = 0.45;
+    const double length = 480000;
+    const double k = log(f1 / f0) / length;
+    Kwave::SweepGenerator sweep;
+    sweep.setSweep(f0, f1, 480000, true);
+
+    QVector<float> buffer(480000);
+    generate(sweep, buffer);
+
+    double max_error = 0.0;
+    for (int i = 0; i < buffer.size(); ++i) {
+        const double phi = 2.0 * M_PI * f0 * expm1(k * i) / k;
+        max_error = qMax(max_error, fabs(buffer[i] - sin(phi)));
+    }
+    QVERIFY(max_error < 1.0E-5);
+}
+
+void TestGenerators::noiseRange_data()
+{
+    QTest::addColumn<int>("shape");
+    QTest::addColumn<double>("rms");
+
+    QTest::newRow("white") << int(Kwave::RandomNoise::White) << 0.577;
+    QTest::newRow("tpdf")  << int(Kwave::RandomNoise::Tpdf)  << 0.408;
+    QTest::newRow("pink")  << int(Kwave::RandomNoise::Pink)  << 0.215;
+}
+
+void TestGenerators::noiseRange()
+{
+    QFETCH(int, shape);
+    QFETCH(double, rms);
+
+    Kwave::RandomNoise noise(42);
+    noise.setShape(static_cast<Kwave::RandomNoise::Shape>(shape));
+    QVector<float> buffer(1 << 20);
+    generate(noise, buffer);
+
+    double sum  = 0.0;
+    double sum2 = 0.0;
+    for (float f : buffer) {
+        QVERIFY((f >= -1.0f) && (f <= 1.0f));
+        sum  += f;
+        sum2 += f * f;
+    }
+    const double n = buffer.size();
+    QVERIFY(fabs(sum / n) < 0.01);
+    QVERIFY(fabs(sqrt(sum2 / n) - rms) < 0.02);
+}
+
+void TestGenerators::noiseIsReproducible()
+{
+    Kwave::RandomNoise a(1234);
+    Kwave::RandomNoise b(1234);
+    QVector<float> buffer_a(10000);
+    QVector<float> buffer_b(10000);
+    a.generate(buffer_a.data(), 10000);
+    b.generate(buffer_b.data(), 10000);
+    QCOMPARE(buffer_a, buffer_b);
+}
+
+QTEST_MAIN(TestGenerators)
+#include "test_Generators.moc"
@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: 2026 Thomas Eschenbacher <Thomas.Eschenbacher@gmx.de>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Curve.h"
+#include "Interpolation.h"
+#include "modules/CurveStreamAdapter.h"
+#include <QTest>
+#include <QVector>
+#include <QtMath>
+
+class TestInterpolation : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void interpolateRange_data();
+    void interpolateRange();
+    void benchmarkSingle();
+    void benchmarkAdapter();
+};
+
+/** creates a curve with a number of points, spread over [0 ... 1] */
+static void fillCurve(Kwave::Curve &curve, unsigned int points)
+{
+    for (unsigned int i = 0; i < points; ++i) {
+        const double x = static_cast<double>(i) / (points - 1);
+        curve.insert(x, 0.5 + 0.4 * qSin(x * 17.0));
+    }
+}
+
+void TestInterpolation::interpolateRange_data()
+{
+    QTest::addColumn<int>("type");
+    QTest::newRow("linear")      << int(Kwave::INTPOL_LINEAR);
+    QTest::newRow("spline")      << int(Kwave::INTPOL_SPLINE);
+    QTest::newRow("n-polynom")   << int(Kwave::INTPOL_NPOLYNOMIAL);
+    QTest::newRow("3-polynom")   << int(Kwave::INTPOL_POLYNOMIAL3);
+    QTest::newRow("5-polynom")   << int(Kwave::INTPOL_POLYNOMIAL5);
+    QTest::newRow("7-polynom")   << int(Kwave::INTPOL_POLYNOMIAL7);
+    QTest::newRow("sample_hold") << int(Kwave::INTPOL_SAH);
+}
+
+void TestInterpolation::interpolateRange()
+{
+    QFETCH(int, type);
+
+    Kwave::Curve curve;
+    curve.setInterpolationType(static_cast<Kwave::interpolation_t>(type));
+    fillCurve(curve, 9);
+    Kwave::Interpolation &interpolation = curve.interpolation();
+
+    const sample_index_t length = 10007;
+    QVector<double> expected(length + 1);
+    for (sample_index_t pos = 0; pos <= length; ++pos)
+        expected[pos] = interpolation.singleInterpolation(
+            static_cast<double>(pos) / static_cast<double>(length));
+
+    // use odd block sizes, so that blocks end within segments
+    QVector<double> block(1000);
+    for (unsigned int size : {1U, 7U, 333U, 1000U}) {
+        sample_index_t pos = 0;
+        while (pos <= length) {
+            const unsigned int n = static_cast<unsigned int>(
+                qMin<sample_index_t>(size, length - pos + 1));
+            interpolation.interpolateRange(pos, length, block.data(), n);
+            for (unsigned int k = 0; k < n; ++k)
+                QVERIFY(qAbs(block[k] - expected[pos + k]) < 1E-9);
+            pos += n;
+        }
+    }
+}
+
+void TestInterpolation::benchmarkSingle()
+{
+    Kwave::Curve curve;
+    fillCurve(curve, 200);
+    Kwave::Interpolation &interpolation = curve.interpolation();
+
+    const sample_index_t length = 1000000;
+    double sum = 0.0;
+    QBENCHMARK {
+        for (sample_index_t pos = 0; pos < length; ++pos)
+            sum += interpolation.singleInterpolation(
+                static_cast<double>(pos) / static_cast<double>(length));
+    }
+    QVERIFY(sum > 0.0);
+}
+
+void TestInterpolation::benchmarkAdapter()
+{
+    Kwave::Curve curve;
+    fillCurve(curve, 200);
+
+    const sample_index_t length = 1000000;
+    Kwave::CurveStreamAdapter adapter(curve, length);
+    const sample_index_t blocks = length / adapter.blockSize();
+    QBENCHMARK {
+        for (sample_index_t i = 0; i < blocks; ++i)
+            adapter.goOn();
+    }
+}
+
+QTEST_MAIN(TestInterpolation)
+
+#include "test_Interpolation.moc"
@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: 2026 Thomas Eschenbacher <Thomas.Eschenbacher@gmx.de>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Label.h"
+#include "LabelIndex.h"
+#include "LabelList.h"
+#include "MetaDataList.h"
+#include <QTest>
+
+class TestLabelIndex : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void rebuild();
+    void insertRemove();
+    void insertList();
+    void nearest();
+    void range();
+};
+
+static Kwave::MetaDataList someLabels()
+{
+    Kwave::MetaDataList list;
+    list.add(Kwave::Label(300, QStringLiteral("c")));
+    list.add(Kwave::Label(100, QStringLiteral("a")));
+    list.add(Kwave::Label(200, QStringLiteral("b")));
+    return list;
+}
+
+void TestLabelIndex::rebuild()
+{
+    Kwave::LabelIndex index;
+    QVERIFY(!index.isValid());
+
+    index.rebuild(someLabels());
+    QVERIFY(index.isValid());
+    QCOMPARE(index.count(), 3);
+    QCOMPARE(index.at(0).pos(), sample_index_t(100));
+    QCOMPARE(index.at(2).pos(), sample_index_t(300));
+    QCOMPARE(index.find(200), 1);
+    QCOMPARE(index.find(201), -1);
+    QCOMPARE(index.indexOf(Kwave::Label(300, QStringLiteral("c"))), 2);
+    QCOMPARE(index.indexOf(Kwave::Label(300, QStringLiteral("x"))), -1);
+
+    index.invalidate();
+    QVERIFY(!index.isValid());
+    QVERIFY(index.isEmpty());
+}
+
+void TestLabelIndex::insertRemove()
+{
+    Kwave::LabelIndex index;
+    index.rebuild(someLabels());
+
+    Kwave::Label label(150, QStringLiteral("new"));
+    QCOMPARE(index.insert(label), 1);
+    QCOMPARE(index.count(), 4);
+    QCOMPARE(index.at(1).name(), QStringLiteral("new"));
+
+    QVERIFY(index.remove(label));
+    QVERIFY(!index.remove(label));
+    QCOMPARE(index.count(), 3);
+    QCOMPARE(index.find(150), -1);
+
+    index.removeAt(0);
+    QCOMPARE(index.at(0).pos(), sample_index_t(200));
+}
+
+void TestLabelIndex::insertList()
+{
+    Kwave::LabelIndex index;
+    index.rebuild(someLabels());
+
+    Kwave::LabelList list;
+    list.append(Kwave::Label(400, QStringLiteral("e")));
+    list.append(Kwave::Label(50,  QStringLiteral("first")));
+    list.append(Kwave::Label(200, QStringLiteral("b2")));
+    index.insert(list);
+
+    QCOMPARE(index.count(), 6);
+    for (int i = 1; i < index.count(); ++i)
+        QVERIFY(index.at(i - 1).pos() <= index.at(i).pos());
+    QCOMPARE(index.at(0).name(), QStringLiteral("first"));
+    QCOMPARE(index.at(2).name(), QStringLiteral("b"));
+    QCOMPARE(index.at(3).name(), QStringLiteral("b2"));
+    QCOMPARE(index.at(5).name(), QStringLiteral("e"));
+}
+
+void TestLabelIndex::nearest()
+{
+    Kwave::LabelIndex index;
+    index.rebuild(someLabels());
+
+    QCOMPARE(index.nextLabelLeft(200), sample_index_t(100));
+    QCOMPARE(index.nextLabelLeft(100), sample_index_t(0));
+    QCOMPARE(index.nextLabelRight(200), sample_index_t(300));
+    QCOMPARE(index.nextLabelRight(300), SAMPLE_INDEX_MAX);
+
+    // same results as the linear search of the label list
+    Kwave::LabelList list(someLabels());
+    for (sample_index_t pos = 0; pos < 400; pos += 50) {
+        QCOMPARE(index.nextLabelLeft(pos), list.nextLabelLeft(pos));
+        QCOMPARE(index.nextLabelRight(pos), list.nextLabelRight(pos));
+    }
+}
+
+void TestLabelIndex::range()
+{
+    Kwave::LabelIndex index;
+    index.rebuild(someLabels());
+
+    QCOMPARE(index.range(100, 200).count(), 2);
+    QCOMPARE(index.range(101, 299).count(), 1);
+    QCOMPARE(index.range(301, 400).count(), 0);
+    QCOMPARE(index.range(200, 100).count(), 0);
+    QCOMPARE(index.lowerBound(150), 1);
+    QCOMPARE(index.upperBound(300), 3);
+}
+
+QTEST_MAIN(TestLabelIndex)
+
+#include "test_LabelIndex.moc"
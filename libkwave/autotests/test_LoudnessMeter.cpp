@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: 2026 Thomas Eschenbacher <Thomas.Eschenbacher@gmx.de>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "modules/LoudnessMeter.h"
+#include <QTest>
+#include <QVector>
+#include <math.h>
+
+static const int RATE = 48000;
+
+class TestLoudnessMeter : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void sine();
+    void truePeak();
+    void loudnessRange();
+    void silence();
+};
+
+/** fills a buffer with a sine, amplitude relative to full scale */
+static void sine(QVector<sample_t> &buffer, double f, double amplitude,
+                 double phase = 0.0)
+{
+    const double scale = amplitude * (1 << (SAMPLE_BITS - 1));
+    for (int i = 0; i < buffer.size(); ++i)
+        buffer[i] = static_cast<sample_t>(lrint(
+            scale * sin((2.0 * M_PI * f * i / RATE) + phase)));
+}
+
+void TestLoudnessMeter::sine()
+{
+    // EBU Tech 3341: stereo 1kHz sine at -20dBFS reads -20 LUFS
+    QVector<sample_t> buffer(10 * RATE);
+    ::sine(buffer, 1000.0, 0.1);
+
+    Kwave::LoudnessMeter meter(RATE, 2);
+    for (int pos = 0; pos < buffer.size(); pos += 4000) {
+        meter.process(0, buffer.constData() + pos, 4000);
+        meter.process(1, buffer.constData() + pos, 4000);
+    }
+    QVERIFY(fabs(meter.integrated() + 20.0) < 0.1);
+    QVERIFY(fabs(meter.momentary()  + 20.0) < 0.1);
+    QVERIFY(fabs(meter.shortTerm()  + 20.0) < 0.1);
+    QVERIFY(meter.loudnessRange() < 0.1);
+}
+
+void TestLoudnessMeter::truePeak()
+{
+    // sine at a quarter of the sample rate, sampled 45 degrees off the
+    // peak: the sample peak is 3dB below the true peak
+    QVector<sample_t> buffer(RATE);
+    ::sine(buffer, RATE / 4, 0.5, M_PI / 4);
+
+    Kwave::LoudnessMeter meter(RATE, 1);
+    meter.process(0, buffer.constData(), buffer.size());
+    QVERIFY(fabs(20.0 * log10(meter.truePeak() / 0.5)) < 0.2);
+}
+
+void TestLoudnessMeter::loudnessRange()
+{
+    // 20 seconds at -20 LUFS followed by 20 seconds at -30 LUFS
+    QVector<sample_t> buffer(20 * RATE);
+    Kwave::LoudnessMeter meter(RATE, 2);
+    ::sine(buffer, 1000.0, 0.1);
+    meter.process(0, buffer.constData(), buffer.size());
+    meter.process(1, buffer.constData(), buffer.size());
+    ::sine(buffer, 1000.0, 0.1 / sqrt(10.0));
+    meter.process(0, buffer.constData(), buffer.size());
+    meter.process(1, buffer.constData(), buffer.size());
+
+    QVERIFY(fabs(meter.loudnessRange() - 10.0) < 0.2);
+}
+
+void TestLoudnessMeter::silence()
+{
+    QVector<sample_t> buffer(RATE, 0);
+    Kwave::LoudnessMeter meter(RATE, 1);
+    meter.process(0, buffer.constData(), buffer.size());
+    QVERIFY(std::isinf(meter.integrated()));
+    QCOMPARE(meter.truePeak(), 0.0);
+}
+
+QTEST_MAIN(TestLoudnessMeter)
+#include "test_LoudnessMeter.moc"
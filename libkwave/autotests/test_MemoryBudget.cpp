@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: 2026 Thomas Eschenbacher <Thomas.Eschenbacher@gmx.de>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "MemoryBudget.h"
+#include "TaskPool.h"
+#include <QTest>
+
+/** one megabyte */
+static const qint64 MB = 1024 * 1024;
+
+/** consumer with a fixed amount of memory of each kind */
+class TestConsumer: public Kwave::MemoryConsumer
+{
+public:
+    TestConsumer(qint64 samples, qint64 undo, qint64 cache)
+        :m_samples(samples), m_undo(undo), m_cache(cache)
+    {
+    }
+
+    qint64 memoryUsage(Kind kind) override
+    {
+        switch (kind) {
+            case Samples: return m_samples;
+            case Undo:    return m_undo;
+            case Cache:   return m_cache;
+        }
+        return 0;
+    }
+
+    qint64 releaseMemory(Kind kind, qint64 bytes) override
+    {
+        qint64 &used = (kind == Undo) ? m_undo : m_cache;
+        const qint64 released = qMin(used, bytes);
+        used -= released;
+        return released;
+    }
+
+    qint64 m_samples;
+    qint64 m_undo;
+    qint64 m_cache;
+};
+
+class TestMemoryBudget : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void accounting();
+    void cachesFirst();
+    void undoWhenNeeded();
+    void taskPool();
+};
+
+void TestMemoryBudget::accounting()
+{
+    TestConsumer a(10 * MB, 2 * MB, 1 * MB);
+    TestConsumer b(20 * MB, 4 * MB, 3 * MB);
+    TestConsumer shared(0, 0, 5 * MB);
+    int doc_a = 0;
+    int doc_b = 0;
+
+    Kwave::MemoryBudget &budget = Kwave::MemoryBudget::instance();
+    budget.registerConsumer(&a, &doc_a);
+    budget.registerConsumer(&b, &doc_b);
+    budget.registerConsumer(&shared, nullptr);
+
+    QCOMPARE(budget.usage(&doc_a, Kwave::MemoryConsumer::Samples), 10 * MB);
+    QCOMPARE(budget.usage(&doc_b, Kwave::MemoryConsumer::Undo), 4 * MB);
+    QCOMPARE(budget.usage(nullptr, Kwave::MemoryConsumer::Samples), 30 * MB);
+    QVERIFY(budget.usage(nullptr, Kwave::MemoryConsumer::Cache) >= 9 * MB);
+
+    budget.unregisterConsumer(&a);
+    budget.unregisterConsumer(&b);
+    budget.unregisterConsumer(&shared);
+    QCOMPARE(budget.usage(&doc_a, Kwave::MemoryConsumer::Samples), 0);
+}
+
+void TestMemoryBudget::cachesFirst()
+{
+    TestConsumer a(60 * MB, 10 * MB, 10 * MB);
+    TestConsumer b(20 * MB, 10 * MB, 30 * MB);
+    int doc_a = 0;
+    int doc_b = 0;
+
+    Kwave::MemoryBudget &budget = Kwave::MemoryBudget::instance();
+    budget.registerConsumer(&a, &doc_a);
+    budget.registerConsumer(&b, &doc_b);
+
+    // 140MB in use, limit 120MB -> down to 108MB, only caches
+    // are released, the largest one first
+    budget.setLimit(120);
+    budget.enforce();
+    QCOMPARE(b.m_cache, 0);
+    QCOMPARE(a.m_cache, 8 * MB);
+    QCOMPARE(a.m_undo, 10 * MB);
+    QCOMPARE(b.m_undo, 10 * MB);
+    QCOMPARE(a.m_samples, 60 * MB);
+
+    budget.unregisterConsumer(&a);
+    budget.unregisterConsumer(&b);
+    budget.setLimit(0);
+}
+
+void TestMemoryBudget::undoWhenNeeded()
+{
+    TestConsumer a(60 * MB, 30 * MB, 5 * MB);
+    int doc_a = 0;
+
+    Kwave::MemoryBudget &budget = Kwave::MemoryBudget::instance();
+    budget.registerConsumer(&a, &doc_a);
+
+    // 95MB in use, limit 80MB -> down to 72MB, sample data stays
+    budget.setLimit(80);
+    budget.enforce();
+    QCOMPARE(a.m_cache, 0);
+    QCOMPARE(a.m_undo, 12 * MB);
+    QCOMPARE(a.m_samples, 60 * MB);
+
+    // samples above the low water mark: only down to the limit
+    budget.setLimit(64);
+    budget.enforce();
+    QCOMPARE(a.m_undo, 4 * MB);
+
+    // samples alone over the limit: releasing would not help,
+    // the undo data survives
+    budget.setLimit(50);
+    budget.enforce();
+    QCOMPARE(a.m_undo, 4 * MB);
+    QCOMPARE(a.m_samples, 60 * MB);
+
+    budget.unregisterConsumer(&a);
+    budget.setLimit(0);
+}
+
+/** helper for taskPool(): returns the square of a number */
+static int square(int x)
+{
+    return x * x;
+}
+
+void TestMemoryBudget::taskPool()
+{
+    Kwave::TaskPool::setMaxThreads(2);
+    QCOMPARE(Kwave::TaskPool::maxThreads(), 2);
+
+    QList< QFuture<int> > jobs;
+    for (int i = 0; i < 16; ++i)
+        jobs.append(Kwave::TaskPool::run(Kwave::TaskPool::Background,
+                                         square, i));
+    int sum = 0;
+    for (QFuture<int> &job : jobs)
+        sum += job.result();
+    QCOMPARE(sum, 1240);
+
+    Kwave::TaskPool::setMaxThreads(0);
+    QVERIFY(Kwave::TaskPool::maxThreads() >= 1);
+}
+
+QTEST_MAIN(TestMemoryBudget)
+
+#include "test_MemoryBudget.moc"
@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: 2026 Thomas Eschenbacher <Thomas.Eschenbacher@gmx.de>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "MixerMatrix.h"
+#include <QRandomGenerator>
+#include <QTest>
+#include <QVector>
+#include <stdlib.h>
+
+Q_DECLARE_METATYPE(Kwave::MixerMatrix::Type)
+
+/** returns a vector with random samples in the range of sample_t */
+static QVector<sample_t> noise(int count, quint32 seed)
+{
+    QRandomGenerator random(seed);
+    QVector<sample_t> samples(count);
+    for (int i = 0; i < count; ++i)
+        samples[i] = random.bounded(SAMPLE_MIN, SAMPLE_MAX);
+    return samples;
+}
+
+class TestMixerMatrix : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void classify_data();
+    void classify();
+    void mix_data();
+    void mix();
+    void clip();
+    void benchmarkMix();
+};
+
+void TestMixerMatrix::classify_data()
+{
+    QTest::addColumn<unsigned int>("inputs");
+    QTest::addColumn<unsigned int>("outputs");
+    QTest::addColumn<Kwave::MixerMatrix::Type>("type");
+    QTest::newRow("stereo")       << 2U << 2U << Kwave::MixerMatrix::Identity;
+    QTest::newRow("mono->stereo") << 1U << 2U
+                                  << Kwave::MixerMatrix::Permutation;
+    QTest::newRow("4->2")         << 4U << 2U << Kwave::MixerMatrix::Sparse;
+    QTest::newRow("stereo->mono") << 2U << 1U << Kwave::MixerMatrix::Dense;
+}
+
+void TestMixerMatrix::classify()
+{
+    QFETCH(unsigned int, inputs);
+    QFETCH(unsigned int, outputs);
+    QFETCH(Kwave::MixerMatrix::Type, type);
+
+    Kwave::MixerMatrix matrix(inputs, outputs);
+    QCOMPARE(matrix.inputs(), inputs);
+    QCOMPARE(matrix.outputs(), outputs);
+    QCOMPARE(matrix.type(), type);
+
+    // swapping the tracks of stereo is a permutation
+    Kwave::MixerMatrix swap(2, 2);
+    swap[0][0] = 0.0; swap[1][0] = 1.0;
+    swap[0][1] = 1.0; swap[1][1] = 0.0;
+    swap.update();
+    QCOMPARE(swap.type(), Kwave::MixerMatrix::Permutation);
+}
+
+void TestMixerMatrix::mix_data()
+{
+    QTest::addColumn<unsigned int>("inputs");
+    QTest::addColumn<unsigned int>("outputs");
+    QTest::addColumn<bool>("random");
+    QTest::newRow("identity")     << 2U << 2U << false;
+    QTest::newRow("mono->stereo") << 1U << 2U << false;
+    QTest::newRow("6->2")         << 6U << 2U << false;
+    QTest::newRow("3->5, random") << 3U << 5U << true;
+}
+
+void TestMixerMatrix::mix()
+{
+    QFETCH(unsigned int, inputs);
+    QFETCH(unsigned int, outputs);
+    QFETCH(bool, random);
+
+    const int count = 1000; // not a multiple of the block size
+    Kwave::MixerMatrix matrix(inputs, outputs);
+    if (random) {
+        QRandomGenerator generator(1);
+        for (unsigned int x = 0; x < inputs; x++)
+            for (unsigned int y = 0; y < outputs; y++)
+                matrix[x][y] = generator.generateDouble() / inputs;
+        matrix.update();
+    }
+
+    QVector< QVector<sample_t> > in;
+    for (unsigned int x = 0; x < inputs; x++)
+        in.append(noise(count, x + 2));
+    QVector<const sample_t *> in_ptr;
+    for (unsigned int x = 0; x < inputs; x++)
+        in_ptr.append(in[x].constData());
+    QVector< QVector<sample_t> > out(outputs, QVector<sample_t>(count));
+    QVector<sample_t *> out_ptr;
+    for (unsigned int y = 0; y < outputs; y++)
+        out_ptr.append(out[y].data());
+
+    matrix.mix(in_ptr.constData(), out_ptr.constData(), count);
+
+    // compare with the sum in double precision, within float rounding
+    for (unsigned int y = 0; y < outputs; y++) {
+        for (int i = 0; i < count; i++) {
+            double sum = 0.0;
+            for (unsigned int x = 0; x < inputs; x++)
+                sum += matrix[x][y] * static_cast<double>(in[x][i]);
+            QVERIFY(abs(out[y][i] - static_cast<sample_t>(sum)) <= 4);
+        }
+    }
+}
+
+void TestMixerMatrix::clip()
+{
+    Kwave::MixerMatrix matrix(2, 1);
+    matrix[0][0] = 1.0;
+    matrix[1][0] = 1.0;
+    matrix.update();
+
+    const sample_t a[2] = { SAMPLE_MAX, SAMPLE_MIN };
+    const sample_t b[2] = { SAMPLE_MAX, SAMPLE_MIN };
+    const sample_t *in[2] = { a, b };
+    sample_t result[2] = { 0, 0 };
+    sample_t *out[1] = { result };
+    matrix.mix(in, out, 2);
+    QCOMPARE(result[0], SAMPLE_MAX);
+    QCOMPARE(result[1], SAMPLE_MIN);
+}
+
+void TestMixerMatrix::benchmarkMix()
+{
+    const int count = 65536;
+    Kwave::MixerMatrix matrix(6, 2);
+
+    QVector< QVector<sample_t> > in;
+    for (unsigned int x = 0; x < 6; x++)
+        in.append(noise(count, x + 10));
+    QVector<const sample_t *> in_ptr;
+    for (unsigned int x = 0; x < 6; x++)
+        in_ptr.append(in[x].constData());
+    QVector< QVector<sample_t> > out(2, QVector<sample_t>(count));
+    QVector<sample_t *> out_ptr;
+    out_ptr.append(out[0].data());
+    out_ptr.append(out[1].data());
+
+    QBENCHMARK {
+        matrix.mix(in_ptr.constData(), out_ptr.constData(), count);
+    }
+}
+
+QTEST_MAIN(TestMixerMatrix)
+
+#include "test_MixerMatrix.moc"
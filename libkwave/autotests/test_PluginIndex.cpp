@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2026 Thomas Eschenbacher <Thomas.Eschenbacher@gmx.de>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "PluginIndex.h"
+#include <KPluginMetaData>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+/** creates a file that looks like a library by its name only */
+static bool createFile(const QString &path, const QByteArray &content)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) return false;
+    return (file.write(content) == content.size());
+}
+
+class TestPluginIndex : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void emptyDirectory();
+    void cache();
+    void benchmarkFindPlugins();
+    void benchmarkIndex();
+};
+
+void TestPluginIndex::emptyDirectory()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QVERIFY(createFile(dir.filePath(QStringLiteral("readme.txt")), "text"));
+
+    Kwave::PluginIndex index(QString());
+    QVERIFY(index.scan(QStringList() << dir.path()).isEmpty());
+    QCOMPARE(index.misses(), 0U);
+}
+
+void TestPluginIndex::cache()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString cache_file = dir.filePath(QStringLiteral("index"));
+    const QString libs = dir.filePath(QStringLiteral("libs"));
+    QVERIFY(QDir().mkpath(libs));
+    const QString a = libs + QStringLiteral("/a.so");
+    const QString b = libs + QStringLiteral("/b.so");
+    QVERIFY(createFile(a, "not a plugin"));
+    QVERIFY(createFile(b, "not a plugin either"));
+
+    // the first scan has to look into both files, they are no plugins
+    Kwave::PluginIndex index(cache_file);
+    QVERIFY(index.scan(QStringList() << libs).isEmpty());
+    QCOMPARE(index.misses(), 2U);
+
+    // the second one takes everything from the cache
+    Kwave::PluginIndex again(cache_file);
+    QVERIFY(again.scan(QStringList() << libs).isEmpty());
+    QCOMPARE(again.misses(), 0U);
+
+    // only the changed file is read again
+    QVERIFY(createFile(b, "changed"));
+    QVERIFY(again.scan(QStringList() << libs).isEmpty());
+    QCOMPARE(again.misses(), 1U);
+
+    // removed files are dropped from the cache
+    QVERIFY(QFile::remove(a));
+    QVERIFY(again.scan(QStringList() << libs).isEmpty());
+    QCOMPARE(again.misses(), 0U);
+    QVERIFY(createFile(a, "not a plugin"));
+    QVERIFY(again.scan(QStringList() << libs).isEmpty());
+    QCOMPARE(again.misses(), 1U);
+}
+
+void TestPluginIndex::benchmarkFindPlugins()
+{
+    // the way the plugins were searched before the index existed
+    QBENCHMARK {
+        KPluginMetaData::findPlugins(QStringLiteral("kwave"));
+    }
+}
+
+void TestPluginIndex::benchmarkIndex()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    Kwave::PluginIndex index(dir.filePath(QStringLiteral("index")));
+    const QStringList directories = Kwave::PluginIndex::directories();
+    const int count = index.scan(directories).count();
+
+    // with a warm cache, as on every start but the first
+    QBENCHMARK {
+        index.scan(directories);
+    }
+    QCOMPARE(index.misses(), 0U);
+    QCOMPARE(index.scan(directories).count(), count);
+}
+
+QTEST_MAIN(TestPluginIndex)
+
+#include "test_PluginIndex.moc"
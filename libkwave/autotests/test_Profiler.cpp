@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2026 Thomas Eschenbacher <Thomas.Eschenbacher@gmx.de>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Profiler.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTest>
+
+class TestProfiler : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void disabled();
+    void timingsAndCounters();
+    void trace();
+};
+
+void TestProfiler::disabled()
+{
+    Kwave::Profiler::setEnabled(false);
+    Kwave::Profiler::reset();
+    {
+        Kwave::ProfileScope scope("disabled");
+        Kwave::Profiler::count("disabled", 42);
+    }
+    QVERIFY(Kwave::Profiler::timings().isEmpty());
+    QVERIFY(!Kwave::Profiler::counters().contains(QStringLiteral("disabled")));
+}
+
+void TestProfiler::timingsAndCounters()
+{
+    Kwave::Profiler::reset();
+    Kwave::Profiler::setEnabled(true);
+    for (int i = 0; i < 3; ++i) {
+        Kwave::ProfileScope scope("job", QStringLiteral("detail"));
+        QTest::qSleep(2);
+        Kwave::Profiler::count("items", 10);
+    }
+    Kwave::Profiler::setEnabled(false);
+
+    const QMap<QString, Kwave::Profiler::Timing> timings =
+        Kwave::Profiler::timings();
+    QVERIFY(timings.contains(QStringLiteral("job: detail")));
+    const Kwave::Profiler::Timing &t = timings[QStringLiteral("job: detail")];
+    QCOMPARE(t.calls, 3ULL);
+    QVERIFY(t.max_us >= 2000);
+    QVERIFY(t.total_us >= 6000);
+    QCOMPARE(Kwave::Profiler::counters()[QStringLiteral("items")],
+             Q_INT64_C(30));
+
+    Kwave::Profiler::reset();
+    QVERIFY(Kwave::Profiler::timings().isEmpty());
+}
+
+void TestProfiler::trace()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString filename = dir.filePath(QStringLiteral("trace.json"));
+
+    QVERIFY(Kwave::Profiler::startTrace(filename));
+    QVERIFY(Kwave::Profiler::isEnabled());
+    {
+        Kwave::ProfileScope scope("traced");
+        Kwave::Profiler::count("bytes", 100);
+    }
+    Kwave::Profiler::stopTrace();
+    Kwave::Profiler::setEnabled(false);
+
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    const QJsonArray events =
+        doc.object().value(QStringLiteral("traceEvents")).toArray();
+    QCOMPARE(events.count(), 2);
+
+    const QJsonObject counter = events[0].toObject();
+    QCOMPARE(counter.value(QStringLiteral("ph")).toString(),
+             QStringLiteral("C"));
+    const QJsonObject span = events[1].toObject();
+    QCOMPARE(span.value(QStringLiteral("name")).toString(),
+             QStringLiteral("traced"));
+    QCOMPARE(span.value(QStringLiteral("ph")).toString(),
+             QStringLiteral("X"));
+}
+
+QTEST_MAIN(TestProfiler)
+
+#include "test_Profiler.moc"
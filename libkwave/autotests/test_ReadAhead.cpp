@@ -0,0 +1,206 @@
+// SPDX-FileCopyrightText: 2026 Thomas Eschenbacher <Thomas.Eschenbacher@gmx.de>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "MultiTrackReader.h"
+#include "ReadAhead.h"
+#include "SampleReader.h"
+#include "SignalManager.h"
+#include "Writer.h"
+#include <QTest>
+
+/** number of samples per track and block */
+#define BLOCK 1024
+
+/** number of tracks of the test signal */
+#define TRACKS 2
+
+/** returns the value of a sample of the test signal */
+static sample_t value(unsigned int track, sample_index_t pos)
+{
+    return static_cast<sample_t>((pos % 1000) + (track * 10000));
+}
+
+/**
+ * checks the content of a block
+ * @param block the block to check
+ * @param count number of samples per track in the block
+ * @param pos index of the first sample of the block
+ * @param length length of the signal, zeroes behind it
+ * @return true if the block is as expected
+ */
+static bool checkBlock(const Kwave::ReadAhead::Block &block,
+                       unsigned int count, sample_index_t pos,
+                       sample_index_t length)
+{
+    if (block.size() != TRACKS) return false;
+    for (unsigned int track = 0; track < TRACKS; ++track) {
+        const Kwave::SampleArray &samples = block[track];
+        if (samples.size() != count) return false;
+        for (unsigned int i = 0; i < count; ++i) {
+            const sample_t expected =
+                ((pos + i) < length) ? value(track, pos + i) : 0;
+            if (samples[i] != expected) return false;
+        }
+    }
+    return true;
+}
+
+class TestReadAhead : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+    void blockOrder();
+    void padShortTracks();
+    void partialBlock();
+    void cancel();
+    void destroyWhileReading();
+
+private:
+    /** creates the test signal */
+    void createSignal(sample_index_t length);
+
+    /** opens a reader for all tracks of the test signal */
+    Kwave::MultiTrackReader *openReader(sample_index_t length);
+
+    /** signal manager with the test signal */
+    Kwave::SignalManager *m_signal_manager;
+};
+
+void TestReadAhead::init()
+{
+    m_signal_manager = new Kwave::SignalManager(nullptr);
+}
+
+void TestReadAhead::cleanup()
+{
+    delete m_signal_manager;
+    m_signal_manager = nullptr;
+}
+
+void TestReadAhead::createSignal(sample_index_t length)
+{
+    m_signal_manager->newSignal(length, 44100, 16, TRACKS);
+    for (unsigned int track = 0; track < TRACKS; ++track) {
+        Kwave::SampleArray samples(static_cast<unsigned int>(length));
+        QCOMPARE(samples.size(), static_cast<unsigned int>(length));
+        for (sample_index_t pos = 0; pos < length; ++pos)
+            samples[static_cast<unsigned int>(pos)] = value(track, pos);
+
+        Kwave::Writer *writer = m_signal_manager->openWriter(
+            Kwave::Overwrite, track, 0, length - 1);
+        QVERIFY(writer);
+        *writer << samples << flush;
+        delete writer;
+    }
+}
+
+Kwave::MultiTrackReader *TestReadAhead::openReader(sample_index_t length)
+{
+    QVector<unsigned int> tracks;
+    for (unsigned int track = 0; track < TRACKS; ++track)
+        tracks.append(track);
+    return new Kwave::MultiTrackReader(Kwave::SinglePassForward,
+        *m_signal_manager, tracks, 0, length - 1);
+}
+
+void TestReadAhead::blockOrder()
+{
+    const sample_index_t length = 16 * BLOCK;
+    createSignal(length);
+    QScopedPointer<Kwave::MultiTrackReader> src(openReader(length));
+
+    Kwave::ReadAhead read_ahead(*src, length, BLOCK, 2);
+    Kwave::ReadAhead::Block block;
+    sample_index_t pos = 0;
+    while (unsigned int count = read_ahead.read(block)) {
+        QCOMPARE(count, static_cast<unsigned int>(BLOCK));
+        QVERIFY(checkBlock(block, count, pos, length));
+        pos += count;
+    }
+    QCOMPARE(pos, length);
+    QVERIFY(block.isEmpty());
+}
+
+void TestReadAhead::padShortTracks()
+{
+    // the tracks end in the middle of the third block
+    const sample_index_t length = (2 * BLOCK) + 100;
+    createSignal(length);
+    QScopedPointer<Kwave::MultiTrackReader> src(openReader(length));
+
+    Kwave::ReadAhead read_ahead(*src, 4 * BLOCK, BLOCK);
+    Kwave::ReadAhead::Block block;
+    sample_index_t pos = 0;
+    while (unsigned int count = read_ahead.read(block)) {
+        QCOMPARE(count, static_cast<unsigned int>(BLOCK));
+        QVERIFY(checkBlock(block, count, pos, length));
+        pos += count;
+    }
+    QCOMPARE(pos, sample_index_t(4 * BLOCK));
+}
+
+void TestReadAhead::partialBlock()
+{
+    const sample_index_t length = (3 * BLOCK) + 17;
+    createSignal(length);
+    QScopedPointer<Kwave::MultiTrackReader> src(openReader(length));
+
+    Kwave::ReadAhead read_ahead(*src, length, BLOCK);
+    Kwave::ReadAhead::Block block;
+    for (unsigned int i = 0; i < 3; ++i) {
+        QCOMPARE(read_ahead.read(block), static_cast<unsigned int>(BLOCK));
+        QVERIFY(checkBlock(block, BLOCK, i * BLOCK, length));
+    }
+    QCOMPARE(read_ahead.read(block), 17U);
+    QVERIFY(checkBlock(block, 17, 3 * BLOCK, length));
+    QCOMPARE(read_ahead.read(block), 0U);
+}
+
+void TestReadAhead::cancel()
+{
+    const sample_index_t length = 64 * BLOCK;
+    createSignal(length);
+    QScopedPointer<Kwave::MultiTrackReader> src(openReader(length));
+
+    Kwave::ReadAhead read_ahead(*src, length, BLOCK);
+    Kwave::ReadAhead::Block block;
+    QCOMPARE(read_ahead.read(block), static_cast<unsigned int>(BLOCK));
+    QCOMPARE(read_ahead.read(block), static_cast<unsigned int>(BLOCK));
+    QVERIFY(checkBlock(block, BLOCK, BLOCK, length));
+
+    // blocks that have already been read ahead are not delivered
+    src->cancel();
+    QCOMPARE(read_ahead.read(block), 0U);
+    QVERIFY(block.isEmpty());
+    QCOMPARE(read_ahead.read(block), 0U);
+}
+
+void TestReadAhead::destroyWhileReading()
+{
+    const sample_index_t length = 256 * BLOCK;
+    createSignal(length);
+
+    for (int round = 0; round < 20; ++round) {
+        QScopedPointer<Kwave::MultiTrackReader> src(openReader(length));
+        {
+            Kwave::ReadAhead read_ahead(*src, length, BLOCK, 16);
+            Kwave::ReadAhead::Block block;
+            QCOMPARE(read_ahead.read(block), static_cast<unsigned int>(BLOCK));
+            // destroyed while the worker thread is still reading ahead
+        }
+
+        // the destructor has waited for a complete block
+        for (unsigned int track = 0; track < TRACKS; ++track) {
+            Kwave::SampleReader *reader = (*src)[track];
+            QVERIFY(reader);
+            QCOMPARE(reader->pos() % BLOCK, sample_index_t(0));
+        }
+    }
+}
+
+QTEST_MAIN(TestReadAhead)
+
+#include "test_ReadAhead.moc"
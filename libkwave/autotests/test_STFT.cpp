@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2026 Thomas Eschenbacher <Thomas.Eschenbacher@gmx.de>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "STFT.h"
+#include <QTest>
+#include <QVector>
+#include <math.h>
+
+class TestSTFT : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void geometry();
+    void sinePeak();
+    void roundTrip();
+};
+
+void TestSTFT::geometry()
+{
+    Kwave::STFT stft(1024, Kwave::WINDOW_FUNC_HANNING);
+    QVERIFY(stft.isValid());
+    QCOMPARE(stft.bins(), 513U);
+    QCOMPARE(stft.hop(), 512U);
+
+    QCOMPARE(stft.frames(0), quint64(0));
+    QCOMPARE(stft.frames(1), quint64(1));
+    QCOMPARE(stft.frames(1024), quint64(1));
+    QCOMPARE(stft.frames(1025), quint64(2));
+    QCOMPARE(stft.frames(1536), quint64(2));
+    QCOMPARE(stft.samples(0), quint64(0));
+    QCOMPARE(stft.samples(3), quint64(2048));
+
+    // the frames always cover the whole length
+    for (quint64 length = 1; length < 5000; length += 37)
+        QVERIFY(stft.samples(stft.frames(length)) >= length);
+}
+
+void TestSTFT::sinePeak()
+{
+    // a sine exactly on bin 100, in more frames than one batch
+    const unsigned int points = 512;
+    const unsigned int frames = 40;
+    Kwave::STFT stft(points, Kwave::WINDOW_FUNC_HANNING, 0, 16);
+    QVERIFY(stft.isValid());
+
+    QVector<double> input(int(stft.samples(frames)));
+    for (int i = 0; i < input.size(); ++i)
+        input[i] = sin(2.0 * M_PI * 100.0 * i / points);
+
+    QVector<Kwave::STFT::Complex> output(int(frames * stft.bins()));
+    QVERIFY(stft.forward(input.constData(), frames, output.data()));
+
+    for (unsigned int f = 0; f < frames; ++f) {
+        const Kwave::STFT::Complex *x = output.constData() + f * stft.bins();
+        unsigned int peak = 0;
+        for (unsigned int b = 1; b < stft.bins(); ++b)
+            if (Kwave::STFT::power(x[b]) > Kwave::STFT::power(x[peak]))
+                peak = b;
+        QCOMPARE(peak, 100U);
+    }
+}
+
+void TestSTFT::roundTrip()
+{
+    // without window and overlap the inverse restores the input
+    const unsigned int points = 256;
+    const unsigned int frames = 10;
+    Kwave::STFT stft(points, Kwave::WINDOW_FUNC_NONE, points, 4);
+    QVERIFY(stft.isValid());
+
+    QVector<double> input(int(stft.samples(frames)));
+    for (int i = 0; i < input.size(); ++i)
+        input[i] = sin(0.01 * i) + 0.5 * cos(0.37 * i);
+
+    QVector<Kwave::STFT::Complex> spectra(int(frames * stft.bins()));
+    QVERIFY(stft.forward(input.constData(), frames, spectra.data()));
+
+    QVector<double> output(input.size(), 0.0);
+    QVERIFY(stft.inverse(spectra.constData(), frames, output.data()));
+    for (int i = 0; i < input.size(); ++i)
+        QVERIFY(fabs(output[i] - input[i]) < 1e-9);
+}
+
+QTEST_MAIN(TestSTFT)
+
+#include "test_STFT.moc"
@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2026 Thomas Eschenbacher <Thomas.Eschenbacher@gmx.de>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "SampleArray.h"
+#include "SamplePool.h"
+#include "modules/Osc.h"
+#include <QTest>
+
+class TestSamplePool : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void recycleBlocks();
+    void plainArrays();
+    void reuseSharedBuffer();
+    void reuseEmpty();
+    void benchmarkOsc();
+};
+
+void TestSamplePool::recycleBlocks()
+{
+    // warm up: the first array allocates from the heap
+    { Kwave::SampleArray a; QVERIFY(a.reuse(8192)); }
+
+    const quint64 before = Kwave::SamplePool::statistics().allocations;
+    for (int i = 0; i < 100; ++i) {
+        Kwave::SampleArray a;
+        QVERIFY(a.reuse(8192));
+        QCOMPARE(a.size(), 8192u);
+    }
+    QCOMPARE(Kwave::SamplePool::statistics().allocations, before);
+}
+
+void TestSamplePool::plainArrays()
+{
+    // arrays that are not prepared for streaming, e.g. the pages
+    // of a stripe, do not take memory from the pool
+    const quint64 before = Kwave::SamplePool::statistics().allocations;
+    const quint64 cached = Kwave::SamplePool::statistics().cached_bytes;
+    Kwave::SampleArray a(5000);
+    QCOMPARE(a.size(), 5000u);
+    QVERIFY(a.resize(6000));
+    QCOMPARE(Kwave::SamplePool::statistics().allocations, before);
+    QCOMPARE(Kwave::SamplePool::statistics().cached_bytes, cached);
+}
+
+void TestSamplePool::reuseSharedBuffer()
+{
+    Kwave::SampleArray a(1000);
+    a.fill(42);
+    Kwave::SampleArray held = a; // e.g. a receiver keeps the block
+
+    QVERIFY(a.reuse(1000));
+    a[0] = 0;
+    QCOMPARE(held[0], 42); // the held block is not touched
+    QVERIFY(held.constData() != a.constData());
+}
+
+void TestSamplePool::reuseEmpty()
+{
+    Kwave::SampleArray a(1000);
+    QVERIFY(a.reuse(0));
+    QVERIFY(a.isEmpty());
+
+    Kwave::SampleArray b(1000);
+    Kwave::SampleArray held = b;
+    QVERIFY(b.reuse(0));
+    QVERIFY(b.isEmpty());
+    QCOMPARE(held.size(), 1000u);
+
+    Kwave::SampleArray empty;
+    QVERIFY(empty.reuse(0));
+    QVERIFY(empty.reuse(10));
+    QCOMPARE(empty.size(), 10u);
+}
+
+void TestSamplePool::benchmarkOsc()
+{
+    Kwave::StreamObject::setInteractive(true);
+    Kwave::Osc osc;
+    osc.setFrequency(QVariant(100.0));
+
+    // simulate a receiver that holds the last block while the
+    // next one is produced
+    Kwave::SampleArray held;
+    connect(&osc, &Kwave::Osc::output,
+            this, [&held](Kwave::SampleArray data) { held = data; });
+
+    // warm up the pool
+    for (int i = 0; i < 4; ++i) osc.goOn();
+
+    const quint64 before = Kwave::SamplePool::statistics().allocations;
+    QBENCHMARK {
+        osc.goOn();
+    }
+    const quint64 after = Kwave::SamplePool::statistics().allocations;
+    qDebug("sample block allocations in steady state: %llu", after - before);
+    QCOMPARE(after, before);
+}
+
+QTEST_MAIN(TestSamplePool)
+#include "test_SamplePool.moc"
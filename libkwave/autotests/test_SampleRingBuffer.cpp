@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2026 Thomas Eschenbacher <Thomas.Eschenbacher@gmx.de>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "SampleRingBuffer.h"
+#include "Writer.h"
+#include <QTest>
+#include <QVector>
+
+/** writer that only collects all written samples */
+class CollectingWriter : public Kwave::Writer
+{
+    Q_OBJECT
+public:
+    bool write(const Kwave::SampleArray &buffer, unsigned int &count) override
+    {
+        for (unsigned int i = 0; i < count; ++i)
+            m_samples.append(buffer[i]);
+        count = 0;
+        return true;
+    }
+
+    QVector<sample_t> m_samples;
+};
+
+class TestSampleRingBuffer : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void partialFill();
+    void wrapAround();
+    void oversizedPut();
+};
+
+static Kwave::SampleArray ramp(sample_t start, unsigned int count)
+{
+    Kwave::SampleArray a(count);
+    for (unsigned int i = 0; i < count; ++i)
+        a[i] = start + static_cast<sample_t>(i);
+    return a;
+}
+
+void TestSampleRingBuffer::partialFill()
+{
+    Kwave::SampleRingBuffer rb(10);
+    rb.put(ramp(0, 4));
+    QCOMPARE(rb.length(), 4u);
+
+    CollectingWriter w;
+    QVERIFY(rb.drainInto(w));
+    QCOMPARE(w.m_samples, QVector<sample_t>({0, 1, 2, 3}));
+    QVERIFY(rb.isEmpty());
+}
+
+void TestSampleRingBuffer::wrapAround()
+{
+    Kwave::SampleRingBuffer rb(5);
+    rb.put(ramp(0, 3));
+    rb.put(ramp(3, 4));
+    QCOMPARE(rb.length(), 5u);
+
+    CollectingWriter w;
+    QVERIFY(rb.drainInto(w));
+    QCOMPARE(w.m_samples, QVector<sample_t>({2, 3, 4, 5, 6}));
+}
+
+void TestSampleRingBuffer::oversizedPut()
+{
+    Kwave::SampleRingBuffer rb(3);
+    rb.put(ramp(0, 2));
+    rb.put(ramp(10, 7));
+    QCOMPARE(rb.length(), 3u);
+
+    CollectingWriter w;
+    QVERIFY(rb.drainInto(w));
+    QCOMPARE(w.m_samples, QVector<sample_t>({14, 15, 16}));
+}
+
+QTEST_MAIN(TestSampleRingBuffer)
+#include "test_SampleRingBuffer.moc"
@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: 2026 Thomas Eschenbacher <Thomas.Eschenbacher@gmx.de>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Connect.h"
+#include "SampleSource.h"
+#include "Writer.h"
+#include "modules/Mul.h"
+#include "modules/StreamPipeline.h"
+#include <QTest>
+
+/** number of samples per block, small to make the overhead visible */
+#define BLOCK 64
+
+/** writer that only counts the written samples */
+class CountingWriter : public Kwave::Writer
+{
+    Q_OBJECT
+public:
+    CountingWriter() :Kwave::Writer(), m_count(0), m_last_value(0) { }
+
+    bool write(const Kwave::SampleArray &buffer, unsigned int &count) override
+    {
+        if (count) m_last_value = buffer[count - 1];
+        m_count += count;
+        m_position += count;
+        count = 0;
+        return true;
+    }
+
+    quint64 m_count;
+    sample_t m_last_value;
+};
+
+/** source that emits constant blocks through a Qt signal */
+class ConstSource : public Kwave::SampleSource
+{
+    Q_OBJECT
+public:
+    ConstSource() :Kwave::SampleSource(), m_buffer(BLOCK)
+    {
+        m_buffer.fill(SAMPLE_MAX / 2);
+    }
+    void goOn() override { emit output(m_buffer); }
+signals:
+    void output(Kwave::SampleArray data);
+private:
+    Kwave::SampleArray m_buffer;
+};
+
+/** stage that produces constant blocks */
+class ConstStage : public Kwave::StreamStage
+{
+public:
+    explicit ConstStage(sample_t value, quint64 limit)
+        :m_value(value), m_rest(limit) { }
+    unsigned int process(Kwave::SampleArray &block,
+                         unsigned int length) override
+    {
+        if (m_rest < length) length = static_cast<unsigned int>(m_rest);
+        sample_t *p = block.data();
+        for (unsigned int i = 0; i < length; ++i) p[i] = m_value;
+        m_rest -= length;
+        return length;
+    }
+private:
+    sample_t m_value;
+    quint64 m_rest;
+};
+
+class TestStreamPipeline : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void pullThroughChain();
+    void benchmarkSignalSlot();
+    void benchmarkPipeline();
+};
+
+void TestStreamPipeline::pullThroughChain()
+{
+    CountingWriter sink;
+    Kwave::StreamPipeline pipeline;
+    const int track = pipeline.addTrack(
+        new ConstStage(SAMPLE_MAX / 2, 1000), &sink);
+    QCOMPARE(track, 0);
+    QVERIFY(pipeline.append(0, new Kwave::MulStage(
+        new ConstStage(SAMPLE_MAX / 2, 100000))));
+    QVERIFY(pipeline.compile(BLOCK));
+    QVERIFY(pipeline.run());
+
+    QCOMPARE(sink.m_count, quint64(1000));
+    QVERIFY(sink.m_last_value > SAMPLE_MAX / 5);
+    QVERIFY(sink.m_last_value < SAMPLE_MAX / 3);
+    QCOMPARE(pipeline.blocksProcessed(), quint64((1000 + BLOCK - 1) / BLOCK));
+}
+
+void TestStreamPipeline::benchmarkSignalSlot()
+{
+    ConstSource source;
+    Kwave::Mul mul;
+    CountingWriter sink;
+    mul.set_b(QVariant(0.5));
+
+    QVERIFY(Kwave::connect(
+        source, SIGNAL(output(Kwave::SampleArray)),
+        mul,    SLOT(input_a(Kwave::SampleArray))));
+    QVERIFY(Kwave::connect(
+        mul,    SIGNAL(output(Kwave::SampleArray)),
+        sink,   SLOT(input(Kwave::SampleArray))));
+
+    QBENCHMARK {
+        source.goOn();
+    }
+    sink.flush();
+}
+
+void TestStreamPipeline::benchmarkPipeline()
+{
+    CountingWriter sink;
+    Kwave::StreamPipeline pipeline;
+    pipeline.addTrack(new ConstStage(SAMPLE_MAX / 2, ~0ULL), &sink);
+    pipeline.append(0, new Kwave::MulStage(
+        new ConstStage(float2sample(0.5), ~0ULL)));
+    QVERIFY(pipeline.compile(BLOCK));
+
+    QBENCHMARK {
+        pipeline.step();
+    }
+}
+
+QTEST_MAIN(TestStreamPipeline)
+#include "test_StreamPipeline.moc"
@@ -0,0 +1,169 @@
+// SPDX-FileCopyrightText: 2026 Thomas Eschenbacher <Thomas.Eschenbacher@gmx.de>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "SampleArray.h"
+#include "Stripe.h"
+#include <QTest>
+
+/** a bit more than three pages of 64k samples */
+static const unsigned int STRIPE_LENGTH = 3 * 65536 + 1000;
+
+class TestStripe : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void copyOnWrite();
+    void deleteRange();
+    void cropFromStart();
+    void silence();
+
+private:
+    static Kwave::Stripe ramp(unsigned int length);
+    static bool isRamp(Kwave::Stripe &stripe, unsigned int first,
+                       unsigned int skip_at, unsigned int skip);
+};
+
+Kwave::Stripe TestStripe::ramp(unsigned int length)
+{
+    Kwave::SampleArray samples(length);
+    for (unsigned int i = 0; i < length; ++i)
+        samples[i] = static_cast<sample_t>(i);
+    Kwave::Stripe stripe(0);
+    stripe << samples;
+    return stripe;
+}
+
+bool TestStripe::isRamp(Kwave::Stripe &stripe, unsigned int first,
+                        unsigned int skip_at, unsigned int skip)
+{
+    Kwave::SampleArray buffer(stripe.length());
+    if (stripe.read(buffer, 0, 0, stripe.length()) != stripe.length())
+        return false;
+    for (unsigned int i = 0; i < buffer.size(); ++i) {
+        unsigned int expected = first + i;
+        if (i >= skip_at) expected += skip;
+        if (buffer[i] != static_cast<sample_t>(expected)) return false;
+    }
+    return true;
+}
+
+void TestStripe::copyOnWrite()
+{
+    Kwave::Stripe stripe = ramp(STRIPE_LENGTH);
+    const quint64 bytes = STRIPE_LENGTH * sizeof(sample_t);
+
+    quint64 shared    = 0;
+    quint64 exclusive = 0;
+    stripe.memoryUsage(shared, exclusive);
+    QCOMPARE(shared, 0ull);
+    QCOMPARE(exclusive, bytes);
+
+    // a copy shares everything
+    Kwave::Stripe copy(stripe);
+    shared = exclusive = 0;
+    copy.memoryUsage(shared, exclusive);
+    QCOMPARE(shared, bytes);
+    QCOMPARE(exclusive, 0ull);
+
+    // modifying a single sample only detaches one page
+    Kwave::SampleArray one(1);
+    one[0] = -1;
+    stripe.overwrite(70000, one, 0, 1);
+    shared = exclusive = 0;
+    copy.memoryUsage(shared, exclusive);
+    QCOMPARE(exclusive, 65536ull * sizeof(sample_t));
+    QCOMPARE(shared, bytes - exclusive);
+
+    // the copy still has the old content
+    QVERIFY(isRamp(copy, 0, STRIPE_LENGTH, 0));
+}
+
+void TestStripe::deleteRange()
+{
+    // delete across a page border, in the middle of the stripe
+    Kwave::Stripe stripe = ramp(STRIPE_LENGTH);
+    Kwave::Stripe copy(stripe);
+    stripe.deleteRange(60000, 10000);
+    QCOMPARE(stripe.length(), STRIPE_LENGTH - 10000);
+    QVERIFY(isRamp(stripe, 0, 60000, 10000));
+    QVERIFY(isRamp(copy, 0, STRIPE_LENGTH, 0));
+
+    // delete at the end
+    stripe.deleteRange(stripe.length() - 500, 500);
+    QCOMPARE(stripe.length(), STRIPE_LENGTH - 10500);
+    QVERIFY(isRamp(stripe, 0, 60000, 10000));
+}
+
+void TestStripe::cropFromStart()
+{
+    Kwave::Stripe stripe = ramp(STRIPE_LENGTH);
+
+    // a cropped copy does not need any extra memory
+    Kwave::Stripe cropped(0, stripe, 100000);
+    QCOMPARE(cropped.length(), STRIPE_LENGTH - 100000);
+    QVERIFY(isRamp(cropped, 100000, STRIPE_LENGTH, 0));
+    quint64 shared    = 0;
+    quint64 exclusive = 0;
+    cropped.memoryUsage(shared, exclusive);
+    QCOMPARE(exclusive, 0ull);
+
+    // deleting from the start drops pages
+    stripe.deleteRange(0, 70000);
+    QCOMPARE(stripe.length(), STRIPE_LENGTH - 70000);
+    QVERIFY(isRamp(stripe, 70000, STRIPE_LENGTH, 0));
+
+    // appending fills up the last page
+    Kwave::SampleArray more(70000);
+    for (unsigned int i = 0; i < more.size(); ++i)
+        more[i] = static_cast<sample_t>(STRIPE_LENGTH + i);
+    stripe << more;
+    QCOMPARE(stripe.length(), STRIPE_LENGTH);
+    QVERIFY(isRamp(stripe, 70000, STRIPE_LENGTH, 0));
+}
+
+void TestStripe::silence()
+{
+    // only the partial last page needs memory of its own
+    Kwave::Stripe stripe(0);
+    QCOMPARE(stripe.resize(STRIPE_LENGTH), STRIPE_LENGTH);
+    quint64 shared    = 0;
+    quint64 exclusive = 0;
+    stripe.memoryUsage(shared, exclusive);
+    QCOMPARE(shared, 0ull);
+    QCOMPARE(exclusive, 1000ull * sizeof(sample_t));
+
+    sample_t min = 5;
+    sample_t max = 7;
+    stripe.minMax(0, STRIPE_LENGTH - 1, min, max);
+    QCOMPARE(min, sample_t(0));
+    QCOMPARE(max, sample_t(7));
+
+    // writing into the second page detaches it
+    Kwave::SampleArray samples(65536);
+    samples[100] = 42;
+    stripe.overwrite(65536, samples, 0, samples.size());
+    shared = exclusive = 0;
+    stripe.memoryUsage(shared, exclusive);
+    QCOMPARE(exclusive, (65536ull + 1000ull) * sizeof(sample_t));
+    min = max = 0;
+    stripe.minMax(0, STRIPE_LENGTH - 1, min, max);
+    QCOMPARE(max, sample_t(42));
+
+    // overwriting it with silence releases it again
+    samples[100] = 0;
+    stripe.overwrite(65536, samples, 0, samples.size());
+    shared = exclusive = 0;
+    stripe.memoryUsage(shared, exclusive);
+    QCOMPARE(exclusive, 1000ull * sizeof(sample_t));
+
+    // reading silence
+    Kwave::SampleArray buffer(STRIPE_LENGTH);
+    buffer.fill(1);
+    QCOMPARE(stripe.read(buffer, 0, 0, STRIPE_LENGTH), STRIPE_LENGTH);
+    for (unsigned int i = 0; i < buffer.size(); ++i)
+        QCOMPARE(buffer[i], sample_t(0));
+}
+
+QTEST_MAIN(TestStripe)
+#include "test_Stripe.moc"
@@ -47,6 +47,20 @@ Kwave::ChannelMixer::ChannelMixer(unsigned int inputs, unsigned int outputs)
 {
 }
 
+//***************************************************************************
+Kwave::ChannelMixer::ChannelMixer(const Kwave::MixerMatrix &matrix)
+    :Kwave::SampleSource(),
+     m_matrix(new(std::nothrow) Kwave::MixerMatrix(matrix)),
+     m_inputs(matrix.inputs()),
+     m_outputs(matrix.outputs()),
+     m_indexer(),
+     m_input_queue(),
+     m_output_buffer(),
+     m_lock()
+{
+    Q_ASSERT(m_matrix);
+}
+
 //***************************************************************************
 bool Kwave::ChannelMixer::init()
 {
@@ -82,10 +96,11 @@ bool Kwave::ChannelMixer::init()
         if (!ok) return false;
     }
 
-    // create the mixer matrix
+    // create the mixer matrix, if not already given
     // create a translation matrix for mixing up/down to the desired
     // number of output channels
-    m_matrix = new(std::nothrow) Kwave::MixerMatrix(m_inputs, m_outputs);
+    if (!m_matrix)
+        m_matrix = new(std::nothrow) Kwave::MixerMatrix(m_inputs, m_outputs);
     Q_ASSERT(m_matrix);
     if (!m_matrix) return false;
 
@@ -109,6 +124,9 @@ Kwave::ChannelMixer::~ChannelMixer()
         delete m_output_buffer[0];
         m_output_buffer.remove(0);
     }
+
+    delete m_matrix;
+    m_matrix = nullptr;
 }
 
 //***************************************************************************
@@ -224,9 +242,11 @@ void Kwave::ChannelMixer::mix()
         Kwave::SampleBuffer *buffer = m_output_buffer[track];
         Q_ASSERT(buffer);
         if (!buffer) return;
+        // the content is overwritten, an emitted block that is still
+        // in use is replaced with a recycled one instead of being copied
         bool ok = true;
         if (buffer->constData().size() < min_len)
-            ok &= buffer->data().resize(min_len);
+            ok &= buffer->data().reuse(min_len);
         if (!ok) {
             qWarning("ChannelMixer: failed to increase buffer size to %u",
                      min_len);
@@ -236,19 +256,10 @@ void Kwave::ChannelMixer::mix()
     }
 
     // mix all channels together, using the mixer matrix
-    for (unsigned int y = 0; y < m_outputs; y++) {
-        sample_t *out = output[y];
-        for (unsigned int pos = 0; pos < min_len; pos++) {
-            double sum = 0.0;
-            for (unsigned int x = 0; x < m_inputs; x++) {
-                const double f = (*m_matrix)[x][y];
-                const double i = static_cast<double>(input[x][pos]);
-                sum += (f * i);
-            }
-            out[pos] = static_cast<sample_t>(sum);
-        }
+    m_matrix->mix(input.constData(), output.constData(), min_len);
 
-        // emit the output
+    // emit the output
+    for (unsigned int y = 0; y < m_outputs; y++) {
         Kwave::SampleBuffer *out_buf = m_output_buffer[y];
         if (Q_UNLIKELY(out_buf->constData().size() > min_len)) {
             bool ok = out_buf->data().resize(min_len);
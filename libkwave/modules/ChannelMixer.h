@@ -50,6 +50,14 @@ namespace Kwave
              */
             ChannelMixer(unsigned int inputs, unsigned int outputs);
 
+            /**
+             * Constructor, for mixing with arbitrary factors instead of
+             * the default up/down mix
+             * @param matrix the mixer matrix, determines the number of
+             *               inputs and outputs
+             */
+            explicit ChannelMixer(const Kwave::MixerMatrix &matrix);
+
             /** Destructor */
             ~ChannelMixer() override;
 
@@ -0,0 +1,344 @@
+/***************************************************************************
+          Convolver.cpp  -  fast convolution with a long impulse response
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <string.h>
+
+#include <fftw3.h>
+
+#include <QFutureSynchronizer>
+#include <QHash>
+
+#include "libkwave/GlobalLock.h"
+#include "libkwave/TaskPool.h"
+#include "libkwave/Utils.h"
+#include "libkwave/modules/Convolver.h"
+
+/** partition size for short impulse responses */
+#define MIN_PARTITION_SIZE 1024
+
+/** partition size for long impulse responses */
+#define MAX_PARTITION_SIZE 8192
+
+/** minimum number of partitions per unit of work */
+#define MIN_PARTITIONS_PER_UNIT 4
+
+//***************************************************************************
+Kwave::Convolver::Convolver(const QVector<double> &response,
+                            unsigned int partition)
+    :Kwave::SampleSource(), m_size(partition), m_partitions(1),
+     m_plans(), m_kernel(), m_history(), m_history_pos(0),
+     m_time(), m_fill(0), m_spectra(), m_products(), m_result(),
+     m_mix(1.0), m_buffer(blockSize())
+{
+    const unsigned int length = Kwave::toUint(response.count());
+
+    // use a power of two, long enough for short responses
+    if (!m_size) {
+        m_size = MIN_PARTITION_SIZE;
+        while ((m_size < length) && (m_size < MAX_PARTITION_SIZE))
+            m_size <<= 1;
+    }
+    Q_ASSERT(!(m_size & (m_size - 1)));
+    m_partitions = qMax(1U, (length + m_size - 1) / m_size);
+
+    m_plans = plans(m_size);
+    if (!isValid()) return;
+
+    // spectra of the partitions, with the scale of the inverse FFT
+    const unsigned int bins = m_size + 1;
+    m_kernel.resize(Kwave::toInt(m_partitions * bins));
+    QVector<double> frame(Kwave::toInt(2 * m_size), 0.0);
+    for (unsigned int p = 0; p < m_partitions; ++p) {
+        frame.fill(0.0);
+        const unsigned int first = p * m_size;
+        const unsigned int count = qMin(m_size, length - first);
+        if (count)
+            memcpy(frame.data(), response.constData() + first,
+                   count * sizeof(double));
+        fftw_execute_dft_r2c(m_plans.forward, frame.data(),
+            reinterpret_cast<fftw_complex *>(m_kernel.data() + p * bins));
+    }
+    const double scale = 1.0 / static_cast<double>(2 * m_size);
+    for (Complex &c : m_kernel) c *= scale;
+
+    m_history.fill(Complex(0.0, 0.0), Kwave::toInt(m_partitions * bins));
+    m_time.fill(0.0, Kwave::toInt(m_size));
+}
+
+//***************************************************************************
+Kwave::Convolver::~Convolver()
+{
+}
+
+//***************************************************************************
+Kwave::Convolver::Plans Kwave::Convolver::plans(unsigned int size)
+{
+    static QHash<unsigned int, Plans> cache;
+
+    Kwave::GlobalLock _lock; // libfftw is not threadsafe!
+    if (cache.contains(size)) return cache[size];
+
+    // the plans are used with other arrays than the ones for planning
+    Plans plans = { nullptr, nullptr };
+    const int n = Kwave::toInt(2 * size);
+    double       *time = fftw_alloc_real(2 * size);
+    fftw_complex *freq = fftw_alloc_complex(size + 1);
+    if (time && freq) {
+        plans.forward = fftw_plan_dft_r2c_1d(n, time, freq,
+            FFTW_MEASURE | FFTW_UNALIGNED);
+        plans.inverse = fftw_plan_dft_c2r_1d(n, freq, time,
+            FFTW_MEASURE | FFTW_UNALIGNED);
+    }
+    if (time) fftw_free(time);
+    if (freq) fftw_free(freq);
+    Q_ASSERT(plans.forward && plans.inverse);
+
+    if (plans.forward && plans.inverse) cache[size] = plans;
+    return plans;
+}
+
+//***************************************************************************
+bool Kwave::Convolver::isValid() const
+{
+    return (m_plans.forward && m_plans.inverse);
+}
+
+//***************************************************************************
+const Kwave::Convolver::Complex *Kwave::Convolver::spectrum(int block) const
+{
+    const unsigned int bins = m_size + 1;
+    if (block >= 0)
+        return m_spectra.constData() + (Kwave::toUint(block) * bins);
+
+    // block -1 is the newest one in the history
+    const unsigned int age  = Kwave::toUint(-block) - 1;
+    const unsigned int slot =
+        (m_history_pos + m_partitions - age) % m_partitions;
+    return m_history.constData() + (slot * bins);
+}
+
+//***************************************************************************
+void Kwave::Convolver::transformBlocks(int first, int last)
+{
+    const unsigned int bins = m_size + 1;
+    for (int k = first; k <= last; ++k) {
+        // overlap-save: the block and the one before it
+        double *src = m_time.data() + (Kwave::toUint(k) * m_size);
+        fftw_execute_dft_r2c(m_plans.forward, src,
+            reinterpret_cast<fftw_complex *>(
+                m_spectra.data() + (Kwave::toUint(k) * bins)));
+    }
+}
+
+//***************************************************************************
+void Kwave::Convolver::multiply(int first, int last, unsigned int ranges)
+{
+    const unsigned int bins = m_size + 1;
+    for (int unit = first; unit <= last; ++unit) {
+        const int          block = unit / Kwave::toInt(ranges);
+        const unsigned int range = Kwave::toUint(unit) % ranges;
+        const unsigned int p0 = (range * m_partitions) / ranges;
+        const unsigned int p1 = ((range + 1) * m_partitions) / ranges;
+
+        double *sum = reinterpret_cast<double *>(
+            m_products.data() + (Kwave::toUint(unit) * bins));
+        memset(sum, 0x00, bins * sizeof(Complex));
+
+        // plain arrays of re/im pairs, so that the loop gets vectorized
+        for (unsigned int p = p0; p < p1; ++p) {
+            const double *x = reinterpret_cast<const double *>(
+                spectrum(block - Kwave::toInt(p)));
+            const double *h = reinterpret_cast<const double *>(
+                m_kernel.constData() + (p * bins));
+            for (unsigned int b = 0; b < 2 * bins; b += 2) {
+                sum[b]     += (x[b] * h[b])     - (x[b + 1] * h[b + 1]);
+                sum[b + 1] += (x[b] * h[b + 1]) + (x[b + 1] * h[b]);
+            }
+        }
+    }
+}
+
+//***************************************************************************
+void Kwave::Convolver::finishBlocks(int first, int last, unsigned int ranges)
+{
+    const unsigned int bins = m_size + 1;
+    QVector<double> frame(Kwave::toInt(2 * m_size));
+    for (int k = first; k <= last; ++k) {
+        Complex *sum = m_products.data() + (Kwave::toUint(k) * ranges * bins);
+        for (unsigned int r = 1; r < ranges; ++r) {
+            const Complex *part = sum + (r * bins);
+            for (unsigned int b = 0; b < bins; ++b) sum[b] += part[b];
+        }
+
+        // only the second half is free of wrap-around
+        fftw_execute_dft_c2r(m_plans.inverse,
+            reinterpret_cast<fftw_complex *>(sum), frame.data());
+        memcpy(m_result.data() + (Kwave::toUint(k) * m_size),
+               frame.constData() + m_size, m_size * sizeof(double));
+    }
+}
+
+//***************************************************************************
+void Kwave::Convolver::process(const double *input, double *output,
+                               unsigned int count)
+{
+    Q_ASSERT(input);
+    Q_ASSERT(output);
+    if (!input || !output || !count) return;
+    if (!isValid()) {
+        if (output != input) memcpy(output, input, count * sizeof(double));
+        return;
+    }
+
+    const unsigned int size  = m_size;
+    const unsigned int bins  = size + 1;
+    const unsigned int total = m_fill + count;
+    const int blocks = Kwave::toInt((total + size - 1) / size);
+
+    // append the new samples, pad the last block with zeroes
+    m_time.resize(Kwave::toInt((Kwave::toUint(blocks) + 1) * size));
+    memcpy(m_time.data() + size + m_fill, input, count * sizeof(double));
+    memset(m_time.data() + size + total, 0x00,
+           (m_time.count() - (size + total)) * sizeof(double));
+
+    const int threads = qMax(1, Kwave::TaskPool::maxThreads());
+
+    // split the partitions if there are less blocks than threads
+    unsigned int ranges = 1;
+    if (blocks < threads) {
+        ranges = Kwave::toUint((threads + blocks - 1) / blocks);
+        ranges = qMin(ranges,
+            qMax(1U, m_partitions / MIN_PARTITIONS_PER_UNIT));
+    }
+    const int units = blocks * Kwave::toInt(ranges);
+
+    m_spectra.resize(blocks * Kwave::toInt(bins));
+    m_products.resize(units * Kwave::toInt(bins));
+    m_result.resize(blocks * Kwave::toInt(size));
+
+    // spectra of the blocks
+    int chunks = qMin(blocks, threads);
+    {
+        QFutureSynchronizer<void> synchronizer;
+        for (int c = 0; c < chunks; ++c)
+            synchronizer.addFuture(Kwave::TaskPool::run(
+                &Kwave::Convolver::transformBlocks, this,
+                (c * blocks) / chunks, (((c + 1) * blocks) / chunks) - 1));
+        synchronizer.waitForFinished();
+    }
+
+    // products with the partitions
+    chunks = qMin(units, threads);
+    {
+        QFutureSynchronizer<void> synchronizer;
+        for (int c = 0; c < chunks; ++c)
+            synchronizer.addFuture(Kwave::TaskPool::run(
+                &Kwave::Convolver::multiply, this,
+                (c * units) / chunks, (((c + 1) * units) / chunks) - 1,
+                ranges));
+        synchronizer.waitForFinished();
+    }
+
+    // back into the time domain
+    chunks = qMin(blocks, threads);
+    {
+        QFutureSynchronizer<void> synchronizer;
+        for (int c = 0; c < chunks; ++c)
+            synchronizer.addFuture(Kwave::TaskPool::run(
+                &Kwave::Convolver::finishBlocks, this,
+                (c * blocks) / chunks, (((c + 1) * blocks) / chunks) - 1,
+                ranges));
+        synchronizer.waitForFinished();
+    }
+
+    // mix the result with the input
+    const double  wet = m_mix;
+    const double  dry = 1.0 - m_mix;
+    const double *x   = m_time.constData() + size + m_fill;
+    const double *y   = m_result.constData() + m_fill;
+    for (unsigned int i = 0; i < count; ++i)
+        output[i] = (wet * y[i]) + (dry * x[i]);
+
+    // keep the spectra of the complete blocks, only the newest ones
+    const unsigned int complete = total / size;
+    const unsigned int keep = qMin(complete, m_partitions);
+    for (unsigned int k = complete - keep; k < complete; ++k) {
+        m_history_pos = (m_history_pos + 1) % m_partitions;
+        memcpy(static_cast<void *>(
+                   m_history.data() + (m_history_pos * bins)),
+               m_spectra.constData() + (k * bins),
+               bins * sizeof(Complex));
+    }
+
+    // the last complete block and the incomplete one stay for next time
+    m_fill = total - (complete * size);
+    if (complete)
+        memmove(m_time.data(), m_time.constData() + (complete * size),
+                (size + m_fill) * sizeof(double));
+    m_time.resize(Kwave::toInt(size + m_fill));
+}
+
+//***************************************************************************
+void Kwave::Convolver::reset()
+{
+    m_history.fill(Complex(0.0, 0.0));
+    m_history_pos = 0;
+    m_time.fill(0.0, Kwave::toInt(m_size));
+    m_fill = 0;
+}
+
+//***************************************************************************
+void Kwave::Convolver::goOn()
+{
+    emit output(m_buffer);
+}
+
+//***************************************************************************
+void Kwave::Convolver::input(Kwave::SampleArray data)
+{
+    const Kwave::SampleArray &in = data;
+    const unsigned int count = in.size();
+    bool ok = m_buffer.reuse(count);
+    Q_ASSERT(ok);
+    if (!ok) return;
+
+    QVector<double> samples(Kwave::toInt(count));
+    const sample_t *src = in.constData();
+    for (unsigned int i = 0; i < count; ++i)
+        samples[i] = sample2double(src[i]);
+
+    process(samples.constData(), samples.data(), count);
+
+    // the convolution may exceed the range, clip it
+    sample_t *dst = m_buffer.data();
+    for (unsigned int i = 0; i < count; ++i)
+        dst[i] = double2sample(qBound(-1.0, samples[i], 1.0 - 1.0 /
+            static_cast<double>(1 << (SAMPLE_BITS - 1))));
+}
+
+//***************************************************************************
+void Kwave::Convolver::setMix(const QVariant &mix)
+{
+    m_mix = qBound(0.0, QVariant(mix).toDouble(), 1.0);
+}
+
+//***************************************************************************
+//***************************************************************************
+
+#include "moc_Convolver.cpp"
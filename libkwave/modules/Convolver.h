@@ -0,0 +1,221 @@
+/***************************************************************************
+            Convolver.h  -  fast convolution with a long impulse response
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef CONVOLVER_H
+#define CONVOLVER_H
+
+#include "config.h"
+#include "libkwave_export.h"
+
+#include <complex>
+
+#include <QtGlobal>
+#include <QObject>
+#include <QVariant>
+#include <QVector>
+
+#include "libkwave/SampleArray.h"
+#include "libkwave/SampleSource.h"
+
+/** opaque plan of libfftw, see fftw3.h */
+struct fftw_plan_s;
+
+namespace Kwave
+{
+
+    /**
+     * Convolution of a stream with a long impulse response (FIR filter),
+     * with the uniformly partitioned overlap-save method. The impulse
+     * response is split into partitions of equal size, the spectra of
+     * the partitions are multiplied with the spectra of the recent
+     * input blocks and summed up, so that the effort per sample grows
+     * only with the logarithm of the partition size.
+     *
+     * The output is not delayed, each call of input() emits as many
+     * samples as it received. A block that is not yet complete is
+     * transformed with zeroes in place of the missing samples and
+     * transformed again when more input arrives.
+     *
+     * All blocks of one input buffer are processed in parallel in the
+     * task pool, for short input buffers the partitions are split
+     * among the threads instead. The FFTW plans are created once per
+     * size and shared by all instances.
+     */
+    class LIBKWAVE_EXPORT Convolver: public Kwave::SampleSource
+    {
+        Q_OBJECT
+    public:
+
+        /** complex value of one bin of a spectrum */
+        typedef std::complex<double> Complex;
+
+        /**
+         * Constructor
+         * @param response the impulse response
+         * @param partition size of one partition, must be a power of
+         *                  two, zero selects a size that fits to the
+         *                  length of the response
+         */
+        explicit Convolver(const QVector<double> &response,
+                           unsigned int partition = 0);
+
+        /** Destructor */
+        ~Convolver() override;
+
+        /** returns true if the plans could be created */
+        bool isValid() const;
+
+        /** returns the size of one partition [samples] */
+        inline unsigned int partitionSize() const { return m_size; }
+
+        /** returns the number of partitions of the impulse response */
+        inline unsigned int partitions() const { return m_partitions; }
+
+        /**
+         * Convolves a number of samples, continuing the previous input
+         * @param input the input samples
+         * @param output receives the same number of samples, may be the
+         *               same as the input
+         * @param count number of samples
+         */
+        void process(const double *input, double *output,
+                     unsigned int count);
+
+        /** discards the previous input, like after silence */
+        void reset();
+
+        /** emits the output of the last input() */
+        void goOn() override;
+
+    signals:
+
+        /** emits a block with the convolved data */
+        void output(Kwave::SampleArray data);
+
+    public slots:
+
+        /** receives input data */
+        void input(Kwave::SampleArray data);
+
+        /**
+         * Sets the portion of the convolved signal in the output,
+         * as a factor [0 ... 1], the rest is the input signal.
+         * The default setting is 1.0.
+         */
+        void setMix(const QVariant &mix);
+
+    private:
+
+        /** shared FFTW plans for one partition size */
+        typedef struct {
+            fftw_plan_s *forward; /**< 2 * size real -> size + 1 complex */
+            fftw_plan_s *inverse; /**< size + 1 complex -> 2 * size real */
+        } Plans;
+
+        /**
+         * Returns the plans for a partition size, creates them on the
+         * first use and keeps them until the program exits
+         */
+        static Plans plans(unsigned int size);
+
+        /**
+         * Returns the spectrum of an earlier input block
+         * @param block index of the block, relative to the first one
+         *              of the current input, negative for older blocks
+         * @return pointer to size + 1 bins
+         */
+        const Complex *spectrum(int block) const;
+
+        /**
+         * Transforms a range of the current input blocks, runs in a
+         * worker thread
+         * @param first index of the first block
+         * @param last index of the last block
+         */
+        void transformBlocks(int first, int last);
+
+        /**
+         * Multiplies the spectra of the blocks and their predecessors
+         * with the partitions and sums them up, runs in a worker thread.
+         * Each block is split into a number of units, each unit covers
+         * a range of the partitions and has its own partial sum.
+         * @param first index of the first unit
+         * @param last index of the last unit
+         * @param ranges number of units per block
+         */
+        void multiply(int first, int last, unsigned int ranges);
+
+        /**
+         * Sums up the partial products of a range of blocks, transforms
+         * them back and stores the valid part, runs in a worker thread
+         * @param first index of the first block
+         * @param last index of the last block
+         * @param ranges number of partial products per block
+         */
+        void finishBlocks(int first, int last, unsigned int ranges);
+
+    private:
+
+        /** size of one partition and hop size */
+        unsigned int m_size;
+
+        /** number of partitions */
+        unsigned int m_partitions;
+
+        /** the plans, not owned */
+        Plans m_plans;
+
+        /** spectra of the partitions, scaled for the inverse FFT */
+        QVector<Complex> m_kernel;
+
+        /** spectra of the last complete input blocks, ring buffer */
+        QVector<Complex> m_history;
+
+        /** index of the newest block in the history */
+        unsigned int m_history_pos;
+
+        /**
+         * input of the current call: the last complete block, then
+         * the incomplete block of the previous calls and the new samples
+         */
+        QVector<double> m_time;
+
+        /** number of samples in the incomplete block */
+        unsigned int m_fill;
+
+        /** spectra of the blocks of the current call */
+        QVector<Complex> m_spectra;
+
+        /** partial sums of the products of the current call */
+        QVector<Complex> m_products;
+
+        /** convolved blocks of the current call, second halves only */
+        QVector<double> m_result;
+
+        /** portion of the convolved signal */
+        double m_mix;
+
+        /** buffer for input */
+        Kwave::SampleArray m_buffer;
+
+    };
+}
+
+#endif /* CONVOLVER_H */
+
+//***************************************************************************
+//***************************************************************************
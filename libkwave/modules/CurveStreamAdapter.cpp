@@ -15,6 +15,7 @@
  *                                                                         *
  ***************************************************************************/
 
+#include "libkwave/Utils.h"
 #include "libkwave/modules/CurveStreamAdapter.h"
 
 /***************************************************************************/
@@ -23,7 +24,8 @@ Kwave::CurveStreamAdapter::CurveStreamAdapter(Kwave::Curve &curve,
     :Kwave::SampleSource(),
      m_position(0), m_length(length),
      m_interpolation(curve.interpolation()),
-     m_buffer(blockSize())
+     m_buffer(blockSize()),
+     m_values()
 {
 }
 
@@ -35,23 +37,30 @@ Kwave::CurveStreamAdapter::~CurveStreamAdapter()
 /***************************************************************************/
 void Kwave::CurveStreamAdapter::goOn()
 {
-    unsigned int offset;
-    double x_max = static_cast<double>(m_length);
     const unsigned int samples = blockSize();
+    if (!m_buffer.reuse(samples)) return;
+    if (Kwave::toUint(m_values.size()) < samples) m_values.resize(samples);
 
-    // fill with interpolated points
-    for (offset = 0; offset < samples; ++offset) {
-        // x is [0.0 ... 1.0]
-        const double x = static_cast<double>(m_position) / x_max;
-        const double y = m_interpolation.singleInterpolation(x);
-        m_buffer[offset] = double2sample(y);
-        m_position++;
-
-        // wrap-around, for periodic signals
+    // fill with interpolated points, x is [0.0 ... 1.0]
+    double *values = m_values.data();
+    unsigned int offset = 0;
+    while (offset < samples) {
+        // wrap-around after the last position, for periodic signals
+        const sample_index_t rest = m_length - m_position + 1;
+        const unsigned int n = (rest < samples - offset) ?
+            Kwave::toUint(rest) : (samples - offset);
+        m_interpolation.interpolateRange(m_position, m_length,
+                                         values + offset, n);
+        offset     += n;
+        m_position += n;
         if (m_position > m_length)
             m_position = 0;
     }
 
+    sample_t *p = m_buffer.data();
+    for (offset = 0; offset < samples; ++offset)
+        p[offset] = double2sample(values[offset]);
+
     emit output(m_buffer);
 }
 
@@ -22,6 +22,7 @@
 #include "libkwave_export.h"
 
 #include <QtGlobal>
+#include <QVector>
 
 #include "libkwave/Curve.h"
 #include "libkwave/SampleSource.h"
@@ -66,6 +67,9 @@ namespace Kwave
         /** array with the interpolated curve data */
         Kwave::SampleArray m_buffer;
 
+        /** interpolated values of one block, before conversion */
+        QVector<double> m_values;
+
     };
 
 }
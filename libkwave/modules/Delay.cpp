@@ -34,7 +34,13 @@ Kwave::Delay::~Delay()
 //***************************************************************************
 void Kwave::Delay::goOn()
 {
-    m_fifo.get(m_out_buffer);
+    if (!m_out_buffer.reuse(m_out_buffer.size())) return;
+
+    // the recycled block contains garbage, pad with silence as long as
+    // the FIFO does not deliver enough samples
+    unsigned int pos = m_fifo.get(m_out_buffer);
+    while (pos < m_out_buffer.size()) m_out_buffer[pos++] = 0;
+
     emit output(m_out_buffer);
 }
 
@@ -0,0 +1,419 @@
+/***************************************************************************
+      LoudnessMeter.cpp  -  loudness measurement after ITU-R BS.1770
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "libkwave/modules/LoudnessMeter.h"
+
+/** number of samples that are processed at once */
+#define CHUNK 256
+
+/** length of the momentary loudness window, in sub-blocks of 100ms */
+#define MOMENTARY_BLOCKS 4
+
+/** length of the short term loudness window, in sub-blocks of 100ms */
+#define SHORT_TERM_BLOCKS 30
+
+/** absolute gate [LUFS] */
+#define ABSOLUTE_GATE (-70.0)
+
+/** relative gate of the integrated loudness [LU] */
+#define RELATIVE_GATE (-10.0)
+
+/** relative gate of the loudness range [LU] */
+#define RELATIVE_GATE_LRA (-20.0)
+
+/** upper limit of the loudness histogram [LUFS] */
+#define HISTOGRAM_MAX (20.0)
+
+/** resolution of the loudness histogram [bins per LU] */
+#define HISTOGRAM_RESOLUTION 50
+
+/** number of bins of the loudness histogram */
+#define HISTOGRAM_BINS \
+    static_cast<int>((HISTOGRAM_MAX - ABSOLUTE_GATE) * HISTOGRAM_RESOLUTION)
+
+/** center tap of the true peak interpolation filter */
+#define TP_CENTER ((LOUDNESS_TP_TAPS / 2) - 1)
+
+//***************************************************************************
+Kwave::LoudnessMeter::LoudnessMeter(double rate, unsigned int channels)
+    :m_block_length(qMax(1, qRound(rate / 10.0))), m_channels(channels),
+     m_hist_blocks(0), m_hist_energy(HISTOGRAM_BINS, 0.0),
+     m_hist_count(HISTOGRAM_BINS, 0), m_hist_sum(0.0), m_hist_gated(0)
+{
+    Q_ASSERT(rate > 0);
+    if (rate <= 0) rate = 48000.0;
+
+    // K-weighting, stage 1: high shelf that models the head,
+    // computed for any sample rate from the analog prototype
+    double f0 = 1681.974450955533;
+    double g  = 3.999843853973347;
+    double q  = 0.7071752369554196;
+    double k  = tan(M_PI * f0 / rate);
+    const double vh = pow(10.0, g / 20.0);
+    const double vb = pow(vh, 0.4996667741545416);
+    double a0 = 1.0 + (k / q) + (k * k);
+    m_coeff[0][0] = (vh + (vb * k / q) + (k * k)) / a0;
+    m_coeff[0][1] = 2.0 * ((k * k) - vh) / a0;
+    m_coeff[0][2] = (vh - (vb * k / q) + (k * k)) / a0;
+    m_coeff[0][3] = 2.0 * ((k * k) - 1.0) / a0;
+    m_coeff[0][4] = (1.0 - (k / q) + (k * k)) / a0;
+
+    // K-weighting, stage 2: RLB highpass
+    f0 = 38.13547087602444;
+    q  = 0.5003270373238773;
+    k  = tan(M_PI * f0 / rate);
+    a0 = 1.0 + (k / q) + (k * k);
+    m_coeff[1][0] =  1.0;
+    m_coeff[1][1] = -2.0;
+    m_coeff[1][2] =  1.0;
+    m_coeff[1][3] = 2.0 * ((k * k) - 1.0) / a0;
+    m_coeff[1][4] = (1.0 - (k / q) + (k * k)) / a0;
+
+    // true peak: windowed sinc interpolation, one set of taps per phase
+    for (unsigned int p = 0; p < LOUDNESS_TP_PHASES; ++p) {
+        double sum = 0.0;
+        for (unsigned int i = 0; i < LOUDNESS_TP_TAPS; ++i) {
+            const double t = TP_CENTER - static_cast<double>(i) +
+                (static_cast<double>(p) / LOUDNESS_TP_PHASES);
+            const double x = M_PI * t;
+            const double sinc = (fabs(x) < 1E-9) ? 1.0 : (sin(x) / x);
+            const double window = 0.5 *
+                (1.0 + cos(M_PI * t / (LOUDNESS_TP_TAPS / 2)));
+            m_tp_coeff[p][i] = static_cast<float>(sinc * window);
+            sum += sinc * window;
+        }
+        for (unsigned int i = 0; i < LOUDNESS_TP_TAPS; ++i)
+            m_tp_coeff[p][i] = static_cast<float>(m_tp_coeff[p][i] / sum);
+    }
+
+    // channel weights, only 5.1 has surround channels and an LFE
+    for (unsigned int c = 0; c < channels; ++c) {
+        double weight = 1.0;
+        if (channels == 6) {
+            if (c == 3) weight = 0.0;  // LFE
+            if (c >= 4) weight = 1.41; // Ls, Rs
+        }
+        m_channels[c].weight = weight;
+    }
+
+    reset();
+}
+
+//***************************************************************************
+Kwave::LoudnessMeter::~LoudnessMeter()
+{
+}
+
+//***************************************************************************
+void Kwave::LoudnessMeter::reset()
+{
+    for (Channel &c : m_channels) {
+        c.s[0][0] = c.s[0][1] = 0.0;
+        c.s[1][0] = c.s[1][1] = 0.0;
+        c.sum  = 0.0;
+        c.fill = 0;
+        c.energy.clear();
+        for (unsigned int i = 0; i < LOUDNESS_TP_TAPS - 1; ++i)
+            c.history[i] = 0.0f;
+        c.peak = 0.0f;
+    }
+
+    m_hist_blocks = 0;
+    m_hist_energy.fill(0.0);
+    m_hist_count.fill(0);
+    m_hist_sum    = 0.0;
+    m_hist_gated  = 0;
+}
+
+//***************************************************************************
+void Kwave::LoudnessMeter::process(unsigned int channel,
+                                   const sample_t *samples,
+                                   unsigned int count)
+{
+    Q_ASSERT(channel < channels());
+    Q_ASSERT(samples);
+    if ((channel >= channels()) || !samples) return;
+
+    Channel &c = m_channels[channel];
+    const double (&f1)[5] = m_coeff[0];
+    const double (&f2)[5] = m_coeff[1];
+
+    float x[CHUNK];
+    float buf[(LOUDNESS_TP_TAPS - 1) + CHUNK];
+    float acc[CHUNK];
+    while (count) {
+        const unsigned int n = qMin<unsigned int>(count, CHUNK);
+        samples2floats(samples, x, n);
+
+        // K-weighting and energy per sub-block, the feedback of the
+        // filters does not allow vectorizing this part
+        for (unsigned int i = 0; i < n; ++i) {
+            const double in = x[i];
+            const double y1 = (f1[0] * in) + c.s[0][0];
+            c.s[0][0] = (f1[1] * in) - (f1[3] * y1) + c.s[0][1];
+            c.s[0][1] = (f1[2] * in) - (f1[4] * y1);
+            const double y2 = (f2[0] * y1) + c.s[1][0];
+            c.s[1][0] = (f2[1] * y1) - (f2[3] * y2) + c.s[1][1];
+            c.s[1][1] = (f2[2] * y1) - (f2[4] * y2);
+
+            c.sum += y2 * y2;
+            if (++c.fill >= m_block_length) {
+                c.energy.append(c.sum);
+                c.sum  = 0.0;
+                c.fill = 0;
+            }
+        }
+
+        // true peak: the samples themselves...
+        float peak = c.peak;
+        for (unsigned int i = 0; i < n; ++i)
+            peak = qMax(peak, fabsf(x[i]));
+
+        // ...and the interpolated values between them, with a delay
+        // of half the filter length
+        for (unsigned int i = 0; i < LOUDNESS_TP_TAPS - 1; ++i)
+            buf[i] = c.history[i];
+        for (unsigned int i = 0; i < n; ++i)
+            buf[(LOUDNESS_TP_TAPS - 1) + i] = x[i];
+        for (unsigned int p = 1; p < LOUDNESS_TP_PHASES; ++p) {
+            for (unsigned int i = 0; i < n; ++i)
+                acc[i] = 0.0f;
+            for (unsigned int k = 0; k < LOUDNESS_TP_TAPS; ++k) {
+                const float coeff = m_tp_coeff[p][k];
+                const float *in   = buf + k;
+                for (unsigned int i = 0; i < n; ++i)
+                    acc[i] += coeff * in[i];
+            }
+            for (unsigned int i = 0; i < n; ++i)
+                peak = qMax(peak, fabsf(acc[i]));
+        }
+        for (unsigned int i = 0; i < LOUDNESS_TP_TAPS - 1; ++i)
+            c.history[i] = buf[n + i];
+        c.peak = peak;
+
+        samples += n;
+        count   -= n;
+    }
+}
+
+//***************************************************************************
+QVector<double> Kwave::LoudnessMeter::cumulatedEnergy() const
+{
+    int blocks = std::numeric_limits<int>::max();
+    for (const Channel &c : m_channels)
+        blocks = qMin(blocks, static_cast<int>(c.energy.size()));
+    if (m_channels.isEmpty()) blocks = 0;
+
+    QVector<double> cum(blocks + 1, 0.0);
+    for (const Channel &c : m_channels) {
+        if (c.weight <= 0.0) continue;
+        const double *e = c.energy.constData();
+        double sum = 0.0;
+        for (int i = 0; i < blocks; ++i) {
+            sum += c.weight * e[i];
+            cum[i + 1] += sum;
+        }
+    }
+    return cum;
+}
+
+//***************************************************************************
+double Kwave::LoudnessMeter::loudness(double energy, unsigned int blocks) const
+{
+    const double z = energy /
+        (static_cast<double>(blocks) * static_cast<double>(m_block_length));
+    if (!(z > 0.0)) return -std::numeric_limits<double>::infinity();
+    return -0.691 + (10.0 * log10(z));
+}
+
+//***************************************************************************
+QVector<double> Kwave::LoudnessMeter::blockLoudness(unsigned int blocks) const
+{
+    const QVector<double> cum = cumulatedEnergy();
+    const int n = static_cast<int>(cum.size()) - static_cast<int>(blocks);
+    QVector<double> result;
+    for (int j = 0; j < n; ++j)
+        result.append(loudness(cum[j + blocks] - cum[j], blocks));
+    return result;
+}
+
+//***************************************************************************
+double Kwave::LoudnessMeter::lastBlocks(unsigned int blocks) const
+{
+    double energy = 0.0;
+    unsigned int n = blocks;
+    for (const Channel &c : m_channels) {
+        n = qMin(n, static_cast<unsigned int>(c.energy.size()));
+    }
+    if (!n) return -std::numeric_limits<double>::infinity();
+
+    for (const Channel &c : m_channels) {
+        const unsigned int last = static_cast<unsigned int>(c.energy.size());
+        for (unsigned int i = last - n; i < last; ++i)
+            energy += c.weight * c.energy[i];
+    }
+    return loudness(energy, n);
+}
+
+//***************************************************************************
+double Kwave::LoudnessMeter::momentary() const
+{
+    return lastBlocks(MOMENTARY_BLOCKS);
+}
+
+//***************************************************************************
+double Kwave::LoudnessMeter::shortTerm() const
+{
+    return lastBlocks(SHORT_TERM_BLOCKS);
+}
+
+//***************************************************************************
+double Kwave::LoudnessMeter::momentaryMax() const
+{
+    const QVector<double> l = blockLoudness(MOMENTARY_BLOCKS);
+    if (l.isEmpty()) return momentary();
+    return *std::max_element(l.constBegin(), l.constEnd());
+}
+
+//***************************************************************************
+double Kwave::LoudnessMeter::shortTermMax() const
+{
+    const QVector<double> l = blockLoudness(SHORT_TERM_BLOCKS);
+    if (l.isEmpty()) return shortTerm();
+    return *std::max_element(l.constBegin(), l.constEnd());
+}
+
+//***************************************************************************
+void Kwave::LoudnessMeter::updateHistogram() const
+{
+    int blocks = std::numeric_limits<int>::max();
+    for (const Channel &c : m_channels)
+        blocks = qMin(blocks, static_cast<int>(c.energy.size()));
+    if (m_channels.isEmpty()) blocks = 0;
+
+    // only the blocks that have been completed since the last call,
+    // with a step of one sub-block
+    const int n = blocks - MOMENTARY_BLOCKS + 1;
+    for (int j = m_hist_blocks; j < n; ++j) {
+        double e = 0.0;
+        for (const Channel &c : m_channels) {
+            if (c.weight <= 0.0) continue;
+            const double *energy = c.energy.constData() + j;
+            double sum = 0.0;
+            for (int i = 0; i < MOMENTARY_BLOCKS; ++i)
+                sum += energy[i];
+            e += c.weight * sum;
+        }
+
+        // absolute gate
+        const double l = loudness(e, MOMENTARY_BLOCKS);
+        if (l <= ABSOLUTE_GATE) continue;
+
+        const int bin = qBound(0, static_cast<int>(
+            (l - ABSOLUTE_GATE) * HISTOGRAM_RESOLUTION), HISTOGRAM_BINS - 1);
+        m_hist_energy[bin] += e;
+        m_hist_count[bin]++;
+        m_hist_sum += e;
+        m_hist_gated++;
+    }
+    if (n > m_hist_blocks) m_hist_blocks = n;
+}
+
+//***************************************************************************
+double Kwave::LoudnessMeter::integrated() const
+{
+    // the blocks above the absolute gate are kept in a histogram, so
+    // that each call only needs to look at the new blocks
+    updateHistogram();
+    if (!m_hist_gated) return -std::numeric_limits<double>::infinity();
+
+    // relative gate, applied to the centers of the bins
+    const double gate = loudness(m_hist_sum / m_hist_gated,
+                                 MOMENTARY_BLOCKS) + RELATIVE_GATE;
+    double  sum   = 0.0;
+    quint64 count = 0;
+    for (int bin = 0; bin < HISTOGRAM_BINS; ++bin) {
+        const double l = ABSOLUTE_GATE +
+            ((bin + 0.5) / HISTOGRAM_RESOLUTION);
+        if (l <= gate) continue;
+        sum   += m_hist_energy[bin];
+        count += m_hist_count[bin];
+    }
+    if (!count) return -std::numeric_limits<double>::infinity();
+    return loudness(sum / count, MOMENTARY_BLOCKS);
+}
+
+//***************************************************************************
+double Kwave::LoudnessMeter::loudnessRange() const
+{
+    const QVector<double> cum = cumulatedEnergy();
+    const int n = static_cast<int>(cum.size()) - SHORT_TERM_BLOCKS;
+
+    // short term loudness, with absolute gate
+    QVector<double> values;
+    double sum = 0.0;
+    for (int j = 0; j < n; ++j) {
+        const double e = cum[j + SHORT_TERM_BLOCKS] - cum[j];
+        const double l = loudness(e, SHORT_TERM_BLOCKS);
+        if (l <= ABSOLUTE_GATE) continue;
+        values.append(l);
+        sum += e;
+    }
+    if (values.count() < 2) return 0.0;
+
+    // relative gate
+    const double gate = loudness(sum / values.count(), SHORT_TERM_BLOCKS) +
+                        RELATIVE_GATE_LRA;
+    QVector<double> gated;
+    for (const double l : std::as_const(values))
+        if (l > gate) gated.append(l);
+    if (gated.count() < 2) return 0.0;
+
+    // difference between the 10% and the 95% percentile
+    std::sort(gated.begin(), gated.end());
+    const double last = static_cast<double>(gated.count() - 1);
+    const double low  = gated[qRound(0.10 * last)];
+    const double high = gated[qRound(0.95 * last)];
+    return high - low;
+}
+
+//***************************************************************************
+double Kwave::LoudnessMeter::truePeak() const
+{
+    double peak = 0.0;
+    for (const Channel &c : m_channels)
+        peak = qMax(peak, static_cast<double>(c.peak));
+    return peak;
+}
+
+//***************************************************************************
+double Kwave::LoudnessMeter::truePeak(unsigned int channel) const
+{
+    Q_ASSERT(channel < channels());
+    if (channel >= channels()) return 0.0;
+    return m_channels[channel].peak;
+}
+
+//***************************************************************************
+//***************************************************************************
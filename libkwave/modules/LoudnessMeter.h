@@ -0,0 +1,194 @@
+/***************************************************************************
+        LoudnessMeter.h  -  loudness measurement after ITU-R BS.1770
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef LOUDNESS_METER_H
+#define LOUDNESS_METER_H
+
+#include "config.h"
+#include "libkwave_export.h"
+
+#include <QtGlobal>
+#include <QVector>
+
+#include "libkwave/Sample.h"
+
+/** number of taps per phase of the true peak interpolation filter */
+#define LOUDNESS_TP_TAPS 12
+
+/** oversampling factor of the true peak measurement */
+#define LOUDNESS_TP_PHASES 4
+
+namespace Kwave
+{
+
+    /**
+     * Streaming loudness meter after ITU-R BS.1770-4 and EBU R128 / EBU
+     * Tech 3342. The samples of each channel are passed through the
+     * K-weighting filter and their energy is collected in sub-blocks of
+     * 100ms, from which the momentary (400ms), short term (3s) and gated
+     * integrated loudness and the loudness range are derived. The true
+     * peak is measured with 4x oversampling.
+     *
+     * The channels are independent of each other until the results are
+     * read out, so process() may be called for different channels from
+     * different threads at the same time.
+     *
+     * Loudness values are in LUFS, or -infinity if there was no signal.
+     */
+    class LIBKWAVE_EXPORT LoudnessMeter
+    {
+    public:
+
+        /**
+         * Constructor
+         * @param rate sample rate [samples per second]
+         * @param channels number of channels, with six channels the
+         *                 order L, R, C, LFE, Ls, Rs is assumed
+         */
+        LoudnessMeter(double rate, unsigned int channels);
+
+        /** Destructor */
+        virtual ~LoudnessMeter();
+
+        /** returns the number of channels */
+        inline unsigned int channels() const {
+            return static_cast<unsigned int>(m_channels.size());
+        }
+
+        /** discards all measured data and starts again */
+        void reset();
+
+        /**
+         * Processes a block of samples of one channel
+         * @param channel index of the channel
+         * @param samples pointer to the first sample
+         * @param count number of samples
+         */
+        void process(unsigned int channel, const sample_t *samples,
+                     unsigned int count);
+
+        /** returns the loudness of the last 400ms */
+        double momentary() const;
+
+        /** returns the loudness of the last 3 seconds */
+        double shortTerm() const;
+
+        /** returns the highest momentary loudness */
+        double momentaryMax() const;
+
+        /** returns the highest short term loudness */
+        double shortTermMax() const;
+
+        /** returns the gated loudness of everything processed so far */
+        double integrated() const;
+
+        /** returns the loudness range after EBU Tech 3342 [LU] */
+        double loudnessRange() const;
+
+        /** returns the highest true peak of all channels [linear] */
+        double truePeak() const;
+
+        /**
+         * returns the true peak of one channel [linear]
+         * @param channel index of the channel
+         */
+        double truePeak(unsigned int channel) const;
+
+    private:
+
+        /** state of one channel */
+        typedef struct {
+            double             weight;  /**< weight of the channel         */
+            double             s[2][2]; /**< states of the two biquads     */
+            double             sum;     /**< energy of current sub-block   */
+            unsigned int       fill;    /**< samples in current sub-block  */
+            QVector<double>    energy;  /**< energy of all sub-blocks      */
+            float              history[LOUDNESS_TP_TAPS - 1]; /**< input */
+            float              peak;    /**< true peak [linear]            */
+        } Channel;
+
+        /**
+         * Returns the weighted energy of all channels per sub-block,
+         * as a running sum that starts with zero
+         */
+        QVector<double> cumulatedEnergy() const;
+
+        /**
+         * Converts the energy of a number of sub-blocks into a loudness
+         * @param energy sum of the weighted energy of all channels
+         * @param blocks number of sub-blocks
+         */
+        double loudness(double energy, unsigned int blocks) const;
+
+        /**
+         * Returns the loudness of all blocks with a given length,
+         * with a step of one sub-block
+         * @param blocks length of the blocks, in sub-blocks
+         */
+        QVector<double> blockLoudness(unsigned int blocks) const;
+
+        /**
+         * Returns the loudness of the last sub-blocks
+         * @param blocks number of sub-blocks
+         */
+        double lastBlocks(unsigned int blocks) const;
+
+        /**
+         * Sorts the 400ms blocks that have been completed since the
+         * last call into the loudness histogram
+         */
+        void updateHistogram() const;
+
+    private:
+
+        /** length of a sub-block of 100ms [samples] */
+        unsigned int m_block_length;
+
+        /** coefficients of the two biquads: b0, b1, b2, a1, a2 */
+        double m_coeff[2][5];
+
+        /** coefficients of the polyphase true peak interpolation filter */
+        float m_tp_coeff[LOUDNESS_TP_PHASES][LOUDNESS_TP_TAPS];
+
+        /** state of all channels */
+        QVector<Channel> m_channels;
+
+        /** number of 400ms blocks that are in the histogram */
+        mutable int m_hist_blocks;
+
+        /**
+         * histogram of the 400ms blocks above the absolute gate, by
+         * loudness: sum of the energy and number of blocks per bin
+         */
+        mutable QVector<double> m_hist_energy;
+
+        /** @see m_hist_energy */
+        mutable QVector<quint64> m_hist_count;
+
+        /** sum of the energy of all blocks in the histogram */
+        mutable double m_hist_sum;
+
+        /** number of blocks in the histogram */
+        mutable quint64 m_hist_gated;
+
+    };
+}
+
+#endif /* LOUDNESS_METER_H */
+
+//***************************************************************************
+//***************************************************************************
@@ -103,7 +103,7 @@ void Kwave::Mul::multiply()
 //      qWarning("Kwave::Mul: block sizes differ: %u x %u -> shrinked to %u",
 //          m_a.size(), m_b.size(), count);
 
-    bool ok = m_buffer_x.resize(count);
+    bool ok = m_buffer_x.reuse(count);
     Q_ASSERT(ok);
     Q_UNUSED(ok)
 
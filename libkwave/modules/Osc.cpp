@@ -17,15 +17,14 @@
 
 #include "config.h"
 
-#include <math.h>
-
 #include "libkwave/modules/Osc.h"
 
 //***************************************************************************
 Kwave::Osc::Osc()
     :Kwave::SampleSource(),
-    m_buffer(blockSize()), m_omega_t(0.0), m_f(44.1), m_a(1.0)
+    m_buffer(blockSize()), m_float_buffer(), m_osc(), m_f(44.1)
 {
+    m_osc.setFrequency(1.0 / m_f);
 }
 
 //***************************************************************************
@@ -36,24 +35,16 @@ Kwave::Osc::~Osc()
 //***************************************************************************
 void Kwave::Osc::goOn()
 {
-    unsigned int samples = m_buffer.size();
-    const double two_pi = 2.0 * M_PI;
+    const unsigned int samples = m_buffer.size();
+    if (!m_buffer.reuse(samples)) return;
 
     Q_ASSERT(!qFuzzyIsNull(m_f));
     if (qFuzzyIsNull(m_f)) return;
 
-    double omega = two_pi / m_f;
-    for (unsigned int sample = 0; sample < samples; sample++) {
-        // calculate one sample as sin(w * t)
-        m_buffer[sample] = double2sample(m_a * sin(m_omega_t));
-
-        // next time, t++
-        m_omega_t += omega;
-
-        // limit the argument of sin() to [0 ... 4*Pi]
-        while (m_omega_t > two_pi)
-            m_omega_t -= two_pi;
-    }
+    // generate a block of floats and convert it to samples
+    m_float_buffer.resize(samples);
+    m_osc.generate(m_float_buffer.data(), samples);
+    floats2samples(m_float_buffer.constData(), m_buffer.data(), samples);
 
     emit output(m_buffer);
 }
@@ -62,18 +53,19 @@ void Kwave::Osc::goOn()
 void Kwave::Osc::setFrequency(const QVariant &f)
 {
     m_f = QVariant(f).toDouble();
+    if (!qFuzzyIsNull(m_f)) m_osc.setFrequency(1.0 / m_f);
 }
 
 //***************************************************************************
 void Kwave::Osc::setPhase(const QVariant &p)
 {
-    m_omega_t = QVariant(p).toDouble();
+    m_osc.setPhase(QVariant(p).toDouble());
 }
 
 //***************************************************************************
 void Kwave::Osc::setAmplitude(const QVariant &a)
 {
-    m_a = QVariant(a).toDouble();
+    m_osc.setAmplitude(QVariant(a).toDouble());
 }
 
 //***************************************************************************
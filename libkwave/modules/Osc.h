@@ -24,8 +24,10 @@
 #include <QtGlobal>
 #include <QObject>
 #include <QVariant>
+#include <QVector>
 
 #include "libkwave/SampleSource.h"
+#include "libkwave/modules/PhasorOscillator.h"
 
 namespace Kwave
 {
@@ -73,14 +75,14 @@ namespace Kwave
             /** buffer for output data */
             Kwave::SampleArray m_buffer;
 
-            /** current time multiplied by 2*Pi*f */
-            double m_omega_t;
+            /** buffer for the output of the oscillator */
+            QVector<float> m_float_buffer;
+
+            /** the oscillator */
+            Kwave::PhasorOscillator m_osc;
 
             /** frequency [samples/period] */
             double m_f;
-
-            /** amplitude [0...1] */
-            double m_a;
     };
 }
 
@@ -0,0 +1,131 @@
+/***************************************************************************
+   PhasorOscillator.cpp  -  block based sine oscillator with rotating phasor
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <math.h>
+
+#include "libkwave/modules/PhasorOscillator.h"
+
+/** number of phasors that are rotated in parallel */
+#define LANES 4
+
+/** number of samples between two re-initializations of the phasors */
+#define SYNC_INTERVAL 1024
+
+//***************************************************************************
+Kwave::PhasorOscillator::PhasorOscillator()
+    :m_phase(0.0), m_omega(0.0), m_amplitude(1.0),
+     m_rot_re(1.0), m_rot_im(0.0), m_countdown(0)
+{
+    for (unsigned int k = 0; k < LANES; ++k) {
+        m_re[k] = 1.0;
+        m_im[k] = 0.0;
+    }
+}
+
+//***************************************************************************
+Kwave::PhasorOscillator::~PhasorOscillator()
+{
+}
+
+//***************************************************************************
+void Kwave::PhasorOscillator::setFrequency(double f)
+{
+    m_omega     = 2.0 * M_PI * f;
+    m_countdown = 0;
+}
+
+//***************************************************************************
+void Kwave::PhasorOscillator::setPhase(double phase)
+{
+    m_phase     = fmod(phase, 2.0 * M_PI);
+    if (m_phase < 0) m_phase += 2.0 * M_PI;
+    m_countdown = 0;
+}
+
+//***************************************************************************
+void Kwave::PhasorOscillator::setAmplitude(double a)
+{
+    m_amplitude = a;
+}
+
+//***************************************************************************
+void Kwave::PhasorOscillator::sync()
+{
+    for (unsigned int k = 0; k < LANES; ++k) {
+        const double phi = m_phase + (k * m_omega);
+        m_re[k] = cos(phi);
+        m_im[k] = sin(phi);
+    }
+    m_rot_re    = cos(LANES * m_omega);
+    m_rot_im    = sin(LANES * m_omega);
+    m_countdown = SYNC_INTERVAL;
+}
+
+//***************************************************************************
+void Kwave::PhasorOscillator::generate(float *dst, unsigned int count)
+{
+    Q_ASSERT(dst);
+    if (!dst) return;
+
+    const double a = m_amplitude;
+    while (count) {
+        if (!m_countdown) sync();
+
+        const unsigned int n    = qMin(count, m_countdown);
+        const unsigned int full = n - (n % LANES);
+
+        // work on local copies, to let the compiler keep them in registers
+        double re[LANES];
+        double im[LANES];
+        for (unsigned int k = 0; k < LANES; ++k) {
+            re[k] = m_re[k];
+            im[k] = m_im[k];
+        }
+        const double rot_re = m_rot_re;
+        const double rot_im = m_rot_im;
+
+        for (unsigned int i = 0; i < full; i += LANES) {
+            for (unsigned int k = 0; k < LANES; ++k) {
+                dst[i + k] = static_cast<float>(a * im[k]);
+                const double r = (re[k] * rot_re) - (im[k] * rot_im);
+                im[k] = (re[k] * rot_im) + (im[k] * rot_re);
+                re[k] = r;
+            }
+        }
+
+        // a partial group at the end: the phasors do not match the
+        // next sample anymore, re-initialize them next time
+        const unsigned int rest = n - full;
+        for (unsigned int k = 0; k < rest; ++k)
+            dst[full + k] = static_cast<float>(a * im[k]);
+
+        for (unsigned int k = 0; k < LANES; ++k) {
+            m_re[k] = re[k];
+            m_im[k] = im[k];
+        }
+        m_countdown = (rest) ? 0 : (m_countdown - n);
+
+        m_phase = fmod(m_phase + (n * m_omega), 2.0 * M_PI);
+        dst   += n;
+        count -= n;
+    }
+}
+
+//***************************************************************************
+//***************************************************************************
@@ -0,0 +1,115 @@
+/***************************************************************************
+     PhasorOscillator.h  -  block based sine oscillator with rotating phasor
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef PHASOR_OSCILLATOR_H
+#define PHASOR_OSCILLATOR_H
+
+#include "config.h"
+#include "libkwave_export.h"
+
+#include <QtGlobal>
+
+namespace Kwave
+{
+
+    /**
+     * Sine oscillator that works on blocks of samples. Instead of calling
+     * sin() for each sample, it rotates a complex phasor by the phase
+     * increment per sample, which needs only a complex multiplication.
+     * Four phasors for four consecutive samples are rotated in parallel,
+     * so that the compiler can vectorize the inner loop.
+     *
+     * Rounding errors of the recursion are accumulating, so the phasors
+     * are periodically re-initialized from an exact phase accumulator
+     * (every 1024 samples), which keeps amplitude and phase stable for
+     * signals of any length.
+     */
+    class LIBKWAVE_EXPORT PhasorOscillator
+    {
+    public:
+        /** Constructor */
+        PhasorOscillator();
+
+        /** Destructor */
+        virtual ~PhasorOscillator();
+
+        /**
+         * Sets the frequency
+         * @param f frequency, normed to the sample rate [0 ... 0.5]
+         */
+        void setFrequency(double f);
+
+        /**
+         * Sets the phase of the next sample
+         * @param phase the phase [radians]
+         */
+        void setPhase(double phase);
+
+        /** returns the phase of the next sample [0 ... 2*Pi] */
+        inline double phase() const { return m_phase; }
+
+        /**
+         * Sets the amplitude
+         * @param a amplitude [0 ... 1.0], default is 1.0
+         */
+        void setAmplitude(double a);
+
+        /**
+         * Generates a block of samples
+         * @param dst destination buffer
+         * @param count number of samples to generate
+         */
+        void generate(float *dst, unsigned int count);
+
+    private:
+
+        /** re-initializes the phasors from the phase accumulator */
+        void sync();
+
+    private:
+
+        /** phase of the next sample [0 ... 2*Pi] */
+        double m_phase;
+
+        /** phase increment per sample [radians] */
+        double m_omega;
+
+        /** amplitude */
+        double m_amplitude;
+
+        /** real part of the phasors, one per lane */
+        double m_re[4];
+
+        /** imaginary part of the phasors, one per lane */
+        double m_im[4];
+
+        /** real part of the rotation by four samples */
+        double m_rot_re;
+
+        /** imaginary part of the rotation by four samples */
+        double m_rot_im;
+
+        /** number of samples until the next sync() */
+        unsigned int m_countdown;
+
+    };
+}
+
+#endif /* PHASOR_OSCILLATOR_H */
+
+//***************************************************************************
+//***************************************************************************
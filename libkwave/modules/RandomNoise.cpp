@@ -0,0 +1,151 @@
+/***************************************************************************
+        RandomNoise.cpp  -  block based generator for white and pink noise
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include "libkwave/modules/RandomNoise.h"
+
+/** number of random generators that are advanced in parallel */
+#define LANES 8
+
+/** number of samples that are processed at once for TPDF noise */
+#define CHUNK 256
+
+/** scale of a signed 32 bit integer to [-1.0 ... +1.0) */
+#define INT_SCALE (1.0f / 2147483648.0f)
+
+//***************************************************************************
+Kwave::RandomNoise::RandomNoise(quint32 seed)
+    :m_shape(White)
+{
+    this->seed(seed);
+}
+
+//***************************************************************************
+Kwave::RandomNoise::~RandomNoise()
+{
+}
+
+//***************************************************************************
+void Kwave::RandomNoise::seed(quint32 seed)
+{
+    // initialize the lanes with splitmix32, which never yields zero
+    // for consecutive values (xorshift must not start with zero)
+    quint32 x = seed;
+    for (unsigned int k = 0; k < LANES; ++k) {
+        quint32 z = (x += 0x9E3779B9U);
+        z = (z ^ (z >> 16)) * 0x85EBCA6BU;
+        z = (z ^ (z >> 13)) * 0xC2B2AE35U;
+        z =  z ^ (z >> 16);
+        m_state[k] = (z) ? z : 0x6C078965U;
+    }
+
+    for (unsigned int k = 0; k < 3; ++k)
+        m_pink[k] = 0.0f;
+}
+
+//***************************************************************************
+void Kwave::RandomNoise::setShape(Shape shape)
+{
+    m_shape = shape;
+}
+
+//***************************************************************************
+void Kwave::RandomNoise::white(float *dst, unsigned int count)
+{
+    quint32 s[LANES];
+    for (unsigned int k = 0; k < LANES; ++k)
+        s[k] = m_state[k];
+
+    const unsigned int full = count - (count % LANES);
+    for (unsigned int i = 0; i < full; i += LANES) {
+        for (unsigned int k = 0; k < LANES; ++k) {
+            quint32 x = s[k];
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            s[k] = x;
+            dst[i + k] = static_cast<float>(
+                static_cast<qint32>(x * 0x2C1B3C6DU)) * INT_SCALE;
+        }
+    }
+
+    // the rest, less than one value per lane
+    for (unsigned int k = 0; k < count - full; ++k) {
+        quint32 x = s[k];
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        s[k] = x;
+        dst[full + k] = static_cast<float>(
+            static_cast<qint32>(x * 0x2C1B3C6DU)) * INT_SCALE;
+    }
+
+    for (unsigned int k = 0; k < LANES; ++k)
+        m_state[k] = s[k];
+}
+
+//***************************************************************************
+void Kwave::RandomNoise::generate(float *dst, unsigned int count)
+{
+    Q_ASSERT(dst);
+    if (!dst) return;
+
+    switch (m_shape) {
+        case White:
+            white(dst, count);
+            break;
+        case Tpdf: {
+            // sum of two uniform distributions, half of the amplitude
+            float tmp[CHUNK];
+            while (count) {
+                const unsigned int n = qMin<unsigned int>(count, CHUNK);
+                white(dst, n);
+                white(tmp, n);
+                for (unsigned int i = 0; i < n; ++i)
+                    dst[i] = 0.5f * (dst[i] + tmp[i]);
+                dst   += n;
+                count -= n;
+            }
+            break;
+        }
+        case Pink: {
+            // white noise through the "economy" pinking filter of
+            // Paul Kellet, with an accuracy of +/-0.5dB above 9.2Hz
+            // (at 44.1kHz), scaled to fit into [-1.0 ... +1.0]
+            white(dst, count);
+            float b0 = m_pink[0];
+            float b1 = m_pink[1];
+            float b2 = m_pink[2];
+            for (unsigned int i = 0; i < count; ++i) {
+                const float w = dst[i];
+                b0 = (0.99765f * b0) + (w * 0.0990460f);
+                b1 = (0.96300f * b1) + (w * 0.2965164f);
+                b2 = (0.57000f * b2) + (w * 1.0526913f);
+                const float p = 0.125f * (b0 + b1 + b2 + (w * 0.1848f));
+                dst[i] = qBound(-1.0f, p, 1.0f);
+            }
+            m_pink[0] = b0;
+            m_pink[1] = b1;
+            m_pink[2] = b2;
+            break;
+        }
+    }
+}
+
+//***************************************************************************
+//***************************************************************************
@@ -0,0 +1,106 @@
+/***************************************************************************
+          RandomNoise.h  -  block based generator for white and pink noise
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef RANDOM_NOISE_H
+#define RANDOM_NOISE_H
+
+#include "config.h"
+#include "libkwave_export.h"
+
+#include <QtGlobal>
+
+namespace Kwave
+{
+
+    /**
+     * Generator for noise, on blocks of samples. The random numbers come
+     * from eight independent xorshift generators with a multiplicative
+     * output stage (xorshift*), which are advanced in parallel so that
+     * the compiler can vectorize the loop. This is not suitable for
+     * cryptography, but much faster than a generic random generator
+     * and good enough for audio.
+     */
+    class LIBKWAVE_EXPORT RandomNoise
+    {
+    public:
+
+        /** shape of the noise */
+        typedef enum {
+            White = 0, /**< white noise, uniform distribution         */
+            Pink  = 1, /**< pink noise, -3dB per octave              */
+            Tpdf  = 2  /**< white noise, triangular distribution     */
+        } Shape;
+
+        /**
+         * Constructor
+         * @param seed initial value of the random generators, the same
+         *             seed always produces the same sequence
+         */
+        explicit RandomNoise(quint32 seed = 0);
+
+        /** Destructor */
+        virtual ~RandomNoise();
+
+        /**
+         * Restarts the generators with a new seed
+         * @param seed initial value of the random generators
+         */
+        void seed(quint32 seed);
+
+        /**
+         * Sets the shape of the noise
+         * @param shape one of White, Pink or Tpdf
+         */
+        void setShape(Shape shape);
+
+        /** returns the shape of the noise */
+        inline Shape shape() const { return m_shape; }
+
+        /**
+         * Generates a block of noise, in the range [-1.0 ... +1.0)
+         * @param dst destination buffer
+         * @param count number of samples to generate
+         */
+        void generate(float *dst, unsigned int count);
+
+    private:
+
+        /**
+         * Generates a block of white noise with uniform distribution
+         * @param dst destination buffer
+         * @param count number of samples to generate
+         */
+        void white(float *dst, unsigned int count);
+
+    private:
+
+        /** state of the random generators */
+        quint32 m_state[8];
+
+        /** shape of the noise */
+        Shape m_shape;
+
+        /** state of the pinking filter */
+        float m_pink[3];
+
+    };
+}
+
+#endif /* RANDOM_NOISE_H */
+
+//***************************************************************************
+//***************************************************************************
@@ -25,7 +25,7 @@
 //***************************************************************************
 Kwave::RateConverter::RateConverter()
     :Kwave::SampleSource(), m_ratio(1.0), m_converter(nullptr),
-     m_converter_in(), m_converter_out()
+     m_converter_in(), m_converter_out(), m_buffer()
 {
     int error = 0;
     m_converter = src_new(SRC_SINC_MEDIUM_QUALITY, 1, &error);
@@ -56,7 +56,6 @@ void Kwave::RateConverter::input(Kwave::SampleArray data)
     }
 
     // normal processing
-    Kwave::SampleArray samples_out;
     const unsigned int in_len = data.size();
 
     // convert the input buffer into an array of floats
@@ -65,19 +64,7 @@ void Kwave::RateConverter::input(Kwave::SampleArray data)
     const sample_t *s_in = data.constData();
     Q_ASSERT(f_in);
     Q_ASSERT(s_in);
-
-    // work blockwise to allow loop unrolling
-    unsigned int remaining = in_len;
-    const unsigned int block_size = 16;
-    while (remaining >= block_size) {
-        for (unsigned int i = 0; i < block_size; i++)
-            f_in[i] = sample2float(s_in[i]);
-        f_in      += block_size;
-        s_in      += block_size;
-        remaining -= block_size;
-    }
-    for (; remaining; remaining--)
-        (*f_in++) = sample2float(*(s_in++));
+    samples2floats(s_in, f_in, in_len);
 
     // prepare the output buffer (estimated size, rounded up)
     // worst case would be factor 2, which means that there was a 100%
@@ -108,23 +95,10 @@ void Kwave::RateConverter::input(Kwave::SampleArray data)
 
     // convert the result back from floats to sample_t
     unsigned int gen = Kwave::toUint(src.output_frames_gen);
-    Kwave::SampleArray out(gen);
-    const float *f_out = src.data_out;
-    sample_t    *s_out = out.data();
-
-    // work blockwise to allow loop unrolling
-    remaining = gen;
-    while (remaining >= block_size) {
-        for (unsigned int i = 0; i < block_size; ++i)
-            s_out[i] = float2sample(f_out[i]);
-        s_out     += block_size;
-        f_out     += block_size;
-        remaining -= block_size;
-    }
-    for (; remaining; remaining--, ++s_out, ++f_out)
-        *s_out = float2sample(*f_out);
+    if (!m_buffer.reuse(gen)) return; // out of memory
+    floats2samples(src.data_out, m_buffer.data(), gen);
 
-    emit output(out);
+    emit output(m_buffer);
 }
 
 //***************************************************************************
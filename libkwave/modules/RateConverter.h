@@ -77,6 +77,9 @@ namespace Kwave
         /** output values for the sample rate converter */
         QVarLengthArray<float, 65536> m_converter_out;
 
+        /** output buffer, recycled for each block */
+        Kwave::SampleArray m_buffer;
+
     };
 }
 
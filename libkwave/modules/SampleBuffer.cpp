@@ -18,8 +18,8 @@
 #include "config.h"
 
 #include <QFuture>
-#include <QtConcurrentRun>
 
+#include "libkwave/TaskPool.h"
 #include "libkwave/Utils.h"
 #include "libkwave/modules/SampleBuffer.h"
 
@@ -107,7 +107,9 @@ void Kwave::SampleBuffer::finished()
 
     enqueue(m_data);
     m_buffered = 0;
-    ok &= m_data.resize(Kwave::StreamObject::blockSize());
+
+    // the emitted data may still be in use, continue with a fresh block
+    ok &= m_data.reuse(Kwave::StreamObject::blockSize());
     Q_ASSERT(ok);
 }
 
@@ -133,7 +135,8 @@ void Kwave::SampleBuffer::input(Kwave::SampleArray data)
 void Kwave::SampleBuffer::enqueue(Kwave::SampleArray data)
 {
     m_sema.acquire();
-    auto discard = QtConcurrent::run(&Kwave::SampleBuffer::emitData, this, data);
+    auto discard = Kwave::TaskPool::run(
+        &Kwave::SampleBuffer::emitData, this, data);
 }
 
 //***************************************************************************
@@ -0,0 +1,257 @@
+/*************************************************************************
+     StreamPipeline.cpp  -  pull based pipeline of stream stages
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <utility>
+
+#include "libkwave/Interpolation.h"
+#include "libkwave/SampleReader.h"
+#include "libkwave/Utils.h"
+#include "libkwave/Writer.h"
+#include "libkwave/modules/StreamPipeline.h"
+
+//***************************************************************************
+Kwave::StreamStage::~StreamStage()
+{
+}
+
+//***************************************************************************
+//***************************************************************************
+Kwave::ReaderStage::ReaderStage(Kwave::SampleReader &reader)
+    :Kwave::StreamStage(), m_reader(reader)
+{
+}
+
+//***************************************************************************
+Kwave::ReaderStage::~ReaderStage()
+{
+}
+
+//***************************************************************************
+unsigned int Kwave::ReaderStage::process(Kwave::SampleArray &block,
+                                         unsigned int length)
+{
+    if (m_reader.eof()) return 0;
+    return m_reader.read(block, 0, length);
+}
+
+//***************************************************************************
+//***************************************************************************
+Kwave::CurveStage::CurveStage(Kwave::Interpolation &interpolation,
+                              sample_index_t length)
+    :Kwave::StreamStage(), m_interpolation(interpolation),
+     m_length(length), m_position(0), m_values()
+{
+}
+
+//***************************************************************************
+Kwave::CurveStage::~CurveStage()
+{
+}
+
+//***************************************************************************
+unsigned int Kwave::CurveStage::process(Kwave::SampleArray &block,
+                                        unsigned int length)
+{
+    if (Kwave::toUint(m_values.size()) < length) m_values.resize(length);
+
+    // x is [0.0 ... 1.0], values after the end repeat the last one
+    double *values = m_values.data();
+    m_interpolation.interpolateRange(m_position, m_length, values, length);
+    m_position += length;
+
+    sample_t *p = block.data();
+    for (unsigned int i = 0; i < length; ++i)
+        p[i] = double2sample(values[i]);
+    return length;
+}
+
+//***************************************************************************
+//***************************************************************************
+Kwave::MulStage::MulStage(Kwave::StreamStage *factor)
+    :Kwave::StreamStage(), m_factor(factor), m_buffer()
+{
+}
+
+//***************************************************************************
+Kwave::MulStage::~MulStage()
+{
+    delete m_factor;
+    m_factor = nullptr;
+}
+
+//***************************************************************************
+unsigned int Kwave::MulStage::process(Kwave::SampleArray &block,
+                                      unsigned int length)
+{
+    Q_ASSERT(m_factor);
+    if (!m_factor || !length) return 0;
+
+    // pull exactly the number of factors that we need
+    if ((m_buffer.size() < length) && !m_buffer.reuse(length)) return 0;
+    const unsigned int count = qMin(length,
+                                    m_factor->process(m_buffer, length));
+
+    const sample_t *p_b = m_buffer.constData();
+    sample_t       *p_x = block.data();
+    for (unsigned int i = 0; i < count; ++i) {
+        float y = sample2float(p_x[i]) * sample2float(p_b[i]);
+        if (y > float( 1.0)) y = float( 1.0);
+        if (y < float(-1.0)) y = float(-1.0);
+        p_x[i] = float2sample(y);
+    }
+    return count;
+}
+
+//***************************************************************************
+//***************************************************************************
+Kwave::StreamPipeline::StreamPipeline()
+    :m_tracks(), m_block_size(0), m_blocks(0), m_canceled(0)
+{
+}
+
+//***************************************************************************
+Kwave::StreamPipeline::~StreamPipeline()
+{
+    for (Track &track : m_tracks) {
+        qDeleteAll(track.stages);
+        track.stages.clear();
+    }
+    m_tracks.clear();
+}
+
+//***************************************************************************
+int Kwave::StreamPipeline::addTrack(Kwave::StreamStage *source,
+                                    Kwave::Writer *sink)
+{
+    Q_ASSERT(source);
+    Q_ASSERT(sink);
+    Q_ASSERT(!m_block_size);
+    if (!source || !sink || m_block_size) {
+        delete source;
+        return -1;
+    }
+
+    Track track;
+    track.stages.append(source);
+    track.sink = sink;
+    track.done = false;
+    m_tracks.append(track);
+    return Kwave::toInt(m_tracks.count()) - 1;
+}
+
+//***************************************************************************
+bool Kwave::StreamPipeline::append(unsigned int track,
+                                   Kwave::StreamStage *stage)
+{
+    Q_ASSERT(stage);
+    Q_ASSERT(Kwave::toInt(track) < m_tracks.count());
+    if (!stage || m_block_size ||
+        (Kwave::toInt(track) >= m_tracks.count()))
+    {
+        delete stage;
+        return false;
+    }
+    m_tracks[track].stages.append(stage);
+    return true;
+}
+
+//***************************************************************************
+bool Kwave::StreamPipeline::compile(unsigned int block_size)
+{
+    if (!block_size || m_tracks.isEmpty()) return false;
+
+    for (Track &track : m_tracks) {
+        if (!track.block.resize(block_size)) return false;
+        track.done = false;
+
+        // flush data that might be pending in the writer, we bypass
+        // its internal buffer and write whole blocks directly
+        if (!track.sink->flush()) return false;
+    }
+
+    m_block_size = block_size;
+    m_blocks     = 0;
+    return true;
+}
+
+//***************************************************************************
+unsigned int Kwave::StreamPipeline::writable(const Track &track) const
+{
+    const Kwave::Writer *sink = track.sink;
+    if (sink->mode() != Kwave::Overwrite) return m_block_size;
+
+    if (sink->position() > sink->last()) return 0;
+    const sample_index_t rest = sink->last() - sink->position() + 1;
+    return (rest < m_block_size) ? Kwave::toUint(rest) : m_block_size;
+}
+
+//***************************************************************************
+bool Kwave::StreamPipeline::step()
+{
+    Q_ASSERT(m_block_size);
+    if (!m_block_size) return false;
+
+    bool active = false;
+    for (Track &track : m_tracks) {
+        if (track.done) continue;
+
+        // the sink decides how much we pull through the chain
+        unsigned int length = writable(track);
+        for (Kwave::StreamStage *stage : std::as_const(track.stages)) {
+            if (!length) break;
+            length = stage->process(track.block, length);
+        }
+
+        if (!length || !track.sink->write(track.block, length)) {
+            track.done = true;
+            continue;
+        }
+        active = true;
+    }
+
+    if (active) m_blocks++;
+    return active;
+}
+
+//***************************************************************************
+bool Kwave::StreamPipeline::run()
+{
+    Q_ASSERT(m_block_size);
+    if (!m_block_size) return false;
+
+    while (!isCanceled() && step()) {
+        // nothing to do, step() does all the work
+    }
+    return !isCanceled();
+}
+
+//***************************************************************************
+void Kwave::StreamPipeline::cancel()
+{
+    m_canceled.storeRelease(1);
+}
+
+//***************************************************************************
+bool Kwave::StreamPipeline::isCanceled() const
+{
+    return (m_canceled.loadAcquire() != 0);
+}
+
+//***************************************************************************
+//***************************************************************************
@@ -0,0 +1,263 @@
+/*************************************************************************
+       StreamPipeline.h  -  pull based pipeline of stream stages
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef STREAM_PIPELINE_H
+#define STREAM_PIPELINE_H
+
+#include "config.h"
+#include "libkwave_export.h"
+
+#include <QtGlobal>
+#include <QAtomicInt>
+#include <QList>
+#include <QVector>
+
+#include "libkwave/Sample.h"
+#include "libkwave/SampleArray.h"
+
+namespace Kwave
+{
+
+    class Interpolation;
+    class SampleReader;
+    class Writer;
+
+    /**
+     * One processing step of a Kwave::StreamPipeline. Stages are called
+     * directly through this interface, without any signal/slot dispatch.
+     * The first stage of a track produces data, all following stages
+     * modify the block in place.
+     */
+    class LIBKWAVE_EXPORT StreamStage
+    {
+    public:
+        /** Destructor */
+        virtual ~StreamStage();
+
+        /**
+         * Processes one block of samples.
+         *
+         * @param block the block to fill (first stage) or to modify
+         *              (all following stages), has at least
+         *              \c length samples
+         * @param length number of samples that should be produced or
+         *               that are valid in the block
+         * @return number of valid samples in the block after processing,
+         *         zero means end of the stream
+         */
+        virtual unsigned int process(Kwave::SampleArray &block,
+                                     unsigned int length) = 0;
+    };
+
+    /**
+     * Stage that pulls samples from a Kwave::SampleReader
+     */
+    class LIBKWAVE_EXPORT ReaderStage: public Kwave::StreamStage
+    {
+    public:
+        /**
+         * Constructor
+         * @param reader the reader to pull from, not owned
+         */
+        explicit ReaderStage(Kwave::SampleReader &reader);
+
+        /** Destructor */
+        ~ReaderStage() override;
+
+        /** @see Kwave::StreamStage::process */
+        unsigned int process(Kwave::SampleArray &block,
+                             unsigned int length) override;
+
+    private:
+
+        /** the reader to pull from */
+        Kwave::SampleReader &m_reader;
+    };
+
+    /**
+     * Stage that produces the interpolated values of a curve, from
+     * the start of the curve up to a given length
+     */
+    class LIBKWAVE_EXPORT CurveStage: public Kwave::StreamStage
+    {
+    public:
+        /**
+         * Constructor
+         * @param interpolation the interpolation of the curve, not owned
+         * @param length number of samples of the interpolated range
+         */
+        CurveStage(Kwave::Interpolation &interpolation,
+                   sample_index_t length);
+
+        /** Destructor */
+        ~CurveStage() override;
+
+        /** @see Kwave::StreamStage::process */
+        unsigned int process(Kwave::SampleArray &block,
+                             unsigned int length) override;
+
+    private:
+
+        /** the interpolation of the curve */
+        Kwave::Interpolation &m_interpolation;
+
+        /** number of samples of the interpolated range */
+        sample_index_t m_length;
+
+        /** position within the interpolation */
+        sample_index_t m_position;
+
+        /** interpolated values of one block, before conversion */
+        QVector<double> m_values;
+    };
+
+    /**
+     * Stage that multiplies the block with the output of another stage,
+     * which gets pulled on demand. The result is clipped to [-1 ... +1].
+     */
+    class LIBKWAVE_EXPORT MulStage: public Kwave::StreamStage
+    {
+    public:
+        /**
+         * Constructor
+         * @param factor stage that produces the factors, will be owned
+         */
+        explicit MulStage(Kwave::StreamStage *factor);
+
+        /** Destructor */
+        ~MulStage() override;
+
+        /** @see Kwave::StreamStage::process */
+        unsigned int process(Kwave::SampleArray &block,
+                             unsigned int length) override;
+
+    private:
+
+        Q_DISABLE_COPY(MulStage)
+
+        /** stage that produces the factors */
+        Kwave::StreamStage *m_factor;
+
+        /** buffer for the factors */
+        Kwave::SampleArray m_buffer;
+    };
+
+    /**
+     * Pull based pipeline for streaming sample data. Each track consists
+     * of a chain of stages and ends in a Kwave::Writer. The sink side
+     * determines how many samples are pulled through the chain, so that
+     * no stage produces more than the writer is able to take
+     * (back-pressure). After compile() the schedule is fixed and each
+     * block is passed through the stages by direct function calls.
+     *
+     * This is a lightweight alternative to connecting Kwave::StreamObject
+     * instances with Kwave::connect(), which remains available.
+     */
+    class LIBKWAVE_EXPORT StreamPipeline
+    {
+    public:
+        /** Constructor */
+        StreamPipeline();
+
+        /** Destructor, deletes all stages */
+        virtual ~StreamPipeline();
+
+        /**
+         * Adds a new track to the pipeline
+         * @param source the first stage, which produces the data, will
+         *               be owned by the pipeline
+         * @param sink the writer that receives the data, not owned
+         * @return index of the new track or -1 if failed
+         */
+        int addTrack(Kwave::StreamStage *source, Kwave::Writer *sink);
+
+        /**
+         * Appends a stage to the chain of a track
+         * @param track index of the track
+         * @param stage a stage that will be owned by the pipeline
+         * @return true if succeeded, false if the track does not exist
+         *         or the pipeline is already compiled
+         */
+        bool append(unsigned int track, Kwave::StreamStage *stage);
+
+        /**
+         * Builds the static schedule and allocates the block buffers.
+         * No stages can be added afterwards.
+         * @param block_size number of samples per block
+         * @return true if succeeded, false if out of memory or empty
+         */
+        bool compile(unsigned int block_size);
+
+        /**
+         * Processes one block on each track that is not yet done
+         * @return true if at least one track produced data
+         */
+        bool step();
+
+        /**
+         * Runs the pipeline until all tracks are done or the pipeline
+         * gets canceled. The pipeline has to be compiled before.
+         * @return true if completed, false if canceled or not compiled
+         */
+        bool run();
+
+        /** cancels a running pipeline, can be called from any thread */
+        void cancel();
+
+        /** returns true if the pipeline has been canceled */
+        bool isCanceled() const;
+
+        /** returns the number of blocks processed since compile() */
+        inline quint64 blocksProcessed() const { return m_blocks; }
+
+    private:
+
+        Q_DISABLE_COPY(StreamPipeline)
+
+        /** one track of the pipeline */
+        typedef struct {
+            QList<Kwave::StreamStage *> stages; /**< chain of stages */
+            Kwave::Writer *sink;                /**< destination     */
+            Kwave::SampleArray block;           /**< block buffer    */
+            bool done;                          /**< end reached     */
+        } Track;
+
+        /**
+         * Returns the number of samples the sink of a track can take
+         * @param track reference to the track
+         * @return number of samples, limited to the block size
+         */
+        unsigned int writable(const Track &track) const;
+
+        /** list of tracks */
+        QVector<Track> m_tracks;
+
+        /** number of samples per block, zero if not compiled */
+        unsigned int m_block_size;
+
+        /** number of processed blocks */
+        quint64 m_blocks;
+
+        /** set to nonzero if canceled */
+        QAtomicInt m_canceled;
+    };
+}
+
+#endif /* STREAM_PIPELINE_H */
+
+//***************************************************************************
+//***************************************************************************
@@ -0,0 +1,220 @@
+/***************************************************************************
+     SweepGenerator.cpp  -  block based generator for sine sweeps (chirps)
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <math.h>
+
+#include "libkwave/modules/SweepGenerator.h"
+
+/** number of phasors that are rotated in parallel */
+#define LANES 4
+
+/** length of a segment with parabolic phase [samples] */
+#define SEGMENT 512
+
+//***************************************************************************
+Kwave::SweepGenerator::SweepGenerator()
+    :m_f_start(0.0), m_f_end(0.0), m_length(1.0), m_k(0.0),
+     m_amplitude(1.0), m_pos(0), m_ddrot_re(1.0), m_ddrot_im(0.0),
+     m_countdown(0)
+{
+    for (unsigned int k = 0; k < LANES; ++k) {
+        m_re[k]      = 1.0;
+        m_im[k]      = 0.0;
+        m_rot_re[k]  = 1.0;
+        m_rot_im[k]  = 0.0;
+        m_drot_re[k] = 1.0;
+        m_drot_im[k] = 0.0;
+    }
+}
+
+//***************************************************************************
+Kwave::SweepGenerator::~SweepGenerator()
+{
+}
+
+//***************************************************************************
+void Kwave::SweepGenerator::setSweep(double f_start, double f_end,
+                                     sample_index_t length,
+                                     bool logarithmic)
+{
+    m_f_start = f_start;
+    m_f_end   = f_end;
+    m_length  = (length) ? static_cast<double>(length) : 1.0;
+    m_k       = 0.0;
+
+    Q_ASSERT(!logarithmic || ((f_start > 0.0) && (f_end > 0.0)));
+    if (logarithmic && (f_start > 0.0) && (f_end > 0.0) &&
+        !qFuzzyCompare(f_start, f_end))
+    {
+        m_k = log(f_end / f_start) / m_length;
+    }
+
+    m_pos       = 0;
+    m_countdown = 0;
+}
+
+//***************************************************************************
+void Kwave::SweepGenerator::setAmplitude(double a)
+{
+    m_amplitude = a;
+}
+
+//***************************************************************************
+double Kwave::SweepGenerator::frequency(double n) const
+{
+    if (n >= m_length) return m_f_end;
+    if (m_k != 0.0) return m_f_start * exp(m_k * n);
+    return m_f_start + ((m_f_end - m_f_start) * n / m_length);
+}
+
+//***************************************************************************
+double Kwave::SweepGenerator::phase(double n) const
+{
+    // behind the end: continue with the end frequency
+    double rest = 0.0;
+    if (n > m_length) {
+        rest = 2.0 * M_PI * m_f_end * (n - m_length);
+        n    = m_length;
+    }
+
+    if (m_k != 0.0)
+        return rest + (2.0 * M_PI * m_f_start * expm1(m_k * n) / m_k);
+    return rest + (2.0 * M_PI * ((m_f_start * n) +
+        ((m_f_end - m_f_start) * n * n / (2.0 * m_length))));
+}
+
+//***************************************************************************
+void Kwave::SweepGenerator::sync()
+{
+    // the segment must not contain the end of the sweep, where the
+    // frequency has a kink
+    const double n0 = static_cast<double>(m_pos);
+    double s = SEGMENT;
+    if ((n0 < m_length) && (n0 + s > m_length)) s = m_length - n0;
+    m_countdown = static_cast<unsigned int>(s);
+
+    // phase within the segment: phi(j) = p0 + w0*j + c2*j^2 + c3*j^3,
+    // matching the exact phase and frequency at both ends
+    const double p0 = phase(n0);
+    const double p1 = phase(n0 + s);
+    const double w0 = 2.0 * M_PI * frequency(n0);
+    const double w1 = 2.0 * M_PI * frequency(n0 + s);
+    const double c2 = ((3.0 * (p1 - p0) / s) - (2.0 * w0) - w1) / s;
+    const double c3 = (w0 + w1 - (2.0 * (p1 - p0) / s)) / (s * s);
+
+    // differences over one step of the lanes, for lane k at j = k:
+    // d1 = phi(j + 4) - phi(j), d2 = d1(j + 4) - d1(j), d3 = constant
+    for (unsigned int k = 0; k < LANES; ++k) {
+        const double j  = k;
+        const double p  = fmod(p0 + (w0 * j) + (c2 * j * j) +
+                               (c3 * j * j * j), 2.0 * M_PI);
+        const double d1 = (LANES * w0) +
+                          (c2 * ((8.0 * j) + 16.0)) +
+                          (c3 * ((12.0 * j * j) + (48.0 * j) + 64.0));
+        const double d2 = (32.0 * c2) + (c3 * ((96.0 * j) + 384.0));
+        m_re[k]      = cos(p);
+        m_im[k]      = sin(p);
+        m_rot_re[k]  = cos(d1);
+        m_rot_im[k]  = sin(d1);
+        m_drot_re[k] = cos(d2);
+        m_drot_im[k] = sin(d2);
+    }
+    m_ddrot_re = cos(384.0 * c3);
+    m_ddrot_im = sin(384.0 * c3);
+}
+
+//***************************************************************************
+void Kwave::SweepGenerator::generate(float *dst, unsigned int count)
+{
+    Q_ASSERT(dst);
+    if (!dst) return;
+
+    const double a = m_amplitude;
+    while (count) {
+        if (!m_countdown) sync();
+
+        const unsigned int n    = qMin(count, m_countdown);
+        const unsigned int full = n - (n % LANES);
+
+        // work on local copies, to let the compiler keep them in registers
+        double re[LANES];
+        double im[LANES];
+        double rot_re[LANES];
+        double rot_im[LANES];
+        double drot_re[LANES];
+        double drot_im[LANES];
+        for (unsigned int k = 0; k < LANES; ++k) {
+            re[k]      = m_re[k];
+            im[k]      = m_im[k];
+            rot_re[k]  = m_rot_re[k];
+            rot_im[k]  = m_rot_im[k];
+            drot_re[k] = m_drot_re[k];
+            drot_im[k] = m_drot_im[k];
+        }
+        const double ddrot_re = m_ddrot_re;
+        const double ddrot_im = m_ddrot_im;
+
+        for (unsigned int i = 0; i < full; i += LANES) {
+            for (unsigned int k = 0; k < LANES; ++k) {
+                dst[i + k] = static_cast<float>(a * im[k]);
+
+                // rotate the phasor
+                const double r = (re[k] * rot_re[k]) - (im[k] * rot_im[k]);
+                im[k] = (re[k] * rot_im[k]) + (im[k] * rot_re[k]);
+                re[k] = r;
+
+                // change the rotation
+                const double s = (rot_re[k] * drot_re[k]) -
+                                 (rot_im[k] * drot_im[k]);
+                rot_im[k] = (rot_re[k] * drot_im[k]) +
+                            (rot_im[k] * drot_re[k]);
+                rot_re[k] = s;
+
+                // and the change of the rotation
+                const double t = (drot_re[k] * ddrot_re) -
+                                 (drot_im[k] * ddrot_im);
+                drot_im[k] = (drot_re[k] * ddrot_im) +
+                             (drot_im[k] * ddrot_re);
+                drot_re[k] = t;
+            }
+        }
+
+        // a partial group at the end: start a new segment next time
+        const unsigned int rest = n - full;
+        for (unsigned int k = 0; k < rest; ++k)
+            dst[full + k] = static_cast<float>(a * im[k]);
+
+        for (unsigned int k = 0; k < LANES; ++k) {
+            m_re[k]      = re[k];
+            m_im[k]      = im[k];
+            m_rot_re[k]  = rot_re[k];
+            m_rot_im[k]  = rot_im[k];
+            m_drot_re[k] = drot_re[k];
+            m_drot_im[k] = drot_im[k];
+        }
+        m_countdown = (rest) ? 0 : (m_countdown - n);
+
+        m_pos += n;
+        dst   += n;
+        count -= n;
+    }
+}
+
+//***************************************************************************
+//***************************************************************************
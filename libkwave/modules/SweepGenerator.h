@@ -0,0 +1,153 @@
+/***************************************************************************
+       SweepGenerator.h  -  block based generator for sine sweeps (chirps)
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef SWEEP_GENERATOR_H
+#define SWEEP_GENERATOR_H
+
+#include "config.h"
+#include "libkwave_export.h"
+
+#include <QtGlobal>
+
+#include "libkwave/Sample.h"
+
+namespace Kwave
+{
+
+    /**
+     * Generates a sine sweep with a linear or logarithmic progression of
+     * the frequency, on blocks of samples. Like Kwave::PhasorOscillator
+     * it rotates four phasors in parallel, here with a rotation that
+     * itself changes from sample to sample (and so does its change),
+     * which gives a phase that is a cubic polynomial in time.
+     *
+     * The exact phase and frequency are computed at the start and the
+     * end of each segment of 512 samples, within the segment the phase
+     * follows the cubic polynomial that matches both. For a linear sweep
+     * this is exact, for a logarithmic one the error is far below the
+     * resolution of the samples.
+     */
+    class LIBKWAVE_EXPORT SweepGenerator
+    {
+    public:
+        /** Constructor */
+        SweepGenerator();
+
+        /** Destructor */
+        virtual ~SweepGenerator();
+
+        /**
+         * Sets up the sweep and restarts at the first sample
+         * @param f_start start frequency, normed to the sample rate
+         *                [0 ... 0.5]
+         * @param f_end end frequency, normed to the sample rate
+         *              [0 ... 0.5]
+         * @param length number of samples from start to end frequency,
+         *               afterwards the end frequency is kept
+         * @param logarithmic if true, the frequency grows exponentially
+         *                    in time (constant octaves per second),
+         *                    both frequencies must be above zero then
+         */
+        void setSweep(double f_start, double f_end, sample_index_t length,
+                      bool logarithmic);
+
+        /**
+         * Sets the amplitude
+         * @param a amplitude [0 ... 1.0], default is 1.0
+         */
+        void setAmplitude(double a);
+
+        /**
+         * Generates a block of samples
+         * @param dst destination buffer
+         * @param count number of samples to generate
+         */
+        void generate(float *dst, unsigned int count);
+
+    private:
+
+        /**
+         * Returns the exact phase at a given sample
+         * @param n index of the sample, relative to the start
+         * @return phase [radians], not wrapped
+         */
+        double phase(double n) const;
+
+        /**
+         * Returns the exact frequency at a given sample
+         * @param n index of the sample, relative to the start
+         * @return frequency, normed to the sample rate
+         */
+        double frequency(double n) const;
+
+        /** initializes the phasors for the segment at m_pos */
+        void sync();
+
+    private:
+
+        /** start frequency */
+        double m_f_start;
+
+        /** end frequency */
+        double m_f_end;
+
+        /** length of the sweep [samples] */
+        double m_length;
+
+        /** exponent of a logarithmic sweep, per sample, zero if linear */
+        double m_k;
+
+        /** amplitude */
+        double m_amplitude;
+
+        /** index of the next sample */
+        sample_index_t m_pos;
+
+        /** real part of the phasors, one per lane */
+        double m_re[4];
+
+        /** imaginary part of the phasors, one per lane */
+        double m_im[4];
+
+        /** real part of the rotations per lane */
+        double m_rot_re[4];
+
+        /** imaginary part of the rotations per lane */
+        double m_rot_im[4];
+
+        /** real part of the change of the rotations per lane */
+        double m_drot_re[4];
+
+        /** imaginary part of the change of the rotations per lane */
+        double m_drot_im[4];
+
+        /** real part of the (constant) change of m_drot */
+        double m_ddrot_re;
+
+        /** imaginary part of the (constant) change of m_drot */
+        double m_ddrot_im;
+
+        /** number of samples until the next sync() */
+        unsigned int m_countdown;
+
+    };
+}
+
+#endif /* SWEEP_GENERATOR_H */
+
+//***************************************************************************
+//***************************************************************************
@@ -160,7 +160,7 @@ Kwave::UndoAction *Kwave::UndoAddMetaDataAction::undo(
     Kwave::UndoAction *redo = nullptr;
 
     Kwave::MetaDataList meta_data =
-        manager.metaData().copy(m_offset, m_length);
+        std::as_const(manager).metaData().copy(m_offset, m_length);
 
     // store data for redo
     if (with_redo && !meta_data.isEmpty()) {
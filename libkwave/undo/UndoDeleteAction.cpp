@@ -83,7 +83,7 @@ bool Kwave::UndoDeleteAction::store(Kwave::SignalManager &manager)
         return false; // retrieving the stripes failed
 
     // save the meta data
-    m_meta_data = manager.metaData().copy(m_offset, m_length);
+    m_meta_data = std::as_const(manager).metaData().copy(m_offset, m_length);
 
     return true;
 }
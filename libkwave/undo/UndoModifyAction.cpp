@@ -48,7 +48,19 @@ QString Kwave::UndoModifyAction::description()
 //***************************************************************************
 qint64 Kwave::UndoModifyAction::undoSize()
 {
-    return sizeof(*this) + (m_length * sizeof(sample_t));
+    // before storing: worst case, all samples will be modified
+    if (m_stripes.isEmpty())
+        return sizeof(*this) + (m_length * sizeof(sample_t));
+
+    // after storing: the stripes share their pages with the signal, only
+    // the pages that have been modified since then need extra memory
+    quint64 shared    = 0;
+    quint64 exclusive = 0;
+    for (const Kwave::Stripe::List &list : std::as_const(m_stripes)) {
+        for (const Kwave::Stripe &stripe : list)
+            stripe.memoryUsage(shared, exclusive);
+    }
+    return sizeof(*this) + static_cast<qint64>(exclusive);
 }
 
 //***************************************************************************
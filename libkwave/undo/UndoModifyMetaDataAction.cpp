@@ -110,7 +110,8 @@ Kwave::UndoAction *Kwave::UndoModifyMetaDataAction::undo(
     // store data for redo
     if (with_redo) {
         Kwave::MetaDataList old_data;
-        const Kwave::MetaDataList &current_data = manager.metaData();
+        const Kwave::MetaDataList &current_data =
+            std::as_const(manager).metaData();
 
         foreach (const Kwave::MetaData &meta, m_saved_data) {
             if (current_data.contains(meta)) {
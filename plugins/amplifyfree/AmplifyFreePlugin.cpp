@@ -24,15 +24,13 @@
 
 #include <KLocalizedString>
 
-#include "libkwave/Connect.h"
 #include "libkwave/MultiTrackReader.h"
-#include "libkwave/MultiTrackSource.h"
 #include "libkwave/MultiTrackWriter.h"
 #include "libkwave/Parser.h"
 #include "libkwave/PluginManager.h"
+#include "libkwave/SampleReader.h"
 #include "libkwave/String.h"
-#include "libkwave/modules/CurveStreamAdapter.h"
-#include "libkwave/modules/Mul.h"
+#include "libkwave/modules/StreamPipeline.h"
 #include "libkwave/undo/UndoTransactionGuard.h"
 
 #include "AmplifyFreeDialog.h"
@@ -154,27 +152,34 @@ void Kwave::AmplifyFreePlugin::run(QStringList params)
     // create all objects
     Kwave::MultiTrackReader source(Kwave::SinglePassForward,
         signalManager(), selectedTracks(), first, last);
-    Kwave::CurveStreamAdapter curve(m_curve, input_length);
     Kwave::MultiTrackWriter sink(signalManager(), track_list, Kwave::Overwrite,
         first, last);
-    Kwave::MultiTrackSource<Kwave::Mul, true> mul(tracks, this);
 
     // break if aborted
-    if (!sink.tracks()) return;
-
-    // connect them
-    bool ok = Kwave::connect(
-        source, SIGNAL(output(Kwave::SampleArray)),
-        mul,    SLOT(input_a(Kwave::SampleArray)));
-    if (ok) ok = Kwave::connect(
-        curve,  SIGNAL(output(Kwave::SampleArray)),
-        mul,    SLOT(input_b(Kwave::SampleArray)));
-    if (ok) ok = Kwave::connect(
-        mul,    SIGNAL(output(Kwave::SampleArray)),
-        sink,   SLOT(input(Kwave::SampleArray)));
-    if (!ok) {
-        return;
+    if (!sink.tracks() || (source.tracks() != tracks)) return;
+
+    // one chain per track: reader -> multiply with the curve -> writer
+    Kwave::StreamPipeline pipeline;
+    for (unsigned int track = 0; track < tracks; ++track) {
+        Kwave::SampleReader *reader = source[track];
+        Q_ASSERT(reader);
+        if (!reader) return;
+
+        const int index = pipeline.addTrack(
+            new(std::nothrow) Kwave::ReaderStage(*reader), sink[track]);
+        if (index < 0) return;
+
+        Kwave::StreamStage *curve = new(std::nothrow) Kwave::CurveStage(
+            m_curve.interpolation(), input_length);
+        if (!curve) return;
+        Kwave::StreamStage *mul = new(std::nothrow) Kwave::MulStage(curve);
+        if (!mul) {
+            delete curve;
+            return;
+        }
+        if (!pipeline.append(index, mul)) return;
     }
+    if (!pipeline.compile(source.blockSize())) return;
 
     // connect the progress dialog
     connect(&sink, SIGNAL(progress(qreal)),
@@ -183,10 +188,8 @@ void Kwave::AmplifyFreePlugin::run(QStringList params)
 
     // transport the samples
     qDebug("AmplifyFreePlugin: filter started...");
-    while (!shouldStop() && !source.done()) {
-        source.goOn();
-        curve.goOn();
-        /* mul.goOn(); */
+    while (!shouldStop() && pipeline.step()) {
+        // nothing to do, the pipeline does all the work
     }
     qDebug("AmplifyFreePlugin: filter done.");
 }
@@ -111,7 +111,7 @@ void Kwave::BandPass::input(Kwave::SampleArray data)
 {
     const Kwave::SampleArray &in = data;
 
-    bool ok = m_buffer.resize(in.size());
+    bool ok = m_buffer.reuse(in.size());
     Q_ASSERT(ok);
     Q_UNUSED(ok)
 
@@ -0,0 +1,255 @@
+/***************************************************************************
+       ChecksumPlugin.cpp  -  checksums for verifying the audio data
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <errno.h>
+
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureSynchronizer>
+#include <QStringList>
+#include <QTextStream>
+
+#include <KLocalizedString> // for the i18n macro
+
+#include "libkwave/AudioChecksum.h"
+#include "libkwave/FileInfo.h"
+#include "libkwave/Logger.h"
+#include "libkwave/MessageBox.h"
+#include "libkwave/MultiTrackReader.h"
+#include "libkwave/SignalManager.h"
+#include "libkwave/String.h"
+#include "libkwave/TaskPool.h"
+#include "libkwave/Utils.h"
+
+#include "ChecksumPlugin.h"
+
+/** extension of the checksum file, appended to the name of the audio file */
+#define CHECKSUM_FILE_SUFFIX _(".checksum")
+
+KWAVE_PLUGIN(checksum, ChecksumPlugin)
+
+//***************************************************************************
+Kwave::ChecksumPlugin::ChecksumPlugin(QObject *parent,
+                                      const QVariantList &args)
+    :Kwave::Plugin(parent, args), m_store(false)
+{
+}
+
+//***************************************************************************
+Kwave::ChecksumPlugin::~ChecksumPlugin()
+{
+}
+
+//***************************************************************************
+int Kwave::ChecksumPlugin::interpreteParameters(QStringList &params)
+{
+    // checksum([verify | store])
+    m_store = false;
+    if (params.isEmpty()) return 0;
+    if (params.count() != 1) return -EINVAL;
+
+    const QString mode = params[0];
+    if (mode == _("store")) {
+        m_store = true;
+    } else if (mode != _("verify")) {
+        return -EINVAL;
+    }
+
+    return 0;
+}
+
+//***************************************************************************
+int Kwave::ChecksumPlugin::start(QStringList &params)
+{
+    int result = interpreteParameters(params);
+    if (result) return result;
+
+    return Kwave::Plugin::start(params);
+}
+
+//***************************************************************************
+void Kwave::ChecksumPlugin::run(QStringList params)
+{
+    if (interpreteParameters(params)) return;
+
+    const sample_index_t length = signalLength();
+    const QVector<unsigned int> tracks = signalManager().allTracks();
+    if (!length || tracks.isEmpty()) return;
+
+    // hash with the resolution of the file, like FLAC does
+    const Kwave::FileInfo info(std::as_const(signalManager()).metaData());
+    const unsigned int bits = (info.bits()) ? info.bits() : SAMPLE_BITS;
+    Kwave::AudioChecksum checksum(
+        static_cast<unsigned int>(tracks.count()), bits);
+
+    {
+        Kwave::MultiTrackReader source(Kwave::SinglePassForward,
+            signalManager(), tracks, 0, length - 1);
+
+        // connect the progress dialog
+        connect(&source, SIGNAL(progress(qreal)),
+                this,  SLOT(updateProgress(qreal)),
+                Qt::BlockingQueuedConnection);
+        emit setProgressText(i18n("Computing checksums..."));
+
+        while (!shouldStop() && !source.eof()) {
+            QFutureSynchronizer<void> synchronizer;
+
+            for (unsigned int t = 0; t < source.tracks(); t++) {
+                Kwave::SampleReader *reader = source[t];
+                if (!reader) continue;
+                if (reader->eof()) continue;
+
+                synchronizer.addFuture(Kwave::TaskPool::run(
+                    Kwave::TaskPool::Background,
+                    &Kwave::ChecksumPlugin::processTrack,
+                    this,
+                    reader, &checksum, t
+                ));
+            }
+            synchronizer.waitForFinished();
+            checksum.combine();
+        }
+    }
+    if (shouldStop()) return;
+
+    const QMap<QString, QString> computed = entries(checksum);
+    QStringList report;
+    QStringList errors;
+    report << i18n("MD5: %1", checksum.md5());
+    report << i18n("XXH64: %1", checksum.xxh64());
+
+    // compare with the MD5 sum from the STREAMINFO of a FLAC file
+    if (info.contains(Kwave::INF_MD5)) {
+        const QString md5 = info.get(Kwave::INF_MD5).toString();
+        if (md5 == checksum.md5())
+            report << i18n("The MD5 sum matches the one stored in the file.");
+        else
+            errors << i18n("The MD5 sum stored in the file is %1.", md5);
+    }
+
+    // the checksum file next to the audio file
+    const QString filename = signalName();
+    const QString checksum_file = filename + CHECKSUM_FILE_SUFFIX;
+    if (m_store) {
+        if (!QFileInfo::exists(filename) || !save(checksum_file, computed))
+            errors << i18n("Writing '%1' failed.", checksum_file);
+        else
+            report << i18n("Checksums written to '%1'.", checksum_file);
+    } else if (QFileInfo::exists(checksum_file)) {
+        const QMap<QString, QString> stored = load(checksum_file);
+        if (stored.isEmpty())
+            errors << i18n("Reading '%1' failed.", checksum_file);
+        for (auto it = stored.constBegin(); it != stored.constEnd(); ++it) {
+            if (computed.value(it.key()) == it.value()) continue;
+            errors << i18n("Mismatch of '%1': expected %2, found %3",
+                           it.key(), it.value(), computed.value(it.key()));
+        }
+        if (errors.isEmpty())
+            report << i18n("All checksums in '%1' match.", checksum_file);
+    }
+
+    for (const QString &line : std::as_const(report))
+        Kwave::Logger::log(this, Kwave::Logger::Info, line);
+    for (const QString &line : std::as_const(errors))
+        Kwave::Logger::log(this, Kwave::Logger::Error, line);
+
+    if (errors.isEmpty()) {
+        Kwave::MessageBox::information(parentWidget(),
+            report.join(_("\n")), i18n("Checksum"));
+    } else {
+        Kwave::MessageBox::error(parentWidget(),
+            (report + errors).join(_("\n")), i18n("Checksum"));
+    }
+}
+
+//***************************************************************************
+void Kwave::ChecksumPlugin::processTrack(Kwave::SampleReader *reader,
+                                         Kwave::AudioChecksum *checksum,
+                                         unsigned int track)
+{
+    const unsigned int block_size = reader->blockSize();
+    Kwave::SampleArray data(block_size);
+    unsigned int round = 0;
+
+    while ((round++ < 5) && !reader->eof()) {
+        unsigned int len = reader->read(data, 0, block_size);
+        if (!len) break;
+        checksum->process(track, data.constData(), len);
+    }
+}
+
+//***************************************************************************
+QMap<QString, QString> Kwave::ChecksumPlugin::entries(
+    const Kwave::AudioChecksum &checksum)
+{
+    QMap<QString, QString> map;
+    map[_("bits")]      = QString::number(checksum.bits());
+    map[_("md5 all")]   = checksum.md5();
+    map[_("xxh64 all")] = checksum.xxh64();
+    for (unsigned int t = 0; t < checksum.tracks(); ++t) {
+        const int track = Kwave::toInt(t);
+        map[_("md5 %1").arg(t + 1)]   = checksum.md5(track);
+        map[_("xxh64 %1").arg(t + 1)] = checksum.xxh64(track);
+    }
+    return map;
+}
+
+//***************************************************************************
+QMap<QString, QString> Kwave::ChecksumPlugin::load(const QString &filename)
+{
+    QMap<QString, QString> map;
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) return map;
+
+    // one entry per line: <name> <value>, comments start with '#'
+    QTextStream in(&file);
+    while (!in.atEnd()) {
+        const QString line = in.readLine().simplified();
+        if (line.isEmpty() || line.startsWith(QLatin1Char('#'))) continue;
+        const qsizetype pos = line.lastIndexOf(QLatin1Char(' '));
+        if (pos <= 0) continue;
+        map[line.left(pos)] = line.mid(pos + 1).toLower();
+    }
+    return map;
+}
+
+//***************************************************************************
+bool Kwave::ChecksumPlugin::save(const QString &filename,
+                                 const QMap<QString, QString> &entries)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate |
+                   QIODevice::Text))
+        return false;
+
+    QTextStream out(&file);
+    out << "# checksums of the audio data, written by Kwave\n";
+    for (auto it = entries.constBegin(); it != entries.constEnd(); ++it)
+        out << it.key() << " " << it.value() << "\n";
+    out.flush();
+    return (out.status() == QTextStream::Ok);
+}
+
+//***************************************************************************
+#include "ChecksumPlugin.moc"
+//***************************************************************************
+//***************************************************************************
+
+#include "moc_ChecksumPlugin.cpp"
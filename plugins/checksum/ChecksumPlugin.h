@@ -0,0 +1,124 @@
+/***************************************************************************
+         ChecksumPlugin.h  -  checksums for verifying the audio data
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef CHECKSUM_PLUGIN_H
+#define CHECKSUM_PLUGIN_H
+
+#include "config.h"
+
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+#include "libkwave/Plugin.h"
+
+namespace Kwave
+{
+    class AudioChecksum;
+    class SampleReader;
+
+    /**
+     * Computes MD5 and XXH64 checksums of the audio data of the whole
+     * signal, per track and over all tracks, with one thread per track.
+     * The result is compared against the MD5 sum from the STREAMINFO of
+     * a FLAC file and against the checksums in a file next to the audio
+     * file, which can also be written by this plugin. This makes it
+     * possible to verify that a round trip through Kwave is bit exact.
+     */
+    class ChecksumPlugin: public Kwave::Plugin
+    {
+        Q_OBJECT
+
+    public:
+
+        /**
+         * Constructor
+         * @param parent reference to our plugin manager
+         * @param args argument list [unused]
+         */
+        ChecksumPlugin(QObject *parent, const QVariantList &args);
+
+        /** Destructor */
+        ~ChecksumPlugin() override;
+
+        /**
+         * Checks the parameters and starts the worker thread
+         * @param params list of strings with parameters
+         * @return zero if successful or negative error code
+         */
+        int start(QStringList &params) override;
+
+        /**
+         * computes and verifies the checksums
+         * @param params list of strings with parameters
+         */
+        void run(QStringList params) override;
+
+    private:
+
+        /**
+         * reads values from the parameter list
+         * @param params list of strings with parameters
+         * @return zero if successful or negative error code
+         */
+        int interpreteParameters(QStringList &params);
+
+        /**
+         * feed some blocks of one track into the checksum
+         * @param reader reference to a SampleReader to read from
+         * @param checksum the checksums of all tracks
+         * @param track index of the track within the checksum
+         */
+        void processTrack(Kwave::SampleReader *reader,
+                          Kwave::AudioChecksum *checksum,
+                          unsigned int track);
+
+        /**
+         * Returns all checksums, with keys like "md5 all" or "xxh64 2"
+         * @param checksum the checksums of all tracks
+         */
+        static QMap<QString, QString> entries(
+            const Kwave::AudioChecksum &checksum);
+
+        /**
+         * Reads the checksums from a file
+         * @param filename name of the checksum file
+         * @return map of checksums, empty if failed
+         */
+        static QMap<QString, QString> load(const QString &filename);
+
+        /**
+         * Writes the checksums into a file
+         * @param filename name of the checksum file
+         * @param entries map of checksums
+         * @return true if successful
+         */
+        static bool save(const QString &filename,
+                         const QMap<QString, QString> &entries);
+
+    private:
+
+        /** if true, store the checksums instead of verifying them */
+        bool m_store;
+
+    };
+}
+
+#endif /* CHECKSUM_PLUGIN_H */
+
+//***************************************************************************
+//***************************************************************************
@@ -19,8 +19,13 @@
 
 #include <new>
 
+#include <QByteArray>
 #include <QDateTime>
+#include <QFile>
+#include <QFuture>
 #include <QIODevice>
+#include <QList>
+#include <QThread>
 
 #include <KLocalizedString>
 
@@ -29,10 +34,22 @@
 #include "libkwave/MultiWriter.h"
 #include "libkwave/Sample.h"
 #include "libkwave/String.h"
+#include "libkwave/TaskPool.h"
+#include "libkwave/Utils.h"
 #include "libkwave/Writer.h"
 
 #include "FlacCodecPlugin.h"
 #include "FlacDecoder.h"
+#include "FlacRangeDecoder.h"
+
+/** size of the decoded data of one range in parallel mode, all tracks */
+#define PARALLEL_RANGE_BYTES (8 * 1024 * 1024)
+
+/** minimum number of samples per range, to keep the seek overhead low */
+#define PARALLEL_RANGE_MIN (64 * 1024)
+
+/** maximum number of ranges that are decoded at the same time */
+#define PARALLEL_MAX_JOBS 8
 
 //***************************************************************************
 Kwave::FlacDecoder::FlacDecoder()
@@ -83,6 +100,48 @@ Kwave::Decoder *Kwave::FlacDecoder::instance()
     return FLAC__STREAM_DECODER_READ_STATUS_CONTINUE;
 }
 
+//***************************************************************************
+::FLAC__StreamDecoderSeekStatus Kwave::FlacDecoder::seek_callback(
+        FLAC__uint64 absolute_byte_offset)
+{
+    if (!m_source || m_source->isSequential())
+        return FLAC__STREAM_DECODER_SEEK_STATUS_UNSUPPORTED;
+
+    return (m_source->seek(static_cast<qint64>(absolute_byte_offset))) ?
+        FLAC__STREAM_DECODER_SEEK_STATUS_OK :
+        FLAC__STREAM_DECODER_SEEK_STATUS_ERROR;
+}
+
+//***************************************************************************
+::FLAC__StreamDecoderTellStatus Kwave::FlacDecoder::tell_callback(
+        FLAC__uint64 *absolute_byte_offset)
+{
+    if (!m_source || m_source->isSequential())
+        return FLAC__STREAM_DECODER_TELL_STATUS_UNSUPPORTED;
+    if (!absolute_byte_offset) return FLAC__STREAM_DECODER_TELL_STATUS_ERROR;
+
+    *absolute_byte_offset = static_cast<FLAC__uint64>(m_source->pos());
+    return FLAC__STREAM_DECODER_TELL_STATUS_OK;
+}
+
+//***************************************************************************
+::FLAC__StreamDecoderLengthStatus Kwave::FlacDecoder::length_callback(
+        FLAC__uint64 *stream_length)
+{
+    if (!m_source || m_source->isSequential())
+        return FLAC__STREAM_DECODER_LENGTH_STATUS_UNSUPPORTED;
+    if (!stream_length) return FLAC__STREAM_DECODER_LENGTH_STATUS_ERROR;
+
+    *stream_length = static_cast<FLAC__uint64>(m_source->size());
+    return FLAC__STREAM_DECODER_LENGTH_STATUS_OK;
+}
+
+//***************************************************************************
+bool Kwave::FlacDecoder::eof_callback()
+{
+    return (!m_source || m_source->atEnd());
+}
+
 //***************************************************************************
 ::FLAC__StreamDecoderWriteStatus Kwave::FlacDecoder::write_callback(
         const ::FLAC__Frame *frame,
@@ -155,6 +214,12 @@ void Kwave::FlacDecoder::parseStreamInfo(
     info.setTracks(stream_info.get_channels());
     info.setBits(stream_info.get_bits_per_sample());
     info.setLength(stream_info.get_total_samples());
+
+    // the MD5 sum of the audio data is optional, zero if not present
+    const QByteArray md5(reinterpret_cast<const char *>(
+        stream_info.get_md5sum()), 16);
+    if (md5.count('\0') != md5.size())
+        info.set(Kwave::INF_MD5, QString::fromLatin1(md5.toHex()));
     metaData().replace(Kwave::MetaDataList(info));
 
     qDebug("Bitstream is %u channel, %uHz",
@@ -312,9 +377,20 @@ bool Kwave::FlacDecoder::decode(QWidget * /* widget */,
 
     m_dest = &dst;
 
-    // read in all remaining data
-    qDebug("FlacDecoder::decode(...)");
-    process_until_end_of_stream();
+    // try to decode in parallel if the source allows seeking
+    sample_index_t decoded = 0;
+    if (!decodeParallel(dst, decoded) && !dst.isCanceled()) {
+        // continue sequentially, where the parallel mode stopped
+        if (decoded && !seek_absolute(decoded)) {
+            qWarning("FlacDecoder: seeking to %llu failed", decoded);
+            m_dest = nullptr;
+            return false;
+        }
+
+        // read in all remaining data
+        qDebug("FlacDecoder::decode(...)");
+        process_until_end_of_stream();
+    }
 
     m_dest = nullptr;
     Kwave::FileInfo info(metaData());
@@ -325,6 +401,90 @@ bool Kwave::FlacDecoder::decode(QWidget * /* widget */,
     return true;
 }
 
+//***************************************************************************
+bool Kwave::FlacDecoder::decodeParallel(Kwave::MultiWriter &dst,
+                                        sample_index_t &decoded)
+{
+    decoded = 0;
+
+    // only possible for files with known length
+    QFile *file = qobject_cast<QFile *>(m_source);
+    if (!file || file->isSequential()) return false;
+
+    const Kwave::FileInfo info(metaData());
+    const sample_index_t length = info.length();
+    const unsigned int   tracks = info.tracks();
+    const unsigned int   bits   = info.bits();
+    if (!length || !tracks || !bits) return false;
+    if (tracks != dst.tracks()) return false;
+
+    // size the ranges by memory, a file with many tracks gets shorter
+    // ranges, and limit the number of ranges in flight
+    const unsigned int range_length = qMax<unsigned int>(
+        PARALLEL_RANGE_MIN,
+        Kwave::toUint(PARALLEL_RANGE_BYTES / (tracks * sizeof(sample_t))));
+    const sample_index_t ranges =
+        (length + range_length - 1) / range_length;
+    int threads = qMin(QThread::idealThreadCount(), PARALLEL_MAX_JOBS);
+    if (ranges < static_cast<sample_index_t>(threads))
+        threads = Kwave::toInt(ranges);
+
+    // not worth the effort for short files or on a single core
+    if (threads < 2) return false;
+
+    // create one decoder per thread, each with its own file handle
+    QList<Kwave::FlacRangeDecoder *> workers;
+    for (int i = 0; i < threads; ++i) {
+        Kwave::FlacRangeDecoder *worker = new(std::nothrow)
+            Kwave::FlacRangeDecoder(file->fileName(), tracks, bits, &dst);
+        if (!worker || !worker->open()) {
+            delete worker;
+            qDeleteAll(workers);
+            return false;
+        }
+        workers.append(worker);
+    }
+    qDebug("FlacDecoder: decoding with %d threads", threads);
+
+    bool ok = true;
+    while (ok && (decoded < length) && !dst.isCanceled()) {
+        // start one range per worker
+        QList< QFuture<bool> > jobs;
+        QList<unsigned int> counts;
+        sample_index_t pos = decoded;
+        for (Kwave::FlacRangeDecoder *worker : std::as_const(workers)) {
+            if (pos >= length) break;
+            const unsigned int count = Kwave::toUint(
+                qMin<sample_index_t>(range_length, length - pos));
+            jobs.append(Kwave::TaskPool::run(Kwave::TaskPool::Background,
+                &Kwave::FlacRangeDecoder::decode, worker, pos, count));
+            counts.append(count);
+            pos += count;
+        }
+
+        // wait for all of them, but merge only the complete ranges in order
+        for (int i = 0; i < jobs.count(); ++i) {
+            const bool range_ok = jobs[i].result();
+            Kwave::FlacRangeDecoder *worker = workers[i];
+            if (!ok) continue;
+            if (!range_ok || (worker->length() != counts[i])) {
+                ok = false;
+                continue;
+            }
+
+            for (unsigned int track = 0; track < tracks; ++track) {
+                Kwave::Writer *writer = dst[track];
+                Q_ASSERT(writer);
+                if (writer) (*writer) << worker->data(track);
+            }
+            decoded += counts[i];
+        }
+    }
+
+    qDeleteAll(workers);
+    return ok;
+}
+
 //***************************************************************************
 void Kwave::FlacDecoder::close()
 {
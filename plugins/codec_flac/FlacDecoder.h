@@ -105,6 +105,41 @@ namespace Kwave
         virtual ::FLAC__StreamDecoderReadStatus read_callback(
             FLAC__byte buffer[], size_t *bytes) override;
 
+        /**
+         * FLAC decoder interface: seek callback, only supported if
+         * the source is not sequential.
+         *
+         * @param absolute_byte_offset the position to seek to
+         * @return seek state
+         */
+        virtual ::FLAC__StreamDecoderSeekStatus seek_callback(
+            FLAC__uint64 absolute_byte_offset) override;
+
+        /**
+         * FLAC decoder interface: tell callback.
+         *
+         * @param absolute_byte_offset receives the current position
+         * @return tell state
+         */
+        virtual ::FLAC__StreamDecoderTellStatus tell_callback(
+            FLAC__uint64 *absolute_byte_offset) override;
+
+        /**
+         * FLAC decoder interface: length callback.
+         *
+         * @param stream_length receives the length of the source
+         * @return length state
+         */
+        virtual ::FLAC__StreamDecoderLengthStatus length_callback(
+            FLAC__uint64 *stream_length) override;
+
+        /**
+         * FLAC decoder interface: eof callback.
+         *
+         * @return true if the end of the source has been reached
+         */
+        virtual bool eof_callback() override;
+
         /**
          * FLAC decoder interface: write callback.
          *
@@ -132,6 +167,24 @@ namespace Kwave
         virtual void error_callback(::FLAC__StreamDecoderErrorStatus status)
             override;
 
+    private:
+
+        /**
+         * Decodes the stream in parallel, by splitting it into ranges
+         * that are decoded by several threads, each with its own file
+         * handle and decoder. The results are written to the destination
+         * in the order of the ranges.
+         *
+         * @param dst MultiWriter that receives the audio data
+         * @param decoded receives the number of samples that have been
+         *                decoded and written
+         * @return true if succeeded, false if the parallel mode is not
+         *         possible or failed (the caller should continue
+         *         sequentially at the position returned in decoded)
+         */
+        bool decodeParallel(Kwave::MultiWriter &dst,
+                            sample_index_t &decoded);
+
     private:
 
         /** source of the audio data */
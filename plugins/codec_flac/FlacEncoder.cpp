@@ -33,10 +33,12 @@
 
 #include <vorbis/vorbisenc.h>
 
+#include "libkwave/Dither.h"
 #include "libkwave/FileInfo.h"
 #include "libkwave/MessageBox.h"
 #include "libkwave/MetaDataList.h"
 #include "libkwave/MultiTrackReader.h"
+#include "libkwave/ReadAhead.h"
 #include "libkwave/Sample.h"
 #include "libkwave/SampleReader.h"
 #include "libkwave/String.h"
@@ -68,7 +70,10 @@ Kwave::Encoder *Kwave::FlacEncoder::instance()
 /***************************************************************************/
 QList<Kwave::FileProperty> Kwave::FlacEncoder::supportedProperties()
 {
-    return m_vorbis_comment_map.values();
+    // the MD5 sum of the audio data is computed by libFLAC
+    QList<Kwave::FileProperty> list = m_vorbis_comment_map.values();
+    list.append(Kwave::INF_MD5);
+    return list;
 }
 
 /***************************************************************************/
@@ -208,6 +213,7 @@ bool Kwave::FlacEncoder::encode(QWidget *widget,
     }
 
     QVector<FLAC__int32 *> flac_buffer;
+    QList<Kwave::Dither *> dither_list;
     do {
         // open the output device
         if (!dst.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
@@ -238,18 +244,26 @@ bool Kwave::FlacEncoder::encode(QWidget *widget,
             flac_buffer.append(buffer);
         }
 
-        // allocate input buffer, with Kwave's sample_t
-        Kwave::SampleArray in_buffer(len);
-        Q_ASSERT(in_buffer.size() == len);
         Q_ASSERT(flac_buffer.size() == tracks);
-
-        if ((in_buffer.size() < len) || (flac_buffer.size() < tracks))
+        if (flac_buffer.size() < tracks)
         {
             Kwave::MessageBox::error(widget, i18n("Out of memory"));
             result = false;
             break;
         }
 
+        // dither for reducing the resolution, one per track
+        for (int track = 0; track < tracks; track++) {
+            Kwave::Dither *dither = new(std::nothrow) Kwave::Dither(
+                bits, Kwave::Dither::defaultMode(),
+                Kwave::Dither::defaultShaping(), Kwave::toUint(track));
+            if (!dither || !dither->isActive()) {
+                delete dither;
+                break;
+            }
+            dither_list.append(dither);
+        }
+
         // calculate divisor for reaching the proper resolution
         int shift = SAMPLE_BITS - bits;
         if (shift < 0) shift = 0;
@@ -258,39 +272,32 @@ bool Kwave::FlacEncoder::encode(QWidget *widget,
         const FLAC__int32 clip_min = -(1 << bits);
         const FLAC__int32 clip_max =  (1 << bits) - 1;
 
+        // read the samples ahead, while FLAC is busy with compression
+        Kwave::ReadAhead read_ahead(src, length, len);
+        Kwave::ReadAhead::Block block;
         sample_index_t rest = length;
-        while (rest && len && !src.isCanceled() && result) {
-            // limit to rest of signal
-            if (len > rest) len = Kwave::toUint(rest);
-            if (!in_buffer.resize(len)) {
+        while (rest && !src.isCanceled() && result) {
+            const unsigned int count = read_ahead.read(block);
+            if (!count) {
+                if (src.isCanceled()) break;
                 Kwave::MessageBox::error(widget, i18n("Out of memory"));
                 result = false;
                 break;
             }
 
-            // add all samples to one single buffer
+            // convert the samples of all tracks
             for (int track = 0; track < tracks; track++) {
-                Kwave::SampleReader *reader = src[track];
-                Q_ASSERT(reader);
-                if (!reader) break;
-
-                (*reader) >> in_buffer;           // read samples into in_buffer
-                unsigned int l = in_buffer.size();// in_buffer might be empty!
-                if (l < len) {
-                    if (!in_buffer.resize(len)) {
-                        Kwave::MessageBox::error(widget, i18n("Out of memory"));
-                        result = false;
-                        break;
-                    }
-                    while (l < len) in_buffer[l++] = 0;
-                }
-
+                Kwave::SampleArray &in_buffer = block[track];
                 FLAC__int32 *buf = flac_buffer.at(track);
                 Q_ASSERT(buf);
                 if (!buf) break;
 
+                // requantize with dither, the division below is exact then
+                if (track < dither_list.count())
+                    dither_list[track]->process(in_buffer.data(), count);
+
                 const Kwave::SampleArray &in = in_buffer;
-                for (unsigned int in_pos = 0; in_pos < len; in_pos++) {
+                for (unsigned int in_pos = 0; in_pos < count; in_pos++) {
                     FLAC__int32 s = in[in_pos];
                     if (div) s /= div;
                     if (s > clip_max) s = clip_max;
@@ -299,17 +306,16 @@ bool Kwave::FlacEncoder::encode(QWidget *widget,
                     buf++;
                 }
             }
-            if (!result) break; // error occurred?
 
             // process all collected samples
             FLAC__int32 **buffer = flac_buffer.data();
-            bool processed = process(buffer, static_cast<unsigned>(len));
+            bool processed = process(buffer, static_cast<unsigned>(count));
             if (!processed) {
                 result = false;
                 break;
             }
 
-            rest -= len;
+            rest -= count;
         }
 
     } while (false);
@@ -332,6 +338,8 @@ bool Kwave::FlacEncoder::encode(QWidget *widget,
         if (buf) free(buf);
         flac_buffer.remove(0);
     }
+    qDeleteAll(dither_list);
+    dither_list.clear();
 
     return result;
 }
@@ -0,0 +1,188 @@
+/*************************************************************************
+   FlacRangeDecoder.cpp  -  decoder for a range of a seekable FLAC file
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include "libkwave/Utils.h"
+
+#include "FlacRangeDecoder.h"
+
+//***************************************************************************
+Kwave::FlacRangeDecoder::FlacRangeDecoder(const QString &filename,
+                                          unsigned int tracks,
+                                          unsigned int bits,
+                                          const Kwave::StreamObject *dst)
+    :FLAC::Decoder::Stream(),
+     m_file(filename),
+     m_tracks(tracks),
+     m_dst(dst),
+     m_shift(qMax(0, SAMPLE_BITS - Kwave::toInt(bits))),
+     m_first(0),
+     m_count(0),
+     m_length(0),
+     m_data(tracks)
+{
+}
+
+//***************************************************************************
+Kwave::FlacRangeDecoder::~FlacRangeDecoder()
+{
+    if (m_file.isOpen()) {
+        finish();
+        m_file.close();
+    }
+}
+
+//***************************************************************************
+bool Kwave::FlacRangeDecoder::open()
+{
+    if (!m_tracks || (m_data.count() != Kwave::toInt(m_tracks)))
+        return false;
+    if (!m_file.open(QIODevice::ReadOnly)) return false;
+
+    set_metadata_ignore_all();
+    if (init() != FLAC__STREAM_DECODER_INIT_STATUS_OK) return false;
+    if (!process_until_end_of_metadata()) return false;
+
+    return (get_state() < FLAC__STREAM_DECODER_END_OF_STREAM);
+}
+
+//***************************************************************************
+bool Kwave::FlacRangeDecoder::decode(sample_index_t first, unsigned int count)
+{
+    m_first  = first;
+    m_count  = count;
+    m_length = 0;
+
+    for (unsigned int track = 0; track < m_tracks; ++track) {
+        if (!m_data[track].resize(count)) return false;
+    }
+
+    // seeking already decodes and delivers the first frame
+    if (!seek_absolute(first)) {
+        qWarning("FlacRangeDecoder: seeking to %llu failed", first);
+        return false;
+    }
+
+    while (m_length < m_count) {
+        if (m_dst && m_dst->isCanceled()) return false;
+        if (!process_single()) return false;
+        if (get_state() >= FLAC__STREAM_DECODER_END_OF_STREAM) break;
+    }
+
+    return true;
+}
+
+//***************************************************************************
+::FLAC__StreamDecoderReadStatus Kwave::FlacRangeDecoder::read_callback(
+        FLAC__byte buffer[], size_t *bytes)
+{
+    if (!bytes) return FLAC__STREAM_DECODER_READ_STATUS_ABORT;
+    if (m_file.atEnd()) {
+        *bytes = 0;
+        return FLAC__STREAM_DECODER_READ_STATUS_END_OF_STREAM;
+    }
+
+    const qint64 read = m_file.read(reinterpret_cast<char *>(&(buffer[0])),
+                                    static_cast<qint64>(*bytes));
+    if (read <= 0) {
+        *bytes = 0;
+        return FLAC__STREAM_DECODER_READ_STATUS_END_OF_STREAM;
+    }
+    *bytes = static_cast<size_t>(read);
+    return FLAC__STREAM_DECODER_READ_STATUS_CONTINUE;
+}
+
+//***************************************************************************
+::FLAC__StreamDecoderSeekStatus Kwave::FlacRangeDecoder::seek_callback(
+        FLAC__uint64 absolute_byte_offset)
+{
+    return (m_file.seek(static_cast<qint64>(absolute_byte_offset))) ?
+        FLAC__STREAM_DECODER_SEEK_STATUS_OK :
+        FLAC__STREAM_DECODER_SEEK_STATUS_ERROR;
+}
+
+//***************************************************************************
+::FLAC__StreamDecoderTellStatus Kwave::FlacRangeDecoder::tell_callback(
+        FLAC__uint64 *absolute_byte_offset)
+{
+    if (!absolute_byte_offset) return FLAC__STREAM_DECODER_TELL_STATUS_ERROR;
+    *absolute_byte_offset = static_cast<FLAC__uint64>(m_file.pos());
+    return FLAC__STREAM_DECODER_TELL_STATUS_OK;
+}
+
+//***************************************************************************
+::FLAC__StreamDecoderLengthStatus Kwave::FlacRangeDecoder::length_callback(
+        FLAC__uint64 *stream_length)
+{
+    if (!stream_length) return FLAC__STREAM_DECODER_LENGTH_STATUS_ERROR;
+    *stream_length = static_cast<FLAC__uint64>(m_file.size());
+    return FLAC__STREAM_DECODER_LENGTH_STATUS_OK;
+}
+
+//***************************************************************************
+bool Kwave::FlacRangeDecoder::eof_callback()
+{
+    return m_file.atEnd();
+}
+
+//***************************************************************************
+::FLAC__StreamDecoderWriteStatus Kwave::FlacRangeDecoder::write_callback(
+        const ::FLAC__Frame *frame,
+        const FLAC__int32 * const buffer[])
+{
+    if (!frame || !buffer) return FLAC__STREAM_DECODER_WRITE_STATUS_ABORT;
+
+    // after seeking libFLAC always reports sample numbers
+    if (frame->header.number_type != FLAC__FRAME_NUMBER_TYPE_SAMPLE_NUMBER)
+        return FLAC__STREAM_DECODER_WRITE_STATUS_ABORT;
+
+    const sample_index_t end   = m_first + m_count;
+    const sample_index_t start = frame->header.number.sample_number;
+    const unsigned int samples = frame->header.blocksize;
+    if ((start >= end) || (start + samples <= m_first))
+        return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
+
+    // clip the frame to our range
+    const unsigned int skip = (start < m_first) ?
+        Kwave::toUint(m_first - start) : 0;
+    const sample_index_t from = start + skip;
+    const unsigned int n = Kwave::toUint(
+        qMin<sample_index_t>(samples - skip, end - from));
+    const unsigned int offset = Kwave::toUint(from - m_first);
+
+    const sample_t mul = static_cast<sample_t>(1 << m_shift);
+    for (unsigned int track = 0; track < m_tracks; ++track) {
+        const FLAC__int32 *src = buffer[track] + skip;
+        sample_t *dst = m_data[track].data() + offset;
+        for (unsigned int i = 0; i < n; ++i)
+            dst[i] = static_cast<sample_t>(src[i]) * mul;
+    }
+
+    m_length = qMax(m_length, offset + n);
+    return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
+}
+
+//***************************************************************************
+void Kwave::FlacRangeDecoder::error_callback(
+    ::FLAC__StreamDecoderErrorStatus status)
+{
+    qDebug("FlacRangeDecoder::error_callback: status=%d", status);
+}
+
+//***************************************************************************
+//***************************************************************************
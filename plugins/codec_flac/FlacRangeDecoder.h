@@ -0,0 +1,144 @@
+/*************************************************************************
+     FlacRangeDecoder.h  -  decoder for a range of a seekable FLAC file
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef FLAC_RANGE_DECODER_H
+#define FLAC_RANGE_DECODER_H
+
+#include "config.h"
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+
+#include <FLAC++/decoder.h>
+#include <FLAC/format.h>
+
+#include "libkwave/Sample.h"
+#include "libkwave/SampleArray.h"
+#include "libkwave/modules/StreamObject.h"
+
+namespace Kwave
+{
+    /**
+     * Decodes a range of samples from a seekable FLAC file into one
+     * buffer per track. Each instance uses its own file handle and FLAC
+     * decoder, so that several instances can run in parallel threads.
+     */
+    class FlacRangeDecoder: protected FLAC::Decoder::Stream
+    {
+    public:
+        /**
+         * Constructor
+         * @param filename name of the FLAC file
+         * @param tracks number of tracks
+         * @param bits number of bits per sample
+         * @param dst the destination, only used for checking whether
+         *            the user has canceled, not owned, may be null
+         */
+        FlacRangeDecoder(const QString &filename,
+                         unsigned int tracks, unsigned int bits,
+                         const Kwave::StreamObject *dst);
+
+        /** Destructor */
+        ~FlacRangeDecoder() override;
+
+        /**
+         * Opens the file and reads the metadata
+         * @return true if succeeded
+         */
+        bool open();
+
+        /**
+         * Decodes a range of samples into the internal buffers
+         * @param first index of the first sample
+         * @param count number of samples
+         * @return true if succeeded, false if seeking or decoding failed
+         *         or the destination has been canceled
+         */
+        bool decode(sample_index_t first, unsigned int count);
+
+        /**
+         * Returns the buffer with the decoded samples of one track,
+         * valid after decode(), contains length() samples
+         * @param track index of the track
+         */
+        Kwave::SampleArray &data(unsigned int track) { return m_data[track]; }
+
+        /** Returns the number of samples decoded by the last decode() */
+        inline unsigned int length() const { return m_length; }
+
+    protected:
+
+        /** @see FLAC::Decoder::Stream::read_callback */
+        ::FLAC__StreamDecoderReadStatus read_callback(
+            FLAC__byte buffer[], size_t *bytes) override;
+
+        /** @see FLAC::Decoder::Stream::seek_callback */
+        ::FLAC__StreamDecoderSeekStatus seek_callback(
+            FLAC__uint64 absolute_byte_offset) override;
+
+        /** @see FLAC::Decoder::Stream::tell_callback */
+        ::FLAC__StreamDecoderTellStatus tell_callback(
+            FLAC__uint64 *absolute_byte_offset) override;
+
+        /** @see FLAC::Decoder::Stream::length_callback */
+        ::FLAC__StreamDecoderLengthStatus length_callback(
+            FLAC__uint64 *stream_length) override;
+
+        /** @see FLAC::Decoder::Stream::eof_callback */
+        bool eof_callback() override;
+
+        /** @see FLAC::Decoder::Stream::write_callback */
+        ::FLAC__StreamDecoderWriteStatus write_callback(
+            const ::FLAC__Frame *frame,
+            const FLAC__int32 *const buffer[]) override;
+
+        /** @see FLAC::Decoder::Stream::error_callback */
+        void error_callback(::FLAC__StreamDecoderErrorStatus status) override;
+
+    private:
+
+        /** the file, opened read-only */
+        QFile m_file;
+
+        /** number of tracks */
+        unsigned int m_tracks;
+
+        /** the destination, for checking for cancel */
+        const Kwave::StreamObject *m_dst;
+
+        /** number of bits to shift up to SAMPLE_BITS */
+        int m_shift;
+
+        /** first sample of the current range */
+        sample_index_t m_first;
+
+        /** number of samples of the current range */
+        unsigned int m_count;
+
+        /** number of decoded samples in the current range */
+        unsigned int m_length;
+
+        /** one buffer per track */
+        QVector<Kwave::SampleArray> m_data;
+    };
+}
+
+#endif /* FLAC_RANGE_DECODER_H */
+
+//***************************************************************************
+//***************************************************************************
@@ -31,6 +31,8 @@
 #include <QLatin1Char>
 #include <QList>
 #include <QMap>
+#include <QVarLengthArray>
+#include <QVector>
 
 #include <KLocalizedString>
 
@@ -41,6 +43,7 @@
 #include "libkwave/MixerMatrix.h"
 #include "libkwave/MultiTrackReader.h"
 #include "libkwave/Sample.h"
+#include "libkwave/SampleArray.h"
 #include "libkwave/SampleReader.h"
 #include "libkwave/String.h"
 #include "libkwave/Utils.h"
@@ -491,52 +494,62 @@ bool Kwave::MP3Encoder::encode(QWidget *widget, Kwave::MultiTrackReader &src,
     const int bytes_per_sample = bits / 8;
 
     sample_index_t rest = length;
-    Kwave::SampleArray in_samples(tracks);
-    Kwave::SampleArray out_samples(tracks);
+
+    // one block per track and per output of the mixer, with as many
+    // sample frames as fit into the write buffer
+    const unsigned int block_frames = buf_len / (bytes_per_sample * tracks);
+    QVector<Kwave::SampleArray> in_blocks(Kwave::toInt(tracks));
+    QVector<Kwave::SampleArray> out_blocks(
+        Kwave::toInt((tracks > 2) ? out_tracks : 0));
+    for (Kwave::SampleArray &block : in_blocks)
+        if (!block.resize(block_frames)) result = false;
+    for (Kwave::SampleArray &block : out_blocks)
+        if (!block.resize(block_frames)) result = false;
+    QVarLengthArray<const sample_t *> in(tracks);
+    QVarLengthArray<sample_t *> out(out_tracks);
+    QVarLengthArray<const sample_t *> channels(out_tracks);
 
     while (result && rest && (m_process.state() != QProcess::NotRunning)) {
         unsigned int x;
         unsigned int y;
 
-        // merge the tracks into the sample buffer
-        quint8 *dst_buffer = &(m_write_buffer[0]);
-        unsigned int count = buf_len / (bytes_per_sample * tracks);
+        unsigned int count = block_frames;
         if (rest < count) count = Kwave::toUint(rest);
 
-        unsigned int written = 0;
-        for (written = 0; written < count; written++) {
-            const sample_t *src_buf = nullptr;
-
-            // fill input buffer with samples
-            for (x = 0; x < tracks; ++x) {
-                in_samples[x] = 0;
-                Kwave::SampleReader *stream = src[x];
-                Q_ASSERT(stream);
-                if (!stream) continue;
+        // fill the input buffers with a block of samples of each track
+        for (x = 0; x < tracks; ++x) {
+            Kwave::SampleArray &block = in_blocks[x];
+            Kwave::SampleReader *stream = src[x];
+            Q_ASSERT(stream);
+            unsigned int len = 0;
+            if (stream && !stream->eof())
+                len = stream->read(block, 0, count);
+            sample_t *samples = block.data();
+            while (len < count) samples[len++] = 0;
+            in[x] = block.constData();
+        }
 
-                if (!stream->eof()) (*stream) >> in_samples[x];
-            }
+        if (tracks > 2) {
+            // multiply matrix with the whole block of input
+            for (y = 0; y < out_tracks; ++y)
+                out[y] = out_blocks[y].data();
+            mixer.mix(in.constData(), out.constData(), count);
 
-            if (tracks > 2) {
-                // multiply matrix with input to get output
-                const Kwave::SampleArray &in = in_samples;
-                for (y = 0; y < out_tracks; ++y) {
-                    double sum = 0;
-                    for (x = 0; x < tracks; ++x)
-                        sum += static_cast<double>(in[x]) * mixer[x][y];
-                    out_samples[y] = static_cast<sample_t>(sum);
-                }
-
-                // use output of the matrix
-                src_buf = out_samples.constData();
-            } else {
-                // use input buffer directly
-                src_buf = in_samples.constData();
-            }
+            // use output of the matrix
+            for (y = 0; y < out_tracks; ++y)
+                channels[y] = out[y];
+        } else {
+            // use input buffers directly
+            for (y = 0; y < out_tracks; ++y)
+                channels[y] = in[y];
+        }
 
-            // sample conversion from 24bit to raw PCM, native endian
+        // merge the channels into the sample buffer, with sample
+        // conversion from 24bit to raw PCM, native endian
+        quint8 *dst_buffer = &(m_write_buffer[0]);
+        for (unsigned int i = 0; i < count; ++i) {
             for (y = 0; y < out_tracks; ++y) {
-                sample_t s = *(src_buf++);
+                sample_t s = channels[y][i];
 #if Q_BYTE_ORDER == Q_BIG_ENDIAN
                 // big endian
                 if (bits >= 8)
@@ -564,7 +577,7 @@ bool Kwave::MP3Encoder::encode(QWidget *widget, Kwave::MultiTrackReader &src,
         // write out to the stdin of the external process
         qint64 bytes_written = m_process.write(
             reinterpret_cast<char *>(&(m_write_buffer[0])),
-            written * (bytes_per_sample * tracks)
+            count * (bytes_per_sample * out_tracks)
         );
 
         // break if eof reached or disk full
@@ -577,8 +590,8 @@ bool Kwave::MP3Encoder::encode(QWidget *widget, Kwave::MultiTrackReader &src,
         // --> this would leave a corrupted file !!!
         if (src.isCanceled()) break;
 
-        Q_ASSERT(rest >= written);
-        rest -= written;
+        Q_ASSERT(rest >= count);
+        rest -= count;
     }
 
     // flush and close the write channel
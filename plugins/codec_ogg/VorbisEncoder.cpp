@@ -29,6 +29,7 @@
 
 #include "libkwave/MessageBox.h"
 #include "libkwave/MultiTrackReader.h"
+#include "libkwave/ReadAhead.h"
 #include "libkwave/Sample.h"
 #include "libkwave/SampleArray.h"
 #include "libkwave/Utils.h"
@@ -43,7 +44,7 @@
 
 /***************************************************************************/
 Kwave::VorbisEncoder::VorbisEncoder()
-    :m_comments_map(), m_info()
+    :m_comments_map(), m_info(), m_widget(nullptr)
 {
     memset(&m_os, 0x00, sizeof(m_os));
     memset(&m_og, 0x00, sizeof(m_og));
@@ -88,7 +89,8 @@ bool Kwave::VorbisEncoder::open(QWidget *widget, const Kwave::FileInfo &info,
     Q_UNUSED(src)
 
     // get info: tracks, sample rate, bitrate(s)
-    m_info = info;
+    m_info   = info;
+    m_widget = widget;
     const unsigned int tracks = info.tracks();
     long int sample_rate = static_cast<long int>(info.rate());
 
@@ -238,9 +240,19 @@ bool Kwave::VorbisEncoder::encode(Kwave::MultiTrackReader &src,
     const unsigned int   tracks = m_info.tracks();
     const sample_index_t length = m_info.length();
 
+    // read the samples ahead, while vorbis is busy with the analysis
+    Kwave::ReadAhead read_ahead(src, length, BUFFER_SIZE);
+    Kwave::ReadAhead::Block block;
     sample_index_t rest = length;
     while (!eos && !src.isCanceled()) {
-        if (src.eof()) {
+        const unsigned int len = read_ahead.read(block);
+        if (!len && rest && !src.isCanceled()) {
+            // not at the end of the stream -> out of memory
+            Kwave::MessageBox::error(m_widget, i18n("Out of memory"));
+            return false;
+        }
+        rest -= len;
+        if (!len) {
             // end of file.  this can be done implicitly in the mainline,
             // but it's easier to see here in non-clever fashion.
             // Tell the library we're at end of stream so that it can handle
@@ -251,31 +263,11 @@ bool Kwave::VorbisEncoder::encode(Kwave::MultiTrackReader &src,
 
             // expose the buffer to submit data
             float **buffer = vorbis_analysis_buffer(&m_vd, BUFFER_SIZE);
-            unsigned int pos = 0;
-            unsigned int len = (rest > BUFFER_SIZE) ? BUFFER_SIZE :
-                                                      Kwave::toUint(rest);
-            Kwave::SampleArray samples(BUFFER_SIZE);
-            for (unsigned int track = 0; track < tracks; ++track) {
-                float *p = buffer[track];
-                unsigned int l = src[track]->read(samples, 0, len);
-                const sample_t *s = samples.constData();
-
-                const unsigned int block = 8;
-                pos = 0;
-                while (pos + block < l) {
-                    for (unsigned int i = 0; i < block; ++i, ++pos)
-                        p[pos] = sample2float(s[pos]);
-                }
-                while (pos < l) {
-                    p[pos] = sample2float(s[pos]);
-                    pos++;
-                }
-                while (pos < len)
-                    p[pos++] = 0;
-            }
+            for (unsigned int track = 0; track < tracks; ++track)
+                samples2floats(block[track].constData(), buffer[track], len);
 
             // tell the library how much we actually submitted
-            vorbis_analysis_wrote(&m_vd, pos);
+            vorbis_analysis_wrote(&m_vd, len);
         }
 
         // vorbis does some data preanalysis, then divvies up blocks for
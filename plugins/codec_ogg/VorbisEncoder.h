@@ -93,6 +93,9 @@ namespace Kwave
         /** file info, set in open(...) */
         Kwave::FileInfo m_info;
 
+        /** parent widget for error messages, set in open(...) */
+        QWidget *m_widget;
+
         /** take physical pages, weld into a logical stream of packets */
         ogg_stream_state m_os;
 
@@ -27,15 +27,19 @@
 
 #include <QByteArray>
 #include <QIODevice>
+#include <QList>
 #include <QtEndian>
 #include <QtGlobal>
 
 #include "libkwave/Compression.h"
+#include "libkwave/Dither.h"
 #include "libkwave/FileInfo.h"
 #include "libkwave/LabelList.h"
 #include "libkwave/MessageBox.h"
 #include "libkwave/MultiTrackReader.h"
+#include "libkwave/ReadAhead.h"
 #include "libkwave/Sample.h"
+#include "libkwave/SampleArray.h"
 #include "libkwave/SampleFormat.h"
 #include "libkwave/SampleReader.h"
 #include "libkwave/Utils.h"
@@ -502,26 +506,51 @@ bool Kwave::WavEncoder::encode(QWidget *widget, Kwave::MultiTrackReader &src,
         malloc(buffer_frames * virtual_frame_size));
     if (!buffer) return false;
 
-    // read in from the sample readers
+    // dither for reducing the resolution, one per track, not needed
+    // for G.711 which has its own quantization
+    QList<Kwave::Dither *> dither_list;
+    if (compression == Kwave::Compression::NONE) {
+        for (unsigned int track = 0; track < tracks; track++) {
+            Kwave::Dither *dither = new(std::nothrow) Kwave::Dither(
+                bits, Kwave::Dither::defaultMode(),
+                Kwave::Dither::defaultShaping(), track);
+            if (!dither || !dither->isActive()) {
+                delete dither;
+                break;
+            }
+            dither_list.append(dither);
+        }
+    }
+
+    // read in from the sample readers, ahead of the output to the file
+    Kwave::ReadAhead read_ahead(src, length, buffer_frames);
+    Kwave::ReadAhead::Block block;
     sample_index_t rest = length;
+    bool result = true;
     while (rest) {
+        unsigned int count = read_ahead.read(block);
+        if (!count) {
+            if (src.isCanceled()) break;
+            Kwave::MessageBox::error(widget, i18n("Out of memory"));
+            result = false;
+            break;
+        }
+
         // merge the tracks into the sample buffer
-        sample_storage_t *p = buffer;
-        unsigned int count = buffer_frames;
-        if (rest < count) count = Kwave::toUint(rest);
-
-        for (unsigned int pos = 0; pos < count; pos++) {
-            for (unsigned int track = 0; track < tracks; track++) {
-                Kwave::SampleReader *stream = src[track];
-                sample_t sample = 0;
-                if (stream && !stream->eof()) (*stream) >> sample;
-
-                // the following cast is only necessary if
-                // sample_t is not equal to sample_storage_t
-                sample_storage_t act = static_cast<sample_storage_t>(sample);
+        for (unsigned int track = 0; track < tracks; track++) {
+            Kwave::SampleArray &in_buffer = block[track];
+            if (track < Kwave::toUint(dither_list.count()))
+                dither_list[track]->process(in_buffer.data(), count);
+
+            // the following cast is only necessary if
+            // sample_t is not equal to sample_storage_t
+            const Kwave::SampleArray &in = in_buffer;
+            sample_storage_t *p = buffer + track;
+            for (unsigned int pos = 0; pos < count; pos++) {
+                sample_storage_t act = static_cast<sample_storage_t>(in[pos]);
                 act *= (1 << (SAMPLE_STORAGE_BITS - SAMPLE_BITS));
                 *p = act;
-                p++;
+                p += tracks;
             }
         }
 
@@ -546,6 +575,7 @@ bool Kwave::WavEncoder::encode(QWidget *widget, Kwave::MultiTrackReader &src,
 
     // clean up the sample buffer
     free(buffer);
+    qDeleteAll(dither_list);
     afFreeFileSetup(setup);
 
     // due to a buggy implementation of libaudiofile
@@ -558,7 +588,7 @@ bool Kwave::WavEncoder::encode(QWidget *widget, Kwave::MultiTrackReader &src,
     // write the labels list
     writeLabels(dst, Kwave::LabelList(meta_data));
 
-    return true;
+    return result;
 }
 
 /***************************************************************************/
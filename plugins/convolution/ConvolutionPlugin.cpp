@@ -0,0 +1,342 @@
+/***************************************************************************
+  ConvolutionPlugin.cpp  -  convolution with an impulse response from a file
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <algorithm>
+#include <errno.h>
+#include <math.h>
+#include <new>
+
+#include <QApplication>
+#include <QCursor>
+#include <QFile>
+#include <QPointer>
+#include <QUrl>
+
+#include <KLocalizedString>
+
+#include "libkwave/CodecManager.h"
+#include "libkwave/Connect.h"
+#include "libkwave/Decoder.h"
+#include "libkwave/FileInfo.h"
+#include "libkwave/MessageBox.h"
+#include "libkwave/MultiStreamWriter.h"
+#include "libkwave/MultiTrackSource.h"
+#include "libkwave/MultiWriter.h"
+#include "libkwave/Parser.h"
+#include "libkwave/STFT.h"
+#include "libkwave/String.h"
+#include "libkwave/Utils.h"
+#include "libkwave/Writer.h"
+#include "libkwave/modules/Convolver.h"
+#include "libkwave/modules/RateConverter.h"
+
+#include "libgui/FileDialog.h"
+
+#include "ConvolutionPlugin.h"
+
+KWAVE_PLUGIN(convolution, ConvolutionPlugin)
+
+/** maximum length of an impulse response [seconds] */
+#define MAX_RESPONSE_SECONDS 60
+
+namespace
+{
+    /** writer that appends the decoded samples to a vector */
+    class ResponseWriter: public Kwave::Writer
+    {
+    public:
+        /** Constructor, takes the vector that receives the samples */
+        explicit ResponseWriter(QVector<double> &response)
+            :Kwave::Writer(), m_response(response)
+        {
+        }
+
+        /** @see Kwave::Writer::write */
+        bool write(const Kwave::SampleArray &buffer,
+                   unsigned int &count) override
+        {
+            const sample_t *src = buffer.constData();
+            for (unsigned int i = 0; i < count; ++i)
+                m_response.append(sample2double(src[i]));
+            m_position += count;
+            count = 0;
+            return true;
+        }
+
+    private:
+        /** vector that receives the samples */
+        QVector<double> &m_response;
+    };
+}
+
+//***************************************************************************
+Kwave::ConvolutionPlugin::ConvolutionPlugin(QObject *parent,
+                                            const QVariantList &args)
+    :Kwave::FilterPlugin(parent, args),
+     m_filename(), m_mix(100.0), m_normalize(true), m_last_mix(-1.0),
+     m_response()
+{
+}
+
+//***************************************************************************
+Kwave::ConvolutionPlugin::~ConvolutionPlugin()
+{
+}
+
+//***************************************************************************
+int Kwave::ConvolutionPlugin::interpreteParameters(QStringList &params)
+{
+    bool ok;
+
+    // convolution(file name [, mix [%] [, normalize]])
+    if ((params.count() < 1) || (params.count() > 3)) return -EINVAL;
+
+    m_filename = Kwave::Parser::unescape(params[0]);
+    if (!m_filename.length()) return -EINVAL;
+
+    m_mix = 100.0;
+    if (params.count() >= 2) {
+        m_mix = params[1].toDouble(&ok);
+        Q_ASSERT(ok);
+        if (!ok || (m_mix < 0.0) || (m_mix > 100.0)) return -EINVAL;
+    }
+
+    m_normalize = true;
+    if (params.count() >= 3) {
+        m_normalize = (params[2].toUInt(&ok) != 0);
+        Q_ASSERT(ok);
+        if (!ok) return -EINVAL;
+    }
+
+    return 0;
+}
+
+//***************************************************************************
+QStringList *Kwave::ConvolutionPlugin::setup(QStringList &previous_params)
+{
+    // try to interpret the previous parameters
+    QUrl last_url;
+    if (!interpreteParameters(previous_params))
+        last_url = Kwave::URLfromUserInput(m_filename);
+
+    QPointer<Kwave::FileDialog> dlg = new(std::nothrow) Kwave::FileDialog(
+        _("kfiledialog:///kwave_impulse_response_dir"),
+        Kwave::FileDialog::OpenFile, Kwave::CodecManager::decodingFilter(),
+        parentWidget(), last_url);
+    if (!dlg) return nullptr;
+    dlg->setWindowTitle(i18n("Select Impulse Response"));
+    if (dlg->exec() != QDialog::Accepted) {
+        delete dlg;
+        return nullptr;
+    }
+    const QUrl url = dlg->selectedUrl();
+    delete dlg;
+
+    QStringList *list = new(std::nothrow) QStringList();
+    Q_ASSERT(list);
+    if (!list) return nullptr;
+
+    *list << Kwave::Parser::escape(url.toLocalFile());
+    *list << QString::number(m_mix);
+    *list << QString::number(m_normalize ? 1 : 0);
+    return list;
+}
+
+//***************************************************************************
+int Kwave::ConvolutionPlugin::start(QStringList &params)
+{
+    // in pre-listen mode the parameters are empty, use the last ones
+    if (!params.isEmpty()) {
+        int result = interpreteParameters(params);
+        if (result) return result;
+    }
+
+    int result = loadResponse();
+    if (result) {
+        Kwave::MessageBox::error(parentWidget(),
+            i18n("Unable to load the impulse response from '%1'",
+                 m_filename));
+        return result;
+    }
+
+    return Kwave::FilterPlugin::start(params);
+}
+
+//***************************************************************************
+int Kwave::ConvolutionPlugin::loadResponse()
+{
+    m_response.clear();
+
+    const QUrl url = Kwave::URLfromUserInput(m_filename);
+    Kwave::Decoder *decoder = Kwave::CodecManager::decoder(
+        Kwave::CodecManager::mimeTypeOf(url));
+    if (!decoder) return -EINVAL;
+
+    QFile src(url.toLocalFile());
+    if (!decoder->open(parentWidget(), src)) {
+        delete decoder;
+        return -EIO;
+    }
+
+    const Kwave::FileInfo info(decoder->metaData());
+    const unsigned int tracks = info.tracks();
+    const double src_rate = info.rate();
+    const double dst_rate = signalRate();
+    if (!tracks || (info.length() > MAX_RESPONSE_SECONDS * src_rate)) {
+        decoder->close();
+        delete decoder;
+        return -EINVAL;
+    }
+
+    // decoder -> [adapter -> rate converter] -> vectors
+    for (unsigned int track = 0; track < tracks; ++track)
+        m_response.append(QVector<double>());
+    Kwave::MultiWriter sink;
+    bool ok = true;
+    for (unsigned int track = 0; ok && (track < tracks); ++track) {
+        ResponseWriter *writer =
+            new(std::nothrow) ResponseWriter(m_response[track]);
+        Q_ASSERT(writer);
+        ok = (writer) && sink.insert(track, writer);
+    }
+
+    QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+    if (ok && !qFuzzyCompare(src_rate, dst_rate) && (dst_rate > 1)) {
+        Kwave::MultiStreamWriter adapter(tracks);
+        Kwave::MultiTrackSource<Kwave::RateConverter, true>
+            rate_converter(tracks);
+        rate_converter.setAttribute(SLOT(setRatio(QVariant)),
+                                    QVariant(dst_rate / src_rate));
+        ok = Kwave::connect(
+            adapter,        SIGNAL(output(Kwave::SampleArray)),
+            rate_converter, SLOT(input(Kwave::SampleArray))) &&
+             Kwave::connect(
+            rate_converter, SIGNAL(output(Kwave::SampleArray)),
+            sink,           SLOT(input(Kwave::SampleArray)));
+        if (ok) ok = decoder->decode(parentWidget(), adapter);
+        adapter.flush();
+    } else if (ok) {
+        ok = decoder->decode(parentWidget(), sink);
+    }
+    sink.flush();
+    QApplication::restoreOverrideCursor();
+
+    decoder->close();
+    delete decoder;
+    if (!ok || m_response.isEmpty() || m_response.first().isEmpty()) {
+        m_response.clear();
+        return -EIO;
+    }
+
+    // scale to a gain of 0 dB at the loudest frequency, the same for
+    // all tracks, so that the balance of the tracks is kept
+    if (m_normalize) {
+        int length = 0;
+        foreach (const QVector<double> &response, m_response)
+            length = qMax(length, Kwave::toInt(response.count()));
+        unsigned int points = 2;
+        while (points < Kwave::toUint(2 * length)) points <<= 1;
+
+        Kwave::STFT stft(points, Kwave::WINDOW_FUNC_NONE, points, 1);
+        QVector<double> frame(Kwave::toInt(points));
+        QVector<Kwave::STFT::Complex> spectrum(Kwave::toInt(stft.bins()));
+        double max = 0.0;
+        foreach (const QVector<double> &response, m_response) {
+            frame.fill(0.0);
+            std::copy(response.constBegin(), response.constEnd(),
+                      frame.begin());
+            if (!stft.forward(frame.constData(), 1, spectrum.data()))
+                break;
+            for (const Kwave::STFT::Complex &c : spectrum)
+                max = qMax(max, Kwave::STFT::power(c));
+        }
+        if (max > 0.0) {
+            const double scale = 1.0 / sqrt(max);
+            for (QVector<double> &response : m_response)
+                for (double &v : response) v *= scale;
+        }
+    }
+
+    return 0;
+}
+
+//***************************************************************************
+Kwave::PluginSetupDialog *Kwave::ConvolutionPlugin::createDialog(QWidget *)
+{
+    return nullptr;
+}
+
+//***************************************************************************
+Kwave::SampleSource *Kwave::ConvolutionPlugin::createFilter(
+    unsigned int tracks)
+{
+    if (m_response.isEmpty()) return nullptr;
+
+    Kwave::MultiTrackSource<Kwave::Convolver, false> *filter =
+        new(std::nothrow) Kwave::MultiTrackSource<Kwave::Convolver, false>(
+            0, nullptr);
+    Q_ASSERT(filter);
+    if (!filter) return nullptr;
+
+    for (unsigned int track = 0; track < tracks; ++track) {
+        const int index = (Kwave::toInt(track) < m_response.count()) ?
+            Kwave::toInt(track) : 0;
+        Kwave::Convolver *convolver =
+            new(std::nothrow) Kwave::Convolver(m_response[index]);
+        Q_ASSERT(convolver);
+        if (!convolver) {
+            delete filter;
+            return nullptr;
+        }
+        filter->insert(track, convolver);
+    }
+    return filter;
+}
+
+//***************************************************************************
+bool Kwave::ConvolutionPlugin::paramsChanged()
+{
+    return (!qFuzzyCompare(m_mix, m_last_mix));
+}
+
+//***************************************************************************
+void Kwave::ConvolutionPlugin::updateFilter(Kwave::SampleSource *filter,
+                                            bool force)
+{
+    if (!filter) return;
+
+    if (!qFuzzyCompare(m_mix, m_last_mix) || force)
+        filter->setAttribute(SLOT(setMix(QVariant)),
+                             QVariant(m_mix / 100.0));
+
+    m_last_mix = m_mix;
+}
+
+//***************************************************************************
+QString Kwave::ConvolutionPlugin::actionName()
+{
+    return i18n("Convolution");
+}
+
+//***************************************************************************
+#include "ConvolutionPlugin.moc"
+//***************************************************************************
+//***************************************************************************
+
+#include "moc_ConvolutionPlugin.cpp"
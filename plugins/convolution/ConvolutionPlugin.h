@@ -0,0 +1,133 @@
+/***************************************************************************
+    ConvolutionPlugin.h  -  convolution with an impulse response from a file
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef CONVOLUTION_PLUGIN_H
+#define CONVOLUTION_PLUGIN_H
+
+#include "config.h"
+
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "libgui/FilterPlugin.h"
+
+namespace Kwave
+{
+
+    class SampleSource;
+
+    /**
+     * Convolves the selection with an impulse response that is loaded
+     * from an audio file, e.g. a long linear phase FIR filter or the
+     * response of a room for a reverb. The file is decoded with the
+     * decoders of the CodecManager and resampled to the rate of the
+     * signal if necessary. Track N of the selection uses track N of
+     * the impulse response, or the first one if the file has less tracks.
+     */
+    class ConvolutionPlugin: public Kwave::FilterPlugin
+    {
+        Q_OBJECT
+    public:
+
+        /**
+         * Constructor
+         * @param parent reference to our plugin manager
+         * @param args argument list [unused]
+         */
+        ConvolutionPlugin(QObject *parent, const QVariantList &args);
+
+        /** Destructor */
+        ~ConvolutionPlugin() override;
+
+        /**
+         * Lets the user select the file with the impulse response
+         * @param previous_params the parameters of the last call
+         * @return list of new parameters or null if canceled
+         */
+        QStringList *setup(QStringList &previous_params) override;
+
+        /**
+         * Loads the impulse response and starts the filter
+         * @param params list of strings with parameters
+         * @return zero if successful or negative error code
+         */
+        int start(QStringList &params) override;
+
+        /** not used, the setup only consists of a file dialog */
+        Kwave::PluginSetupDialog *createDialog(QWidget *parent) override;
+
+        /** Creates one convolver per track */
+        Kwave::SampleSource *createFilter(unsigned int tracks) override;
+
+        /**
+         * Returns true if the parameters have changed during pre-listen.
+         */
+        bool paramsChanged() override;
+
+        /**
+         * Update the filter with new parameters if it has changed
+         * changed during the pre-listen.
+         * @param filter the Kwave::SampleSource to be updated
+         * @param force if true, even update if no settings have changed
+         */
+        void updateFilter(Kwave::SampleSource *filter,
+                          bool force = false) override;
+
+        /**
+         * Returns a verbose name of the performed action. Used for giving
+         * the undo action a readable name.
+         */
+        QString actionName() override;
+
+    protected:
+
+        /** reads values from the parameter list */
+        int interpreteParameters(QStringList &params) override;
+
+        /**
+         * Decodes the file with the impulse response
+         * @return zero if successful or negative error code
+         */
+        int loadResponse();
+
+    private:
+
+        /** name of the file with the impulse response */
+        QString m_filename;
+
+        /** portion of the convolved signal [0 ... 100 %] */
+        double m_mix;
+
+        /** if true, scale the response to a maximum gain of 0 dB */
+        bool m_normalize;
+
+        /** last value of m_mix */
+        double m_last_mix;
+
+        /** the impulse response, one vector per track of the file */
+        QList<QVector<double> > m_response;
+
+    };
+}
+
+#endif /* CONVOLUTION_PLUGIN_H */
+
+//***************************************************************************
+//***************************************************************************
@@ -43,6 +43,7 @@
 #include <KLazyLocalizedString>
 #include <KLocalizedString> // for the i18n macro
 
+#include "libkwave/LabelList.h"
 #include "libkwave/Logger.h"
 #include "libkwave/MultiTrackReader.h"
 #include "libkwave/MultiTrackWriter.h"
@@ -56,6 +57,7 @@
 #include "libgui/SelectTimeWidget.h" // for selection mode
 
 #include "DebugPlugin.h"
+#include "ProfilerDialog.h"
 
 KWAVE_PLUGIN(debug, DebugPlugin)
 
@@ -111,6 +113,10 @@ void Kwave::DebugPlugin::load(QStringList &params)
     entry = _("menu(plugin:setup(debug,%1),Help/%2)");
     MENU_ENTRY("dump_windows",
                _(kli18n("Dump Window Hierarchy").untranslatedText()))
+    MENU_ENTRY("memory_usage",
+               _(kli18n("Dump Memory Usage").untranslatedText()))
+    MENU_ENTRY("profile",
+               _(kli18n("Profiling...").untranslatedText()))
 
     entry = _("menu(%1,Help/%2)");
     MENU_ENTRY("dump_metadata()",
@@ -132,6 +138,19 @@ QStringList *Kwave::DebugPlugin::setup(QStringList &params)
 
     if (command == _("dump_windows")) {
         dump_children(parentWidget(), _(""));
+    } else if (command == _("memory_usage")) {
+        // sample data that is shared with the undo buffer or readers
+        // versus sample data only used by the signal
+        quint64 shared    = 0;
+        quint64 exclusive = 0;
+        signalManager().memoryUsage(shared, exclusive);
+        qDebug("memory usage of samples: %llu bytes shared, "
+               "%llu bytes private",
+               static_cast<unsigned long long>(shared),
+               static_cast<unsigned long long>(exclusive));
+    } else if (command == _("profile")) {
+        Kwave::ProfilerDialog dialog(parentWidget());
+        dialog.exec();
     } else if (command == _("window:click")) {
         if (params.count() != 4) return nullptr;
         QString    class_name = params[1];
@@ -263,6 +282,7 @@ void Kwave::DebugPlugin::run(QStringList params)
         if (all_stripes.isEmpty()) return;
 
         const Kwave::Stripe::List &stripes = all_stripes.first();
+        Kwave::LabelList labels;
         unsigned int index = 0;
         foreach (const Kwave::Stripe &stripe, stripes) {
             QString text;
@@ -270,11 +290,12 @@ void Kwave::DebugPlugin::run(QStringList params)
                 arg(index++).
                 arg(stripe.start()).
                 arg(stripe.end());
-            sig.addLabel(stripe.start(), text);
+            labels.append(Kwave::Label(stripe.start(), text));
         }
+        sig.addLabels(labels);
         return;
     } else if (command == _("dump_metadata")) {
-        sig.metaData().dump();
+        std::as_const(sig).metaData().dump();
         return;
     } else if (command == _("sawtooth_verify")) {
         Kwave::MultiTrackReader *readers = new(std::nothrow)
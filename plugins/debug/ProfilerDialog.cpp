@@ -0,0 +1,174 @@
+/***************************************************************************
+     ProfilerDialog.cpp  -  dialog for showing the profiling results
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <new>
+
+#include <QDialogButtonBox>
+#include <QHeaderView>
+#include <QMap>
+#include <QPushButton>
+#include <QTimer>
+#include <QTreeWidget>
+#include <QTreeWidgetItem>
+#include <QVBoxLayout>
+
+#include <KLocalizedString>
+
+#include "libkwave/Profiler.h"
+#include "libkwave/String.h"
+
+#include "ProfilerDialog.h"
+
+/** interval of the automatic refresh [ms] */
+#define REFRESH_INTERVAL 1000
+
+//***************************************************************************
+Kwave::ProfilerDialog::ProfilerDialog(QWidget *parent)
+    :QDialog(parent), m_view(nullptr), m_enable(nullptr), m_timer(nullptr)
+{
+    setWindowTitle(i18n("Profiling"));
+
+    QVBoxLayout *layout = new(std::nothrow) QVBoxLayout(this);
+    Q_ASSERT(layout);
+    if (!layout) return;
+
+    m_view = new(std::nothrow) QTreeWidget(this);
+    Q_ASSERT(m_view);
+    if (!m_view) return;
+    m_view->setRootIsDecorated(true);
+    m_view->setSortingEnabled(true);
+    m_view->setHeaderLabels(QStringList()
+        << i18n("Name")
+        << i18n("Calls / Value")
+        << i18n("Total [ms]")
+        << i18n("Average [ms]")
+        << i18n("Maximum [ms]"));
+    m_view->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    layout->addWidget(m_view);
+
+    QDialogButtonBox *buttons = new(std::nothrow)
+        QDialogButtonBox(QDialogButtonBox::Close, this);
+    Q_ASSERT(buttons);
+    if (!buttons) return;
+    m_enable = buttons->addButton(QString(), QDialogButtonBox::ActionRole);
+    QPushButton *reset_button =
+        buttons->addButton(i18n("Reset"), QDialogButtonBox::ResetRole);
+    QPushButton *refresh_button =
+        buttons->addButton(i18n("Refresh"), QDialogButtonBox::ActionRole);
+    layout->addWidget(buttons);
+
+    connect(m_enable,       SIGNAL(clicked()), this, SLOT(toggle()));
+    connect(reset_button,   SIGNAL(clicked()), this, SLOT(reset()));
+    connect(refresh_button, SIGNAL(clicked()), this, SLOT(refresh()));
+    connect(buttons,        SIGNAL(rejected()), this, SLOT(reject()));
+
+    m_timer = new(std::nothrow) QTimer(this);
+    Q_ASSERT(m_timer);
+    if (m_timer) {
+        connect(m_timer, SIGNAL(timeout()), this, SLOT(refresh()));
+        m_timer->start(REFRESH_INTERVAL);
+    }
+
+    resize(640, 480);
+    updateButton();
+    refresh();
+}
+
+//***************************************************************************
+Kwave::ProfilerDialog::~ProfilerDialog()
+{
+}
+
+//***************************************************************************
+void Kwave::ProfilerDialog::refresh()
+{
+    if (!m_view) return;
+
+    // remember which branches are collapsed
+    QStringList collapsed;
+    for (int i = 0; i < m_view->topLevelItemCount(); ++i) {
+        QTreeWidgetItem *item = m_view->topLevelItem(i);
+        if (item && !item->isExpanded()) collapsed.append(item->text(0));
+    }
+
+    m_view->setUpdatesEnabled(false);
+    m_view->clear();
+
+    QTreeWidgetItem *timings = new(std::nothrow)
+        QTreeWidgetItem(m_view, QStringList(i18n("Timings")));
+    const QMap<QString, Kwave::Profiler::Timing> t =
+        Kwave::Profiler::timings();
+    for (auto it = t.constBegin(); timings && (it != t.constEnd()); ++it) {
+        const Kwave::Profiler::Timing &timing = it.value();
+        const double total = static_cast<double>(timing.total_us) / 1E3;
+        const double avg   = (timing.calls) ?
+            (total / static_cast<double>(timing.calls)) : 0.0;
+        QTreeWidgetItem *item = new(std::nothrow) QTreeWidgetItem(timings);
+        if (!item) break;
+        item->setText(0, it.key());
+        item->setText(1, QString::number(timing.calls));
+        item->setText(2, QString::number(total, 'f', 3));
+        item->setText(3, QString::number(avg, 'f', 3));
+        item->setText(4, QString::number(
+            static_cast<double>(timing.max_us) / 1E3, 'f', 3));
+    }
+
+    QTreeWidgetItem *counters = new(std::nothrow)
+        QTreeWidgetItem(m_view, QStringList(i18n("Counters")));
+    const QMap<QString, qint64> c = Kwave::Profiler::counters();
+    for (auto it = c.constBegin(); counters && (it != c.constEnd()); ++it) {
+        QTreeWidgetItem *item = new(std::nothrow) QTreeWidgetItem(counters);
+        if (!item) break;
+        item->setText(0, it.key());
+        item->setText(1, QString::number(it.value()));
+    }
+
+    for (int i = 0; i < m_view->topLevelItemCount(); ++i) {
+        QTreeWidgetItem *item = m_view->topLevelItem(i);
+        if (item) item->setExpanded(!collapsed.contains(item->text(0)));
+    }
+    m_view->setUpdatesEnabled(true);
+}
+
+//***************************************************************************
+void Kwave::ProfilerDialog::toggle()
+{
+    Kwave::Profiler::setEnabled(!Kwave::Profiler::isEnabled());
+    updateButton();
+}
+
+//***************************************************************************
+void Kwave::ProfilerDialog::reset()
+{
+    Kwave::Profiler::reset();
+    refresh();
+}
+
+//***************************************************************************
+void Kwave::ProfilerDialog::updateButton()
+{
+    if (!m_enable) return;
+    m_enable->setText((Kwave::Profiler::isEnabled()) ?
+        i18n("Disable") : i18n("Enable"));
+}
+
+//***************************************************************************
+//***************************************************************************
+
+#include "moc_ProfilerDialog.cpp"
@@ -0,0 +1,84 @@
+/***************************************************************************
+       ProfilerDialog.h  -  dialog for showing the profiling results
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef PROFILER_DIALOG_H
+#define PROFILER_DIALOG_H
+
+#include "config.h"
+
+#include <QDialog>
+#include <QObject>
+
+class QPushButton;
+class QTimer;
+class QTreeWidget;
+class QWidget;
+
+namespace Kwave
+{
+    /**
+     * Shows the timings and counters collected by Kwave::Profiler and
+     * lets the user enable, disable and reset the profiling.
+     */
+    class ProfilerDialog: public QDialog
+    {
+        Q_OBJECT
+    public:
+
+        /**
+         * Constructor
+         * @param parent the parent widget
+         */
+        explicit ProfilerDialog(QWidget *parent);
+
+        /** Destructor */
+        ~ProfilerDialog() override;
+
+    private slots:
+
+        /** fills the list with the current values */
+        void refresh();
+
+        /** toggles profiling on/off */
+        void toggle();
+
+        /** discards all collected values */
+        void reset();
+
+    private:
+
+        /** updates the text of the enable/disable button */
+        void updateButton();
+
+    private:
+
+        /** list of timings and counters */
+        QTreeWidget *m_view;
+
+        /** button for enabling/disabling the profiler */
+        QPushButton *m_enable;
+
+        /** timer for periodic refresh */
+        QTimer *m_timer;
+
+    };
+}
+
+#endif /* PROFILER_DIALOG_H */
+
+//***************************************************************************
+//***************************************************************************
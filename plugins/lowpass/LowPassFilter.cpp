@@ -22,11 +22,14 @@
 #include <complex>
 #include <math.h>
 
+#include "libkwave/Sample.h"
+#include "libkwave/Utils.h"
+
 #include "LowPassFilter.h"
 
 //***************************************************************************
 Kwave::LowPassFilter::LowPassFilter()
-    :Kwave::SampleSource(nullptr), m_buffer(blockSize()),
+    :Kwave::SampleSource(nullptr), m_buffer(blockSize()), m_float(),
     m_f_cutoff(M_PI)
 {
     initFilter();
@@ -138,28 +141,47 @@ void Kwave::LowPassFilter::normed_setfilter_shelvelowpass(double freq)
 void Kwave::LowPassFilter::input(Kwave::SampleArray data)
 {
     const Kwave::SampleArray &in = data;
-    bool ok = m_buffer.resize(in.size());
+    const unsigned int len = in.size();
+    bool ok = m_buffer.reuse(len);
     Q_ASSERT(ok);
     Q_UNUSED(ok)
+    if (Kwave::toUint(m_float.size()) < len)
+        m_float.resize(Kwave::toInt(len));
 
     normed_setfilter_shelvelowpass(m_f_cutoff);
 
-    for (unsigned i = 0; i < in.size(); i++)
-    {
+    // work on a block of floats, the filter state stays in double
+    // precision and in local variables during the loop
+    float *f = m_float.data();
+    samples2floats(in.constData(), f, len);
+
+    const double cx  = m_filter.cx;
+    const double cx1 = m_filter.cx1;
+    const double cx2 = m_filter.cx2;
+    const double cy1 = m_filter.cy1;
+    const double cy2 = m_filter.cy2;
+    double x1 = m_filter.x1;
+    double x2 = m_filter.x2;
+    double y1 = m_filter.y1;
+    double y2 = m_filter.y2;
+    for (unsigned int i = 0; i < len; i++) {
         // do the filtering
-        m_filter.x = sample2double(in[i]);
-        m_filter.y =
-            m_filter.cx  * m_filter.x  +
-            m_filter.cx1 * m_filter.x1 +
-            m_filter.cx2 * m_filter.x2 +
-            m_filter.cy1 * m_filter.y1 +
-            m_filter.cy2 * m_filter.y2;
-        m_filter.x2 = m_filter.x1;
-        m_filter.x1 = m_filter.x;
-        m_filter.y2 = m_filter.y1;
-        m_filter.y1 = m_filter.y;
-        m_buffer[i] = double2sample(0.95 * m_filter.y);
+        const double x = static_cast<double>(f[i]);
+        const double y = cx * x + cx1 * x1 + cx2 * x2 + cy1 * y1 + cy2 * y2;
+        x2 = x1;
+        x1 = x;
+        y2 = y1;
+        y1 = y;
+        f[i] = static_cast<float>(0.95 * y);
     }
+    m_filter.x  = x1;
+    m_filter.x1 = x1;
+    m_filter.x2 = x2;
+    m_filter.y  = y1;
+    m_filter.y1 = y1;
+    m_filter.y2 = y2;
+
+    floats2samples(f, m_buffer.data(), len);
 }
 
 //***************************************************************************
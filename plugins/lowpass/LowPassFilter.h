@@ -22,6 +22,7 @@
 
 #include <QObject>
 #include <QVariant>
+#include <QVector>
 
 #include "libkwave/SampleArray.h"
 #include "libkwave/SampleSource.h"
@@ -77,6 +78,9 @@ namespace Kwave
         /** buffer for input */
         Kwave::SampleArray m_buffer;
 
+        /** the current block, converted to floats */
+        QVector<float> m_float;
+
         /** cutoff frequency [0...PI] */
         double m_f_cutoff;
 
@@ -18,6 +18,7 @@
 #include "config.h"
 
 #include <QtGlobal>
+#include <QRandomGenerator>
 
 #include "NoiseGenerator.h"
 #include "libkwave/Sample.h"
@@ -25,8 +26,10 @@
 //***************************************************************************
 Kwave::NoiseGenerator::NoiseGenerator(QObject *parent)
     :Kwave::SampleSource(parent),
-     m_random(),
+     m_random(QRandomGenerator::global()->generate()),
      m_buffer(blockSize()),
+     m_input(),
+     m_noise(),
      m_noise_level(1.0)
 {
 }
@@ -45,23 +48,25 @@ void Kwave::NoiseGenerator::goOn()
 //***************************************************************************
 void Kwave::NoiseGenerator::input(Kwave::SampleArray data)
 {
-    bool ok = m_buffer.resize(data.size());
+    bool ok = m_buffer.reuse(data.size());
     Q_ASSERT(ok);
     Q_UNUSED(ok)
 
-    m_buffer = data;
+    const unsigned int count = data.size();
+    m_input.resize(count);
+    m_noise.resize(count);
+    samples2floats(data.constData(), m_input.data(), count);
+    m_random.generate(m_noise.data(), count);
 
-    const quint32 max  = m_random.max();
-    const quint32 m_2  = max / 2;
-    const double alpha = (1.0 - m_noise_level);
-    const double scale = (m_noise_level * 2.0) / static_cast<double>(max);
-    for (unsigned i = 0; i < data.size(); ++i) {
-        const Kwave::SampleArray &in = data;
-        m_buffer[i] = double2sample(
-            (sample2double(in[i]) * alpha) +
-            (qint32(m_random.generate() - m_2) * scale)
-        );
-    }
+    // mix the input with the noise
+    const float alpha = static_cast<float>(1.0 - m_noise_level);
+    const float level = static_cast<float>(m_noise_level);
+    float       *in    = m_input.data();
+    const float *noise = m_noise.constData();
+    for (unsigned int i = 0; i < count; ++i)
+        in[i] = (in[i] * alpha) + (noise[i] * level);
+
+    floats2samples(in, m_buffer.data(), count);
 }
 
 //***************************************************************************
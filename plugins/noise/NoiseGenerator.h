@@ -21,11 +21,12 @@
 #include "config.h"
 
 #include <QObject>
-#include <QRandomGenerator>
 #include <QVariant>
+#include <QVector>
 
 #include "libkwave/SampleArray.h"
 #include "libkwave/SampleSource.h"
+#include "libkwave/modules/RandomNoise.h"
 
 namespace Kwave
 {
@@ -64,11 +65,17 @@ namespace Kwave
     private:
 
         /** random generator for the noise */
-        QRandomGenerator m_random;
+        Kwave::RandomNoise m_random;
 
         /** buffer for input */
         Kwave::SampleArray m_buffer;
 
+        /** input, converted to floats */
+        QVector<float> m_input;
+
+        /** block of noise */
+        QVector<float> m_noise;
+
         /** noise level [0 .. 1.0] */
         double m_noise_level;
 
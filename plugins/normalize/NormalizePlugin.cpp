@@ -20,25 +20,32 @@
 
 #include "config.h"
 
+#include <errno.h>
 #include <math.h>
+
+#include <cmath>
+#include <limits>
 #include <new>
 
 #include <QFutureSynchronizer>
 #include <QList>
 #include <QStringList>
 #include <QThread>
-#include <QtConcurrentRun>
 
 #include <KLocalizedString> // for the i18n macro
 
 #include "libkwave/Connect.h"
 #include "libkwave/FileInfo.h"
+#include "libkwave/MessageBox.h"
 #include "libkwave/MultiTrackReader.h"
 #include "libkwave/MultiTrackWriter.h"
 #include "libkwave/PluginManager.h"
 #include "libkwave/SignalManager.h"
+#include "libkwave/String.h"
+#include "libkwave/TaskPool.h"
 #include "libkwave/Utils.h"
 #include "libkwave/Writer.h"
+#include "libkwave/modules/LoudnessMeter.h"
 #include "libkwave/undo/UndoTransactionGuard.h"
 
 #include "NormalizePlugin.h"
@@ -50,12 +57,19 @@
 /** target volume level [dB] */
 #define TARGET_LEVEL -12
 
+/** default target loudness, after EBU R128 [LUFS] */
+#define DEFAULT_LOUDNESS -23.0
+
+/** default maximum true peak level, after EBU R128 [dBTP] */
+#define DEFAULT_TRUE_PEAK -1.0
+
 KWAVE_PLUGIN(normalize, NormalizePlugin)
 
 //***************************************************************************
 Kwave::NormalizePlugin::NormalizePlugin(QObject *parent,
                                         const QVariantList &args)
-    :Kwave::Plugin(parent, args)
+    :Kwave::Plugin(parent, args), m_mode(Rms),
+     m_target(DEFAULT_LOUDNESS), m_ceiling(DEFAULT_TRUE_PEAK)
 {
 }
 
@@ -64,11 +78,65 @@ Kwave::NormalizePlugin::~NormalizePlugin()
 {
 }
 
+//***************************************************************************
+int Kwave::NormalizePlugin::interpreteParameters(QStringList &params)
+{
+    bool ok = true;
+
+    // normalize([rms | lufs[, <target LUFS>[, <ceiling dBTP>]] | measure])
+    m_mode    = Rms;
+    m_target  = DEFAULT_LOUDNESS;
+    m_ceiling = DEFAULT_TRUE_PEAK;
+    if (params.isEmpty()) return 0;
+
+    const QString mode = params[0];
+    if (mode == _("rms")) {
+        m_mode = Rms;
+        if (params.count() != 1) return -EINVAL;
+    } else if (mode == _("measure")) {
+        m_mode = Measure;
+        if (params.count() != 1) return -EINVAL;
+    } else if (mode == _("lufs")) {
+        m_mode = Loudness;
+        if (params.count() > 3) return -EINVAL;
+        if (params.count() > 1) {
+            m_target = params[1].toDouble(&ok);
+            Q_ASSERT(ok);
+            if (!ok || (m_target > 0.0)) return -EINVAL;
+        }
+        if (params.count() > 2) {
+            m_ceiling = params[2].toDouble(&ok);
+            Q_ASSERT(ok);
+            if (!ok || (m_ceiling > 0.0)) return -EINVAL;
+        }
+    } else {
+        return -EINVAL;
+    }
+
+    return 0;
+}
+
+//***************************************************************************
+int Kwave::NormalizePlugin::start(QStringList &params)
+{
+    int result = interpreteParameters(params);
+    if (result) return result;
+
+    return Kwave::Plugin::start(params);
+}
+
+//***************************************************************************
+/** formats a loudness value for the user, silence has no loudness */
+static QString lufs(double value)
+{
+    if (std::isinf(value)) return _("-inf");
+    return QString::number(value, 'f', 1);
+}
+
 //***************************************************************************
 void Kwave::NormalizePlugin::run(QStringList params)
 {
-    Q_UNUSED(params)
-    Kwave::UndoTransactionGuard undo_guard(*this, i18n("Normalize"));
+    if (interpreteParameters(params)) return;
 
     // get the current selection
     QVector<unsigned int> tracks;
@@ -77,8 +145,8 @@ void Kwave::NormalizePlugin::run(QStringList params)
     sample_index_t length = selection(&tracks, &first, &last, true);
     if (!length || tracks.isEmpty()) return;
 
-    // get the current volume level
-    double level = 0.0;
+    // get the current volume or loudness level
+    double gain = 1.0;
     {
         Kwave::MultiTrackReader src(Kwave::SinglePassForward,
             signalManager(), tracks, first, last);
@@ -88,13 +156,56 @@ void Kwave::NormalizePlugin::run(QStringList params)
                 this,  SLOT(updateProgress(qreal)),
                 Qt::BlockingQueuedConnection);
 
-        // detect the peak value
-        emit setProgressText(i18n("Analyzing volume level..."));
-//         qDebug("NormalizePlugin: getting peak...");
-        level = getMaxPower(src);
-//         qDebug("NormalizePlugin: level is %g", level);
+        if (m_mode == Rms) {
+            // detect the peak value
+            emit setProgressText(i18n("Analyzing volume level..."));
+//             qDebug("NormalizePlugin: getting peak...");
+            double level = getMaxPower(src);
+//             qDebug("NormalizePlugin: level is %g", level);
+
+            double target = pow(10.0, (TARGET_LEVEL / 20.0));
+            gain = target / level;
+        } else {
+            emit setProgressText(i18n("Analyzing loudness..."));
+            Kwave::LoudnessMeter meter(signalRate(),
+                static_cast<unsigned int>(tracks.count()));
+            measureLoudness(src, meter);
+            if (shouldStop()) return;
+
+            const double integrated = meter.integrated();
+            const double peak       = meter.truePeak();
+
+            if (m_mode == Measure) {
+                Kwave::MessageBox::information(parentWidget(), i18n(
+                    "Integrated loudness: %1 LUFS\n"
+                    "Loudness range: %2 LU\n"
+                    "True peak: %3 dBTP\n"
+                    "Maximum momentary loudness: %4 LUFS\n"
+                    "Maximum short term loudness: %5 LUFS",
+                    lufs(integrated),
+                    QString::number(meter.loudnessRange(), 'f', 1),
+                    lufs((peak > 0.0) ? (20.0 * log10(peak)) :
+                        -std::numeric_limits<double>::infinity()),
+                    lufs(meter.momentaryMax()),
+                    lufs(meter.shortTermMax())),
+                    i18n("Loudness"));
+                return;
+            }
+            if (std::isinf(integrated)) return; // nothing to normalize
+
+            // reach the target loudness, but stay below the true peak
+            // ceiling, the limiter is not used in this mode
+            gain = pow(10.0, (m_target - integrated) / 20.0);
+            const double ceiling = pow(10.0, m_ceiling / 20.0);
+            if ((peak > 0.0) && (peak * gain > ceiling)) {
+                gain = ceiling / peak;
+                qDebug("NormalizePlugin: limited by true peak ceiling");
+            }
+        }
     }
 
+    Kwave::UndoTransactionGuard undo_guard(*this, i18n("Normalize"));
+
     Kwave::MultiTrackReader source(Kwave::SinglePassForward,
         signalManager(), tracks, first, last);
     Kwave::MultiTrackWriter sink(signalManager(), tracks, Kwave::Overwrite,
@@ -121,8 +232,6 @@ void Kwave::NormalizePlugin::run(QStringList params)
         return;
     }
 
-    double target = pow(10.0, (TARGET_LEVEL / 20.0));
-    double gain = target / level;
     qDebug("NormalizePlugin: gain=%g", gain);
 
     QString db;
@@ -130,6 +239,9 @@ void Kwave::NormalizePlugin::run(QStringList params)
         db.asprintf("%+0.1f", 20 * log10(gain))));
 
     normalizer.setAttribute(SLOT(setGain(QVariant)), QVariant(gain));
+    if (m_mode == Loudness)
+        normalizer.setAttribute(SLOT(setLimiterLevel(QVariant)),
+                                QVariant(1.0));
     while (!shouldStop() && !source.eof()) {
         source.goOn();
     }
@@ -164,7 +276,8 @@ double Kwave::NormalizePlugin::getMaxPower(Kwave::MultiTrackReader &source)
             if (!reader) continue;
             if (reader->eof()) continue;
 
-            synchronizer.addFuture(QtConcurrent::run(
+            synchronizer.addFuture(Kwave::TaskPool::run(
+                Kwave::TaskPool::Background,
                 &Kwave::NormalizePlugin::getMaxPowerOfTrack,
                 this,
                 reader, &(average[t]), window_size
@@ -200,6 +313,7 @@ void Kwave::NormalizePlugin::getMaxPowerOfTrack(
 {
     Kwave::NormalizePlugin::Average &average = *p_average;
     Kwave::SampleArray data(window_size);
+    QVector<float> f(Kwave::toInt(window_size));
     unsigned int round = 0;
     unsigned int loops = 5 * reader->blockSize() / window_size;
     loops++;
@@ -209,10 +323,10 @@ void Kwave::NormalizePlugin::getMaxPowerOfTrack(
 
         // calculate power of one block
         double sum = 0;
-        const Kwave::SampleArray &in = data;
+        samples2floats(data.constData(), f.data(), len);
+        const float *in = f.constData();
         for (unsigned int i = 0; i < len; i++) {
-            sample_t s = in[i];
-            double d   = sample2double(s);
+            const double d = static_cast<double>(in[i]);
             sum += (d * d);
         }
         double pow = sum / static_cast<double>(len);
@@ -235,6 +349,50 @@ void Kwave::NormalizePlugin::getMaxPowerOfTrack(
 //     qDebug("%p -> pos=%llu, max=%g", this, reader->pos(), average.max);
 }
 
+//***************************************************************************
+void Kwave::NormalizePlugin::measureLoudness(Kwave::MultiTrackReader &source,
+                                             Kwave::LoudnessMeter &meter)
+{
+    const unsigned int tracks = source.tracks();
+    Q_ASSERT(meter.channels() == tracks);
+    if (meter.channels() != tracks) return;
+
+    while (!shouldStop() && !source.eof()) {
+        QFutureSynchronizer<void> synchronizer;
+
+        for (unsigned int t = 0; t < tracks; t++) {
+            Kwave::SampleReader *reader = source[t];
+            if (!reader) continue;
+            if (reader->eof()) continue;
+
+            synchronizer.addFuture(Kwave::TaskPool::run(
+                Kwave::TaskPool::Background,
+                &Kwave::NormalizePlugin::measureLoudnessOfTrack,
+                this,
+                reader, &meter, t
+            ));
+        }
+        synchronizer.waitForFinished();
+    }
+}
+
+//***************************************************************************
+void Kwave::NormalizePlugin::measureLoudnessOfTrack(
+    Kwave::SampleReader *reader,
+    Kwave::LoudnessMeter *meter,
+    unsigned int track)
+{
+    const unsigned int block_size = reader->blockSize();
+    Kwave::SampleArray data(block_size);
+    unsigned int round = 0;
+
+    while ((round++ < 5) && !reader->eof()) {
+        unsigned int len = reader->read(data, 0, block_size);
+        if (!len) break;
+        meter->process(track, data.constData(), len);
+    }
+}
+
 //***************************************************************************
 #include "NormalizePlugin.moc"
 //***************************************************************************
@@ -33,12 +33,15 @@
 
 namespace Kwave
 {
+    class LoudnessMeter;
     class MultiTrackReader;
     class SampleReader;
 
     /**
      * This is a two-pass plugin that determines the average volume level
      * of a signal and then calls the volume plugin to adjust the volume.
+     * Instead of the smoothed RMS level it can also use the integrated
+     * loudness after ITU-R BS.1770 / EBU R128, or only measure it.
      */
     class NormalizePlugin: public Kwave::Plugin
     {
@@ -56,6 +59,13 @@ namespace Kwave
         /** Destructor */
         ~NormalizePlugin() override;
 
+        /**
+         * Checks the parameters and starts the worker thread
+         * @param params list of strings with parameters
+         * @return zero if successful or negative error code
+         */
+        int start(QStringList &params) override;
+
         /**
          * normalizes the volume
          * @param params list of strings with parameters
@@ -63,6 +73,20 @@ namespace Kwave
         void run(QStringList params) override;
 
     private:
+
+        /** what to measure, and whether to change the volume */
+        typedef enum {
+            Rms      = 0, /**< smoothed RMS, -12dB (default)        */
+            Loudness = 1, /**< integrated loudness, in LUFS          */
+            Measure  = 2  /**< only measure and show the loudness   */
+        } Mode;
+
+        /**
+         * reads values from the parameter list
+         * @param params list of strings with parameters
+         * @return zero if successful or negative error code
+         */
+        int interpreteParameters(QStringList &params);
         typedef struct {
             QVector<double> fifo; /**< FIFO for power values */
             unsigned int    wp;   /**< FIFO write pointer */
@@ -87,6 +111,36 @@ namespace Kwave
                                 Kwave::NormalizePlugin::Average *average,
                                 unsigned int window_size);
 
+        /**
+         * measure the loudness of all tracks, in one pass and with one
+         * thread per track
+         * @param source the tracks to measure
+         * @param meter the loudness meter, one channel per track
+         */
+        void measureLoudness(Kwave::MultiTrackReader &source,
+                             Kwave::LoudnessMeter &meter);
+
+        /**
+         * feed some blocks of one track into the loudness meter
+         * @param reader reference to a SampleReader to read from
+         * @param meter the loudness meter
+         * @param track index of the track within the meter
+         */
+        void measureLoudnessOfTrack(Kwave::SampleReader *reader,
+                                    Kwave::LoudnessMeter *meter,
+                                    unsigned int track);
+
+    private:
+
+        /** mode of operation */
+        Mode m_mode;
+
+        /** target loudness [LUFS] */
+        double m_target;
+
+        /** highest allowed true peak [dBTP] */
+        double m_ceiling;
+
     };
 }
 
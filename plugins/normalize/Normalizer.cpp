@@ -23,12 +23,13 @@
 #include <math.h>
 
 #include "libkwave/Sample.h"
+#include "libkwave/Utils.h"
 
 #include "Normalizer.h"
 
 //***************************************************************************
 Kwave::Normalizer::Normalizer()
-    :Kwave::SampleSource(nullptr), m_gain(1.0), m_limit(0.5)
+    :Kwave::SampleSource(nullptr), m_float(), m_gain(1.0), m_limit(0.5)
 {
 }
 
@@ -53,7 +54,8 @@ void Kwave::Normalizer::goOn()
  *        \ tanh((x - lev) / (1-lev)) * (1-lev) + lev        (for x > lev)
  *
  * With limiter level = 0, this is equivalent to a tanh() function;
- * with limiter level = 1, this is equivalent to clipping.
+ * with limiter level = 1, this is equivalent to clipping, which
+ * is what happens when the limiter is not used at all.
  */
 static inline double limiter(const double x, const double lmtr_lvl)
 {
@@ -73,15 +75,28 @@ static inline double limiter(const double x, const double lmtr_lvl)
 void Kwave::Normalizer::input(Kwave::SampleArray data)
 {
     const unsigned int len = data.size();
-    const bool use_limiter = (m_gain > 1.0);
-
-    for (unsigned int i = 0; i < len; i++) {
-        double s = sample2double(data[i]);
-        s *= m_gain;
-        if (use_limiter) s = limiter(s, m_limit);
-        data[i] = double2sample(s);
+    const bool use_limiter = (m_gain > 1.0) && (m_limit < 1.0);
+    if (Kwave::toUint(m_float.size()) < len)
+        m_float.resize(Kwave::toInt(len));
+
+    // amplify a whole block of floats, clipping happens only at the end
+    float *f = m_float.data();
+    samples2floats(data.constData(), f, len);
+    const float gain = static_cast<float>(m_gain);
+    for (unsigned int i = 0; i < len; i++)
+        f[i] *= gain;
+
+    // the limiter only touches samples above the limiter level
+    if (use_limiter) {
+        const float level = static_cast<float>(m_limit);
+        for (unsigned int i = 0; i < len; i++) {
+            if ((f[i] > level) || (f[i] < -level))
+                f[i] = static_cast<float>(limiter(f[i], m_limit));
+        }
     }
 
+    floats2samples(f, data.data(), len);
+
     emit output(data);
 }
 
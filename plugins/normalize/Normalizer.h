@@ -25,6 +25,7 @@
 
 #include <QObject>
 #include <QVariant>
+#include <QVector>
 
 #include "libkwave/SampleArray.h"
 #include "libkwave/SampleSource.h"
@@ -67,8 +68,8 @@ namespace Kwave
 
     private:
 
-        /** buffer for input */
-        Kwave::SampleArray m_buffer;
+        /** the current block, converted to floats */
+        QVector<float> m_float;
 
         /** gain */
         double m_gain;
@@ -120,7 +120,7 @@ void Kwave::NotchFilter::setfilter_peaknotch2(double freq, double bw)
 void Kwave::NotchFilter::input(Kwave::SampleArray data)
 {
     const Kwave::SampleArray &in = data;
-    bool ok = m_buffer.resize(in.size());
+    bool ok = m_buffer.reuse(in.size());
     Q_ASSERT(ok);
     Q_UNUSED(ok)
 
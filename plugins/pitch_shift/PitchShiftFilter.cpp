@@ -32,7 +32,7 @@
 
 //***************************************************************************
 Kwave::PitchShiftFilter::PitchShiftFilter()
-    :Kwave::SampleSource(nullptr), m_buffer(blockSize()),
+    :Kwave::SampleSource(nullptr), m_buffer(blockSize()), m_float(),
      m_speed(1.0), m_frequency(0.5), m_dbuffer(),
      m_lfopos(0), m_b1pos(0), m_b2pos(0), m_b1inc(0), m_b2inc(0),
      m_b1reset(false), m_b2reset(false), m_dbpos(0)
@@ -76,19 +76,27 @@ void Kwave::PitchShiftFilter::input(Kwave::SampleArray data)
 {
     const Kwave::SampleArray &in = data;
 
-    Q_ASSERT(Kwave::toInt(in.size()) <= m_dbuffer.size());
-    bool ok = m_buffer.resize(in.size());
+    const unsigned int len = in.size();
+    Q_ASSERT(Kwave::toInt(len) <= m_dbuffer.size());
+    bool ok = m_buffer.reuse(len);
     Q_ASSERT(ok);
     Q_UNUSED(ok)
 
+    // convert the whole block to floats and back, not sample by sample
+    if (Kwave::toUint(m_float.size()) < len)
+        m_float.resize(Kwave::toInt(len));
+    float *f = m_float.data();
+    samples2floats(in.constData(), f, len);
+    float *dbuffer = m_dbuffer.data();
+
     const float pi2 = 2 * float(M_PI);
     const float lfoposinc = static_cast<float>(m_frequency);
 
-    for (unsigned int pos = 0; pos < m_buffer.size(); pos++) {
+    for (unsigned int pos = 0; pos < len; pos++) {
         /*
          * fill delay buffer with the input signal
          */
-        m_dbuffer[m_dbpos] = sample2float(in[pos]);
+        dbuffer[m_dbpos] = f[pos];
 
         m_lfopos += lfoposinc;
         m_lfopos -= floorf(m_lfopos);
@@ -148,8 +156,8 @@ void Kwave::PitchShiftFilter::input(Kwave::SampleArray data)
         if (position1 < 0)
             position1 += MAXDELAY;
 
-        const float b1value = m_dbuffer[position] * (1 - error) +
-                              m_dbuffer[position1] * error;
+        const float b1value = dbuffer[position] * (1 - error) +
+                              dbuffer[position1] * error;
 
         /*
          * Interpolate value from buffer position 2
@@ -163,8 +171,8 @@ void Kwave::PitchShiftFilter::input(Kwave::SampleArray data)
         if ( position1 < 0)
             position1 += MAXDELAY;
 
-        const float b2value = m_dbuffer[position] * (1 - error) +
-                              m_dbuffer[position1] * error;
+        const float b2value = dbuffer[position] * (1 - error) +
+                              dbuffer[position1] * error;
 
         /*
          * Calculate output signal from these two buffers
@@ -178,7 +186,7 @@ void Kwave::PitchShiftFilter::input(Kwave::SampleArray data)
          *               0.75      -1         0        => buffer 1 is used
          */
 
-        m_buffer[pos] = float2sample(b1value * (1.0f - lfo) + b2value * lfo);
+        f[pos] = b1value * (1.0f - lfo) + b2value * lfo;
 
         /*
          * increment delay buffer position
@@ -188,6 +196,7 @@ void Kwave::PitchShiftFilter::input(Kwave::SampleArray data)
             m_dbpos = 0;
     }
 
+    floats2samples(f, m_buffer.data(), len);
 }
 
 //***************************************************************************
@@ -81,6 +81,9 @@ namespace Kwave
         /** buffer for input */
         Kwave::SampleArray m_buffer;
 
+        /** the current block, converted to floats */
+        QVector<float> m_float;
+
         /** speed factor */
         float m_speed;
 
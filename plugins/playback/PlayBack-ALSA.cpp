@@ -37,6 +37,7 @@
 #include <KLocalizedString>
 
 #include "libkwave/Compression.h"
+#include "libkwave/Dither.h"
 #include "libkwave/SampleEncoderLinear.h"
 #include "libkwave/SampleFormat.h"
 #include "libkwave/String.h"
@@ -237,16 +238,20 @@ int Kwave::PlayBackALSA::setFormat(snd_pcm_hw_params_t *hw_params,
     m_bytes_per_sample =
         ((snd_pcm_format_physical_width(m_format) + 7) >> 3) * m_channels;
 
-    m_encoder = new(std::nothrow) Kwave::SampleEncoderLinear(
-        sample_format_of(m_format),
-        m_bits,
-        endian_of(m_format)
-    );
-    Q_ASSERT(m_encoder);
-    if (!m_encoder) {
+    Kwave::SampleEncoderLinear *encoder =
+        new(std::nothrow) Kwave::SampleEncoderLinear(
+            sample_format_of(m_format),
+            m_bits,
+            endian_of(m_format)
+        );
+    Q_ASSERT(encoder);
+    if (!encoder) {
         qWarning("PlayBackALSA: out of memory");
         return -ENOMEM;
     }
+    encoder->setDither(m_channels, Kwave::Dither::defaultMode(),
+                       Kwave::Dither::defaultShaping());
+    m_encoder = encoder;
 
     // activate the settings
     Q_ASSERT(m_bits);
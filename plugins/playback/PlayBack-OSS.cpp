@@ -38,6 +38,7 @@
 
 #include "libkwave/ByteOrder.h"
 #include "libkwave/Compression.h"
+#include "libkwave/Dither.h"
 #include "libkwave/SampleEncoderLinear.h"
 #include "libkwave/String.h"
 #include "libkwave/Utils.h"
@@ -218,34 +219,38 @@ QString Kwave::PlayBackOSS::open(const QString &device, double rate,
     delete m_encoder;
     m_encoder = nullptr;
 
+    Kwave::SampleEncoderLinear *encoder = nullptr;
     switch (m_bits) {
         case 8:
-            m_encoder = new(std::nothrow) Kwave::SampleEncoderLinear(
+            encoder = new(std::nothrow) Kwave::SampleEncoderLinear(
                 Kwave::SampleFormat::Unsigned, 8, Kwave::LittleEndian);
             break;
         case 24:
             if (m_oss_version >= 0x040000) {
-                m_encoder = new(std::nothrow) Kwave::SampleEncoderLinear(
+                encoder = new(std::nothrow) Kwave::SampleEncoderLinear(
                 Kwave::SampleFormat::Signed, 24, Kwave::LittleEndian);
                 break;
             } // else:
             /* FALLTHROUGH */
         case 32:
             if (m_oss_version >= 0x040000) {
-                m_encoder = new(std::nothrow) Kwave::SampleEncoderLinear(
+                encoder = new(std::nothrow) Kwave::SampleEncoderLinear(
                     Kwave::SampleFormat::Signed, 32, Kwave::LittleEndian);
                 break;
             }
             // else:
             /* FALLTHROUGH */
         default:
-            m_encoder = new(std::nothrow) Kwave::SampleEncoderLinear(
+            encoder = new(std::nothrow) Kwave::SampleEncoderLinear(
                 Kwave::SampleFormat::Signed, 16, Kwave::LittleEndian);
             break;
     }
 
-    Q_ASSERT(m_encoder);
-    if (!m_encoder) return i18n("Out of memory");
+    Q_ASSERT(encoder);
+    if (!encoder) return i18n("Out of memory");
+    encoder->setDither(m_channels, Kwave::Dither::defaultMode(),
+                       Kwave::Dither::defaultShaping());
+    m_encoder = encoder;
 
     // resize the raw buffer
     m_raw_buffer.resize(m_buffer_size);
@@ -34,6 +34,7 @@
 
 #include <KLocalizedString>
 
+#include "libkwave/Dither.h"
 #include "libkwave/SampleEncoderLinear.h"
 #include "libkwave/String.h"
 #include "libkwave/Utils.h"
@@ -101,8 +102,12 @@ void Kwave::PlayBackQt::createEncoder(const QAudioFormat &format)
     }
 
     // create the sample encoder
-    m_encoder = new(std::nothrow)
+    Kwave::SampleEncoderLinear *encoder = new(std::nothrow)
         Kwave::SampleEncoderLinear(sample_format, bits, Kwave::CpuEndian);
+    if (encoder) encoder->setDither(
+        Kwave::toUint(format.channelCount()),
+        Kwave::Dither::defaultMode(), Kwave::Dither::defaultShaping());
+    m_encoder = encoder;
 }
 
 //***************************************************************************
@@ -20,6 +20,8 @@
 #include "config.h"
 
 #include <math.h>
+
+#include <cmath>
 #include <new>
 
 #include <QApplication>
@@ -33,7 +35,9 @@
 
 #include <KLocalizedString>
 
+#include "libkwave/String.h"
 #include "libkwave/Utils.h"
+#include "libkwave/modules/LoudnessMeter.h"
 
 #include "LevelMeter.h"
 
@@ -57,7 +61,7 @@ Kwave::LevelMeter::LevelMeter(QWidget *parent)
     :QWidget(parent),
     m_tracks(0), m_sample_rate(0), m_yf(), m_yp(),
     m_fast_queue(), m_peak_queue(),
-    m_current_fast(), m_current_peak(), m_timer(),
+    m_current_fast(), m_current_peak(), m_loudness(nullptr), m_timer(),
     m_color_low(Qt::green),
     m_color_normal(Qt::yellow),
     m_color_high(Qt::red)
@@ -73,6 +77,8 @@ Kwave::LevelMeter::LevelMeter(QWidget *parent)
 Kwave::LevelMeter::~LevelMeter()
 {
     setTracks(0);
+    delete m_loudness;
+    m_loudness = nullptr;
 }
 
 //***************************************************************************
@@ -100,6 +106,7 @@ void Kwave::LevelMeter::setSampleRate(double rate)
 {
     if (qFuzzyCompare(static_cast<float>(rate), m_sample_rate)) return;
     m_sample_rate = static_cast<float>(rate);
+    resetLoudness();
 }
 
 //***************************************************************************
@@ -170,6 +177,8 @@ void Kwave::LevelMeter::updateTrack(unsigned int track,
     }
     m_yf[track] = yf;
     m_yp[track] = yp;
+
+    if (m_loudness) m_loudness->process(track, buffer.constData(), samples);
 }
 
 //***************************************************************************
@@ -188,6 +197,20 @@ void Kwave::LevelMeter::reset()
     m_peak_queue.resize(m_tracks);
     m_current_peak.resize(m_tracks);
     m_current_peak.fill(0.0);
+
+    resetLoudness();
+}
+
+//***************************************************************************
+void Kwave::LevelMeter::resetLoudness()
+{
+    delete m_loudness;
+    m_loudness = nullptr;
+    if ((m_tracks <= 0) || (m_sample_rate <= 0)) return;
+
+    m_loudness = new(std::nothrow) Kwave::LoudnessMeter(
+        m_sample_rate, Kwave::toUint(m_tracks));
+    Q_ASSERT(m_loudness);
 }
 
 //***************************************************************************
@@ -271,7 +294,7 @@ void Kwave::LevelMeter::timedUpdate()
 }
 
 //***************************************************************************
-void Kwave::LevelMeter::drawScale(QPainter &p)
+void Kwave::LevelMeter::drawScale(QPainter &p, int left)
 {
     // draw the levels in 3dB steps, like -12dB -9dB  -6dB  -3dB and 0dB
     QFontMetrics fm = p.fontMetrics();
@@ -293,7 +316,7 @@ void Kwave::LevelMeter::drawScale(QPainter &p)
     if (!th) return;
 
     p.setBrush(brush);
-    while (right > tw + border) {
+    while (right > tw + border + left) {
         // find the first position in dB which is not overlapping
         // the last output position
         QString txt;
@@ -303,8 +326,8 @@ void Kwave::LevelMeter::drawScale(QPainter &p)
             x = Kwave::toInt(static_cast<double>(w) *
                 pow(10.0, static_cast<double>(db) / 20.0));
             db -= 3; // one step left == -3dB
-        } while ((x > right) && (x >= tw));
-        if (x < tw) break;
+        } while ((x > right) && (x >= tw + left));
+        if (x < tw + left) break;
 
         // calculate the text position
         int text_width = fm.boundingRect(txt).width();
@@ -332,6 +355,52 @@ void Kwave::LevelMeter::drawScale(QPainter &p)
 
 }
 
+//***************************************************************************
+int Kwave::LevelMeter::drawLoudness(QPainter &p)
+{
+    if (!m_loudness) return 0;
+
+    const auto lufs = [](double value) -> QString {
+        if (std::isinf(value)) return _("-inf");
+        return QString::number(value, 'f', 1);
+    };
+    const QString txt = i18nc(
+        "momentary, short term and integrated loudness",
+        "M %1  S %2  I %3 LUFS",
+        lufs(m_loudness->momentary()),
+        lufs(m_loudness->shortTerm()),
+        lufs(m_loudness->integrated())
+    );
+
+    QFontMetrics fm = p.fontMetrics();
+    const int border     = 4;
+    const int r          = 5;
+    const int th         = fm.height();
+    const int text_width = fm.boundingRect(txt).width();
+    const int x          = border + r;
+    const int y          = ((height() - th) / 2);
+    Q_ASSERT(th);
+    if (!th || (text_width + 2 * (border + r) > width())) return 0;
+
+    // dim the text background area, like the scale
+    p.setBrush(QBrush(palette().window().color()));
+    p.setOpacity(0.66);
+    p.setPen(Qt::NoPen);
+    p.drawRoundedRect(
+        x - r              , y - r,
+        text_width + 2 * r , th + 2 * r,
+        (200 * r) / th     , (200 * r) / th,
+        Qt::RelativeSize
+    );
+
+    // draw the text, left/center aligned
+    p.setOpacity(1.0);
+    p.setPen(palette().buttonText().color());
+    p.drawText(x, 1, text_width, height(), Qt::AlignCenter, txt);
+
+    return x + text_width + th;
+}
+
 //***************************************************************************
 /*
   Original idea:
@@ -408,8 +477,8 @@ void Kwave::LevelMeter::drawContents()
         );
     }
 
-    // draw the scale / dB numbers
-    drawScale(p);
+    // draw the loudness and the scale / dB numbers
+    drawScale(p, drawLoudness(p));
 
     p.end();
 }
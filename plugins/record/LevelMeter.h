@@ -35,6 +35,8 @@ class QPaintEvent;
 
 namespace Kwave
 {
+    class LoudnessMeter;
+
     class LevelMeter: public QWidget
     {
         Q_OBJECT
@@ -75,6 +77,12 @@ namespace Kwave
          */
         virtual void reset();
 
+        /**
+         * Restarts the loudness measurement, e.g. when a new
+         * recording starts
+         */
+        virtual void resetLoudness();
+
         /**
          * Redraws the whole widget
          * @author (original idea taken from) Rik Hemsley (rikkus) <rik@kde.org>
@@ -116,8 +124,17 @@ namespace Kwave
         /**
          * Draw some scale into the meter, using 3dB steps
          * @param p an already opened QPainter
+         * @param left the leftmost position that may be used
          */
-        void drawScale(QPainter &p);
+        void drawScale(QPainter &p, int left);
+
+        /**
+         * Draw the current loudness after EBU R128 into the left part
+         * of the meter
+         * @param p an already opened QPainter
+         * @return the right edge of the text area
+         */
+        int drawLoudness(QPainter &p);
 
     private:
 
@@ -145,6 +162,9 @@ namespace Kwave
         /** current peak value for each track */
         QVector<float> m_current_peak;
 
+        /** loudness meter for momentary, short term and integrated */
+        Kwave::LoudnessMeter *m_loudness;
+
         /** timer for display updates */
         QTimer *m_timer;
 
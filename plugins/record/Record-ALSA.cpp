@@ -20,8 +20,10 @@
 
 #include <errno.h>
 #include <math.h>
+#include <string.h>
 
 #include <QtGlobal>
+#include <QMutexLocker>
 
 #include "libkwave/Compression.h"
 #include "libkwave/String.h"
@@ -202,8 +204,14 @@ Kwave::RecordALSA::RecordALSA()
      m_bits_per_sample(0), m_bytes_per_sample(0),
      m_sample_format(Kwave::SampleFormat::Unknown),
      m_supported_formats(), m_initialized(false), m_buffer_size(0),
-     m_chunk_size(0)
+     m_chunk_size(0), m_period_size(0), m_mmap(false), m_read_timer(),
+     m_last_read(0), m_statistics_lock(), m_statistics()
 {
+    m_statistics.xruns     = 0;
+    m_statistics.latency   = 0.0;
+    m_statistics.jitter    = 0.0;
+    m_statistics.zero_copy = false;
+
     snd_pcm_hw_params_malloc(&m_hw_params);
     snd_pcm_sw_params_malloc(&m_sw_params);
     Q_ASSERT(m_hw_params);
@@ -361,7 +369,12 @@ int Kwave::RecordALSA::initialize()
         return -EIO;
     }
 
+    // prefer reading directly out of the ring buffer of the device,
+    // fall back to normal reads if it cannot be mapped
     err = snd_pcm_hw_params_set_access(m_handle, m_hw_params,
+         SND_PCM_ACCESS_MMAP_INTERLEAVED);
+    m_mmap = (err >= 0);
+    if (!m_mmap) err = snd_pcm_hw_params_set_access(m_handle, m_hw_params,
          SND_PCM_ACCESS_RW_INTERLEAVED);
     if (err < 0) {
         qWarning("Cannot set access type: %s", snd_strerror(err));
@@ -438,6 +451,16 @@ int Kwave::RecordALSA::initialize()
     else
         period_frames = buffer_frames / 4;
 
+    // use shorter periods if requested, for lower latency
+    if (m_period_size && (m_rate > 0)) {
+        const unsigned int t = Kwave::toUint(
+            (1000000.0 * m_period_size) / m_rate);
+        if ((period_time > 0) && (t > 0) && (t < period_time))
+            period_time = t;
+        if ((period_frames > 0) && (m_period_size < period_frames))
+            period_frames = m_period_size;
+    }
+
     if (period_time > 0) {
         err = snd_pcm_hw_params_set_period_time_near(m_handle, m_hw_params,
                                                      &period_time, nullptr);
@@ -519,6 +542,19 @@ int Kwave::RecordALSA::initialize()
     Q_ASSERT(m_chunk_size);
     Q_ASSERT(m_bytes_per_sample);
 
+    // start new statistics
+    m_last_read = 0;
+    m_read_timer.start();
+    {
+        QMutexLocker lock(&m_statistics_lock);
+        m_statistics.xruns     = 0;
+        m_statistics.latency   = 0.0;
+        m_statistics.jitter    = 0.0;
+        m_statistics.zero_copy = m_mmap;
+    }
+//     qDebug("RecordALSA: %lu samples per period, %s", m_chunk_size,
+//            m_mmap ? "memory mapped" : "read/write");
+
 //     snd_pcm_dump(m_handle, output);
     snd_output_close(output);
 
@@ -609,19 +645,27 @@ int Kwave::RecordALSA::read(QByteArray &buffer, unsigned int offset)
     // try to read as much as the device accepts
     Q_ASSERT(samples);
     Q_ASSERT(offset + samples <= Kwave::toUint(buffer.size()));
-    int r = Kwave::toInt(
-        snd_pcm_readi(m_handle, buffer.data() + offset, samples)
-    );
+    int r = (m_mmap) ?
+        readMapped(buffer.data() + offset, samples) :
+        Kwave::toInt(snd_pcm_readi(m_handle, buffer.data() + offset, samples));
 
     // handle all negative result codes
     if (r == -EAGAIN) {
+        // sleep in poll() until the device has a period ready, the
+        // timeout only applies if the device stalls
         unsigned int timeout = (m_rate > 0) ?
-            (((1000 * samples) / 4) / Kwave::toUint(m_rate)) : 10U;
-        snd_pcm_wait(m_handle, timeout);
+            ((2000 * Kwave::toUint(m_chunk_size)) / Kwave::toUint(m_rate))
+            : 10U;
+        snd_pcm_wait(m_handle, qMax(timeout, 1U));
         return -EAGAIN;
     } else if (r == -EPIPE) {
         // underrun -> start again
         qWarning("RecordALSA::read(), underrun");
+        {
+            QMutexLocker lock(&m_statistics_lock);
+            m_statistics.xruns++;
+        }
+        m_last_read = 0;
         r = snd_pcm_prepare(m_handle);
         if (r >= 0) r = snd_pcm_start(m_handle);
         if (r < 0) {
@@ -659,9 +703,65 @@ int Kwave::RecordALSA::read(QByteArray &buffer, unsigned int offset)
     Q_ASSERT(r <= Kwave::toInt(samples));
     if (r > Kwave::toInt(samples)) r = samples;
 
+    updateStatistics(static_cast<snd_pcm_uframes_t>(r));
+
     return (r * m_bytes_per_sample);
 }
 
+//***************************************************************************
+int Kwave::RecordALSA::readMapped(char *dst, snd_pcm_uframes_t samples)
+{
+    snd_pcm_sframes_t avail = snd_pcm_avail_update(m_handle);
+    if (avail < 0) return Kwave::toInt(avail);
+    if (static_cast<snd_pcm_uframes_t>(avail) < samples) return -EAGAIN;
+
+    // the mapped area may be shorter at the end of the ring buffer
+    const snd_pcm_channel_area_t *areas = nullptr;
+    snd_pcm_uframes_t offset = 0;
+    snd_pcm_uframes_t frames = samples;
+    int err = snd_pcm_mmap_begin(m_handle, &areas, &offset, &frames);
+    if (err < 0) return err;
+    Q_ASSERT(areas);
+    if (!areas) return -EIO;
+
+    // with interleaved access all tracks share the first area
+    const char *src = static_cast<const char *>(areas[0].addr) +
+        ((areas[0].first + (offset * areas[0].step)) / 8);
+    memcpy(dst, src, frames * m_bytes_per_sample);
+
+    snd_pcm_sframes_t committed = snd_pcm_mmap_commit(m_handle, offset, frames);
+    if (committed < 0) return Kwave::toInt(committed);
+    if (static_cast<snd_pcm_uframes_t>(committed) != frames) return -EPIPE;
+    return Kwave::toInt(committed);
+}
+
+//***************************************************************************
+void Kwave::RecordALSA::updateStatistics(snd_pcm_uframes_t samples)
+{
+    if (m_rate <= 0) return;
+
+    // samples that are captured but not yet read
+    snd_pcm_sframes_t delay = 0;
+    double latency = 0.0;
+    if (snd_pcm_delay(m_handle, &delay) >= 0)
+        latency = (1000.0 * static_cast<double>(delay)) / m_rate;
+
+    // the time since the previous read should match the length
+    // of the data that has been read by it
+    const double elapsed = static_cast<double>(
+        m_read_timer.nsecsElapsed()) / 1000000.0;
+    m_read_timer.restart();
+    double jitter = 0.0;
+    if (m_last_read)
+        jitter = fabs(elapsed -
+            ((1000.0 * static_cast<double>(m_last_read)) / m_rate));
+    m_last_read = samples;
+
+    QMutexLocker lock(&m_statistics_lock);
+    m_statistics.latency = latency;
+    if (jitter > m_statistics.jitter) m_statistics.jitter = jitter;
+}
+
 //***************************************************************************
 int Kwave::RecordALSA::close()
 {
@@ -958,6 +1058,21 @@ Kwave::byte_order_t Kwave::RecordALSA::endianness()
         endian_of(_known_formats[index]) : Kwave::UnknownEndian;
 }
 
+//***************************************************************************
+void Kwave::RecordALSA::setPeriodSize(unsigned int samples)
+{
+    if (samples != m_period_size) m_initialized = false;
+    m_period_size = samples;
+}
+
+//***************************************************************************
+bool Kwave::RecordALSA::statistics(Kwave::RecordDevice::Statistics &stats)
+{
+    QMutexLocker lock(&m_statistics_lock);
+    stats = m_statistics;
+    return true;
+}
+
 //***************************************************************************
 QStringList Kwave::RecordALSA::supportedDevices()
 {
@@ -30,8 +30,10 @@
 
 #include <alsa/asoundlib.h>
 
+#include <QElapsedTimer>
 #include <QList>
 #include <QMap>
+#include <QMutex>
 #include <QString>
 
 #include "libkwave/Compression.h"
@@ -178,8 +180,41 @@ namespace Kwave
         /** Returns the current endianness (big/little) */
         Kwave::byte_order_t endianness() override;
 
+        /**
+         * Sets the preferred number of samples per period, the period
+         * will not become longer than a quarter of the ALSA buffer
+         * @param samples number of samples per track, zero for default
+         */
+        void setPeriodSize(unsigned int samples) override;
+
+        /**
+         * Gets the number of overruns, the current latency and the
+         * jitter of the wakeups since the last initialization
+         * @param stats receives the statistics
+         * @return true
+         */
+        bool statistics(Kwave::RecordDevice::Statistics &stats) override;
+
     private:
 
+        /**
+         * Reads samples directly out of the memory mapped ring buffer
+         * of the device
+         * @param dst destination of the interleaved samples
+         * @param samples maximum number of samples to read
+         * @return number of samples read, -EAGAIN if less than the
+         *         requested number of samples is available or a
+         *         negative error code
+         */
+        int readMapped(char *dst, snd_pcm_uframes_t samples);
+
+        /**
+         * Updates the latency and jitter statistics after a successful
+         * read
+         * @param samples number of samples that have been read
+         */
+        void updateStatistics(snd_pcm_uframes_t samples);
+
         /**
          * Walk through the list of all known formats and collect the
          * ones that are supported into "m_supported_formats".
@@ -277,6 +312,24 @@ namespace Kwave
         /** number of samples per period */
         snd_pcm_uframes_t m_chunk_size;
 
+        /** preferred number of samples per period, zero for default */
+        unsigned int m_period_size;
+
+        /** true if the ring buffer of the device is memory mapped */
+        bool m_mmap;
+
+        /** measures the time between two successful reads */
+        QElapsedTimer m_read_timer;
+
+        /** number of samples of the previous successful read */
+        snd_pcm_uframes_t m_last_read;
+
+        /** mutex for protecting m_statistics */
+        QMutex m_statistics_lock;
+
+        /** statistics of the transfer */
+        Kwave::RecordDevice::Statistics m_statistics;
+
     };
 }
 
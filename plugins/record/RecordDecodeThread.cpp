@@ -0,0 +1,157 @@
+/***************************************************************************
+ RecordDecodeThread.cpp  -  thread for decoding recorded raw data
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <QMutexLocker>
+#include <QVariant>
+
+#include "libkwave/Utils.h"
+
+#include "RecordDecodeThread.h"
+#include "RecordThread.h"
+#include "SampleDecoder.h"
+
+/** interval for checking for a stop request [ms] */
+#define WAKEUP_INTERVAL 100
+
+//***************************************************************************
+Kwave::RecordDecodeThread::RecordDecodeThread(Kwave::RecordThread &source)
+    :Kwave::WorkerThread(nullptr, QVariant()),
+     m_source(source),
+     m_lock(),
+     m_wake(),
+     m_decoder(nullptr),
+     m_tracks(0),
+     m_max_queued(0),
+     m_queue()
+{
+}
+
+//***************************************************************************
+Kwave::RecordDecodeThread::~RecordDecodeThread()
+{
+    stop();
+
+    QMutexLocker lock(&m_lock);
+    m_queue.clear();
+}
+
+//***************************************************************************
+void Kwave::RecordDecodeThread::setDecoder(Kwave::SampleDecoder *decoder,
+                                           unsigned int tracks,
+                                           unsigned int max_queued)
+{
+    Q_ASSERT(!isRunning());
+    if (isRunning()) return;
+
+    QMutexLocker lock(&m_lock);
+    m_decoder    = decoder;
+    m_tracks     = tracks;
+    m_max_queued = qMax(max_queued, 1U);
+    m_queue.clear();
+}
+
+//***************************************************************************
+unsigned int Kwave::RecordDecodeThread::queuedBuffers()
+{
+    QMutexLocker lock(&m_lock);
+    return static_cast<unsigned int>(m_queue.count());
+}
+
+//***************************************************************************
+QVector<Kwave::SampleArray> Kwave::RecordDecodeThread::dequeue()
+{
+    QMutexLocker lock(&m_lock);
+    if (m_queue.isEmpty()) return QVector<Kwave::SampleArray>();
+
+    // there is space in the queue again
+    m_wake.wakeAll();
+    return m_queue.dequeue();
+}
+
+//***************************************************************************
+void Kwave::RecordDecodeThread::bufferAvailable()
+{
+    QMutexLocker lock(&m_lock);
+    m_wake.wakeAll();
+}
+
+//***************************************************************************
+bool Kwave::RecordDecodeThread::decodeNext()
+{
+    if (!m_decoder || !m_tracks) return false;
+
+    QByteArray raw = m_source.dequeue();
+    if (raw.isEmpty()) return false;
+
+    const unsigned int bytes_per_sample = m_decoder->rawBytesPerSample();
+    Q_ASSERT(bytes_per_sample);
+    if (!bytes_per_sample) return false;
+    const unsigned int samples = Kwave::toUint(raw.size()) /
+                                 (bytes_per_sample * m_tracks);
+
+    QVector<Kwave::SampleArray> decoded(m_tracks);
+    for (Kwave::SampleArray &track : decoded) {
+        if (!track.resize(samples)) return false; // out of memory
+    }
+
+    // decode and de-interleave all tracks at once
+    m_decoder->decode(raw, decoded);
+
+    {
+        QMutexLocker lock(&m_lock);
+        m_queue.enqueue(decoded);
+    }
+    emit bufferDecoded();
+    return true;
+}
+
+//***************************************************************************
+void Kwave::RecordDecodeThread::run()
+{
+    while (!isInterruptionRequested()) {
+        {
+            // wait for raw data and space in the queue
+            QMutexLocker lock(&m_lock);
+            if ((Kwave::toUint(m_queue.count()) >= m_max_queued) ||
+                !m_source.queuedBuffers())
+            {
+                m_wake.wait(&m_lock, WAKEUP_INTERVAL);
+                continue;
+            }
+        }
+
+        decodeNext();
+    }
+}
+
+//***************************************************************************
+void Kwave::RecordDecodeThread::flush()
+{
+    Q_ASSERT(!isRunning());
+    if (isRunning()) return;
+
+    while (m_source.queuedBuffers()) {
+        if (!decodeNext()) break;
+    }
+}
+
+//***************************************************************************
+//***************************************************************************
+
+#include "moc_RecordDecodeThread.cpp"
@@ -0,0 +1,140 @@
+/***************************************************************************
+   RecordDecodeThread.h  -  thread for decoding recorded raw data
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef RECORD_DECODE_THREAD_H
+#define RECORD_DECODE_THREAD_H
+
+#include "config.h"
+
+#include <QMutex>
+#include <QQueue>
+#include <QVector>
+#include <QWaitCondition>
+
+#include "libkwave/SampleArray.h"
+#include "libkwave/WorkerThread.h"
+
+namespace Kwave
+{
+
+    class RecordThread;
+    class SampleDecoder;
+
+    /**
+     * Takes the buffers with raw data from the record thread, decodes and
+     * de-interleaves them into one array of samples per track and queues
+     * them up for the record plugin. This keeps the decoding out of the
+     * GUI thread and the record thread free for reading from the device.
+     */
+    class RecordDecodeThread: public Kwave::WorkerThread
+    {
+        Q_OBJECT
+    public:
+
+        /**
+         * Constructor
+         * @param source the record thread that delivers the raw data
+         */
+        explicit RecordDecodeThread(Kwave::RecordThread &source);
+
+        /** Destructor */
+        ~RecordDecodeThread() override;
+
+        /** does the decoding */
+        void run() override;
+
+        /**
+         * Sets up the decoder and the queue size
+         * @param decoder the decoder for the raw data, not owned
+         * @param tracks number of tracks in the raw data
+         * @param max_queued maximum number of decoded buffers to hold, if
+         *        exceeded the raw buffers are left in the record thread
+         * @note this must not be called during recording
+         */
+        void setDecoder(Kwave::SampleDecoder *decoder, unsigned int tracks,
+                        unsigned int max_queued);
+
+        /**
+         * Decodes all buffers that are still queued in the record thread,
+         * within the context of the caller
+         * @note this must not be called during recording
+         */
+        void flush();
+
+        /** Returns the number of queued decoded buffers */
+        unsigned int queuedBuffers();
+
+        /**
+         * De-queues a decoded buffer
+         * @return one array per track, or an empty vector
+         */
+        QVector<Kwave::SampleArray> dequeue();
+
+    public slots:
+
+        /**
+         * Called from the record thread when a raw buffer has been
+         * filled, wakes up the decoding.
+         */
+        void bufferAvailable();
+
+    signals:
+
+        /**
+         * emitted when a buffer has been decoded and can be de-queued
+         * with dequeue()
+         */
+        void bufferDecoded();
+
+    private:
+
+        /**
+         * De-queues one raw buffer from the record thread and decodes it
+         * @return true if a buffer has been decoded
+         */
+        bool decodeNext();
+
+    private:
+
+        /** the record thread as source of raw data */
+        Kwave::RecordThread &m_source;
+
+        /** lock for the queue and the settings */
+        QMutex m_lock;
+
+        /** wakes up the thread if raw data or queue space is available */
+        QWaitCondition m_wake;
+
+        /** decoder for the raw data */
+        Kwave::SampleDecoder *m_decoder;
+
+        /** number of tracks */
+        unsigned int m_tracks;
+
+        /** maximum number of decoded buffers in m_queue */
+        unsigned int m_max_queued;
+
+        /** queue with decoded buffers */
+        QQueue< QVector<Kwave::SampleArray> > m_queue;
+
+    };
+}
+
+#endif /* RECORD_DECODE_THREAD_H */
+
+//***************************************************************************
+//***************************************************************************
@@ -38,6 +38,14 @@ namespace Kwave
     {
     public:
 
+        /** statistics about the transfer of data from the device */
+        typedef struct {
+            quint64 xruns;      /**< number of overruns since start     */
+            double  latency;    /**< data not yet read [ms]             */
+            double  jitter;     /**< max. deviation of wakeups [ms]     */
+            bool    zero_copy;  /**< true if reading from a mapped area */
+        } Statistics;
+
         /** Constructor */
         RecordDevice() {}
 
@@ -168,6 +176,26 @@ namespace Kwave
         /** Returns the current endianness (big/little) */
         virtual Kwave::byte_order_t endianness() = 0;
 
+        /**
+         * Sets the preferred number of samples per transfer from the
+         * device. The device may use less if its hardware supports it.
+         * @param samples number of samples per track, zero for default
+         */
+        virtual void setPeriodSize(unsigned int samples) {
+            Q_UNUSED(samples)
+        }
+
+        /**
+         * Gets statistics about the transfer of data from the device,
+         * may be called from a different thread than read()
+         * @param stats receives the statistics
+         * @return true if the device supports statistics
+         */
+        virtual bool statistics(Statistics &stats) {
+            Q_UNUSED(stats)
+            return false;
+        }
+
     };
 }
 
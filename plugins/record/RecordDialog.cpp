@@ -105,6 +105,7 @@ Kwave::RecordDialog::RecordDialog(QWidget *parent, QStringList &params,
     m_status_bar.m_sample_rate     = nullptr;
     m_status_bar.m_bits_per_sample = nullptr;
     m_status_bar.m_tracks          = nullptr;
+    m_status_bar.m_statistics      = nullptr;
 
     setupUi(this);
 
@@ -293,6 +294,13 @@ Kwave::RecordDialog::RecordDialog(QWidget *parent, QStringList &params,
     m_status_bar.m_tracks->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
     lbl_state->addWidget(m_status_bar.m_tracks);
 
+    m_status_bar.m_statistics = new(std::nothrow) QLabel(_(" "));
+    Q_ASSERT(m_status_bar.m_statistics);
+    if (!m_status_bar.m_statistics) return;
+    m_status_bar.m_statistics->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    m_status_bar.m_statistics->hide();
+    lbl_state->addWidget(m_status_bar.m_statistics);
+
     m_state_icon_widget->setFixedSize(16, lbl_state->childrenRect().height());
 
     // set the initial state of the dialog to "Reset/Empty"
@@ -998,6 +1006,7 @@ void Kwave::RecordDialog::setState(Kwave::RecordState state)
     QVector<QPixmap> pixmaps;
     unsigned int animation_time = 500;
 
+    const Kwave::RecordState previous = m_state;
     m_state = state;
     switch (state) {
         case Kwave::REC_UNINITIALIZED:
@@ -1073,6 +1082,11 @@ void Kwave::RecordDialog::setState(Kwave::RecordState state)
             pixmaps.push_back(QPixmap(walk_r7_xpm));
             pixmaps.push_back(QPixmap(walk_r8_xpm));
             animation_time = 100;
+
+            // measure the loudness of each new recording from its start
+            if (level_meter && (previous != Kwave::REC_RECORDING) &&
+                (previous != Kwave::REC_PAUSED))
+                level_meter->resetLoudness();
             break;
         case Kwave::REC_PAUSED:
             state_text = i18n("Paused");
@@ -1133,6 +1147,27 @@ void Kwave::RecordDialog::setState(Kwave::RecordState state)
 
 }
 
+//***************************************************************************
+void Kwave::RecordDialog::showStatistics(
+    const Kwave::RecordDevice::Statistics &stats)
+{
+    Q_ASSERT(m_status_bar.m_statistics);
+    if (!m_status_bar.m_statistics) return;
+
+    m_status_bar.m_statistics->setText(
+        i18np("1 overrun", "%1 overruns", stats.xruns));
+    m_status_bar.m_statistics->setToolTip(
+        i18n("Overruns: %1\n"
+             "Latency: %2 ms\n"
+             "Jitter: %3 ms\n"
+             "Transfer: %4",
+             stats.xruns,
+             QString::number(stats.latency, 'f', 1),
+             QString::number(stats.jitter, 'f', 1),
+             stats.zero_copy ? i18n("memory mapped") : i18n("read/write")));
+    m_status_bar.m_statistics->show();
+}
+
 //***************************************************************************
 void Kwave::RecordDialog::updateBufferState(unsigned int count,
                                             unsigned int total)
@@ -32,6 +32,7 @@
 #include "libkwave/SampleFormat.h"
 
 #include "RecordController.h"
+#include "RecordDevice.h"
 #include "RecordParams.h"
 #include "RecordState.h"
 #include "RecordTypesMap.h"
@@ -146,6 +147,12 @@ namespace Kwave
          */
         void updateBufferState(unsigned int count, unsigned int total);
 
+        /**
+         * shows the transfer statistics of the record device
+         * @param stats overruns, latency and jitter of the device
+         */
+        void showStatistics(const Kwave::RecordDevice::Statistics &stats);
+
         /**
          * updates all enabled visual effects
          * @param track index of the track that is updated
@@ -354,6 +361,7 @@ namespace Kwave
             QLabel *m_sample_rate;     /**< status bar id: sample rate */
             QLabel *m_bits_per_sample; /**< status bar id: number of tracks */
             QLabel *m_tracks;          /**< status bar id: number of tracks */
+            QLabel *m_statistics;      /**< status bar id: device statistics */
         } m_status_bar;
     };
 }
@@ -43,8 +43,8 @@
 #include "libkwave/MessageBox.h"
 #include "libkwave/PluginManager.h"
 #include "libkwave/Sample.h"
-#include "libkwave/SampleFIFO.h"
 #include "libkwave/SampleFormat.h"
+#include "libkwave/SampleRingBuffer.h"
 #include "libkwave/SignalManager.h"
 #include "libkwave/String.h"
 #include "libkwave/Utils.h"
@@ -54,6 +54,7 @@
 #include "Record-OSS.h"
 #include "Record-PulseAudio.h"
 #include "Record-Qt.h"
+#include "RecordDecodeThread.h"
 #include "RecordDevice.h"
 #include "RecordDialog.h"
 #include "RecordPlugin.h"
@@ -74,6 +75,7 @@ Kwave::RecordPlugin::RecordPlugin(QObject *parent, const QVariantList &args)
      m_device(nullptr),
      m_dialog(nullptr),
      m_thread(nullptr),
+     m_decode_thread(nullptr),
      m_decoder(nullptr),
      m_prerecording_queue(),
      m_writers(nullptr),
@@ -96,6 +98,10 @@ Kwave::RecordPlugin::~RecordPlugin()
     delete m_dialog;
     m_dialog = nullptr;
 
+    Q_ASSERT(!m_decode_thread);
+    delete m_decode_thread;
+    m_decode_thread = nullptr;
+
     Q_ASSERT(!m_thread);
     delete m_thread;
     m_thread = nullptr;
@@ -149,6 +155,17 @@ QStringList *Kwave::RecordPlugin::setup(QStringList &previous_params)
         return nullptr;
     }
 
+    // create the thread for decoding the recorded data
+    m_decode_thread = new(std::nothrow) Kwave::RecordDecodeThread(*m_thread);
+    Q_ASSERT(m_decode_thread);
+    if (!m_decode_thread) {
+        delete m_thread;
+        m_thread = nullptr;
+        delete m_dialog;
+        m_dialog = nullptr;
+        return nullptr;
+    }
+
     // connect some signals of the setup dialog
     connect(m_dialog, SIGNAL(sigMethodChanged(Kwave::record_method_t)),
             this,     SLOT(setMethod(Kwave::record_method_t)));
@@ -202,8 +219,11 @@ QStringList *Kwave::RecordPlugin::setup(QStringList &previous_params)
     // connect us to the record thread
     connect(m_thread, SIGNAL(stopped(int)),
             this,     SLOT(recordStopped(int)));
-    connect(m_thread, SIGNAL(bufferFull()),
-            this,     SLOT(processBuffer()),
+    connect(m_thread,        SIGNAL(bufferFull()),
+            m_decode_thread, SLOT(bufferAvailable()),
+            Qt::DirectConnection);
+    connect(m_decode_thread, SIGNAL(bufferDecoded()),
+            this,            SLOT(processBuffer()),
             Qt::QueuedConnection);
 
     // dummy init -> disable format settings
@@ -228,13 +248,11 @@ QStringList *Kwave::RecordPlugin::setup(QStringList &previous_params)
     }
 
     /* de-queue all buffers that are pending and remove the record thread */
-    if (m_thread) {
-        m_thread->stop();
-        while (m_thread->queuedBuffers())
-            processBuffer();
-        delete m_thread;
-        m_thread = nullptr;
-    }
+    stopRecordThreads();
+    delete m_decode_thread;
+    m_decode_thread = nullptr;
+    delete m_thread;
+    m_thread = nullptr;
 
     delete m_decoder;
     m_decoder = nullptr;
@@ -831,15 +849,27 @@ void Kwave::RecordPlugin::enterInhibit()
         QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
 
 //      qDebug("RecordPlugin::enterInhibit() - STOPPING");
-        m_thread->stop();
-        Q_ASSERT(!m_thread->isRunning());
-
-        // de-queue all buffers that are still in the queue
-        while (m_thread->queuedBuffers())
-            processBuffer();
+        stopRecordThreads();
     }
 }
 
+//***************************************************************************
+void Kwave::RecordPlugin::stopRecordThreads()
+{
+    if (!m_thread || !m_decode_thread) return;
+
+    // stop reading from the device first, then the decoding
+    m_thread->stop();
+    Q_ASSERT(!m_thread->isRunning());
+    m_decode_thread->stop();
+    Q_ASSERT(!m_decode_thread->isRunning());
+
+    // decode and de-queue all buffers that are still pending
+    m_decode_thread->flush();
+    while (m_decode_thread->queuedBuffers())
+        processBuffer();
+}
+
 //***************************************************************************
 void Kwave::RecordPlugin::leaveInhibit()
 {
@@ -860,7 +890,8 @@ void Kwave::RecordPlugin::leaveInhibit()
         // set new parameters for the recorder
         setupRecordThread();
 
-        // and let the thread run (again)
+        // and let the threads run (again)
+        m_decode_thread->start();
         m_thread->start();
         break;
     }
@@ -921,10 +952,14 @@ void Kwave::RecordPlugin::setupRecordThread()
     Q_ASSERT(m_device);
     if (!paramsValid()) return;
 
-    // stop the thread if necessary (should never happen)
+    // stop the threads if necessary (should never happen)
     Q_ASSERT(!m_thread->isRunning());
     if (m_thread->isRunning()) m_thread->stop();
     Q_ASSERT(!m_thread->isRunning());
+    Q_ASSERT(m_decode_thread);
+    if (!m_decode_thread) return;
+    Q_ASSERT(!m_decode_thread->isRunning());
+    if (m_decode_thread->isRunning()) m_decode_thread->stop();
 
     // delete the previous decoder
     delete m_decoder;
@@ -973,10 +1008,11 @@ void Kwave::RecordPlugin::setupRecordThread()
         const unsigned int prerecording_samples = Kwave::toUint(
             rint(params.pre_record_time * params.sample_rate));
         m_prerecording_queue.resize(params.tracks);
-        for (int i=0; i < m_prerecording_queue.size(); i++)
-            m_prerecording_queue[i].setSize(prerecording_samples);
+        bool ok = (m_prerecording_queue.size() == Kwave::toInt(params.tracks));
+        for (int i = 0; ok && (i < m_prerecording_queue.size()); i++)
+            ok = m_prerecording_queue[i].setCapacity(prerecording_samples);
 
-        if (m_prerecording_queue.size() != Kwave::toInt(params.tracks)) {
+        if (!ok) {
             m_prerecording_queue.clear();
             Kwave::MessageBox::sorry(m_dialog, i18n("Out of memory"));
             return;
@@ -987,13 +1023,17 @@ void Kwave::RecordPlugin::setupRecordThread()
     m_trigger_value.resize(params.tracks);
     m_trigger_value.fill(0.0);
 
-    // set up the record thread
+    // set up the record thread, transfer at most one buffer per period
+    m_device->setPeriodSize(1 << params.buffer_size);
     m_thread->setRecordDevice(m_device);
     unsigned int buf_count = params.buffer_count;
     unsigned int buf_size  = params.tracks *
                              m_decoder->rawBytesPerSample() *
                             (1 << params.buffer_size);
     m_thread->setBuffers(buf_count, buf_size);
+
+    // the decoded data occupies a record buffer until it is processed
+    m_decode_thread->setDecoder(m_decoder, params.tracks, buf_count);
 }
 
 //***************************************************************************
@@ -1154,7 +1194,8 @@ void Kwave::RecordPlugin::updateBufferProgressBar()
 {
     Q_ASSERT(m_dialog);
     Q_ASSERT(m_thread);
-    if (!m_dialog || !m_thread) return;
+    Q_ASSERT(m_decode_thread);
+    if (!m_dialog || !m_thread || !m_decode_thread) return;
 
     unsigned int buffers_total = m_dialog->params().buffer_count;
 
@@ -1165,154 +1206,31 @@ void Kwave::RecordPlugin::updateBufferProgressBar()
         // count up the number of recorded buffers
         m_buffers_recorded++;
 
+        Kwave::RecordDevice::Statistics stats;
+        if (m_device && m_device->statistics(stats))
+            m_dialog->showStatistics(stats);
+
         if (m_buffers_recorded <= buffers_total) {
             // buffers are just in progress of getting filled
             m_dialog->updateBufferState(m_buffers_recorded, buffers_total);
         } else {
-            // we have remaining+1 buffers (one is currently filled)
+            // we have remaining+1 buffers (one is currently filled),
+            // decoded ones that are still queued are not free
             unsigned int remaining = m_thread->remainingBuffers() + 1;
+            unsigned int decoded   = m_decode_thread->queuedBuffers();
+            remaining = (remaining > decoded) ? (remaining - decoded) : 0;
             if (remaining > buffers_total) remaining = buffers_total;
             m_dialog->updateBufferState(remaining, buffers_total);
         }
     } else {
         // no longer recording: count the buffer downwards
-        unsigned int queued = m_thread->queuedBuffers();
+        unsigned int queued = m_thread->queuedBuffers() +
+                              m_decode_thread->queuedBuffers();
         if (!queued) buffers_total = 0;
         m_dialog->updateBufferState(queued, buffers_total);
     }
 }
 
-//***************************************************************************
-void Kwave::RecordPlugin::split(QByteArray &raw_data, QByteArray &dest,
-                                unsigned int bytes_per_sample,
-                                unsigned int track,
-                                unsigned int tracks)
-{
-    unsigned int raw_data_size = static_cast<unsigned int>(raw_data.size());
-    unsigned int samples = (raw_data_size / bytes_per_sample) / tracks;
-
-#if 0
-    // simple sawtooth generator, based on raw data
-    // works for up to 16 channels
-    static int saw[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-    raw_data.fill(0x05);
-    for (unsigned int s = 0; s < samples; s++) {
-        int v = saw[track];
-        for (unsigned int byte = 0; byte < bytes_per_sample; byte++) {
-            quint8 x = (quint8)v;
-            raw_data[(((s * tracks) + track) * bytes_per_sample) + byte] = x;
-            v >>= 8;
-        }
-
-        const int max = (1 << ((bytes_per_sample * 8) - 1)) - 1;
-        saw[track] += max / 64;
-        if (saw[track] >= max) saw[track] = 0;
-    }
-#endif
-
-    if (tracks == 1) {
-        // this would give a 1:1 memcpy
-        dest = raw_data;
-    } else {
-        switch (bytes_per_sample) {
-            case 1: {
-                // 1...8 bits per sample, use 8 bit pointers
-                const quint8 *src =
-                    reinterpret_cast<const quint8 *>(raw_data.constData());
-                quint8 *dst =
-                    reinterpret_cast<quint8 *>(dest.data());
-                src += track;
-                while (samples) {
-                    *dst = *src;
-                    dst++;
-                    src += tracks;
-                    samples--;
-                }
-                break;
-            }
-            case 2: {
-                // 9...16 bits per sample, use 16 bit pointers
-                const quint16 *src =
-                    reinterpret_cast<const quint16 *>(raw_data.constData());
-                quint16 *dst =
-                    reinterpret_cast<quint16 *>(dest.data());
-                src += track;
-                while (samples) {
-                    *dst = *src;
-                    dst++;
-                    src += tracks;
-                    samples--;
-                }
-                break;
-            }
-            case 3: {
-                // 17...24 bits per sample, use 8 bit pointers, three times
-                const quint8 *src =
-                    reinterpret_cast<const quint8 *>(raw_data.constData());
-                quint8 *dst =
-                    reinterpret_cast<quint8 *>(dest.data());
-                src += track * 3;
-                while (samples) {
-                    *(dst++) = *(src++);
-                    *(dst++) = *(src++);
-                    *(dst++) = *(src++);
-                    src += (tracks - 1) * 3;
-                    samples--;
-                }
-                break;
-            }
-            case 4: {
-                // 24...32 bits per sample, use 32 bit pointers
-                const quint32 *src =
-                    reinterpret_cast<const quint32 *>(raw_data.constData());
-                quint32 *dst =
-                    reinterpret_cast<quint32 *>(dest.data());
-                src += track;
-                while (samples) {
-                    *dst = *src;
-                    dst++;
-                    src += tracks;
-                    samples--;
-                }
-                break;
-            }
-            case 8: {
-                // 64 bits per sample, use 64 bit pointers
-                const quint64 *src =
-                    reinterpret_cast<const quint64 *>(raw_data.constData());
-                quint64 *dst =
-                    reinterpret_cast<quint64 *>(dest.data());
-                src += track;
-                while (samples) {
-                    *dst = *src;
-                    dst++;
-                    src += tracks;
-                    samples--;
-                }
-                break;
-            }
-            default: {
-                // default: byte wise operation
-                const quint8 *src =
-                    reinterpret_cast<const quint8 *>(raw_data.constData());
-                quint8 *dst =
-                    reinterpret_cast<quint8 *>(dest.data());
-                src += (track * bytes_per_sample);
-                unsigned int increment = (tracks - 1) * bytes_per_sample;
-                while (samples) {
-                    for (unsigned int b = 0; b < bytes_per_sample; b++) {
-                        *dst = *src;
-                        dst++;
-                        src++;
-                        samples--;
-                    }
-                    src += increment;
-                }
-            }
-        }
-    }
-}
-
 //***************************************************************************
 bool Kwave::RecordPlugin::checkTrigger(unsigned int track,
                                        const Kwave::SampleArray &buffer)
@@ -1434,28 +1352,20 @@ void Kwave::RecordPlugin::flushPrerecordingQueue()
     if (tracks != m_writers->tracks()) return;
 
     for (unsigned int track=0; track < tracks; ++track) {
-        Kwave::SampleFIFO &fifo = m_prerecording_queue[track];
-        Q_ASSERT(fifo.length());
-        if (!fifo.length()) continue;
-        fifo.crop(); // enforce the correct size
+        Kwave::SampleRingBuffer &queue = m_prerecording_queue[track];
+        Q_ASSERT(queue.length());
+        if (!queue.length()) continue;
 
-        // push all buffers to the writer, starting at the tail
+        // push the whole content to the writer, starting at the oldest
         Kwave::Writer *writer = (*m_writers)[track];
         Q_ASSERT(writer);
         if (writer) {
-            Kwave::SampleArray buffer(writer->blockSize());
-            unsigned int rest = fifo.length();
-            while (rest) {
-                unsigned int read = fifo.get(buffer);
-                if (read < 1) break;
-                writer->write(buffer, read);
-                rest -= read;
-            }
+            queue.drainInto(*writer);
         } else {
-            // fallback: discard the FIFO content
-            fifo.flush();
+            // fallback: discard the queue content
+            queue.flush();
         }
-        Q_ASSERT(fifo.length() == 0);
+        Q_ASSERT(queue.isEmpty());
     }
 
     // the queues are no longer needed
@@ -1470,10 +1380,10 @@ void Kwave::RecordPlugin::processBuffer()
 {
     bool recording_done = false;
 
-    // de-queue the buffer from the thread
-    if (!m_thread) return;
-    if (!m_thread->queuedBuffers()) return;
-    QByteArray buffer = m_thread->dequeue();
+    // de-queue the decoded buffer from the decode thread
+    if (!m_decode_thread) return;
+    if (!m_decode_thread->queuedBuffers()) return;
+    QVector<Kwave::SampleArray> buffer = m_decode_thread->dequeue();
 
     // abort here if we have no dialog or no decoder
     if (!m_dialog || !m_decoder) return;
@@ -1485,13 +1395,10 @@ void Kwave::RecordPlugin::processBuffer()
     const unsigned int tracks = params.tracks;
     Q_ASSERT(tracks);
     if (!tracks) return;
+    Q_ASSERT(Kwave::toUint(buffer.size()) == tracks);
+    if (Kwave::toUint(buffer.size()) != tracks) return;
 
-    const unsigned int bytes_per_sample = m_decoder->rawBytesPerSample();
-    Q_ASSERT(bytes_per_sample);
-    if (!bytes_per_sample) return;
-
-    unsigned int buffer_size = static_cast<unsigned int>(buffer.size());
-    unsigned int samples = (buffer_size / bytes_per_sample) / tracks;
+    unsigned int samples = buffer[0].size();
     Q_ASSERT(samples);
     if (!samples) return;
 
@@ -1507,21 +1414,13 @@ void Kwave::RecordPlugin::processBuffer()
                 samples = Kwave::toUint(
                     (limit > already_recorded) ?
                     (limit - already_recorded) : 0);
-                buffer.resize(samples * tracks * bytes_per_sample);
+                for (Kwave::SampleArray &decoded : buffer)
+                    decoded.resize(samples);
             }
             recording_done = true;
         }
     }
 
-    QByteArray buf;
-    buf.resize(bytes_per_sample * samples);
-    Q_ASSERT(buf.size() == Kwave::toInt(bytes_per_sample * samples));
-    if (buf.size() != Kwave::toInt(bytes_per_sample * samples)) return;
-
-    Kwave::SampleArray decoded(samples);
-    Q_ASSERT(decoded.size() == samples);
-    if (decoded.size() != samples) return;
-
     // check for trigger
     // note: this might change the state, which affects the
     //       processing of all tracks !
@@ -1532,10 +1431,7 @@ void Kwave::RecordPlugin::processBuffer()
           params.start_time_enabled))
     {
         for (unsigned int track=0; track < tracks; ++track) {
-            // split off and decode buffer with current track
-            split(buffer, buf, bytes_per_sample, track, tracks);
-            m_decoder->decode(buf, decoded);
-            if (checkTrigger(track, decoded)) {
+            if (checkTrigger(track, buffer[track])) {
                 m_controller.deviceTriggerReached();
                 break;
             }
@@ -1550,10 +1446,7 @@ void Kwave::RecordPlugin::processBuffer()
     // use a copy of the state, in case it changes below ;-)
     Kwave::RecordState state = m_state;
     for (unsigned int track = 0; track < tracks; ++track) {
-        // decode and care for all special effects, meters and so on
-        // split off and decode buffer with current track
-        split(buffer, buf, bytes_per_sample, track, tracks);
-        m_decoder->decode(buf, decoded);
+        Kwave::SampleArray &decoded = buffer[track];
 
         // update the level meter and other effects
         m_dialog->updateEffects(track, decoded);
@@ -32,8 +32,8 @@
 #include "libkwave/Plugin.h"
 #include "libkwave/Sample.h"
 #include "libkwave/SampleArray.h"
-#include "libkwave/SampleFIFO.h"
 #include "libkwave/SampleFormat.h"
+#include "libkwave/SampleRingBuffer.h"
 
 #include "RecordController.h"
 #include "RecordParams.h"
@@ -42,6 +42,7 @@
 namespace Kwave
 {
 
+    class RecordDecodeThread;
     class RecordDevice;
     class RecordDialog;
     class RecordThread;
@@ -198,20 +199,6 @@ namespace Kwave
          */
         bool checkTrigger(unsigned int track, const Kwave::SampleArray &buffer);
 
-        /**
-         * Split off one track from a raw buffer with multiple tracks into
-         * a separate buffer
-         * @param raw_data the raw buffer with multiple tracks
-         * @param dest byte array that receives the data of the specified track
-         * @param bytes_per_sample number of bytes for each sample
-         * @param track index of the track to split off [1...n-1]
-         * @param tracks number of total tracks
-         */
-        void split(QByteArray &raw_data, QByteArray &dest,
-                   unsigned int bytes_per_sample,
-                   unsigned int track,
-                   unsigned int tracks);
-
         /**
          * Enqueue a buffer with decoded samples into a prerecording
          * buffer of the corresponding track.
@@ -234,6 +221,12 @@ namespace Kwave
          */
         bool paramsValid();
 
+        /**
+         * Stops the record thread and the decode thread and processes
+         * all buffers that are still pending
+         */
+        void stopRecordThreads();
+
     private:
 
         /** last recording method */
@@ -257,14 +250,17 @@ namespace Kwave
         /** the thread for recording */
         Kwave::RecordThread *m_thread;
 
+        /** the thread for decoding the recorded raw data */
+        Kwave::RecordDecodeThread *m_decode_thread;
+
         /** decoder for converting raw data to samples */
         Kwave::SampleDecoder *m_decoder;
 
         /**
-         * set of queues for buffering prerecording data, one for each
-         * track
+         * set of ring buffers for buffering prerecording data, one for
+         * each track, preallocated with the full prerecording length
          */
-        QVector<Kwave::SampleFIFO> m_prerecording_queue;
+        QVector<Kwave::SampleRingBuffer> m_prerecording_queue;
 
         /** sink for the audio data */
         Kwave::MultiTrackWriter *m_writers;
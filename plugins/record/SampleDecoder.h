@@ -21,6 +21,7 @@
 #include "config.h"
 
 #include <QByteArray>
+#include <QVector>
 
 #include "libkwave/Sample.h"
 #include "libkwave/SampleArray.h"
@@ -46,6 +47,16 @@ namespace Kwave
         virtual void decode(QByteArray &raw_data,
                             Kwave::SampleArray &decoded) = 0;
 
+        /**
+         * Decodes a buffer with interleaved samples of all tracks in a
+         * single pass over the raw data.
+         * @param raw_data array with raw undecoded audio data
+         * @param decoded one array per track, each one must be large
+         *                enough for all samples of the track
+         */
+        virtual void decode(const QByteArray &raw_data,
+                            QVector<Kwave::SampleArray> &decoded) = 0;
+
         /** Returns the number of bytes per sample in raw (not encoded) form */
         virtual unsigned int rawBytesPerSample() = 0;
 
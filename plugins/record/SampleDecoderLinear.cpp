@@ -17,6 +17,7 @@
 
 #include "config.h"
 
+#include <QVarLengthArray>
 #include <QtGlobal>
 
 #include "libkwave/Sample.h"
@@ -49,67 +50,100 @@ static inline quint32 shl(const quint32 v, const int s)
 
 //***************************************************************************
 /**
- * Template for decoding a buffer with linear samples. The tricky part is
- * done in the compiler which optimizes away all unused parts of current
- * variant and does nice loop optimizing!
- * @param src array with raw data
- * @param dst array that receives the samples in Kwave's format
- * @param count the number of samples to be decoded
+ * Template for decoding a single linear sample. The tricky part is done in
+ * the compiler which optimizes away all unused parts of current variant.
+ * @param src pointer to the raw data, will be advanced to the next sample
+ * @return the sample in Kwave's format
  */
 template<const unsigned int bits, const bool is_signed,
          const bool is_little_endian>
-void decode_linear(const quint8 *src, sample_t *dst, unsigned int count)
+static inline sample_t decode_sample(const quint8 *&src)
 {
     const int shift = (SAMPLE_BITS - bits);
     const quint32 sign = 1 << (SAMPLE_BITS-1);
     const quint32 negative = ~(sign - 1);
     const quint32 bytes = (bits+7) >> 3;
 
-    while (count) {
-        count--;
-
-        // read from source buffer
-        quint32 s = 0;
-        if (is_little_endian) {
-            // little endian
-            for (unsigned int byte = 0; byte < bytes; ++byte, ++src) {
-                s |= static_cast<quint8>(*src) << (byte << 3);
-            }
-        } else {
-            // big endian
-            for (int byte = bytes - 1; byte >= 0; --byte, ++src) {
-                s |= static_cast<quint8>(*src) << (byte << 3);
-            }
+    // read from source buffer
+    quint32 s = 0;
+    if (is_little_endian) {
+        // little endian
+        for (unsigned int byte = 0; byte < bytes; ++byte, ++src) {
+            s |= static_cast<quint8>(*src) << (byte << 3);
+        }
+    } else {
+        // big endian
+        for (int byte = bytes - 1; byte >= 0; --byte, ++src) {
+            s |= static_cast<quint8>(*src) << (byte << 3);
         }
+    }
 
-        // convert to signed
-        if (!is_signed) s -= shl(1, bits-1)-1;
+    // convert to signed
+    if (!is_signed) s -= shl(1, bits-1)-1;
 
-        // shift up to Kwave's bit count
-        s = shl(s, shift);
+    // shift up to Kwave's bit count
+    s = shl(s, shift);
 
-        // sign correcture for negative values
-        if (is_signed && (s & sign)) s |= negative;
+    // sign correcture for negative values
+    if (is_signed && (s & sign)) s |= negative;
 
-        // write to destination buffer
-        *(dst++) = static_cast<sample_t>(s);
-    }
+    return static_cast<sample_t>(s);
 }
 
 //***************************************************************************
-#define MAKE_DECODER(bits)                             \
-if (sample_format != Kwave::SampleFormat::Unsigned) {  \
-    if (endianness != Kwave::BigEndian) {              \
-        m_decoder = decode_linear<bits, true, true>;   \
-    } else {                                           \
-        m_decoder = decode_linear<bits, true, false>;  \
-    }                                                  \
-} else {                                               \
-    if (endianness != Kwave::BigEndian) {              \
-        m_decoder = decode_linear<bits, false, true>;  \
-    } else {                                           \
-        m_decoder = decode_linear<bits, false, false>; \
-    }                                                  \
+/**
+ * Template for decoding a buffer with linear samples and nice loop
+ * optimizing.
+ * @param src array with raw data
+ * @param dst array that receives the samples in Kwave's format
+ * @param count the number of samples to be decoded
+ */
+template<const unsigned int bits, const bool is_signed,
+         const bool is_little_endian>
+void decode_linear(const quint8 *src, sample_t *dst, unsigned int count)
+{
+    while (count--)
+        *(dst++) = decode_sample<bits, is_signed, is_little_endian>(src);
+}
+
+//***************************************************************************
+/**
+ * Template for decoding a buffer with interleaved linear samples of
+ * several tracks, in a single pass over the raw data.
+ * @param src array with raw data
+ * @param dst array of pointers to the destination of each track
+ * @param tracks the number of tracks
+ * @param count the number of samples per track to be decoded
+ */
+template<const unsigned int bits, const bool is_signed,
+         const bool is_little_endian>
+void decode_interleaved(const quint8 *src, sample_t * const *dst,
+                        unsigned int tracks, unsigned int count)
+{
+    for (unsigned int index = 0; index < count; ++index)
+        for (unsigned int track = 0; track < tracks; ++track)
+            dst[track][index] =
+                decode_sample<bits, is_signed, is_little_endian>(src);
+}
+
+//***************************************************************************
+#define MAKE_DECODER(bits)                                                \
+if (sample_format != Kwave::SampleFormat::Unsigned) {                     \
+    if (endianness != Kwave::BigEndian) {                                 \
+        m_decoder             = decode_linear<bits, true, true>;          \
+        m_decoder_interleaved = decode_interleaved<bits, true, true>;     \
+    } else {                                                              \
+        m_decoder             = decode_linear<bits, true, false>;         \
+        m_decoder_interleaved = decode_interleaved<bits, true, false>;    \
+    }                                                                     \
+} else {                                                                  \
+    if (endianness != Kwave::BigEndian) {                                 \
+        m_decoder             = decode_linear<bits, false, true>;         \
+        m_decoder_interleaved = decode_interleaved<bits, false, true>;    \
+    } else {                                                              \
+        m_decoder             = decode_linear<bits, false, false>;        \
+        m_decoder_interleaved = decode_interleaved<bits, false, false>;   \
+    }                                                                     \
 }
 
 //***************************************************************************
@@ -120,7 +154,8 @@ Kwave::SampleDecoderLinear::SampleDecoderLinear(
 )
     :Kwave::SampleDecoder(),
      m_bytes_per_sample((bits_per_sample + 7) >> 3),
-     m_decoder(decode_NULL)
+     m_decoder(decode_NULL),
+     m_decoder_interleaved(nullptr)
 {
     // sanity checks: we support only signed/unsigned and big/little endian
     Q_ASSERT((sample_format == Kwave::SampleFormat::Signed) ||
@@ -177,6 +212,38 @@ void Kwave::SampleDecoderLinear::decode(QByteArray &raw_data,
     m_decoder(src, dst, samples);
 }
 
+//***************************************************************************
+void Kwave::SampleDecoderLinear::decode(const QByteArray &raw_data,
+                                        QVector<Kwave::SampleArray> &decoded)
+{
+    const unsigned int tracks = Kwave::toUint(decoded.size());
+    Q_ASSERT(tracks);
+    if (!tracks) return;
+
+    const unsigned int raw_size = static_cast<unsigned int>(raw_data.size());
+    const unsigned int samples  = (raw_size / m_bytes_per_sample) / tracks;
+    const quint8 *src = reinterpret_cast<const quint8 *>(raw_data.constData());
+
+    Q_ASSERT(m_decoder_interleaved);
+    if (!m_decoder_interleaved) return; // unsupported format
+
+    if (tracks == 1) {
+        // nothing to de-interleave
+        Q_ASSERT(decoded[0].size() >= samples);
+        sample_t *dst = decoded[0].data();
+        if (dst) m_decoder(src, dst, samples);
+        return;
+    }
+
+    QVarLengthArray<sample_t *, 32> dst(tracks);
+    for (unsigned int track = 0; track < tracks; ++track) {
+        Q_ASSERT(decoded[track].size() >= samples);
+        dst[track] = decoded[track].data();
+        if (!dst[track]) return; // out of memory
+    }
+    m_decoder_interleaved(src, dst.constData(), tracks, samples);
+}
+
 //***************************************************************************
 unsigned int Kwave::SampleDecoderLinear::rawBytesPerSample()
 {
@@ -52,6 +52,16 @@ namespace Kwave
         virtual void decode(QByteArray &raw_data,
                             Kwave::SampleArray &decoded) override;
 
+        /**
+         * Decodes a buffer with interleaved samples of all tracks in a
+         * single pass over the raw data.
+         * @param raw_data array with raw undecoded audio data
+         * @param decoded one array per track, each one must be large
+         *                enough for all samples of the track
+         */
+        void decode(const QByteArray &raw_data,
+                    QVector<Kwave::SampleArray> &decoded) override;
+
         /** Returns the number of bytes per sample in raw (not encoded) form */
         unsigned int rawBytesPerSample() override;
 
@@ -63,6 +73,10 @@ namespace Kwave
         /** optimized function used for decoding the given format */
         void(*m_decoder)(const quint8 *, sample_t*, unsigned int);
 
+        /** function used for decoding and de-interleaving all tracks */
+        void(*m_decoder_interleaved)(const quint8 *, sample_t * const *,
+                                     unsigned int, unsigned int);
+
     };
 }
 
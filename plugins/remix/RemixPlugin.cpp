@@ -0,0 +1,173 @@
+/***************************************************************************
+        RemixPlugin.cpp  -  remixes all tracks with a mixer matrix
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+#include <errno.h>
+
+#include <KLocalizedString>
+
+#include "libkwave/Connect.h"
+#include "libkwave/MessageBox.h"
+#include "libkwave/MixerMatrix.h"
+#include "libkwave/MultiTrackReader.h"
+#include "libkwave/MultiTrackWriter.h"
+#include "libkwave/SignalManager.h"
+#include "libkwave/Utils.h"
+#include "libkwave/modules/ChannelMixer.h"
+#include "libkwave/undo/UndoTransactionGuard.h"
+
+#include "RemixPlugin.h"
+
+KWAVE_PLUGIN(remix, RemixPlugin)
+
+/** highest number of new tracks */
+#define MAX_OUTPUTS 256
+
+//***************************************************************************
+Kwave::RemixPlugin::RemixPlugin(QObject *parent, const QVariantList &args)
+    :Kwave::Plugin(parent, args), m_outputs(0), m_factors()
+{
+}
+
+//***************************************************************************
+Kwave::RemixPlugin::~RemixPlugin()
+{
+}
+
+//***************************************************************************
+int Kwave::RemixPlugin::interpreteParameters(QStringList &params)
+{
+    bool ok = false;
+
+    // remix(outputs [, factors...])
+    m_outputs = 0;
+    m_factors.clear();
+    if (params.count() < 1) return -EINVAL;
+
+    m_outputs = params[0].toUInt(&ok);
+    if (!ok || !m_outputs || (m_outputs > MAX_OUTPUTS)) return -EINVAL;
+
+    for (int i = 1; i < params.count(); ++i) {
+        const double factor = params[i].toDouble(&ok);
+        if (!ok) return -EINVAL;
+        m_factors.append(factor);
+    }
+
+    return 0;
+}
+
+//***************************************************************************
+int Kwave::RemixPlugin::start(QStringList &params)
+{
+    int result = interpreteParameters(params);
+    if (result) return result;
+
+    const unsigned int inputs = signalManager().tracks();
+    if (!m_factors.isEmpty() &&
+        (Kwave::toUint(m_factors.count()) != inputs * m_outputs))
+    {
+        Kwave::MessageBox::sorry(parentWidget(),
+            i18n("The number of factors does not fit to the "
+                 "number of tracks of the signal."));
+        return -EINVAL;
+    }
+
+    return Kwave::Plugin::start(params);
+}
+
+//***************************************************************************
+void Kwave::RemixPlugin::run(QStringList params)
+{
+    Kwave::SignalManager &mgr = signalManager();
+
+    if (interpreteParameters(params) < 0)
+        return;
+
+    const QVector<unsigned int> tracks = mgr.allTracks();
+    const unsigned int inputs = Kwave::toUint(tracks.count());
+    const sample_index_t length = signalLength();
+    if (!inputs || !length) return;
+    if (!m_factors.isEmpty() &&
+        (Kwave::toUint(m_factors.count()) != inputs * m_outputs))
+        return;
+
+    // set up the matrix, nothing to do if it would not change anything
+    Kwave::MixerMatrix matrix(inputs, m_outputs);
+    if (!m_factors.isEmpty()) {
+        for (unsigned int y = 0; y < m_outputs; y++)
+            for (unsigned int x = 0; x < inputs; x++)
+                matrix[x][y] = m_factors[Kwave::toInt(y * inputs + x)];
+        matrix.update();
+    }
+    if (matrix.type() == Kwave::MixerMatrix::Identity) return;
+
+    Kwave::ChannelMixer mixer(matrix);
+    if (!mixer.init()) return;
+
+    Kwave::UndoTransactionGuard undo_guard(*this, i18n("Remix Channels"));
+
+    // append the new tracks behind the old ones
+    QVector<unsigned int> new_tracks;
+    for (unsigned int y = 0; y < m_outputs; y++) {
+        mgr.appendTrack();
+        new_tracks.append(inputs + y);
+    }
+
+    bool ok = (mgr.tracks() == inputs + m_outputs);
+    if (ok) {
+        // old tracks -> mixer -> new tracks
+        Kwave::MultiTrackReader source(Kwave::SinglePassForward,
+            mgr, tracks, 0, length - 1);
+        Kwave::MultiTrackWriter sink(mgr, new_tracks, Kwave::Overwrite,
+            0, length - 1);
+
+        // connect the progress dialog
+        connect(&source, SIGNAL(progress(qreal)),
+                this,    SLOT(updateProgress(qreal)),
+                Qt::BlockingQueuedConnection);
+        emit setProgressText(i18n("Remixing channels..."));
+
+        ok = Kwave::connect(
+            source, SIGNAL(output(Kwave::SampleArray)),
+            mixer,  SLOT(input(Kwave::SampleArray)));
+        if (ok) ok = Kwave::connect(
+            mixer,  SIGNAL(output(Kwave::SampleArray)),
+            sink,   SLOT(input(Kwave::SampleArray)));
+
+        while (ok && !shouldStop() && !source.eof())
+            source.goOn();
+
+        sink.flush();
+    }
+
+    // replace the old tracks with the new ones, or discard the new
+    // ones if something went wrong or the user has canceled
+    if (ok && !shouldStop()) {
+        for (unsigned int x = inputs; x > 0; x--)
+            mgr.deleteTrack(tracks[Kwave::toInt(x - 1)]);
+    } else {
+        while (mgr.tracks() > inputs)
+            mgr.deleteTrack(mgr.tracks() - 1);
+    }
+}
+
+//***************************************************************************
+#include "RemixPlugin.moc"
+//***************************************************************************
+//***************************************************************************
+
+#include "moc_RemixPlugin.cpp"
@@ -0,0 +1,90 @@
+/***************************************************************************
+          RemixPlugin.h  -  remixes all tracks with a mixer matrix
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef REMIX_PLUGIN_H
+#define REMIX_PLUGIN_H
+
+#include "config.h"
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "libkwave/Plugin.h"
+
+namespace Kwave
+{
+
+    /**
+     * Replaces all tracks of the signal with a new set of tracks, each
+     * of them a weighted sum of the old tracks, e.g. for mixing down to
+     * mono or for swapping channels.
+     *
+     * Parameters: <c>remix(outputs [, factors...])</c>, without factors
+     * the tracks are mixed up or down to the given number of tracks,
+     * otherwise the factors of all old tracks for the first new track
+     * follow, then those for the second new track and so on.
+     */
+    class RemixPlugin: public Kwave::Plugin
+    {
+        Q_OBJECT
+
+    public:
+
+        /**
+         * Constructor
+         * @param parent reference to our plugin manager
+         * @param args argument list [unused]
+         */
+        RemixPlugin(QObject *parent, const QVariantList &args);
+
+        /** Destructor */
+        ~RemixPlugin() override;
+
+        /**
+         * Checks the parameters against the current signal
+         * @param params list of strings with parameters
+         * @return zero if successful or negative error code
+         */
+        int start(QStringList &params) override;
+
+        /**
+         * Does the remixing
+         * @param params list of strings with parameters
+         */
+        void run(QStringList params) override;
+
+    protected:
+
+        /** reads values from the parameter list */
+        int interpreteParameters(QStringList &params);
+
+    private:
+
+        /** number of new tracks */
+        unsigned int m_outputs;
+
+        /** factors of the old tracks, per new track, or empty */
+        QVector<double> m_factors;
+
+    };
+}
+
+#endif /* REMIX_PLUGIN_H */
+
+//***************************************************************************
+//***************************************************************************
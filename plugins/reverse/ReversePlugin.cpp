@@ -26,11 +26,11 @@
 #include <QSharedPointer>
 #include <QStringList>
 #include <QThread>
-#include <QtConcurrentRun>
 
 #include "libkwave/MultiTrackReader.h"
 #include "libkwave/PluginManager.h"
 #include "libkwave/SignalManager.h"
+#include "libkwave/TaskPool.h"
 #include "libkwave/String.h"
 #include "libkwave/Utils.h"
 #include "libkwave/Writer.h"
@@ -113,7 +113,8 @@ void Kwave::ReversePlugin::run(QStringList params)
 
         // loop over all tracks
         for (int i = 0; i < tracks.count(); i++) {
-            synchronizer.addFuture(QtConcurrent::run(
+            synchronizer.addFuture(Kwave::TaskPool::run(
+                Kwave::TaskPool::Background,
                 &Kwave::ReversePlugin::reverseSlice,
                 this,
                 tracks[i], source_a[i], source_b[i],
@@ -222,7 +222,8 @@ int Kwave::SaveBlocksPlugin::start(QStringList &params)
     // remember the original file info and determine the list of unsupported
     // properties, we need that later to avoid that the signal manager
     // complains on saving each and every block, again and again...
-    const Kwave::FileInfo orig_file_info(signalManager().metaData());
+    const Kwave::FileInfo orig_file_info(
+        std::as_const(signalManager()).metaData());
     Kwave::FileInfo file_info(orig_file_info);
     QList<Kwave::FileProperty> unsupported_properties;
     {
@@ -316,7 +317,7 @@ int Kwave::SaveBlocksPlugin::start(QStringList &params)
     // now we can loop over all blocks and save them
     sample_index_t block_start;
     sample_index_t block_end = 0;
-    Kwave::LabelList labels(signalManager().metaData());
+    Kwave::LabelList labels(std::as_const(signalManager()).metaData());
     Kwave::LabelListIterator it(labels);
     Kwave::Label label = it.hasNext() ? it.next() : Kwave::Label();
 
@@ -368,6 +369,11 @@ int Kwave::SaveBlocksPlugin::start(QStringList &params)
             if (signalManager().save(url, true) < 0)
                 break;
 
+            // the block is encoded in background, wait for it and stop
+            // at the first block that could not be saved
+            if (signalManager().waitForSave())
+                break;
+
             // if there were unsupported properties, the user might have been
             // asked whether it is ok to continue or not. If he answered with
             // "Cancel", we do not reach this point, otherwise we can continue
@@ -446,7 +452,7 @@ void Kwave::SaveBlocksPlugin::scanBlocksToSave(const QString &base,
     sample_index_t block_start;
     sample_index_t block_end = 0;
     QString        block_title;
-    Kwave::LabelList labels(signalManager().metaData());
+    Kwave::LabelList labels(std::as_const(signalManager()).metaData());
     Kwave::LabelListIterator it(labels);
     Kwave::Label label = (it.hasNext()) ? it.next() : Kwave::Label();
 
@@ -459,7 +465,7 @@ void Kwave::SaveBlocksPlugin::scanBlocksToSave(const QString &base,
 
     // get the title of the whole file, in case that a block does not have
     // an own title
-    FileInfo info(signalManager().metaData());
+    FileInfo info(std::as_const(signalManager()).metaData());
     QString file_title = info.get(INF_NAME).toString();
 
     // fallback: if there is no INF_NAME either, fall back to the file
@@ -560,7 +566,7 @@ QString Kwave::SaveBlocksPlugin::createFileName(const QString &base,
         _("\\\\\\[\\\\%(\\d*)fileinfo\\\\\\{([\\w\\s]+)\\\\\\}\\\\\\]"),
         QRegularExpression::CaseInsensitiveOption
     );
-    Kwave::FileInfo info(signalManager().metaData());
+    Kwave::FileInfo info(std::as_const(signalManager()).metaData());
     i = rx_fileinfo.globalMatch(p);
     while (i.hasNext()) {
         QRegularExpressionMatch match = i.next();
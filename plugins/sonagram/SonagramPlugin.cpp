@@ -18,30 +18,18 @@
 #include "config.h"
 
 #include <errno.h>
-#include <math.h>
-#include <stdlib.h>
 
-#include <limits>
 #include <new>
 
-#include <QApplication>
 #include <QColor>
-#include <QFutureSynchronizer>
 #include <QImage>
-#include <QMutexLocker>
 #include <QPointer>
 #include <QString>
-#include <QtConcurrentRun>
 
-#include "libkwave/GlobalLock.h"
-#include "libkwave/MessageBox.h"
-#include "libkwave/MultiTrackReader.h"
 #include "libkwave/Plugin.h"
 #include "libkwave/PluginManager.h"
 #include "libkwave/Sample.h"
-#include "libkwave/SampleReader.h"
 #include "libkwave/SignalManager.h"
-#include "libkwave/Track.h"
 #include "libkwave/Utils.h"
 #include "libkwave/WindowFunction.h"
 
@@ -50,6 +38,7 @@
 
 #include "SonagramDialog.h"
 #include "SonagramPlugin.h"
+#include "SonagramTileCache.h"
 #include "SonagramWindow.h"
 
 KWAVE_PLUGIN(sonagram, SonagramPlugin)
@@ -65,20 +54,15 @@ Kwave::SonagramPlugin::SonagramPlugin(QObject *parent,
     :Kwave::Plugin(parent, args),
      m_sonagram_window(nullptr),
      m_selection(nullptr),
-     m_slices(0), m_fft_points(0),
+     m_fft_points(0),
      m_window_type(Kwave::WINDOW_FUNC_NONE), m_color(true),
-     m_track_changes(true), m_follow_selection(false), m_image(),
-     m_overview_cache(nullptr), m_slice_pool(), m_valid(MAX_SLICES, false),
-     m_pending_jobs(), m_lock_job_list(), m_future(),
+     m_track_changes(true), m_follow_selection(false),
+     m_overview_cache(nullptr), m_tile_cache(nullptr),
+     m_stride(0), m_first_column(0), m_view_width(0), m_zoom_all(true),
      m_repaint_timer()
 {
     i18n("Sonagram");
 
-    // connect the output ouf the sonagram worker thread
-    connect(this, SIGNAL(sliceAvailable(Kwave::SonagramPlugin::Slice*)),
-            this, SLOT(insertSlice(Kwave::SonagramPlugin::Slice*)),
-            Qt::QueuedConnection);
-
     // connect repaint timer
     connect(&m_repaint_timer, SIGNAL(timeout()),
             this, SLOT(validate()));
@@ -92,6 +76,9 @@ Kwave::SonagramPlugin::~SonagramPlugin()
     delete m_sonagram_window;
     m_sonagram_window = nullptr;
 
+    delete m_tile_cache;
+    m_tile_cache = nullptr;
+
     delete m_selection;
     m_selection = nullptr;
 }
@@ -162,6 +149,8 @@ int Kwave::SonagramPlugin::start(QStringList &params)
     // clean up leftovers from last run
     delete m_sonagram_window;
     m_sonagram_window = nullptr;
+    delete m_tile_cache;
+    m_tile_cache = nullptr;
     delete m_selection;
     m_selection = nullptr;
     delete m_overview_cache;
@@ -172,6 +161,7 @@ int Kwave::SonagramPlugin::start(QStringList &params)
     // interpret parameter list and abort if it contains invalid data
     int result = interpreteParameters(params);
     if (result) return result;
+    if (m_fft_points < 4) return -EINVAL;
 
     // create an empty sonagram window
     m_sonagram_window = new(std::nothrow)
@@ -193,18 +183,6 @@ int Kwave::SonagramPlugin::start(QStringList &params)
     if (!length || selected_channels.isEmpty())
         return -EINVAL;
 
-    // calculate the number of slices (width of image)
-    m_slices = Kwave::toUint(ceil(static_cast<double>(length) /
-                                  static_cast<double>(m_fft_points)));
-    if (m_slices > MAX_SLICES) m_slices = MAX_SLICES;
-
-    /* limit selection to INT_MAX samples (limitation of the cache index) */
-    if ((length / m_fft_points) >= SAMPLE_INDEX_MAX) {
-        Kwave::MessageBox::error(parentWidget(),
-                                 i18n("File or selection too large"));
-        return -EFBIG;
-    }
-
     // create a selection tracker
     m_selection = new(std::nothrow) Kwave::SelectionTracker(
         &sig_mgr, offset, length, &selected_channels);
@@ -222,8 +200,14 @@ int Kwave::SonagramPlugin::start(QStringList &params)
         SLOT(slotInvalidated(const QUuid*,sample_index_t,sample_index_t))
     );
 
-    // create a new empty image
-    createNewImage(m_slices, m_fft_points / 2);
+    // create the cache for the tiles of the sonagram
+    m_tile_cache = new(std::nothrow) Kwave::SonagramTileCache(sig_mgr);
+    Q_ASSERT(m_tile_cache);
+    if (!m_tile_cache) return -ENOMEM;
+    m_tile_cache->setParameters(m_fft_points, m_window_type);
+    updateSource();
+    connect(m_tile_cache, SIGNAL(sigTilesReady()),
+            this,         SLOT(requestValidation()));
 
     // set the overview
     m_overview_cache = new(std::nothrow)
@@ -246,14 +230,26 @@ int Kwave::SonagramPlugin::start(QStringList &params)
     // connect all needed signals
     connect(m_sonagram_window, SIGNAL(destroyed()),
             this, SLOT(windowDestroyed()));
-
-    // activate the window with an initial image
-    // and all necessary information
+    connect(m_sonagram_window, SIGNAL(sigZoom(int)),
+            this, SLOT(slotZoom(int)));
+    connect(m_sonagram_window, SIGNAL(sigScroll(int)),
+            this, SLOT(slotScroll(int)));
+    connect(m_sonagram_window, SIGNAL(sigViewResized(int)),
+            this, SLOT(slotViewResized(int)));
+
+    // start with showing everything
+    m_view_width   = m_sonagram_window->viewWidth();
+    m_zoom_all     = true;
+    m_stride       = fitStride();
+    m_first_column = 0;
+
+    // activate the window with all necessary information,
+    // the image is filled as soon as the first tiles are ready
     m_sonagram_window->setColorMode((m_color) ? 1 : 0);
-    m_sonagram_window->setImage(m_image);
     m_sonagram_window->setPoints(m_fft_points);
     m_sonagram_window->setRate(signalRate());
     m_sonagram_window->show();
+    validate();
 
     if (m_track_changes) {
         QObject::connect(static_cast<QObject*>(&(manager())),
@@ -269,234 +265,35 @@ int Kwave::SonagramPlugin::start(QStringList &params)
 }
 
 //***************************************************************************
-void Kwave::SonagramPlugin::makeAllValid()
+void Kwave::SonagramPlugin::updateSource()
 {
-    unsigned int             fft_points;
-    unsigned int             slices;
-    Kwave::window_function_t window_type;
-    sample_index_t           first_sample;
-    sample_index_t           last_sample;
-    QBitArray                valid;
-    QVector<unsigned int>    track_list;
-
-    {
-        QMutexLocker _lock(&m_lock_job_list);
-
-        if (!m_selection) return;
-        if (!m_selection->length() || (m_fft_points < 4)) return;
-
-        fft_points   = m_fft_points;
-        slices       = m_slices;
-        window_type  = m_window_type;
-        first_sample = m_selection->first();
-        last_sample  = m_selection->last();
-        valid        = m_valid;
-        m_valid.fill(true);
-
-        const QList<QUuid> selected_tracks(m_selection->allTracks());
-        foreach (unsigned int track, signalManager().allTracks())
-            if (selected_tracks.contains(signalManager().uuidOfTrack(track)))
-                track_list.append(track);
-    }
-    const unsigned int tracks = static_cast<unsigned int>(track_list.count());
-
-    Kwave::WindowFunction func(window_type);
-    const QVector<double> windowfunction = func.points(fft_points);
-    Q_ASSERT(windowfunction.count() == Kwave::toInt(fft_points));
-    if (windowfunction.count() != Kwave::toInt(fft_points)) return;
-
-    Kwave::MultiTrackReader source(Kwave::SinglePassForward,
-        signalManager(), track_list, first_sample, last_sample);
-
-//     qDebug("SonagramPlugin[%p]::makeAllValid() [%llu .. %llu]",
-//      static_cast<void *>(this), first_sample, last_sample);
-
-    QFutureSynchronizer<void> synchronizer;
-    for (unsigned int slice_nr = 0; slice_nr < slices; slice_nr++) {
-//      qDebug("SonagramPlugin::run(): calculating slice %d of %d",
-//             slice_nr, m_slices);
-
-        if (valid[slice_nr]) continue;
-
-        // determine start of the stripe
-        sample_index_t pos = first_sample + (slice_nr * fft_points);
-
-        // get a new slice from the pool and initialize it
-        Kwave::SonagramPlugin::Slice *slice = m_slice_pool.allocate();
-        Q_ASSERT(slice);
-
-        slice->m_index = slice_nr;
-        memset(slice->m_input,  0x00, sizeof(slice->m_input));
-        memset(slice->m_output, 0x00, sizeof(slice->m_output));
-
-        if ((pos <= last_sample) && (tracks)) {
-            // initialize result with zeroes
-            memset(slice->m_result, 0x00, sizeof(slice->m_result));
-
-            // seek to the start of the slice
-            source.seek(pos);
-
-            // we have a new slice, now fill it's input buffer
-            double *in = slice->m_input;
-            for (unsigned int j = 0; j < fft_points; j++) {
-                double value = 0.0;
-                if (!(source.eof())) {
-                    for (unsigned int t = 0; t < tracks; t++) {
-                        sample_t s = 0;
-                        Kwave::SampleReader *reader = source[t];
-                        Q_ASSERT(reader);
-                        if (reader) *reader >> s;
-                        value += sample2double(s);
-                    }
-                    value /= tracks;
-                }
-                in[j] = value * windowfunction[j];
-            }
-
-            // a background job is running soon
-            // (for counterpart, see insertSlice(...) below [main thread])
-            m_pending_jobs.lockForRead();
-
-            // run the FFT in a background thread
-            synchronizer.addFuture(QtConcurrent::run(
-                &Kwave::SonagramPlugin::calculateSlice, this, slice)
-            );
-        } else {
-            // range has been deleted -> fill with "empty"
-            memset(slice->m_result, 0xFF, sizeof(slice->m_result));
-            m_pending_jobs.lockForRead();
-            emit sliceAvailable(slice);
-        }
-
-        if (shouldStop()) break;
-    }
+    if (!m_selection || !m_tile_cache) return;
 
-//     qDebug("SonagramPlugin::makeAllValid(): waiting for background jobs...");
+    QVector<unsigned int> track_list;
+    const QList<QUuid> selected_tracks(m_selection->allTracks());
+    foreach (unsigned int track, signalManager().allTracks())
+        if (selected_tracks.contains(signalManager().uuidOfTrack(track)))
+            track_list.append(track);
 
-    // wait for all worker threads
-    synchronizer.waitForFinished();
-
-    // wait for queued signals
-    m_pending_jobs.lockForWrite();
-    m_pending_jobs.unlock();
-
-//     qDebug("SonagramPlugin::makeAllValid(): done.");
-}
-
-//***************************************************************************
-void Kwave::SonagramPlugin::run(QStringList params)
-{
-    qDebug("SonagramPlugin::run()");
-    Q_UNUSED(params)
-    {
-        // invalidate all slices
-        QMutexLocker _lock(&m_lock_job_list);
-        m_valid.fill(false);
-    }
-    makeAllValid();
+    m_tile_cache->setSource(m_selection->offset(), m_selection->length(),
+                            track_list);
 }
 
 //***************************************************************************
-void Kwave::SonagramPlugin::calculateSlice(Kwave::SonagramPlugin::Slice *slice)
+sample_index_t Kwave::SonagramPlugin::fitStride() const
 {
-    fftw_plan p;
-
-    // prepare for a 1-dimensional real-to-complex DFT
-    {
-        Kwave::GlobalLock _lock; // libfftw is not threadsafe!
-        p = fftw_plan_dft_r2c_1d(
-            m_fft_points,
-            &(slice->m_input[0]),
-            &(slice->m_output[0]),
-            FFTW_ESTIMATE
-        );
-    }
-    Q_ASSERT(p);
-    if (!p) return;
-
-    // calculate the fft (according to the specs, this is the one and only
-    // libfft function that is threadsafe!)
-    fftw_execute(p);
-
-    // norm all values to [0...254] and use them as pixel value
-    const double scale = static_cast<double>(m_fft_points) / 254.0;
-    for (unsigned int j = 0; j < m_fft_points / 2; j++) {
-        // get singal energy and scale to [0 .. 254]
-        double rea = slice->m_output[j][0];
-        double ima = slice->m_output[j][1];
-        double a = ((rea * rea) + (ima * ima)) / scale;
-
-        slice->m_result[j] = static_cast<unsigned char>(qMin(a, double(254.0)));
-    }
-
-    // free the allocated FFT resources
-    {
-        Kwave::GlobalLock _lock; // libfftw is not threadsafe!
-        fftw_destroy_plan(p);
-    }
-
-    // emit the slice data to be synchronously inserted into
-    // the current image in the context of the main thread
-    // (Qt does the queuing for us)
-    emit sliceAvailable(slice);
+    const sample_index_t length = (m_selection) ? m_selection->length() : 0;
+    const sample_index_t width  = static_cast<sample_index_t>(
+        qMax(1, m_view_width));
+    const sample_index_t stride = (length + width - 1) / width;
+    return qMax(static_cast<sample_index_t>(m_fft_points), stride);
 }
 
 //***************************************************************************
-void Kwave::SonagramPlugin::insertSlice(Kwave::SonagramPlugin::Slice *slice)
+sample_index_t Kwave::SonagramPlugin::columns() const
 {
-    // check: this must be called from the GUI thread only!
-    Q_ASSERT(this->thread() == QThread::currentThread());
-    Q_ASSERT(this->thread() == qApp->thread());
-
-    Q_ASSERT(slice);
-    if (!slice) return;
-
-    QByteArray result;
-    result.setRawData(reinterpret_cast<char *>(&(slice->m_result[0])),
-                      m_fft_points / 2);
-    unsigned int nr = slice->m_index;
-
-    // forward the slice to the window to display it
-    if (m_sonagram_window) m_sonagram_window->insertSlice(nr, result);
-
-    // return the slice into the pool
-    m_slice_pool.release(slice);
-
-    // job is done
-    m_pending_jobs.unlock();
-}
-
-//***************************************************************************
-void Kwave::SonagramPlugin::createNewImage(const unsigned int width,
-                                           const unsigned int height)
-{
-    // delete the previous image
-    m_image = QImage();
-    if (m_sonagram_window) m_sonagram_window->setImage(m_image);
-
-    // do not create a new image if one dimension is zero!
-    Q_ASSERT(width);
-    Q_ASSERT(height);
-    if (!width || !height) return;
-
-    // also do not create if the image size is out of range
-    Q_ASSERT(width <= 32767);
-    Q_ASSERT(height <= 32767);
-    if ((width >= 32767) || (height >= 32767)) return;
-
-    // create the new image object
-    m_image = QImage(width, height, QImage::Format_Indexed8);
-    Q_ASSERT(!m_image.isNull());
-    if (m_image.isNull()) return;
-
-    // initialize the image's palette with transparecy
-    m_image.setColorCount(256);
-    for (int i = 0; i < 256; i++) {
-        m_image.setColor(i, 0x00000000);
-    }
-
-    // fill the image with "empty" (transparent)
-    m_image.fill(0xFF);
+    const sample_index_t length = (m_selection) ? m_selection->length() : 0;
+    return (m_stride) ? ((length + m_stride - 1) / m_stride) : 0;
 }
 
 //***************************************************************************
@@ -526,43 +323,104 @@ void Kwave::SonagramPlugin::requestValidation()
 //***************************************************************************
 void Kwave::SonagramPlugin::validate()
 {
-    // wait for previously running jobs to finish
-    if (m_future.isRunning()) {
-        requestValidation();
-        return; // job is still running, come back later...
+    if (!m_sonagram_window || !m_selection || !m_tile_cache) return;
+
+    updateSource();
+    if (m_zoom_all) m_stride = fitStride();
+    const sample_index_t total = columns();
+    if (!total) {
+        m_sonagram_window->setImage(QImage());
+        return;
+    }
+
+    // one pixel per column, the view scales it to the window
+    const int width = Kwave::toInt(qMin(total,
+        static_cast<sample_index_t>(qMax(1, m_view_width))));
+    if (m_first_column + width > total) m_first_column = total - width;
+
+    QImage image(width, Kwave::toInt(m_fft_points / 2),
+                 QImage::Format_Indexed8);
+    Q_ASSERT(!image.isNull());
+    if (image.isNull()) return;
+
+    // initialize the image's palette with transparency,
+    // the window sets the colors
+    image.setColorCount(256);
+    for (int i = 0; i < 256; i++) {
+        image.setColor(i, 0x00000000);
     }
 
-    // queue a background thread for updates
-    m_future = QtConcurrent::run(&Kwave::SonagramPlugin::makeAllValid, this);
+    // missing tiles are computed in the background and trigger
+    // another validation when they are done
+    m_tile_cache->compose(image, m_stride, m_first_column);
+
+    m_sonagram_window->setViewport(m_first_column, total, m_stride);
+    m_sonagram_window->setImage(image);
 }
 
 //***************************************************************************
-void Kwave::SonagramPlugin::slotTrackInserted(const QUuid &track_id)
+void Kwave::SonagramPlugin::slotZoom(int direction)
 {
-    QMutexLocker _lock(&m_lock_job_list);
+    if (!m_selection || !m_stride) return;
+
+    // keep the sample in the center of the view at its position
+    const sample_index_t half   = static_cast<sample_index_t>(
+        qMax(1, m_view_width) / 2);
+    const sample_index_t center = (m_first_column + half) * m_stride;
+    const sample_index_t fit    = fitStride();
+    const sample_index_t min    = static_cast<sample_index_t>(m_fft_points);
+
+    if (direction > 0)
+        m_stride = qMax(min, m_stride / 2);
+    else if (direction < 0)
+        m_stride = qMin(fit, m_stride * 2);
+    else
+        m_stride = fit;
+    m_zoom_all = (m_stride >= fit);
+
+    const sample_index_t column = center / m_stride;
+    m_first_column = (column > half) ? (column - half) : 0;
+    validate();
+}
 
+//***************************************************************************
+void Kwave::SonagramPlugin::slotScroll(int first_column)
+{
+    m_first_column = static_cast<sample_index_t>(qMax(0, first_column));
+    validate();
+}
+
+//***************************************************************************
+void Kwave::SonagramPlugin::slotViewResized(int width)
+{
+    if (width == m_view_width) return;
+    m_view_width = width;
+    requestValidation();
+}
+
+//***************************************************************************
+void Kwave::SonagramPlugin::slotTrackInserted(const QUuid &track_id)
+{
     Q_UNUSED(track_id)
 
     // check for "track changes" mode
     if (!m_track_changes) return;
 
-    // invalidate complete signal
-    m_valid.fill(false, m_slices);
+    // the list of tracks has changed -> invalidate complete signal
+    updateSource();
     requestValidation();
 }
 
 //***************************************************************************
 void Kwave::SonagramPlugin::slotTrackDeleted(const QUuid &track_id)
 {
-    QMutexLocker _lock(&m_lock_job_list);
-
     Q_UNUSED(track_id)
 
     // check for "track changes" mode
     if (!m_track_changes) return;
 
-    // invalidate complete signal
-    m_valid.fill(false, m_slices);
+    // the list of tracks has changed -> invalidate complete signal
+    updateSource();
     requestValidation();
 }
 
@@ -571,8 +429,6 @@ void Kwave::SonagramPlugin::slotInvalidated(const QUuid *track_id,
                                             sample_index_t first,
                                             sample_index_t last)
 {
-    QMutexLocker lock(&m_lock_job_list);
-
     Q_UNUSED(track_id)
 //     qDebug("SonagramPlugin[%p]::slotInvalidated(%s, %llu, %llu)",
 //          static_cast<void *>(this),
@@ -580,6 +436,7 @@ void Kwave::SonagramPlugin::slotInvalidated(const QUuid *track_id,
 
     // check for "track changes" mode
     if (!m_track_changes) return;
+    if (!m_tile_cache) return;
 
     // adjust offsets, absolute -> relative
     sample_index_t offset = (m_selection) ? m_selection->offset() : 0;
@@ -589,17 +446,10 @@ void Kwave::SonagramPlugin::slotInvalidated(const QUuid *track_id,
     first -= offset;
     last  -= offset;
 
-    unsigned int first_idx = Kwave::toUint(first / m_fft_points);
-    unsigned int last_idx;
-    if (last >= (SAMPLE_INDEX_MAX - (m_fft_points - 1)))
-        last_idx = m_slices - 1;
-    else
-        last_idx = Kwave::toUint(qMin(Kwave::round_up(last,
-            static_cast<sample_index_t>(m_fft_points)) / m_fft_points,
-            static_cast<sample_index_t>(m_slices - 1))
-        );
-
-    m_valid.fill(false, first_idx, last_idx + 1);
+    // a changed length discards everything, otherwise only the
+    // tiles that overlap with the modified range
+    updateSource();
+    m_tile_cache->invalidate(first, last);
     requestValidation();
 }
 
@@ -610,6 +460,9 @@ void Kwave::SonagramPlugin::windowDestroyed()
 
     m_sonagram_window = nullptr; // closes itself !
 
+    delete m_tile_cache;
+    m_tile_cache = nullptr;
+
     delete m_selection;
     m_selection = nullptr;
 
@@ -20,39 +20,22 @@
 
 #include "config.h"
 
-#include <fftw3.h>
-
-#include <QBitArray>
-#include <QByteArray>
-#include <QFuture>
-#include <QList>
-#include <QMutex>
-#include <QQueue>
-#include <QReadWriteLock>
-#include <QRecursiveMutex>
 #include <QString>
 #include <QTimer>
 #include <QUuid>
+#include <QVector>
 
-#include "libkwave/FixedPool.h"
 #include "libkwave/Plugin.h"
 #include "libkwave/WindowFunction.h"
 
-class QImage;
-
 /** maximum number of FFT points */
 #define MAX_FFT_POINTS 32767
 
-/** maximum number of concurrent FFT jobs */
-#define MAX_FFT_JOBS 256
-
-/** maximum number of slices (width of the image) */
-#define MAX_SLICES 32767
-
 namespace Kwave
 {
     class OverViewCache;
     class SelectionTracker;
+    class SonagramTileCache;
     class SonagramWindow;
 
     /**
@@ -77,48 +60,25 @@ namespace Kwave
         virtual QStringList *setup(QStringList &previous_params)
             override;
 
-        /** @see Kwave::Plugin::start() */
-        int start(QStringList &params) override;
-
         /**
-         * Runns once until all slices of the sonagram are
-         * calculated.
-         * @param params list of strings with parameters
-         * @see Kwave::Plugin::run()
+         * Shows the sonagram window, the sonagram itself is computed
+         * on demand, only for the visible part
+         * @see Kwave::Plugin::start()
          */
-        void run(QStringList params) override;
-
-    private:
-
-        /** internal data of a slice */
-        typedef struct {
-            /** index of the slice */
-            unsigned int m_index;
-
-            /** array with input samples */
-            double m_input[MAX_FFT_POINTS];
-
-            /** FFT output data */
-            fftw_complex m_output[MAX_FFT_POINTS];
-
-            /** rendered FFT result data */
-            unsigned char m_result[MAX_FFT_POINTS];
-        } Slice;
+        int start(QStringList &params) override;
 
-    signals:
+    private slots:
 
         /**
-         * emitted when a new slice has been calculated in calculateSlice()
-         * @param slice the slice data container, including result
+         * validates the visible part of the sonagram, with the tiles
+         * that are available in the tile cache
          */
-        void sliceAvailable(Kwave::SonagramPlugin::Slice *slice);
-
-    private slots:
+        void validate();
 
         /**
-         * validate the sonagram by calling makeAllValid in a background thread
+         * Requests an update of the sonagram or portions of it
          */
-        void validate();
+        void requestValidation();
 
         /**
          * Connected to the SonagramWindow's "destroyed()" signal.
@@ -127,13 +87,26 @@ namespace Kwave
         void windowDestroyed();
 
         /**
-         * Internally used to synchronously insert the data of one
-         * sonagram slice int the current image and refresh the
-         * display.
-         * @note DO NOT CALL DIRECTLY!
-         * @param slice a slice data container, including result
+         * Changes the zoom factor
+         * @param direction +1 for zoom in, -1 for zoom out,
+         *                  0 for showing everything
+         * @see SonagramWindow::sigZoom
+         */
+        void slotZoom(int direction);
+
+        /**
+         * Scrolls to a new position
+         * @param first_column index of the first visible column
+         * @see SonagramWindow::sigScroll
+         */
+        void slotScroll(int first_column);
+
+        /**
+         * Adapts the viewport to a new size of the view
+         * @param width the new width of the view [pixels]
+         * @see SonagramWindow::sigViewResized
          */
-        void insertSlice(Kwave::SonagramPlugin::Slice *slice);
+        void slotViewResized(int width);
 
         /**
          * Updates the overview image under the sonagram
@@ -177,34 +150,20 @@ namespace Kwave
     private:
 
         /**
-         * will be run in a background thread to make all stripes
-         * valid.
-         */
-        void makeAllValid();
-
-        /**
-         * Requests an update of the sonagram or portions of it
+         * Passes the selected range and tracks to the tile cache, which
+         * discards all tiles if they have changed
          */
-        void requestValidation();
+        void updateSource();
 
         /**
-         * do the FFT calculation on a slice
-         * @param slice structure with the input data and output buffer
+         * Returns the stride that shows the whole selection in the view
          */
-        void calculateSlice(Kwave::SonagramPlugin::Slice *slice);
+        sample_index_t fitStride() const;
 
         /**
-         * Creates a new image for the current processing.
-         * If an old image exists, it will be deleted first, a new image
-         * will not be created if either width or height is zero.
-         * The image will get 8 bits depth and use a color or a greyscale
-         * palette.
-         * @param width number of horizontal pixels (slices = signal
-         *        length / fft points, rounded up) [1..32767]
-         * @param height number of vertical pixels (= fft points / 2) [1..32767]
+         * Returns the number of columns at the current stride
          */
-        void createNewImage(const unsigned int width,
-            const unsigned int height);
+        sample_index_t columns() const;
 
     private:
 
@@ -214,9 +173,6 @@ namespace Kwave
         /** selection tracker */
         Kwave::SelectionTracker *m_selection;
 
-        /** number of slices (= width of the image in pixels) */
-        unsigned int m_slices;
-
         /** number of fft points */
         unsigned int m_fft_points;
 
@@ -232,26 +188,23 @@ namespace Kwave
         /** if true, update the sonagram if the selection changed */
         bool m_follow_selection;
 
-        /** stores the image that is currently in process */
-        QImage m_image;
-
         /** cache with the current signal overview */
         Kwave::OverViewCache *m_overview_cache;
 
-        /** pool of slices */
-        Kwave::FixedPool<MAX_FFT_JOBS, Slice> m_slice_pool;
+        /** cache with the computed tiles of the sonagram */
+        Kwave::SonagramTileCache *m_tile_cache;
 
-        /** bit field with "is valid" a flag for each stripe */
-        QBitArray m_valid;
+        /** number of samples per column, the zoom factor */
+        sample_index_t m_stride;
 
-        /** lock used for tracking running background jobs */
-        QReadWriteLock m_pending_jobs;
+        /** index of the first visible column */
+        sample_index_t m_first_column;
 
-        /** lock to protect the job list (m_valid) */
-        QRecursiveMutex m_lock_job_list;
+        /** width of the view [pixels] */
+        int m_view_width;
 
-        /** the currently running background job */
-        QFuture<void> m_future;
+        /** if true, adapt the zoom to show everything */
+        bool m_zoom_all;
 
         /** timer for refreshing the sonagram */
         QTimer m_repaint_timer;
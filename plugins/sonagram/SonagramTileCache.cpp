@@ -0,0 +1,295 @@
+/***************************************************************************
+  SonagramTileCache.cpp  -  cache for background computed sonagram tiles
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <QImage>
+
+#include "libkwave/STFT.h"
+#include "libkwave/SampleArray.h"
+#include "libkwave/SampleReader.h"
+#include "libkwave/SignalManager.h"
+#include "libkwave/TaskPool.h"
+#include "libkwave/Utils.h"
+
+#include "SonagramTileCache.h"
+
+/** number of input samples of one tile, determines the number of columns */
+#define TILE_SAMPLES (256 * 1024)
+
+/** minimum number of columns per tile */
+#define MIN_TILE_COLUMNS 8
+
+/** maximum number of columns per tile */
+#define MAX_TILE_COLUMNS 256
+
+/** minimum size of the cache [kilobytes] */
+#define CACHE_MIN_COST 8192
+
+//***************************************************************************
+Kwave::SonagramTileCache::SonagramTileCache(
+    Kwave::SignalManager &signal_manager)
+    :QObject(), Kwave::TileCache<TileKey, Tile>(CACHE_MIN_COST),
+     m_signal_manager(signal_manager), m_setup(), m_offset(0), m_tracks(),
+     m_stride(0)
+{
+    m_setup.fft_points = 0;
+    m_setup.columns    = MIN_TILE_COLUMNS;
+    m_setup.window     = Kwave::WINDOW_FUNC_NONE;
+    m_setup.length     = 0;
+}
+
+//***************************************************************************
+Kwave::SonagramTileCache::~SonagramTileCache()
+{
+}
+
+//***************************************************************************
+void Kwave::SonagramTileCache::setParameters(unsigned int fft_points,
+    Kwave::window_function_t window_type)
+{
+    if ((fft_points == m_setup.fft_points) && (window_type == m_setup.window))
+        return; // no change
+
+    m_setup.fft_points = fft_points;
+    m_setup.columns    = qBound<unsigned int>(MIN_TILE_COLUMNS,
+        TILE_SAMPLES / qMax(1U, fft_points), MAX_TILE_COLUMNS);
+    m_setup.window     = window_type;
+    clear();
+}
+
+//***************************************************************************
+void Kwave::SonagramTileCache::setSource(sample_index_t offset,
+                                         sample_index_t length,
+                                         const QVector<unsigned int> &tracks)
+{
+    if ((offset == m_offset) && (length == m_setup.length) &&
+        (tracks == m_tracks)) return; // no change
+
+    m_offset       = offset;
+    m_setup.length = length;
+    m_tracks       = tracks;
+    clear();
+}
+
+//***************************************************************************
+sample_index_t Kwave::SonagramTileCache::firstSample(const TileKey &key) const
+{
+    return key.index * m_setup.columns * key.stride;
+}
+
+//***************************************************************************
+sample_index_t Kwave::SonagramTileCache::lastSample(const TileKey &key) const
+{
+    const sample_index_t last = firstSample(key) +
+        ((m_setup.columns - 1) * key.stride) + m_setup.fft_points - 1;
+    return (m_setup.length) ? qMin(last, m_setup.length - 1) : 0;
+}
+
+//***************************************************************************
+bool Kwave::SonagramTileCache::compose(QImage &image, sample_index_t stride,
+                                       sample_index_t first_column)
+{
+    Q_ASSERT(image.format() == QImage::Format_Indexed8);
+    Q_ASSERT(stride >= m_setup.fft_points);
+    if (image.isNull() || (image.format() != QImage::Format_Indexed8))
+        return false;
+    if ((m_setup.fft_points < 4) || (stride < m_setup.fft_points))
+        return false;
+    m_stride = stride;
+
+    const unsigned int columns = m_setup.columns;
+    const int bins   = Kwave::toInt(m_setup.fft_points / 2);
+    const int height = qMin(image.height(), bins);
+    const int width  = image.width();
+    const sample_index_t last_column = first_column + width - 1;
+    const sample_index_t first_tile  = first_column / columns;
+    const sample_index_t last_tile   = last_column  / columns;
+
+    // keep the visible tiles and some more for scrolling back and forth
+    const int visible = Kwave::toInt(last_tile - first_tile + 1);
+    const int cost    = qMax(1, Kwave::toInt((columns * bins) >> 10));
+    setVisibleCost(static_cast<qint64>(visible) * cost);
+
+    // everything that is not available stays transparent
+    image.fill(0xFF);
+
+    TileKey key;
+    key.stride = stride;
+    key.index  = 0;
+    bool complete = true;
+    for (sample_index_t index = first_tile; index <= last_tile; ++index) {
+        key.index = index;
+        if (firstSample(key) >= m_setup.length) break; // behind the end
+
+        const Tile *tile = cachedTile(key);
+        if (!tile) {
+            request(key);
+            complete = false;
+            continue;
+        }
+
+        // copy the visible columns, the first row is the highest frequency
+        const sample_index_t tile_start = index * columns;
+        const sample_index_t c0 = qMax(first_column, tile_start);
+        const sample_index_t c1 = qMin(last_column, tile_start + columns - 1);
+        const uchar *data = reinterpret_cast<const uchar *>(
+            tile->data.constData());
+        for (int y = 0; y < height; ++y) {
+            uchar *line = image.scanLine(y);
+            const int bin = bins - 1 - y;
+            for (sample_index_t c = c0; c <= c1; ++c)
+                line[c - first_column] = data[((c - tile_start) * bins) + bin];
+        }
+    }
+
+    // prefetch the neighbours, for smooth scrolling
+    if (complete) {
+        key.index = last_tile + 1;
+        if ((firstSample(key) < m_setup.length) && !contains(key))
+            request(key);
+        key.index = first_tile - 1;
+        if (first_tile && !contains(key))
+            request(key);
+    }
+
+    return complete;
+}
+
+//***************************************************************************
+void Kwave::SonagramTileCache::request(const TileKey &key)
+{
+    if (isPending(key)) return; // already on the way
+    if (m_tracks.isEmpty()) return;
+
+    Tile job;
+    job.key = key;
+
+    const sample_index_t first = m_offset + firstSample(key);
+    const sample_index_t last  = m_offset + lastSample(key);
+    foreach (unsigned int track, m_tracks) {
+        Kwave::SampleReader *reader = m_signal_manager.openReader(
+            Kwave::SinglePassForward, track, first, last);
+        Q_ASSERT(reader);
+        if (!reader) {
+            qDeleteAll(job.readers);
+            return;
+        }
+        job.readers.append(reader);
+    }
+
+    QFutureWatcher<Tile> *watcher =
+        addJob(key, this, SLOT(tileFinished()));
+    if (!watcher) {
+        qDeleteAll(job.readers);
+        return;
+    }
+
+    Setup setup(m_setup);
+    setup.length += m_offset; // readers use absolute positions
+    watcher->setFuture(Kwave::TaskPool::run(Kwave::TaskPool::Interactive,
+        &Kwave::SonagramTileCache::compute, job, setup));
+}
+
+//***************************************************************************
+Kwave::SonagramTileCache::Tile Kwave::SonagramTileCache::compute(Tile tile,
+                                                                 Setup setup)
+{
+    const unsigned int points  = setup.fft_points;
+    const unsigned int bins    = points / 2;
+    const unsigned int columns = setup.columns;
+    const int tracks = Kwave::toInt(tile.readers.count());
+
+    // columns behind the end stay transparent
+    tile.data.fill(static_cast<char>(0xFF), columns * bins);
+
+    // the columns are not contiguous in the signal, so they are
+    // collected one after another and transformed without overlap
+    Kwave::STFT stft(points, setup.window, points, columns);
+    QVector<double> input(Kwave::toInt(points * columns), 0.0);
+    Kwave::SampleArray buffer(points);
+    Q_ASSERT(buffer.size() == points);
+
+    // fill the input of all columns, averaged over all tracks
+    unsigned int used = 0;
+    if (stft.isValid() && tracks && (buffer.size() == points)) {
+        const sample_index_t first = tile.readers.first()->first();
+        for (; used < columns; ++used) {
+            const sample_index_t pos = first + (used * tile.key.stride);
+            if (pos >= setup.length) break;
+
+            double *column = input.data() + (used * points);
+            foreach (Kwave::SampleReader *reader, tile.readers) {
+                reader->seek(pos);
+                const unsigned int count = reader->read(buffer, 0, points);
+                const sample_t *samples = buffer.constData();
+                for (unsigned int j = 0; j < count; ++j)
+                    column[j] += sample2double(samples[j]);
+            }
+            for (unsigned int j = 0; j < points; ++j)
+                column[j] /= tracks;
+        }
+    }
+    qDeleteAll(tile.readers);
+    tile.readers.clear();
+
+    // one batched transform for all columns of the tile
+    QVector<Kwave::STFT::Complex> spectra(
+        Kwave::toInt(used * stft.bins()));
+    if (used && stft.forward(input.constData(), used, spectra.data())) {
+        // norm all values to [0...254] and use them as pixel value
+        const double scale = static_cast<double>(points) / 254.0;
+        uchar *data = reinterpret_cast<uchar *>(tile.data.data());
+        for (unsigned int c = 0; c < used; ++c) {
+            const Kwave::STFT::Complex *o =
+                spectra.constData() + (c * stft.bins());
+            uchar *d = data + (c * bins);
+            for (unsigned int j = 0; j < bins; ++j) {
+                const double a = Kwave::STFT::power(o[j]) / scale;
+                d[j] = static_cast<uchar>(qMin(a, 254.0));
+            }
+        }
+    }
+
+    return tile;
+}
+
+//***************************************************************************
+void Kwave::SonagramTileCache::tileFinished()
+{
+    QFutureWatcher<Tile> *watcher =
+        static_cast<QFutureWatcher<Tile> *>(sender());
+    Q_ASSERT(watcher);
+    if (!watcher) return;
+
+    const Tile result = watcher->result();
+    takeResult(result, qMax(1, Kwave::toInt(result.data.size() >> 10)));
+
+    if (result.key.stride == m_stride) emit sigTilesReady();
+}
+
+//***************************************************************************
+void Kwave::SonagramTileCache::invalidate(sample_index_t first,
+                                          sample_index_t last)
+{
+    discard(first, last);
+}
+
+//***************************************************************************
+//***************************************************************************
+
+#include "moc_SonagramTileCache.cpp"
@@ -0,0 +1,200 @@
+/***************************************************************************
+    SonagramTileCache.h  -  cache for background computed sonagram tiles
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef SONAGRAM_TILE_CACHE_H
+#define SONAGRAM_TILE_CACHE_H
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QByteArray>
+#include <QList>
+#include <QObject>
+#include <QVector>
+
+#include "libkwave/Sample.h"
+#include "libkwave/TileCache.h"
+#include "libkwave/WindowFunction.h"
+
+class QImage;
+
+namespace Kwave
+{
+    class SampleReader;
+    class SignalManager;
+
+    /** identifies a sonagram tile: zoom factor and index of the tile */
+    typedef struct SonagramTileKey {
+        sample_index_t stride; /**< samples per column        */
+        sample_index_t index;  /**< index of the tile         */
+
+        /** compare operator, needed for QHash and QCache */
+        bool operator == (const SonagramTileKey &other) const {
+            return ((stride == other.stride) && (index == other.index));
+        }
+
+        /** hash function, needed for QHash and QCache */
+        friend size_t qHash(const SonagramTileKey &key, size_t seed = 0) {
+            return ::qHash(key.stride, seed) ^ ::qHash(key.index, seed);
+        }
+    } SonagramTileKey;
+
+    /** one sonagram tile, or one job */
+    typedef struct {
+        SonagramTileKey key;                 /**< zoom and index    */
+        QByteArray data;                     /**< columns, 0...254  */
+        QList<Kwave::SampleReader *> readers;/**< only for jobs     */
+    } SonagramTile;
+
+    /**
+     * Cache for the columns of a sonagram. The sonagram is split into
+     * tiles with a fixed number of columns, for each zoom factor. Only
+     * the tiles that are needed for the visible area are computed, in
+     * the global thread pool and with one batched STFT per tile. The GUI
+     * thread only copies the finished columns into the image.
+     *
+     * One column is the spectrum of fft_points samples, starting at
+     * the column's index multiplied with the stride, which is the zoom
+     * factor in samples per column.
+     */
+    class SonagramTileCache: public QObject,
+        public Kwave::TileCache<Kwave::SonagramTileKey, Kwave::SonagramTile>
+    {
+        Q_OBJECT
+    public:
+
+        /**
+         * Constructor
+         * @param signal_manager the signal manager with the sample data
+         */
+        explicit SonagramTileCache(Kwave::SignalManager &signal_manager);
+
+        /** Destructor */
+        ~SonagramTileCache() override;
+
+        /**
+         * Sets the parameters of the FFT, discards all tiles if they
+         * have changed
+         * @param fft_points number of FFT points [4...]
+         * @param window_type the window function
+         */
+        void setParameters(unsigned int fft_points,
+                           Kwave::window_function_t window_type);
+
+        /**
+         * Sets the range of samples and the tracks to use, discards
+         * all tiles if they have changed
+         * @param offset index of the first sample
+         * @param length number of samples
+         * @param tracks list of track indices, the tracks are averaged
+         */
+        void setSource(sample_index_t offset, sample_index_t length,
+                       const QVector<unsigned int> &tracks);
+
+        /**
+         * Fills an image with columns of the sonagram. Tiles that are
+         * not available are requested in the background and left
+         * transparent, sigTilesReady() is emitted when they are done.
+         *
+         * @param image an 8 bit indexed image, with a height of
+         *              fft_points / 2, the first pixel row is the
+         *              highest frequency
+         * @param stride number of samples per column [fft_points...]
+         * @param first_column index of the first column
+         * @return true if all columns were available
+         */
+        bool compose(QImage &image, sample_index_t stride,
+                     sample_index_t first_column);
+
+        /**
+         * Discards all tiles that contain samples of a given range
+         * @param first index of the first sample, relative to the offset
+         * @param last index of the last sample, relative to the offset
+         */
+        void invalidate(sample_index_t first, sample_index_t last);
+
+    signals:
+
+        /** emitted when tiles for the current zoom have become ready */
+        void sigTilesReady();
+
+    private slots:
+
+        /** takes over the result of a finished job */
+        void tileFinished();
+
+    private:
+
+        /** identifies a tile */
+        typedef Kwave::SonagramTileKey TileKey;
+
+        /** one tile, or one job */
+        typedef Kwave::SonagramTile Tile;
+
+        /** parameters of the computation, the same for all tiles */
+        typedef struct {
+            unsigned int fft_points;    /**< number of FFT points      */
+            unsigned int columns;       /**< columns per tile          */
+            Kwave::window_function_t window; /**< window function  */
+            sample_index_t length;      /**< number of samples, for a
+                                             job the end of the range */
+        } Setup;
+
+        /** returns the first sample of a tile, relative to the offset */
+        sample_index_t firstSample(const TileKey &key) const override;
+
+        /** returns the last sample of a tile, relative to the offset */
+        sample_index_t lastSample(const TileKey &key) const override;
+
+        /**
+         * Computes the columns of a tile, runs in a worker thread
+         * @param tile the job, with one reader per track
+         * @param setup parameters of the computation
+         * @return the finished tile
+         */
+        static Tile compute(Tile tile, Setup setup);
+
+        /**
+         * Starts a job for a tile if not already pending
+         * @param key zoom and index of the tile
+         */
+        void request(const TileKey &key);
+
+    private:
+
+        /** signal manager with the sample data */
+        Kwave::SignalManager &m_signal_manager;
+
+        /** parameters of the computation */
+        Setup m_setup;
+
+        /** index of the first sample */
+        sample_index_t m_offset;
+
+        /** list of track indices */
+        QVector<unsigned int> m_tracks;
+
+        /** zoom factor of the last compose() */
+        sample_index_t m_stride;
+
+    };
+}
+
+#endif /* SONAGRAM_TILE_CACHE_H */
+
+//***************************************************************************
+//***************************************************************************
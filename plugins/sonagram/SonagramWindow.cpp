@@ -18,16 +18,19 @@
 #include "config.h"
 
 #include <math.h>
+
+#include <limits>
 #include <new>
 
 #include <QBitmap>
+#include <QEvent>
 #include <QImage>
 #include <QLabel>
 #include <QMenuBar>
 #include <QPointer>
 #include <QLayout>
+#include <QScrollBar>
 #include <QStatusBar>
-#include <QTimer>
 
 #include "libkwave/String.h"
 #include "libkwave/Utils.h"
@@ -39,11 +42,6 @@
 
 #include "SonagramWindow.h"
 
-/**
- * delay between two screen updates [ms]
- */
-#define REFRESH_DELAY 100
-
 /**
  * Color values below this limit are cut off when adjusting the
  * sonagram image's brightness
@@ -94,7 +92,9 @@ Kwave::SonagramWindow::SonagramWindow(QWidget *parent, const QString &name)
      m_rate(0),
      m_xscale(nullptr),
      m_yscale(nullptr),
-     m_refresh_timer()
+     m_scrollbar(nullptr),
+     m_first_column(0),
+     m_stride(0)
 {
 
     for (unsigned int i = 0; i < 256; ++i) { m_histogram[i] = 0; }
@@ -138,6 +138,28 @@ Kwave::SonagramWindow::SonagramWindow(QWidget *parent, const QString &name)
 //    spectral->addAction(i18n("&Retransform to Signal"), this,
 //                        SLOT(toSignal()));
 
+    QMenu *view = bar->addMenu(i18n("&View"));
+    Q_ASSERT(view);
+    if (!view) return ;
+
+    view->addAction(
+        QIcon::fromTheme(_("zoom-in")),
+        i18n("Zoom &In"),
+        QKeySequence::ZoomIn,
+        this, SLOT(zoomIn())
+    );
+    view->addAction(
+        QIcon::fromTheme(_("zoom-out")),
+        i18n("Zoom &Out"),
+        QKeySequence::ZoomOut,
+        this, SLOT(zoomOut())
+    );
+    view->addAction(
+        QIcon::fromTheme(_("zoom-fit-best")),
+        i18n("Zoom to &All"),
+        this, SLOT(zoomAll())
+    );
+
     QStatusBar *status = statusBar();
     Q_ASSERT(status);
     if (!status) return ;
@@ -156,6 +178,7 @@ Kwave::SonagramWindow::SonagramWindow(QWidget *parent, const QString &name)
     Q_ASSERT(m_view);
     if (!m_view) return;
     top_layout->addWidget(m_view, 0, 1);
+    m_view->installEventFilter(this);
     QPalette palette;
     palette.setBrush(m_view->backgroundRole(), QBrush(QImage(background)));
     m_view->setAutoFillBackground(true);
@@ -166,7 +189,13 @@ Kwave::SonagramWindow::SonagramWindow(QWidget *parent, const QString &name)
     Q_ASSERT(m_xscale);
     if (!m_xscale) return;
     m_xscale->setFixedHeight(m_xscale->sizeHint().height());
-    top_layout->addWidget(m_xscale, 1, 1);
+    top_layout->addWidget(m_xscale, 2, 1);
+
+    m_scrollbar = new(std::nothrow) QScrollBar(Qt::Horizontal, mainwidget);
+    Q_ASSERT(m_scrollbar);
+    if (!m_scrollbar) return;
+    m_scrollbar->setRange(0, 0);
+    top_layout->addWidget(m_scrollbar, 1, 1);
 
     m_yscale = new(std::nothrow)
         Kwave::ScaleWidget(mainwidget, 0, 100, i18n("Hz"));
@@ -180,18 +209,19 @@ Kwave::SonagramWindow::SonagramWindow(QWidget *parent, const QString &name)
     Q_ASSERT(m_overview);
     if (!m_overview) return;
     m_overview->setFixedHeight(SONAGRAM_OVERVIEW_HEIGHT);
-    top_layout->addWidget(m_overview, 2, 1);
+    top_layout->addWidget(m_overview, 3, 1);
 
     connect(m_view, SIGNAL(sigCursorPos(QPoint)),
             this, SLOT(cursorPosChanged(QPoint)));
-    connect(&m_refresh_timer, SIGNAL(timeout()),
-            this, SLOT(refresh_view()));
+    connect(m_scrollbar, SIGNAL(valueChanged(int)),
+            this, SIGNAL(sigScroll(int)));
 
     setName(name);
 
     top_layout->setRowStretch(0, 100);
     top_layout->setRowStretch(1, 0);
     top_layout->setRowStretch(2, 0);
+    top_layout->setRowStretch(3, 0);
     top_layout->setColumnStretch(0, 0);
     top_layout->setColumnStretch(1, 100);
     top_layout->activate();
@@ -288,15 +318,16 @@ void Kwave::SonagramWindow::setImage(QImage image)
     for (unsigned int i = 0; i < 256; i++)
         m_histogram[i] = 0;
     if (!m_image.isNull()) {
-        for (int x = 0; x < m_image.width(); x++) {
-            for (int y = 0; y < m_image.height(); y++) {
-                quint8 p = static_cast<quint8>(m_image.pixelIndex(x, y));
-                m_histogram[p]++;
-            }
+        const int width = m_image.width();
+        for (int y = 0; y < m_image.height(); y++) {
+            const uchar *line = m_image.constScanLine(y);
+            for (int x = 0; x < width; x++)
+                m_histogram[line[x]]++;
         }
     }
 
     refresh_view();
+    updateScaleWidgets();
 }
 
 //****************************************************************************
@@ -305,47 +336,6 @@ void Kwave::SonagramWindow::setOverView(const QImage &overview)
     if (m_overview) m_overview->setImage(overview);
 }
 
-//****************************************************************************
-void Kwave::SonagramWindow::insertSlice(const unsigned int slice_nr,
-                                        const QByteArray &slice)
-{
-    Q_ASSERT(m_view);
-    if (!m_view) return;
-    if (m_image.isNull()) return;
-
-    unsigned int image_width  = m_image.width();
-    unsigned int image_height = m_image.height();
-
-    // slice is out of range ?
-    if (slice_nr >= image_width) return;
-
-    unsigned int y;
-    unsigned int size = static_cast<unsigned int>(slice.size());
-    for (y = 0; y < size; y++) {
-        quint8 p;
-
-        // remove the current pixel from the histogram
-        p = static_cast<quint8>(m_image.pixelIndex(slice_nr, y));
-        m_histogram[p]--;
-
-        // set the new pixel value
-        p = slice[(size - 1) - y];
-        m_image.setPixel(slice_nr, y, p);
-
-        // insert the new pixel into the histogram
-        m_histogram[p]++;
-    }
-    while (y < image_height) { // fill the rest with blank
-        m_image.setPixel(slice_nr, y++, 0xFE);
-        m_histogram[0xFE]++;
-    }
-
-    if (!m_refresh_timer.isActive()) {
-        m_refresh_timer.setSingleShot(true);
-        m_refresh_timer.start(REFRESH_DELAY);
-    }
-}
-
 //****************************************************************************
 void Kwave::SonagramWindow::adjustBrightness()
 {
@@ -476,8 +466,9 @@ void Kwave::SonagramWindow::translatePixels2TF(const QPoint p,
     if (ms) {
         // get the time coordinate [0...(N_samples-1)* (1/f_sample) ]
         if (!qFuzzyIsNull(m_rate)) {
-            *ms = static_cast<double>(p.x()) *
-                  static_cast<double>(m_points) * 1000.0 / m_rate;
+            const sample_index_t stride = (m_stride) ? m_stride : m_points;
+            *ms = static_cast<double>(m_first_column + p.x()) *
+                  static_cast<double>(stride) * 1000.0 / m_rate;
         } else {
             *ms = 0;
         }
@@ -495,12 +486,16 @@ void Kwave::SonagramWindow::translatePixels2TF(const QPoint p,
 //***************************************************************************
 void Kwave::SonagramWindow::updateScaleWidgets()
 {
+    double ms_first;
     double ms;
     double f;
 
-    translatePixels2TF(QPoint(m_image.width() - 1, 0), &ms, &f);
+    if (!m_xscale || !m_yscale) return;
 
-    m_xscale->setMinMax(0, Kwave::toInt(rint(ms)));
+    translatePixels2TF(QPoint(0, 0), &ms_first, nullptr);
+    translatePixels2TF(QPoint(qMax(0, m_image.width() - 1), 0), &ms, &f);
+
+    m_xscale->setMinMax(Kwave::toInt(rint(ms_first)), Kwave::toInt(rint(ms)));
     m_yscale->setMinMax(0, Kwave::toInt(rint(f)));
 }
 
@@ -579,6 +574,62 @@ void Kwave::SonagramWindow::setRate(double rate)
     updateScaleWidgets();
 }
 
+//****************************************************************************
+void Kwave::SonagramWindow::setViewport(sample_index_t first_column,
+                                        sample_index_t columns,
+                                        sample_index_t stride)
+{
+    m_first_column = first_column;
+    m_stride       = stride;
+
+    if (m_scrollbar) {
+        const int page = qMax(1, viewWidth());
+        const sample_index_t max = (columns > sample_index_t(page)) ?
+            (columns - page) : 0;
+        m_scrollbar->blockSignals(true);
+        m_scrollbar->setRange(0, Kwave::toInt(qMin(max,
+            static_cast<sample_index_t>(std::numeric_limits<int>::max()))));
+        m_scrollbar->setPageStep(page);
+        m_scrollbar->setSingleStep(qMax(1, page / 16));
+        m_scrollbar->setValue(Kwave::toInt(qMin(first_column, max)));
+        m_scrollbar->blockSignals(false);
+    }
+
+    updateScaleWidgets();
+}
+
+//****************************************************************************
+int Kwave::SonagramWindow::viewWidth() const
+{
+    return (m_view) ? m_view->width() : 0;
+}
+
+//****************************************************************************
+void Kwave::SonagramWindow::zoomIn()
+{
+    emit sigZoom(+1);
+}
+
+//****************************************************************************
+void Kwave::SonagramWindow::zoomOut()
+{
+    emit sigZoom(-1);
+}
+
+//****************************************************************************
+void Kwave::SonagramWindow::zoomAll()
+{
+    emit sigZoom(0);
+}
+
+//****************************************************************************
+bool Kwave::SonagramWindow::eventFilter(QObject *watched, QEvent *event)
+{
+    if ((watched == m_view) && event && (event->type() == QEvent::Resize))
+        emit sigViewResized(m_view->width());
+    return KMainWindow::eventFilter(watched, event);
+}
+
 //***************************************************************************
 //***************************************************************************
 
@@ -20,11 +20,13 @@
 
 #include "config.h"
 
-#include <QTimer>
-
 #include <KMainWindow>
 
+#include "libkwave/Sample.h"
+
+class QEvent;
 class QImage;
+class QScrollBar;
 
 /** height of the overview widget in a sonagram window [pixels] */
 #define SONAGRAM_OVERVIEW_HEIGHT 30
@@ -70,14 +72,39 @@ namespace Kwave
         void setOverView(const QImage &image);
 
         /**
-         * Inserts a slice into the current image. If the slice contains more
-         * data than fits into the image, the remaining rest will be ignored,
-         * if less data is present, it will be filled with 0xFF. The previous
-         * content of the image slice will be cleared or updated in all cases.
-         * @param slice_nr index of the slice (horizontal position) [0..n-1]
-         * @param slice array with the byte data
+         * Sets the visible part of the sonagram, the image that is set
+         * with setImage() starts at the first visible column and has one
+         * pixel per column.
+         * @param first_column index of the first visible column
+         * @param columns total number of columns
+         * @param stride number of samples per column
+         */
+        void setViewport(sample_index_t first_column, sample_index_t columns,
+                         sample_index_t stride);
+
+        /** returns the width of the view [pixels] */
+        int viewWidth() const;
+
+    signals:
+
+        /**
+         * Emitted when the user wants to zoom
+         * @param direction +1 for zoom in, -1 for zoom out,
+         *                  0 for showing everything
+         */
+        void sigZoom(int direction);
+
+        /**
+         * Emitted when the user has scrolled
+         * @param first_column index of the first visible column
          */
-        void insertSlice(const unsigned int slice_nr, const QByteArray &slice);
+        void sigScroll(int first_column);
+
+        /**
+         * Emitted when the size of the view has changed
+         * @param width the new width of the view [pixels]
+         */
+        void sigViewResized(int width);
 
     public slots:
 
@@ -126,13 +153,25 @@ namespace Kwave
          */
         void setRate(double rate);
 
+        /** zooms in by a factor of two */
+        void zoomIn();
+
+        /** zooms out by a factor of two */
+        void zoomOut();
+
+        /** zooms out to show everything */
+        void zoomAll();
+
     private slots:
 
-        /** refreshes the image, connected to m_refresh_timer */
+        /** refreshes the image */
         void refresh_view();
 
     protected:
 
+        /** watches the view for resize events */
+        bool eventFilter(QObject *watched, QEvent *event) override;
+
         /** updates the scale widgets */
         void updateScaleWidgets();
 
@@ -193,8 +232,14 @@ namespace Kwave
         /** widget for the scale on the frequency (y) axis */
         Kwave::ScaleWidget *m_yscale;
 
-        /** timer used for refreshing the view from time to time */
-        QTimer m_refresh_timer;
+        /** horizontal scroll bar, in units of columns */
+        QScrollBar *m_scrollbar;
+
+        /** index of the first visible column */
+        sample_index_t m_first_column;
+
+        /** number of samples per column, zero means fft points */
+        sample_index_t m_stride;
 
         /** histogram of color indices, used for auto-contrast */
         unsigned int m_histogram[256];
@@ -0,0 +1,402 @@
+/***************************************************************************
+       SpectrumPlugin.cpp  -  averaged spectrum and coherence of a selection
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <errno.h>
+#include <math.h>
+#include <new>
+
+#include <QFutureSynchronizer>
+#include <QThread>
+
+#include <KLocalizedString> // for the i18n macro
+
+#include "libkwave/MessageBox.h"
+#include "libkwave/PluginManager.h"
+#include "libkwave/SampleArray.h"
+#include "libkwave/SampleReader.h"
+#include "libkwave/SignalManager.h"
+#include "libkwave/String.h"
+#include "libkwave/TaskPool.h"
+#include "libkwave/Utils.h"
+
+#include "SpectrumPlugin.h"
+#include "SpectrumWindow.h"
+
+KWAVE_PLUGIN(spectrum, SpectrumPlugin)
+
+/** default number of FFT points */
+#define DEFAULT_FFT_POINTS 4096
+
+/** maximum number of FFT points */
+#define MAX_FFT_POINTS 65536
+
+/** number of frames that are transformed in one task */
+#define SEGMENT_FRAMES 64
+
+/** number of frames that are transformed in one FFT call */
+#define BATCH_FRAMES 16
+
+/** lowest level that is shown [dB] */
+#define MIN_DB (-120.0)
+
+//***************************************************************************
+Kwave::SpectrumPlugin::SpectrumPlugin(QObject *parent,
+                                      const QVariantList &args)
+    :Kwave::Plugin(parent, args), m_coherence(false),
+     m_fft_points(DEFAULT_FFT_POINTS),
+     m_window_type(Kwave::WINDOW_FUNC_HANNING),
+     m_curves(), m_names(), m_rate(0)
+{
+}
+
+//***************************************************************************
+Kwave::SpectrumPlugin::~SpectrumPlugin()
+{
+}
+
+//***************************************************************************
+int Kwave::SpectrumPlugin::interpreteParameters(QStringList &params)
+{
+    // spectrum([psd | coherence] [, fft points [, window function]])
+    m_coherence   = false;
+    m_fft_points  = DEFAULT_FFT_POINTS;
+    m_window_type = Kwave::WINDOW_FUNC_HANNING;
+    if (params.count() > 3) return -EINVAL;
+
+    if (params.count() >= 1) {
+        const QString mode = params[0].trimmed();
+        if (mode == _("coherence"))
+            m_coherence = true;
+        else if (mode != _("psd"))
+            return -EINVAL;
+    }
+
+    if (params.count() >= 2) {
+        bool ok;
+        m_fft_points = params[1].trimmed().toUInt(&ok);
+        if (!ok || (m_fft_points < 16) || (m_fft_points > MAX_FFT_POINTS))
+            return -EINVAL;
+    }
+
+    if (params.count() >= 3)
+        m_window_type =
+            Kwave::WindowFunction::findFromName(params[2].trimmed());
+
+    return 0;
+}
+
+//***************************************************************************
+int Kwave::SpectrumPlugin::start(QStringList &params)
+{
+    int result = interpreteParameters(params);
+    if (result) return result;
+
+    QVector<unsigned int> tracks;
+    if (!selection(&tracks, nullptr, nullptr, true) || tracks.isEmpty())
+        return -EINVAL;
+    if (m_coherence && (tracks.count() < 2)) {
+        Kwave::MessageBox::sorry(parentWidget(),
+            i18n("The coherence needs at least two selected tracks."));
+        return -EINVAL;
+    }
+
+    return Kwave::Plugin::start(params);
+}
+
+//***************************************************************************
+void Kwave::SpectrumPlugin::run(QStringList params)
+{
+    if (interpreteParameters(params)) return;
+
+    QVector<unsigned int> tracks;
+    sample_index_t offset = 0;
+    const sample_index_t length =
+        selection(&tracks, &offset, nullptr, true);
+    if (!length || tracks.isEmpty()) return;
+    if (m_coherence) {
+        if (tracks.count() < 2) return;
+        tracks.resize(2);
+    }
+    const int count = Kwave::toInt(tracks.count());
+
+    // the geometry of the frames, each task uses its own instance
+    const Kwave::STFT stft(m_fft_points, m_window_type);
+    if (!stft.isValid()) return;
+    const unsigned int bins   = stft.bins();
+    const quint64      frames = stft.frames(length);
+    const quint64 segments    =
+        (frames + SEGMENT_FRAMES - 1) / SEGMENT_FRAMES;
+
+    QList<QVector<double> > power;
+    for (int t = 0; t < count; ++t)
+        power.append(QVector<double>(Kwave::toInt(bins), 0.0));
+    QVector<Kwave::STFT::Complex> cross(Kwave::toInt(bins));
+
+    emit setProgressText((m_coherence) ?
+        i18n("Computing the coherence...") :
+        i18n("Computing the spectrum..."));
+
+    // transform as many segments in parallel as there are cores
+    const int parallel = qMax(1, QThread::idealThreadCount());
+    QVector<Segment> jobs(parallel);
+    quint64 segment = 0;
+    while (!shouldStop() && (segment < segments)) {
+        QFutureSynchronizer<void> synchronizer;
+        int n = 0;
+        for (; (n < parallel) && (segment < segments); ++n, ++segment) {
+            Segment &seg = jobs[n];
+            const quint64 first_frame = segment * SEGMENT_FRAMES;
+            seg.frames = qMin<quint64>(SEGMENT_FRAMES, frames - first_frame);
+            seg.power.clear();
+            seg.cross.clear();
+
+            const sample_index_t first = offset + (first_frame * stft.hop());
+            const sample_index_t last  = qMin<sample_index_t>(
+                first + stft.samples(seg.frames) - 1, offset + length - 1);
+            foreach (unsigned int track, tracks) {
+                Kwave::SampleReader *reader = signalManager().openReader(
+                    Kwave::SinglePassForward, track, first, last);
+                Q_ASSERT(reader);
+                if (reader) seg.readers.append(reader);
+            }
+
+            synchronizer.addFuture(Kwave::TaskPool::run(
+                Kwave::TaskPool::Background,
+                &Kwave::SpectrumPlugin::processSegment, this, &seg));
+        }
+        synchronizer.waitForFinished();
+
+        // add up the results of this round
+        for (int i = 0; i < n; ++i) {
+            const Segment &seg = jobs[i];
+            for (int t = 0; t < count && t < seg.power.count(); ++t) {
+                const double *src = seg.power[t].constData();
+                double *dst = power[t].data();
+                for (unsigned int b = 0; b < bins; ++b) dst[b] += src[b];
+            }
+            for (int b = 0; b < seg.cross.count(); ++b)
+                cross[b] += seg.cross[b];
+        }
+
+        const qreal progress = (100.0 * static_cast<qreal>(segment)) /
+                               static_cast<qreal>(segments);
+        QMetaObject::invokeMethod(this, "updateProgress",
+                                  Qt::QueuedConnection,
+                                  Q_ARG(qreal, progress));
+    }
+    if (shouldStop()) return;
+
+    m_rate = signalRate();
+    m_curves.clear();
+    m_names.clear();
+    if (m_coherence) {
+        // magnitude squared coherence [%] and phase [degrees]
+        QVector<double> coherence(Kwave::toInt(bins), 0.0);
+        QVector<double> phase(Kwave::toInt(bins), 0.0);
+        for (unsigned int b = 0; b < bins; ++b) {
+            const double pxy = Kwave::STFT::power(cross[b]);
+            const double pxx_pyy = power[0][b] * power[1][b];
+            if (pxx_pyy <= 0.0) continue;
+            coherence[b] = 100.0 * qMin(1.0, pxy / pxx_pyy);
+            phase[b] = std::arg(cross[b]) * 180.0 / M_PI;
+        }
+        m_curves << coherence << phase;
+        m_names  << i18n("Coherence") << i18n("Phase");
+    } else {
+        // the last frames may reach behind the end of the selection and
+        // are padded with zeroes, they only count with the part of the
+        // window energy that covers real samples
+        const QVector<double> &window = stft.window();
+        const unsigned int points = m_fft_points;
+        double energy = 0.0;
+        for (const double w : window) energy += w * w;
+        double weight = 0.0;
+        for (quint64 f = frames; (energy > 0.0) && (f-- > 0); ) {
+            const quint64 real = length - (f * stft.hop());
+            if (real >= points) {
+                weight += static_cast<double>(f + 1); // all complete
+                break;
+            }
+            double part = 0.0;
+            for (unsigned int i = 0; i < real; ++i)
+                part += window[i] * window[i];
+            weight += part / energy;
+        }
+
+        // average of all frames, 0 dB is a sine with full scale
+        double sum = 0.0;
+        for (const double w : window) sum += w;
+        const double reference = (sum * sum) / 4.0;
+        const double scale = ((weight > 0.0) && (reference > 0.0)) ?
+            (1.0 / (weight * reference)) : 0.0;
+        for (int t = 0; t < count; ++t) {
+            QVector<double> db(Kwave::toInt(bins), MIN_DB);
+            for (unsigned int b = 0; b < bins; ++b) {
+                const double p = power[t][b] * scale;
+                if (p > 0.0) db[b] = qMax(MIN_DB, 10.0 * log10(p));
+            }
+            m_curves << db;
+            m_names  << i18n("Track %1", tracks[t] + 1);
+        }
+    }
+
+    // the window keeps the plugin alive until it is closed
+    use();
+    QMetaObject::invokeMethod(this, "showResult", Qt::QueuedConnection);
+}
+
+//***************************************************************************
+/**
+ * Reads the samples of one segment, the last frames of the selection are
+ * padded with zeroes
+ * @param reader the source of the samples
+ * @param input receives the samples
+ * @param buffer buffer for reading
+ */
+static void readSegment(Kwave::SampleReader *reader, QVector<double> &input,
+                        Kwave::SampleArray &buffer)
+{
+    const quint64 samples = static_cast<quint64>(input.size());
+    input.fill(0.0);
+
+    quint64 pos = 0;
+    while ((pos < samples) && !reader->eof()) {
+        const unsigned int len = reader->read(buffer, 0,
+            Kwave::toUint(qMin<quint64>(buffer.size(), samples - pos)));
+        if (!len) break;
+        const sample_t *src = buffer.constData();
+        double *dst = input.data() + pos;
+        for (unsigned int i = 0; i < len; ++i)
+            dst[i] = sample2double(src[i]);
+        pos += len;
+    }
+}
+
+//***************************************************************************
+void Kwave::SpectrumPlugin::processSegment(Segment *segment)
+{
+    Q_ASSERT(segment);
+    if (!segment) return;
+
+    Kwave::STFT stft(m_fft_points, m_window_type, 0, BATCH_FRAMES);
+    const unsigned int bins    = stft.bins();
+    const unsigned int hop     = stft.hop();
+    const unsigned int frames  = Kwave::toUint(segment->frames);
+    const quint64      samples = stft.samples(frames);
+    const int          tracks  = Kwave::toInt(segment->readers.count());
+    const bool         cross   = m_coherence && (tracks >= 2);
+
+    // the spectra are summed up batch by batch, only the coherence
+    // needs the spectra of its two tracks at the same time
+    QVector<double> x_in(Kwave::toInt(samples), 0.0);
+    QVector<double> y_in((cross) ? Kwave::toInt(samples) : 0, 0.0);
+    QVector<Kwave::STFT::Complex> x(Kwave::toInt(BATCH_FRAMES * bins));
+    QVector<Kwave::STFT::Complex> y((cross) ? x.size() : 0);
+    Kwave::SampleArray buffer(64 * 1024);
+
+    for (int t = 0; t < tracks; t += (cross) ? 2 : 1) {
+        QVector<double> x_power(Kwave::toInt(bins), 0.0);
+        QVector<double> y_power((cross) ? Kwave::toInt(bins) : 0, 0.0);
+        readSegment(segment->readers[t], x_in, buffer);
+        if (cross) {
+            readSegment(segment->readers[t + 1], y_in, buffer);
+            segment->cross.fill(Kwave::STFT::Complex(0.0, 0.0),
+                                Kwave::toInt(bins));
+        }
+
+        for (unsigned int f = 0; f < frames; f += BATCH_FRAMES) {
+            const unsigned int n = qMin<unsigned int>(BATCH_FRAMES,
+                                                      frames - f);
+            const quint64 start = quint64(f) * hop;
+            if (!stft.forward(x_in.constData() + start, n, x.data()))
+                break;
+            if (cross && !stft.forward(y_in.constData() + start, n,
+                                       y.data()))
+                break;
+
+            for (unsigned int i = 0; i < n * bins; i += bins) {
+                const Kwave::STFT::Complex *xf = x.constData() + i;
+                for (unsigned int b = 0; b < bins; ++b)
+                    x_power[b] += Kwave::STFT::power(xf[b]);
+                if (!cross) continue;
+
+                const Kwave::STFT::Complex *yf = y.constData() + i;
+                for (unsigned int b = 0; b < bins; ++b) {
+                    y_power[b] += Kwave::STFT::power(yf[b]);
+                    segment->cross[b] += std::conj(xf[b]) * yf[b];
+                }
+            }
+        }
+
+        segment->power.append(x_power);
+        if (cross) {
+            segment->power.append(y_power);
+            break; // the coherence only uses the first two tracks
+        }
+    }
+    qDeleteAll(segment->readers);
+    segment->readers.clear();
+}
+
+//***************************************************************************
+void Kwave::SpectrumPlugin::showResult()
+{
+    const QString name = signalName();
+    const QString title = (m_coherence) ?
+        i18n("Coherence of %1", name) : i18n("Spectrum of %1", name);
+
+    Kwave::SpectrumWindow *window = new(std::nothrow)
+        Kwave::SpectrumWindow(parentWidget(), title);
+    Q_ASSERT(window);
+    if (!window) {
+        release();
+        return;
+    }
+
+    connect(window, SIGNAL(destroyed()), this, SLOT(windowDestroyed()));
+    connect(&manager(), SIGNAL(sigClosed()), window, SLOT(close()));
+
+    window->setRate(m_rate);
+    if (m_coherence && (m_curves.count() >= 2)) {
+        window->addPanel(_("%"), 0.0, 100.0,
+                         m_curves.mid(0, 1), m_names.mid(0, 1));
+        window->addPanel(i18n("deg"), -180.0, 180.0,
+                         m_curves.mid(1, 1), m_names.mid(1, 1));
+    } else {
+        double max = 0.0;
+        foreach (const QVector<double> &curve, m_curves)
+            for (const double v : curve) max = qMax(max, v);
+        window->addPanel(i18n("dB"), MIN_DB, ceil(max / 10.0) * 10.0,
+                         m_curves, m_names);
+    }
+    window->show();
+}
+
+//***************************************************************************
+void Kwave::SpectrumPlugin::windowDestroyed()
+{
+    release();
+}
+
+//***************************************************************************
+#include "SpectrumPlugin.moc"
+//***************************************************************************
+//***************************************************************************
+
+#include "moc_SpectrumPlugin.cpp"
@@ -0,0 +1,133 @@
+/***************************************************************************
+         SpectrumPlugin.h  -  averaged spectrum and coherence of a selection
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef SPECTRUM_PLUGIN_H
+#define SPECTRUM_PLUGIN_H
+
+#include "config.h"
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "libkwave/Plugin.h"
+#include "libkwave/STFT.h"
+#include "libkwave/WindowFunction.h"
+
+namespace Kwave
+{
+    class SampleReader;
+
+    /**
+     * Evaluates the current selection in the frequency domain, with the
+     * short time fourier transform over the whole selection:
+     * - "psd": the averaged power spectrum of each track (Welch method)
+     * - "coherence": the magnitude squared coherence and the phase
+     *   between the first two selected tracks
+     *
+     * The selection is split into segments which are transformed in
+     * parallel, the result is shown in a SpectrumWindow.
+     */
+    class SpectrumPlugin: public Kwave::Plugin
+    {
+        Q_OBJECT
+
+    public:
+
+        /**
+         * Constructor
+         * @param parent reference to our plugin manager
+         * @param args argument list [unused]
+         */
+        SpectrumPlugin(QObject *parent, const QVariantList &args);
+
+        /** Destructor */
+        ~SpectrumPlugin() override;
+
+        /**
+         * Checks the parameters and starts the worker thread
+         * @param params list of strings with parameters
+         * @return zero if successful or negative error code
+         */
+        int start(QStringList &params) override;
+
+        /**
+         * computes the spectrum of the selection
+         * @param params list of strings with parameters
+         */
+        void run(QStringList params) override;
+
+    private slots:
+
+        /** shows the result in a new window, in the GUI thread */
+        void showResult();
+
+        /** releases the plugin when the window has been closed */
+        void windowDestroyed();
+
+    private:
+
+        /** sums of the spectra of one segment of the selection */
+        typedef struct {
+            QList<Kwave::SampleReader *> readers; /**< one per track    */
+            quint64 frames;                      /**< number of frames  */
+            QList<QVector<double> > power;       /**< |X|^2 per track   */
+            QVector<Kwave::STFT::Complex> cross; /**< conj(X) * Y       */
+        } Segment;
+
+        /**
+         * reads values from the parameter list
+         * @param params list of strings with parameters
+         * @return zero if successful or negative error code
+         */
+        int interpreteParameters(QStringList &params);
+
+        /**
+         * Transforms one segment of the selection, runs in a worker
+         * thread with its own STFT
+         * @param segment the segment, receives the sums of the spectra
+         */
+        void processSegment(Segment *segment);
+
+    private:
+
+        /** if true, compute the coherence instead of the spectrum */
+        bool m_coherence;
+
+        /** number of FFT points */
+        unsigned int m_fft_points;
+
+        /** the window function */
+        Kwave::window_function_t m_window_type;
+
+        /** curves of the result, see SpectrumWindow::addPanel */
+        QList<QVector<double> > m_curves;
+
+        /** names of the curves */
+        QStringList m_names;
+
+        /** sample rate of the signal */
+        double m_rate;
+
+    };
+}
+
+#endif /* SPECTRUM_PLUGIN_H */
+
+//***************************************************************************
+//***************************************************************************
@@ -0,0 +1,120 @@
+/***************************************************************************
+         SpectrumView.cpp  -  widget for displaying spectral curves
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <math.h>
+
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QPolygonF>
+
+#include "libkwave/Utils.h"
+
+#include "SpectrumView.h"
+
+/** number of grid lines in each direction */
+#define GRID_LINES 10
+
+//***************************************************************************
+Kwave::SpectrumView::SpectrumView(QWidget *parent)
+    :QWidget(parent), m_curves(), m_min(0.0), m_max(1.0)
+{
+    setMouseTracking(true);
+    setMinimumSize(200, 100);
+}
+
+//***************************************************************************
+Kwave::SpectrumView::~SpectrumView()
+{
+}
+
+//***************************************************************************
+void Kwave::SpectrumView::setCurves(const QList<QVector<double> > &curves,
+                                    double min, double max)
+{
+    m_curves = curves;
+    m_min    = min;
+    m_max    = (max > min) ? max : (min + 1.0);
+    update();
+}
+
+//***************************************************************************
+QColor Kwave::SpectrumView::color(int index)
+{
+    static const Qt::GlobalColor colors[] = {
+        Qt::green, Qt::yellow, Qt::cyan, Qt::magenta, Qt::red, Qt::white
+    };
+    const int count = static_cast<int>(sizeof(colors) / sizeof(colors[0]));
+    return QColor(colors[qMax(0, index) % count]);
+}
+
+//***************************************************************************
+void Kwave::SpectrumView::mouseMoveEvent(QMouseEvent *e)
+{
+    if (!e || m_curves.isEmpty()) return;
+    const int bins = Kwave::toInt(m_curves.first().count());
+    if ((bins < 2) || (width() < 2)) return;
+
+    const double x = qBound(0.0, e->position().x(),
+                            static_cast<double>(width() - 1));
+    emit sigCursor(Kwave::toInt(rint(x * (bins - 1) / (width() - 1))));
+}
+
+//***************************************************************************
+void Kwave::SpectrumView::paintEvent(QPaintEvent *)
+{
+    const int w = width();
+    const int h = height();
+
+    QPainter p(this);
+    p.fillRect(rect(), Qt::black);
+
+    // grid
+    p.setPen(QColor(0x40, 0x40, 0x40));
+    for (int i = 1; i < GRID_LINES; ++i) {
+        const int x = (i * (w - 1)) / GRID_LINES;
+        const int y = (i * (h - 1)) / GRID_LINES;
+        p.drawLine(x, 0, x, h - 1);
+        p.drawLine(0, y, w - 1, y);
+    }
+
+    // the curves, values outside of [min ... max] are clipped
+    const double scale = static_cast<double>(h - 1) / (m_max - m_min);
+    int index = 0;
+    foreach (const QVector<double> &curve, m_curves) {
+        const int bins = Kwave::toInt(curve.count());
+        if (bins < 2) continue;
+
+        QPolygonF line;
+        line.reserve(bins);
+        for (int i = 0; i < bins; ++i) {
+            const double v = qBound(m_min, curve[i], m_max);
+            line.append(QPointF(
+                static_cast<double>(i) * (w - 1) / (bins - 1),
+                (h - 1) - ((v - m_min) * scale)));
+        }
+        p.setPen(color(index++));
+        p.drawPolyline(line);
+    }
+}
+
+//***************************************************************************
+//***************************************************************************
+
+#include "moc_SpectrumView.cpp"
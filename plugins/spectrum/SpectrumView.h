@@ -0,0 +1,97 @@
+/***************************************************************************
+           SpectrumView.h  -  widget for displaying spectral curves
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef SPECTRUM_VIEW_H
+#define SPECTRUM_VIEW_H
+
+#include "config.h"
+
+#include <QColor>
+#include <QList>
+#include <QVector>
+#include <QWidget>
+
+class QMouseEvent;
+class QPaintEvent;
+
+namespace Kwave
+{
+
+    /**
+     * Shows one or more curves over the frequency axis, with the
+     * lowest frequency on the left and a linear vertical scale.
+     */
+    class SpectrumView: public QWidget
+    {
+        Q_OBJECT
+    public:
+
+        /**
+         * Constructor
+         * @param parent the parent widget
+         */
+        explicit SpectrumView(QWidget *parent);
+
+        /** Destructor */
+        ~SpectrumView() override;
+
+        /**
+         * Sets the curves to display
+         * @param curves list of curves, with one value per bin
+         * @param min value at the lower border
+         * @param max value at the upper border
+         */
+        void setCurves(const QList<QVector<double> > &curves,
+                       double min, double max);
+
+        /** returns the color of a curve */
+        static QColor color(int index);
+
+    signals:
+
+        /**
+         * Emitted when the mouse moves over the view
+         * @param bin index of the bin under the mouse cursor
+         */
+        void sigCursor(int bin);
+
+    protected:
+
+        /** @see QWidget::mouseMoveEvent */
+        void mouseMoveEvent(QMouseEvent *e) override;
+
+        /** @see QWidget::paintEvent */
+        void paintEvent(QPaintEvent *) override;
+
+    private:
+
+        /** the curves */
+        QList<QVector<double> > m_curves;
+
+        /** value at the lower border */
+        double m_min;
+
+        /** value at the upper border */
+        double m_max;
+
+    };
+}
+
+#endif /* SPECTRUM_VIEW_H */
+
+//***************************************************************************
+//***************************************************************************
@@ -0,0 +1,166 @@
+/***************************************************************************
+       SpectrumWindow.cpp  -  window for displaying spectral curves
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <math.h>
+#include <new>
+
+#include <QLabel>
+#include <QLayout>
+#include <QMenuBar>
+#include <QStatusBar>
+
+#include <KLocalizedString>
+
+#include "libkwave/String.h"
+#include "libkwave/Utils.h"
+
+#include "libgui/ScaleWidget.h"
+
+#include "SpectrumView.h"
+#include "SpectrumWindow.h"
+
+//***************************************************************************
+Kwave::SpectrumWindow::SpectrumWindow(QWidget *parent, const QString &title)
+    :KMainWindow(parent), m_layout(nullptr), m_xscale(nullptr),
+     m_status_freq(nullptr), m_status_values(nullptr), m_rate(0),
+     m_panels(0), m_curves(), m_names(), m_units()
+{
+    setAttribute(Qt::WA_DeleteOnClose);
+    setWindowTitle(title);
+
+    QWidget *mainwidget = new(std::nothrow) QWidget(this);
+    Q_ASSERT(mainwidget);
+    if (!mainwidget) return;
+    setCentralWidget(mainwidget);
+
+    m_layout = new(std::nothrow) QGridLayout(mainwidget);
+    Q_ASSERT(m_layout);
+    if (!m_layout) return;
+    m_layout->setColumnStretch(0, 0);
+    m_layout->setColumnStretch(1, 100);
+
+    QMenuBar *bar = menuBar();
+    Q_ASSERT(bar);
+    if (!bar) return;
+    QMenu *file = bar->addMenu(i18n("&Spectrum"));
+    Q_ASSERT(file);
+    if (!file) return;
+    file->addAction(
+        QIcon::fromTheme(_("dialog-close")),
+        i18n("&Close"),
+        QKeySequence::Close,
+        this, SLOT(close())
+    );
+
+    QStatusBar *status = statusBar();
+    Q_ASSERT(status);
+    if (!status) return;
+    m_status_freq = new(std::nothrow)
+        QLabel(i18n("Frequency: ------ Hz"), status);
+    m_status_values = new(std::nothrow) QLabel(status);
+    status->addPermanentWidget(m_status_freq);
+    status->addPermanentWidget(m_status_values, 100);
+
+    m_xscale = new(std::nothrow)
+        Kwave::ScaleWidget(mainwidget, 0, 100, i18n("Hz"));
+    Q_ASSERT(m_xscale);
+    if (!m_xscale) return;
+    m_xscale->setFixedHeight(m_xscale->sizeHint().height());
+
+    resize(640, 400);
+}
+
+//***************************************************************************
+Kwave::SpectrumWindow::~SpectrumWindow()
+{
+}
+
+//***************************************************************************
+void Kwave::SpectrumWindow::setRate(double rate)
+{
+    m_rate = rate;
+    if (m_xscale) m_xscale->setMinMax(0, Kwave::toInt(rint(rate / 2.0)));
+}
+
+//***************************************************************************
+void Kwave::SpectrumWindow::addPanel(const QString &unit,
+                                     double min, double max,
+                                     const QList<QVector<double> > &curves,
+                                     const QStringList &names)
+{
+    Q_ASSERT(m_layout);
+    Q_ASSERT(m_xscale);
+    if (!m_layout || !m_xscale) return;
+    QWidget *mainwidget = centralWidget();
+
+    const int panel_row = m_panels++;
+
+    Kwave::ScaleWidget *yscale = new(std::nothrow) Kwave::ScaleWidget(
+        mainwidget, Kwave::toInt(floor(min)), Kwave::toInt(ceil(max)), unit);
+    Q_ASSERT(yscale);
+    if (!yscale) return;
+    yscale->setFixedWidth(yscale->sizeHint().width());
+    m_layout->addWidget(yscale, panel_row, 0);
+
+    Kwave::SpectrumView *view = new(std::nothrow)
+        Kwave::SpectrumView(mainwidget);
+    Q_ASSERT(view);
+    if (!view) return;
+    view->setCurves(curves, min, max);
+    m_layout->addWidget(view, panel_row, 1);
+    m_layout->setRowStretch(panel_row, 100);
+    connect(view, SIGNAL(sigCursor(int)), this, SLOT(cursorChanged(int)));
+
+    // the frequency scale stays below the last panel
+    m_layout->removeWidget(m_xscale);
+    m_layout->addWidget(m_xscale, panel_row + 1, 1);
+    m_layout->setRowStretch(panel_row + 1, 0);
+
+    for (int i = 0; i < curves.count(); ++i) {
+        m_curves.append(curves[i]);
+        m_names.append((i < names.count()) ? names[i] : QString());
+        m_units.append(unit);
+    }
+}
+
+//***************************************************************************
+void Kwave::SpectrumWindow::cursorChanged(int bin)
+{
+    if (m_curves.isEmpty()) return;
+    const int bins = Kwave::toInt(m_curves.first().count());
+    if ((bin < 0) || (bin >= bins) || (bins < 2)) return;
+
+    const double f = (m_rate / 2.0) * bin / (bins - 1);
+    if (m_status_freq)
+        m_status_freq->setText(i18n("Frequency: %1 Hz", Kwave::toInt(f)));
+
+    QStringList values;
+    for (int i = 0; i < m_curves.count(); ++i) {
+        if (bin >= m_curves[i].count()) continue;
+        values.append(i18nc("name of a curve, value, unit", "%1: %2 %3",
+            m_names[i], QString::number(m_curves[i][bin], 'f', 1),
+            m_units[i]));
+    }
+    if (m_status_values) m_status_values->setText(values.join(_("   ")));
+}
+
+//***************************************************************************
+//***************************************************************************
+
+#include "moc_SpectrumWindow.cpp"
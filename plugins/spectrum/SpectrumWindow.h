@@ -0,0 +1,120 @@
+/***************************************************************************
+         SpectrumWindow.h  -  window for displaying spectral curves
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef SPECTRUM_WINDOW_H
+#define SPECTRUM_WINDOW_H
+
+#include "config.h"
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <KMainWindow>
+
+class QGridLayout;
+class QLabel;
+
+namespace Kwave
+{
+
+    class ScaleWidget;
+
+    /**
+     * Window for displaying the results of a spectral analysis, with
+     * one or more panels of curves over a common frequency axis and a
+     * status bar with the values under the mouse cursor.
+     */
+    class SpectrumWindow: public KMainWindow
+    {
+        Q_OBJECT
+
+    public:
+
+        /**
+         * Constructor.
+         * @param parent the parent widget
+         * @param title the title of the window
+         */
+        SpectrumWindow(QWidget *parent, const QString &title);
+
+        /** Destructor */
+        ~SpectrumWindow() override;
+
+        /**
+         * Sets the sample rate, for the frequency axis
+         * @param rate sample rate in samples per second
+         */
+        void setRate(double rate);
+
+        /**
+         * Adds a panel with curves
+         * @param unit unit of the vertical scale
+         * @param min value at the lower border
+         * @param max value at the upper border
+         * @param curves list of curves, with one value per bin
+         * @param names names of the curves, for the status bar
+         */
+        void addPanel(const QString &unit, double min, double max,
+                      const QList<QVector<double> > &curves,
+                      const QStringList &names);
+
+    private slots:
+
+        /**
+         * Shows the values under the mouse cursor
+         * @param bin index of the bin
+         */
+        void cursorChanged(int bin);
+
+    private:
+
+        /** layout with the panels */
+        QGridLayout *m_layout;
+
+        /** widget for the scale on the frequency axis */
+        Kwave::ScaleWidget *m_xscale;
+
+        /** status bar label for the frequency */
+        QLabel *m_status_freq;
+
+        /** status bar label for the values */
+        QLabel *m_status_values;
+
+        /** sample rate */
+        double m_rate;
+
+        /** number of panels */
+        int m_panels;
+
+        /** all curves of all panels */
+        QList<QVector<double> > m_curves;
+
+        /** names of the curves */
+        QStringList m_names;
+
+        /** units of the curves */
+        QStringList m_units;
+
+    };
+}
+
+#endif /* SPECTRUM_WINDOW_H */
+
+//***************************************************************************
+//***************************************************************************
@@ -0,0 +1,216 @@
+/***************************************************************************
+   TestSignalPlugin.cpp  -  generates sine waves, sweeps and noise
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include <errno.h>
+#include <math.h>
+#include <new>
+#include <vector>
+
+#include <KLocalizedString> // for the i18n macro
+
+#include <QRandomGenerator>
+#include <QStringList>
+#include <QVector>
+
+#include "libkwave/MultiTrackWriter.h"
+#include "libkwave/PluginManager.h"
+#include "libkwave/String.h"
+#include "libkwave/Utils.h"
+#include "libkwave/Writer.h"
+#include "libkwave/modules/PhasorOscillator.h"
+#include "libkwave/modules/RandomNoise.h"
+#include "libkwave/modules/SweepGenerator.h"
+#include "libkwave/undo/UndoTransactionGuard.h"
+
+#include "TestSignalPlugin.h"
+
+KWAVE_PLUGIN(testsignal, TestSignalPlugin)
+
+/** number of samples generated at once */
+#define BLOCK_SIZE (64 * 1024)
+
+//***************************************************************************
+Kwave::TestSignalPlugin::TestSignalPlugin(QObject *parent,
+                                          const QVariantList &args)
+    :Kwave::Plugin(parent, args), m_type(Sine), m_level(0.0),
+     m_f_start(0.0), m_f_end(0.0)
+{
+}
+
+//***************************************************************************
+Kwave::TestSignalPlugin::~TestSignalPlugin()
+{
+}
+
+//***************************************************************************
+int Kwave::TestSignalPlugin::interpreteParameters(QStringList &params)
+{
+    bool ok;
+
+    // testsignal(<type>, <level>[, <frequency>[, <end frequency>]])
+    if (params.count() < 2) return -EINVAL;
+
+    const QString type = params[0];
+    int needed = 2;
+    if (type == _("sine")) {
+        m_type = Sine;
+        needed = 3;
+    } else if (type == _("sweep")) {
+        m_type = LinearSweep;
+        needed = 4;
+    } else if (type == _("logsweep")) {
+        m_type = LogSweep;
+        needed = 4;
+    } else if (type == _("white")) {
+        m_type = WhiteNoise;
+    } else if (type == _("pink")) {
+        m_type = PinkNoise;
+    } else if (type == _("tpdf")) {
+        m_type = TpdfNoise;
+    } else {
+        return -EINVAL;
+    }
+    if (params.count() != needed) return -EINVAL;
+
+    // level in dBFS
+    m_level = params[1].toDouble(&ok);
+    Q_ASSERT(ok);
+    if (!ok || (m_level > 0.0)) return -EINVAL;
+
+    // frequencies in Hz, limited to the Nyquist frequency, so that the
+    // presets in the menu also work with low sample rates
+    const double f_max = signalRate() / 2.0;
+    if (needed >= 3) {
+        m_f_start = params[2].toDouble(&ok);
+        Q_ASSERT(ok);
+        if (!ok || (m_f_start < 0.0)) return -EINVAL;
+        m_f_start = qMin(m_f_start, f_max);
+    }
+    m_f_end = m_f_start;
+    if (needed >= 4) {
+        m_f_end = params[3].toDouble(&ok);
+        Q_ASSERT(ok);
+        if (!ok || (m_f_end < 0.0)) return -EINVAL;
+        m_f_end = qMin(m_f_end, f_max);
+    }
+    if ((m_type == LogSweep) && ((m_f_start <= 0.0) || (m_f_end <= 0.0)))
+        return -EINVAL;
+
+    // all parameters accepted
+    return 0;
+}
+
+//***************************************************************************
+int Kwave::TestSignalPlugin::start(QStringList &params)
+{
+    int result = interpreteParameters(params);
+    if (result) return result;
+
+    return Kwave::Plugin::start(params);
+}
+
+//***************************************************************************
+void Kwave::TestSignalPlugin::run(QStringList params)
+{
+    if (interpreteParameters(params)) return;
+
+    Kwave::UndoTransactionGuard undo_guard(*this, i18n("Test Signal"));
+
+    Kwave::MultiTrackWriter writers(signalManager(), Kwave::Overwrite);
+    if (!writers.tracks()) return;
+
+    // connect the progress dialog
+    connect(&writers, SIGNAL(progress(qreal)),
+            this,     SLOT(updateProgress(qreal)),
+            Qt::BlockingQueuedConnection);
+
+    sample_index_t first = writers[0]->first();
+    sample_index_t last  = writers[0]->last();
+    const unsigned int tracks    = writers.tracks();
+    const double       rate      = signalRate();
+    const double       amplitude = pow(10.0, m_level / 20.0);
+    const bool         periodic  = (m_type == Sine) ||
+                                   (m_type == LinearSweep) ||
+                                   (m_type == LogSweep);
+
+    // periodic signals: one generator for all tracks
+    Kwave::PhasorOscillator osc;
+    osc.setFrequency(m_f_start / rate);
+    osc.setAmplitude(amplitude);
+
+    Kwave::SweepGenerator sweep;
+    sweep.setSweep(m_f_start / rate, m_f_end / rate, last - first + 1,
+                   (m_type == LogSweep));
+    sweep.setAmplitude(amplitude);
+
+    // noise: one independent generator per track
+    std::vector<Kwave::RandomNoise> noise(tracks);
+    for (Kwave::RandomNoise &n : noise) {
+        n.seed(QRandomGenerator::global()->generate());
+        if (m_type == PinkNoise)
+            n.setShape(Kwave::RandomNoise::Pink);
+        else if (m_type == TpdfNoise)
+            n.setShape(Kwave::RandomNoise::Tpdf);
+    }
+
+    QVector<float> buffer(BLOCK_SIZE);
+    Kwave::SampleArray samples(BLOCK_SIZE);
+    bool succeeded = (samples.size() == BLOCK_SIZE);
+
+    // loop over the sample range
+    while ((first <= last) && !shouldStop() && succeeded) {
+        const sample_index_t rest = last - first + 1;
+        const unsigned int   len  = Kwave::toUint(
+            qMin<sample_index_t>(rest, BLOCK_SIZE));
+        if (len != samples.size()) {
+            succeeded = samples.resize(len);
+            Q_ASSERT(succeeded);
+            if (!succeeded) break;
+        }
+        float *f = buffer.data();
+
+        if (periodic) {
+            if (m_type == Sine)
+                osc.generate(f, len);
+            else
+                sweep.generate(f, len);
+            floats2samples(f, samples.data(), len);
+            for (unsigned int w = 0; w < tracks; w++)
+                *(writers[w]) << samples;
+        } else {
+            const float a = static_cast<float>(amplitude);
+            for (unsigned int w = 0; w < tracks; w++) {
+                noise[w].generate(f, len);
+                for (unsigned int i = 0; i < len; ++i)
+                    f[i] *= a;
+                floats2samples(f, samples.data(), len);
+                *(writers[w]) << samples;
+            }
+        }
+
+        first += len;
+    }
+}
+
+//***************************************************************************
+#include "TestSignalPlugin.moc"
+//***************************************************************************
+//***************************************************************************
+
+#include "moc_TestSignalPlugin.cpp"
@@ -0,0 +1,105 @@
+/***************************************************************************
+     TestSignalPlugin.h  -  generates sine waves, sweeps and noise
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by Thomas Eschenbacher
+    email                : Thomas.Eschenbacher@gmx.de
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TEST_SIGNAL_PLUGIN_H
+#define TEST_SIGNAL_PLUGIN_H
+
+#include "config.h"
+
+#include <QString>
+#include <QStringList>
+
+#include "libkwave/Plugin.h"
+
+namespace Kwave
+{
+    /**
+     * @class TestSignalPlugin
+     * Overwrites the current selection with a test signal: a sine wave,
+     * a linear or logarithmic sweep or white, pink or TPDF noise. The
+     * periodic signals are the same in all tracks, the noise is
+     * independent in each track.
+     */
+    class TestSignalPlugin: public Kwave::Plugin
+    {
+        Q_OBJECT
+
+    public:
+
+        /**
+         * Constructor
+         * @param parent reference to our plugin manager
+         * @param args argument list [unused]
+         */
+        TestSignalPlugin(QObject *parent, const QVariantList &args);
+
+        /** Destructor */
+        ~TestSignalPlugin() override;
+
+        /**
+         * Checks the parameters before the worker thread starts
+         * @param params list of strings with parameters
+         * @return zero if ok, -EINVAL if the parameters are invalid
+         */
+        int start(QStringList &params) override;
+
+        /**
+         * Generates the test signal
+         * @param params list of strings with parameters
+         */
+        void run(QStringList params) override;
+
+    private:
+
+        /** type of the test signal */
+        typedef enum {
+            Sine,        /**< sine wave                            */
+            LinearSweep, /**< sweep with linear frequency          */
+            LogSweep,    /**< sweep with logarithmic frequency     */
+            WhiteNoise,  /**< white noise, uniform distribution    */
+            PinkNoise,   /**< pink noise                           */
+            TpdfNoise    /**< white noise, triangular distribution */
+        } Type;
+
+        /**
+         * Reads values from the parameter list
+         * @param params list of strings with parameters
+         * @return zero if ok, -EINVAL if the parameters are invalid
+         */
+        int interpreteParameters(QStringList &params);
+
+    private:
+
+        /** type of the signal */
+        Type m_type;
+
+        /** level [dBFS] */
+        double m_level;
+
+        /** (start) frequency [Hz] */
+        double m_f_start;
+
+        /** end frequency of a sweep [Hz] */
+        double m_f_end;
+
+    };
+}
+
+#endif /* TEST_SIGNAL_PLUGIN_H */
+
+//***************************************************************************
+//***************************************************************************